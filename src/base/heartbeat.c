@@ -31,6 +31,21 @@
  * When the -heartbeat option is specified then the HEARTBEAT_ACTIVE flag is set
  */
 static	char	activity_indicators[8] = {'|','/','-','\\','*'};
+
+// The counters and latency histogram of a target at the end of the last
+// heartbeat interval - used by the 'timeseries' option
+struct xint_heartbeat_interval {
+	int32_t						hi_pass_number;	// Pass number at the end of the last interval
+	nclk_t						hi_time;		// Time of the end of the last interval
+	xint_target_counters_t		hi_counters;	// Sum of the Worker Thread counters at the end of the last interval
+	xint_latency_histogram_t	*hi_lathistp;	// Sum of the Worker Thread latency histograms at the end of the last interval
+	xint_latency_histogram_t	*hi_nowp;		// Sum of the Worker Thread latency histograms now
+	xint_latency_histogram_t	*hi_deltap;		// Latency histogram of this interval
+};
+static int32_t	xdd_heartbeat_timeseries_open(xdd_plan_t *planp, target_data_t *tdp);
+static void		xdd_heartbeat_timeseries_sample(xdd_plan_t *planp, target_data_t *tdp);
+static void		xdd_heartbeat_timeseries_close(target_data_t *tdp);
+
 void *
 xdd_heartbeat(void *data) {
 	int32_t 	i;						// If it is not obvious what "i" is then you should not be reading this
@@ -40,10 +55,14 @@ xdd_heartbeat(void *data) {
 	int64_t		total_ops_issued;		// This is the total number of ops issued/completed up til now
 	double		elapsed;				// Elapsed time for this Worker Thread
 	target_data_t 		*tdp;			// Pointer to the Target's Data Struct
+	xint_target_counters_t	counters;	// The sum of the Worker Thread counters of a target
 	int			activity_index;			// A number from 0 to 4 to index into the activity indicators table
 	int			prior_activity_index;	// Used to save the state of the activity index 
 	int			scattered_output;		// When set to something other than 0 it means that the output is directed to mutliple files
-	uint32_t	interval;				// The shortest heartbeat interval that is greater than 0
+	nclk_t		interval;				// The shortest heartbeat interval that is greater than 0
+	nclk_t		next_beat;				// Time of the next heartbeat
+	nclk_t		nap;					// Time to sleep before checking for HEARTBEAT_EXIT again
+	struct timespec	req;				// Time to sleep for nanosleep()
 	xdd_occupant_t	barrier_occupant;	// Used by the xdd_barrier() function to track who is inside a barrier
 	xdd_plan_t* planp = (xdd_plan_t*)data;
 
@@ -54,7 +73,7 @@ xdd_heartbeat(void *data) {
 
 	// Open all the Heartbeat output Files if they are not the default (stderr)
 	scattered_output = 0;
-	interval = 31536000; // a year's worth of seconds
+	interval = 31536000ULL * BILLION; // a year's worth of nanoseconds
 	for (i = 0; i < planp->number_of_targets; i++) {
 		tdp = planp->target_datap[i];
 		if (tdp->td_hb.hb_filename) {
@@ -69,25 +88,62 @@ xdd_heartbeat(void *data) {
 			if (tdp->td_hb.hb_interval < interval) 
 				interval = tdp->td_hb.hb_interval;
 		}
+
+		// Open the time series file if requested
+		if (tdp->td_hb.hb_options & HB_TIMESERIES) 
+			xdd_heartbeat_timeseries_open(planp, tdp);
 	}
 	planp->heartbeat_flags |= HEARTBEAT_ACTIVE;
 	// Enter this barrier and wait for the heartbeat monitor to initialize
 	xdd_barrier(&planp->main_general_init_barrier,&barrier_occupant, 0);
 
+	nclk_now(&next_beat);
 	while (1) {
-		sleep(interval);
+		// Sleep until the next heartbeat in naps of at most HEARTBEAT_MAX_NAP so
+		// that the results_manager does not wait long for the heartbeat to exit
+		next_beat += interval;
+		nclk_now(&now);
+		while ((now < next_beat) && !(planp->heartbeat_flags & HEARTBEAT_EXIT)) {
+			nap = next_beat - now;
+			if (nap > HEARTBEAT_MAX_NAP)
+				nap = HEARTBEAT_MAX_NAP;
+			req.tv_sec = nap / BILLION;
+			req.tv_nsec = nap % BILLION;
+			nanosleep(&req, NULL);
+			nclk_now(&now);
+		}
+		if (now > next_beat + interval) // Do not try to catch up with beats that were missed
+			next_beat = now;
 		if (xgp->canceled) {
 			fprintf(xgp->errout,"\nHEARTBEAT: Canceled\n");
+			for (i = 0; i < planp->number_of_targets; i++) 
+				xdd_heartbeat_timeseries_close(planp->target_datap[i]);
 			return(0);
 		}
 		if (xgp->abort) {
 			fprintf(xgp->errout,"\nHEARTBEAT: Abort\n");
+			for (i = 0; i < planp->number_of_targets; i++) 
+				xdd_heartbeat_timeseries_close(planp->target_datap[i]);
+			return(0);
+		}
+
+		// The time series files are written even while the results are being displayed
+		for (i = 0; i < planp->number_of_targets; i++) {
+			tdp = planp->target_datap[i];
+			if (tdp->td_hb.hb_ts_lastp) {
+				pthread_mutex_lock(&tdp->td_hb.hb_ts_mutex);
+				if (tdp->td_hb.hb_ts_lastp) 
+					xdd_heartbeat_timeseries_sample(planp, tdp);
+				pthread_mutex_unlock(&tdp->td_hb.hb_ts_mutex);
+			}
+		}
+		if (planp->heartbeat_flags & HEARTBEAT_EXIT) {
+			for (i = 0; i < planp->number_of_targets; i++) 
+				xdd_heartbeat_timeseries_close(planp->target_datap[i]);
 			return(0);
 		}
 		if (planp->heartbeat_flags & HEARTBEAT_HOLDOFF) 
 			continue;
-		if (planp->heartbeat_flags & HEARTBEAT_EXIT) 
-			return(0);
 
 		// Display all the requested items for each target
 		for (i = 0; i < planp->number_of_targets; i++) {
@@ -96,6 +152,8 @@ xdd_heartbeat(void *data) {
 			// Check to see if this Target wants a heartbeat display, if not, just continue
 			if (tdp->td_hb.hb_interval == 0) 
 				continue;
+			if (tdp->td_hb.hb_options == HB_TIMESERIES) // Only the time series was requested
+				continue;
 
 			// Display the "legend" string
 			// If the "scattered_output" is greater than 0 then display the legend for each target
@@ -110,8 +168,9 @@ xdd_heartbeat(void *data) {
 				continue; 
 			}
 			// Get the number of bytes xferred by all Worker Threads for this Target
-			total_bytes_xferred = tdp->td_counters.tc_accumulated_bytes_xfered;
-			total_ops_issued = tdp->td_counters.tc_accumulated_op_count;
+			xdd_target_counters_sum(tdp, &counters);
+			total_bytes_xferred = counters.tc_accumulated_bytes_xfered;
+			total_ops_issued = counters.tc_accumulated_op_count;
 			// Determine if this is the earliest start time
 			if (earliest_start_time > tdp->td_counters.tc_pass_start_time) 
 				earliest_start_time = tdp->td_counters.tc_pass_start_time;
@@ -148,6 +207,211 @@ xdd_heartbeat(void *data) {
 DFLOW("\n----------------------heartbeat: Exit-------------------------\n");
 } /* end of xdd_heartbeat() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_heartbeat_timeseries_open() 
+ * Open the time series file of a target, write the column names and allocate
+ * the counters and latency histograms of the last interval.
+ * Returns 0 if all went well or -1 if the time series cannot be written in
+ * which case the 'timeseries' option is turned off for this target.
+ */
+static int32_t
+xdd_heartbeat_timeseries_open(xdd_plan_t *planp, target_data_t *tdp) {
+	struct xint_heartbeat_interval	*hip;
+
+
+	pthread_mutex_init(&tdp->td_hb.hb_ts_mutex, NULL);
+	hip = (struct xint_heartbeat_interval *)calloc(1, sizeof(struct xint_heartbeat_interval));
+	if (hip == NULL) {
+		fprintf(xgp->errout,"%s: xdd_heartbeat_timeseries_open: Target %d: ERROR: Cannot allocate %d bytes of memory for the heartbeat time series\n",
+			xgp->progname, tdp->td_target_number, (int)sizeof(struct xint_heartbeat_interval));
+		tdp->td_hb.hb_options &= ~HB_TIMESERIES;
+		return(-1);
+	}
+	hip->hi_lathistp = xdd_latency_histogram_alloc(tdp->td_target_number, "heartbeat");
+	hip->hi_nowp = xdd_latency_histogram_alloc(tdp->td_target_number, "heartbeat");
+	hip->hi_deltap = xdd_latency_histogram_alloc(tdp->td_target_number, "heartbeat");
+	if ((hip->hi_lathistp == NULL) || (hip->hi_nowp == NULL) || (hip->hi_deltap == NULL)) {
+		free(hip->hi_lathistp);
+		free(hip->hi_nowp);
+		free(hip->hi_deltap);
+		free(hip);
+		tdp->td_hb.hb_options &= ~HB_TIMESERIES;
+		return(-1);
+	}
+	tdp->td_hb.hb_ts_file_pointer = fopen(tdp->td_hb.hb_ts_filename,"w");
+	if (tdp->td_hb.hb_ts_file_pointer == NULL) {
+		fprintf(xgp->errout,"%s: xdd_heartbeat_timeseries_open: Target %d: ERROR: Cannot open time series file '%s'\n",
+			xgp->progname, tdp->td_target_number, tdp->td_hb.hb_ts_filename);
+		perror("reason");
+		free(hip->hi_lathistp);
+		free(hip->hi_nowp);
+		free(hip->hi_deltap);
+		free(hip);
+		tdp->td_hb.hb_options &= ~HB_TIMESERIES;
+		return(-1);
+	}
+	hip->hi_pass_number = -1;
+	tdp->td_hb.hb_ts_lastp = hip;
+	fprintf(tdp->td_hb.hb_ts_file_pointer,"Elapsed_sec,Pass,Target,Interval_sec,Ops,Read_Ops,Write_Ops,Bytes,Bandwidth_MBps,IOPS,Mean_Latency_ms,P50_Latency_ms,P90_Latency_ms,P99_Latency_ms,P999_Latency_ms,Busy_Workers,Queue_Depth\n");
+	fflush(tdp->td_hb.hb_ts_file_pointer);
+	return(0);
+} // End of xdd_heartbeat_timeseries_open()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_heartbeat_timeseries_sample() 
+ * Write the statistics of the interval since the last sample of a target to
+ * its time series file. The counters and latency histograms of the Worker
+ * Threads keep growing during a pass so the statistics of the interval are
+ * the difference between their sum now and their sum at the last sample.
+ * The Worker Threads are never stopped for this. 
+ * Nothing is written before the first pass starts or after a pass ends
+ * until the next pass starts. The last interval of a pass is written by the
+ * Target Thread when the pass ends - see xdd_heartbeat_timeseries_pass_end().
+ * The caller holds hb_ts_mutex.
+ */
+static void
+xdd_heartbeat_timeseries_sample(xdd_plan_t *planp, target_data_t *tdp) {
+	struct xint_heartbeat_interval	*hip;
+	worker_data_t			*wdp;
+	xint_latency_histogram_t	*lhp;
+	xint_target_counters_t	counters;	// The sum of the Worker Thread counters now
+	nclk_t					now;
+	int32_t					pass_number;
+	int64_t					ops;
+	int64_t					bytes;
+	double					interval;	// Seconds in this interval
+	double					mean;		// Mean latency in milliseconds
+	double					p[4];		// Latency percentiles in milliseconds
+	int32_t					busy;		// Worker Threads that are not available
+	int						w;
+
+
+	hip = tdp->td_hb.hb_ts_lastp;
+	if (tdp->td_counters.tc_pass_start_time == NCLK_MAX)  // Haven't started yet...
+		return;
+	pass_number = tdp->td_counters.tc_pass_number;
+	if (tdp->td_current_state & TARGET_CURRENT_STATE_PASS_COMPLETE) 
+		now = tdp->td_counters.tc_pass_end_time;
+	else nclk_now(&now);
+
+	// Get the sums of the counters and the latency histograms of all Worker Threads
+	xdd_target_counters_sum(tdp, &counters);
+	xdd_latency_histogram_reset(hip->hi_nowp);
+	wdp = tdp->td_next_wdp;
+	while (wdp) {
+		if (wdp->wd_lathistp)
+			xdd_latency_histogram_merge(hip->hi_nowp, wdp->wd_lathistp);
+		wdp = wdp->wd_next_wdp;
+	}
+
+	// A new pass resets the counters of the Worker Threads so this interval starts with the pass
+	if ((pass_number != hip->hi_pass_number) || 
+		(counters.tc_accumulated_op_count < hip->hi_counters.tc_accumulated_op_count)) {
+		memset(&hip->hi_counters, 0, sizeof(hip->hi_counters));
+		xdd_latency_histogram_reset(hip->hi_lathistp);
+		if (hip->hi_time < tdp->td_counters.tc_pass_start_time)
+			hip->hi_time = tdp->td_counters.tc_pass_start_time;
+		hip->hi_pass_number = pass_number;
+	}
+	if (now <= hip->hi_time)  // Nothing happened since the last sample
+		return;
+	xdd_latency_histogram_delta(hip->hi_deltap, hip->hi_nowp, hip->hi_lathistp);
+
+	interval = (double)(now - hip->hi_time) / FLOAT_BILLION;
+	ops = counters.tc_accumulated_op_count - hip->hi_counters.tc_accumulated_op_count;
+	bytes = counters.tc_accumulated_bytes_xfered - hip->hi_counters.tc_accumulated_bytes_xfered;
+	if (ops > 0) 
+		mean = ((double)(counters.tc_accumulated_op_time - hip->hi_counters.tc_accumulated_op_time) / (double)ops) / FLOAT_MILLION;
+	else mean = -1.0;
+	p[0] = (double)xdd_latency_histogram_value_at(hip->hi_deltap, XDD_LATHIST_ALL, 50.0);
+	p[1] = (double)xdd_latency_histogram_value_at(hip->hi_deltap, XDD_LATHIST_ALL, 90.0);
+	p[2] = (double)xdd_latency_histogram_value_at(hip->hi_deltap, XDD_LATHIST_ALL, 99.0);
+	p[3] = (double)xdd_latency_histogram_value_at(hip->hi_deltap, XDD_LATHIST_ALL, 99.9);
+	for (w = 0; w < 4; w++) 
+		if (p[w] > 0.0)
+			p[w] /= FLOAT_MILLION; // nano to milli
+
+	// The Worker Threads that are not in the idle map are busy with an operation
+	busy = 0;
+	if ((tdp->td_idle_worker_map) && !(tdp->td_current_state & TARGET_CURRENT_STATE_PASS_COMPLETE)) {
+		busy = tdp->td_queue_depth;
+		for (w = 0; w < tdp->td_idle_worker_words; w++) 
+			busy -= __builtin_popcountll(__atomic_load_n(&tdp->td_idle_worker_map[w], __ATOMIC_RELAXED));
+		if (busy < 0)
+			busy = 0;
+	}
+
+	fprintf(tdp->td_hb.hb_ts_file_pointer,"%.6f,%d,%d,%.6f,%lld,%lld,%lld,%lld,%.3f,%.3f,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%d\n",
+		(double)((double)now - (double)planp->run_start_time) / FLOAT_BILLION,
+		pass_number,
+		tdp->td_target_number,
+		interval,
+		(long long int)ops,
+		(long long int)(counters.tc_accumulated_read_op_count - hip->hi_counters.tc_accumulated_read_op_count),
+		(long long int)(counters.tc_accumulated_write_op_count - hip->hi_counters.tc_accumulated_write_op_count),
+		(long long int)bytes,
+		((double)bytes / interval) / FLOAT_MILLION,
+		(double)ops / interval,
+		mean,
+		p[0], p[1], p[2], p[3],
+		busy,
+		tdp->td_queue_depth);
+	fflush(tdp->td_hb.hb_ts_file_pointer);
+
+	// This sample is the start of the next interval
+	hip->hi_time = now;
+	hip->hi_counters = counters;
+	lhp = hip->hi_lathistp;
+	hip->hi_lathistp = hip->hi_nowp;
+	hip->hi_nowp = lhp;
+} // End of xdd_heartbeat_timeseries_sample()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_heartbeat_timeseries_close() 
+ * Close the time series file of a target if it has one
+ */
+static void
+xdd_heartbeat_timeseries_close(target_data_t *tdp) {
+	struct xint_heartbeat_interval	*hip;
+
+
+	if (tdp->td_hb.hb_ts_lastp == NULL) 
+		return;
+	pthread_mutex_lock(&tdp->td_hb.hb_ts_mutex);
+	hip = tdp->td_hb.hb_ts_lastp;
+	if (hip == NULL) {
+		pthread_mutex_unlock(&tdp->td_hb.hb_ts_mutex);
+		return;
+	}
+	fclose(tdp->td_hb.hb_ts_file_pointer);
+	tdp->td_hb.hb_ts_file_pointer = NULL;
+	free(hip->hi_lathistp);
+	free(hip->hi_nowp);
+	free(hip->hi_deltap);
+	free(hip);
+	tdp->td_hb.hb_ts_lastp = NULL;
+	pthread_mutex_unlock(&tdp->td_hb.hb_ts_mutex);
+} // End of xdd_heartbeat_timeseries_close()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_heartbeat_timeseries_pass_end() 
+ * Write the last interval of a pass to the time series file of a target.
+ * This is called by the Target Thread after a pass while the counters and
+ * latency histograms of its Worker Threads still hold the whole pass so
+ * the interval ends at tc_pass_end_time even if the heartbeat does not
+ * sample the target again before the next pass resets them.
+ */
+void
+xdd_heartbeat_timeseries_pass_end(target_data_t *tdp) {
+
+	if (tdp->td_hb.hb_ts_lastp == NULL) 
+		return;
+	pthread_mutex_lock(&tdp->td_hb.hb_ts_mutex);
+	if (tdp->td_hb.hb_ts_lastp) 
+		xdd_heartbeat_timeseries_sample(tdp->td_planp, tdp);
+	pthread_mutex_unlock(&tdp->td_hb.hb_ts_mutex);
+} // End of xdd_heartbeat_timeseries_pass_end()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_heartbeat_legend() 
  * This will display the 'legend' for the heartbeat line 
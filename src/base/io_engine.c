@@ -0,0 +1,329 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that drive an asynchronous I/O engine
+ * from the Target Thread. The engine-specific code lives in io_engine_*.c.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_engine_init() - Allocate and initialize the asynchronous I/O engine
+ * selected by the -ioengine option for this target.
+ * This is called by xint_target_init() before the Worker Data structs are
+ * initialized. If no asynchronous engine was requested then nothing is done.
+ *
+ * Return values: 0 is good, -1 indicates an error
+ */
+int32_t
+xdd_io_engine_init(target_data_t *tdp) {
+	xint_io_engine_t	*ioep;		// Pointer to the I/O engine for this target
+	worker_data_t		*wdp;		// Pointer to a Worker Data struct
+	int32_t				status;
+
+
+	if (!(tdp->td_target_options & TO_ASYNC_IO_ENGINE))
+		return(0);
+
+	// The asynchronous engines issue everything from the Target Thread so the
+	// features that depend on one Worker Thread per I/O cannot be used with them
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_SGIO | TO_METADATA | TO_ORDERING_STORAGE_SERIAL | TO_ORDERING_STORAGE_LOOSE) ||
+		(tdp->td_lsp)) {
+		fprintf(xgp->errout,"%s: xdd_io_engine_init: Target %d: ERROR: The asynchronous I/O engine cannot be combined with -e2e, -sgio, -metadata, -lockstep, or storage ordering\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+
+	ioep = (xint_io_engine_t *)malloc(sizeof(xint_io_engine_t));
+	if (ioep == NULL) {
+		fprintf(xgp->errout,"%s: xdd_io_engine_init: Target %d: ERROR: Cannot allocate %d bytes of memory for the I/O engine\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(int)sizeof(xint_io_engine_t));
+		return(-1);
+	}
+	memset(ioep, 0, sizeof(xint_io_engine_t));
+	ioep->ioe_queue_depth = tdp->td_queue_depth;
+	ioep->ioe_free_slots = (worker_data_t **)malloc(tdp->td_queue_depth * sizeof(worker_data_t *));
+	if (ioep->ioe_free_slots == NULL) {
+		fprintf(xgp->errout,"%s: xdd_io_engine_init: Target %d: ERROR: Cannot allocate the I/O engine free slot list for a queue depth of %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		free(ioep);
+		return(-1);
+	}
+	// Every Worker Data struct starts out on the free slot stack
+	wdp = tdp->td_next_wdp;
+	while (wdp) {
+		ioep->ioe_free_slots[ioep->ioe_free_count++] = wdp;
+		wdp = wdp->wd_next_wdp;
+	}
+	tdp->td_ioep = ioep;
+
+	// Fill in the engine operations
+	status = -1;
+	if (tdp->td_target_options & TO_IO_URING)
+		status = xdd_io_uring_engine_setup(ioep);
+	else if (tdp->td_target_options & TO_LIBAIO)
+		status = xdd_libaio_engine_setup(ioep);
+	if (status) {
+		xdd_io_engine_cleanup(tdp);
+		return(-1);
+	}
+
+	status = ioep->ioe_init(tdp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_io_engine_init: Target %d: ERROR: Cannot initialize the %s I/O engine\n",
+			xgp->progname,
+			tdp->td_target_number,
+			ioep->ioe_name);
+		xdd_io_engine_cleanup(tdp);
+		return(-1);
+	}
+	return(0);
+
+} // End of xdd_io_engine_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_engine_cleanup() - Release the asynchronous I/O engine for a target
+ */
+void
+xdd_io_engine_cleanup(target_data_t *tdp) {
+	xint_io_engine_t	*ioep;
+
+
+	ioep = tdp->td_ioep;
+	if (ioep == NULL)
+		return;
+	if (ioep->ioe_cleanup)
+		ioep->ioe_cleanup(tdp);
+	if (ioep->ioe_free_slots)
+		free(ioep->ioe_free_slots);
+	free(ioep);
+	tdp->td_ioep = NULL;
+
+} // End of xdd_io_engine_cleanup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_engine_start_op() - Time stamp the task that was set up in the
+ * Worker Data struct and hand it to the I/O engine.
+ * NOOPs and operations on a NULL target never go to the engine; they are
+ * completed right here.
+ *
+ * Return values: 0 is good, -1 indicates the engine could not queue the op
+ */
+int32_t
+xdd_io_engine_start_op(worker_data_t *wdp) {
+	target_data_t		*tdp;		// Pointer to the parent Target Data Structure
+	xint_io_engine_t	*ioep;		// Pointer to the I/O engine for this target
+	xdd_ts_tte_t		*ttep;		// Pointer to a Timestamp Table Entry
+
+
+	tdp = wdp->wd_tdp;
+	ioep = tdp->td_ioep;
+
+	// Record the starting time for this op
+	nclk_now(&wdp->wd_counters.tc_current_op_start_time);
+	wdp->wd_counters.tc_current_op_end_time = 0;
+	// Time stamp if requested
+	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
+		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
+		ttep->tte_disk_processor_start = xdd_get_processor();
+	}
+
+	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE)
+		xdd_datapattern_fill(wdp);
+
+	if ((tdp->td_target_options & TO_NULL_TARGET) || (wdp->wd_task.task_op_type == TASK_OP_TYPE_NOOP)) {
+		// Make it look like a successful I/O
+		ioep->ioe_inflight++;
+		xdd_io_engine_complete(wdp, (int64_t)wdp->wd_task.task_xfer_size);
+		return(0);
+	}
+
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_engine_start_op: Target: %d: Slot: %d: %s: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_op_string,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
+	return(ioep->ioe_prep(wdp));
+
+} // End of xdd_io_engine_start_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_engine_complete() - Called by an I/O engine for every completed
+ * operation. The result is the number of bytes transferred or a negative
+ * errno value. This does the same bookkeeping that xdd_worker_thread_io()
+ * does after xdd_io_for_os() returns and then puts the Worker Data struct
+ * back on the free slot stack.
+ */
+void
+xdd_io_engine_complete(worker_data_t *wdp, int64_t result) {
+	target_data_t		*tdp;		// Pointer to the parent Target Data Structure
+	xint_io_engine_t	*ioep;		// Pointer to the I/O engine for this target
+	xdd_ts_tte_t		*ttep;		// Pointer to a Timestamp Table Entry
+
+
+	tdp = wdp->wd_tdp;
+	ioep = tdp->td_ioep;
+
+	// Record the ending time for this op
+	nclk_now(&wdp->wd_counters.tc_current_op_end_time);
+	if (result < 0) {
+		wdp->wd_task.task_io_status = -1;
+		errno = (int)-result;
+	} else {
+		wdp->wd_task.task_io_status = (ssize_t)result;
+		errno = 0;
+	}
+	wdp->wd_task.task_errno = errno;
+
+	// Time stamp if requested
+	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
+		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		ttep->tte_disk_end = wdp->wd_counters.tc_current_op_end_time;
+		ttep->tte_disk_xfer_size = wdp->wd_task.task_io_status;
+		ttep->tte_disk_processor_end = xdd_get_processor();
+	}
+	ioep->ioe_inflight--;
+
+	// Update counters and status in this slot's Worker Data
+	xdd_worker_thread_update_local_counters(wdp);
+
+	// Verify the data that was just read
+	xdd_verify_after_io_op(wdp);
+
+	// Check I/O operation completion
+	xdd_worker_thread_ttd_after_io_op(wdp);
+
+	// Let the timestamp stream have the entry for this operation
+	xdd_ts_entry_done(wdp);
+
+	// This slot is available for the next operation
+	ioep->ioe_free_slots[ioep->ioe_free_count++] = wdp;
+
+} // End of xdd_io_engine_complete()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_target_pass_async_loop() - This is the equivalent of
+ * xdd_target_pass_loop() for a target that uses an asynchronous I/O engine.
+ * Rather than handing each task to a Worker Thread, the Target Thread sets
+ * up a task in every free slot, submits them all to the engine, and then
+ * reaps completions until there is a free slot again.
+ *
+ * This subroutine is called by xdd_target_pass().
+ */
+void
+xdd_target_pass_async_loop(xdd_plan_t* planp, target_data_t *tdp) {
+	xint_io_engine_t	*ioep;		// Pointer to the I/O engine for this target
+	worker_data_t		*wdp;		// Pointer to the slot being set up
+	int32_t				status;		// Return status from various subroutines
+	int32_t				issue_done;	// Set when no more I/O should be issued this pass
+	int32_t				throttled;	// Set when each op must be submitted as soon as it is set up
+
+
+	ioep = tdp->td_ioep;
+	issue_done = 0;
+	throttled = ((tdp->td_throtp != NULL) && (tdp->td_throtp->throttle > 0.0));
+
+/////////////////////////////// Loop Starts Here ///////////////////////////////
+	while ((!issue_done && tdp->td_current_bytes_remaining) || ioep->ioe_queued || ioep->ioe_inflight) {
+		// Set up a task in every free slot
+		while (!issue_done && tdp->td_current_bytes_remaining && (ioep->ioe_free_count > 0)) {
+			wdp = ioep->ioe_free_slots[ioep->ioe_free_count - 1];
+
+			// Things to do before an I/O is issued
+			status = xdd_target_ttd_before_io_op(tdp, wdp);
+			if (status != XDD_RC_GOOD) {
+				issue_done = 1;
+				break;
+			}
+			ioep->ioe_free_count--;
+
+			// Set up the task in this slot
+			xdd_target_pass_task_setup(wdp);
+
+			// Read-after-write, DirectIO, and throttle processing
+			status = xdd_worker_thread_ttd_before_io_op(wdp);
+			if (status) {
+				fprintf(xgp->errout,"\n%s: xdd_target_pass_async_loop: Target %d: ERROR: Canceling run due to previous error\n",
+					xgp->progname,
+					tdp->td_target_number);
+				xgp->canceled = 1;
+			}
+			if ((xgp->canceled) || (xgp->abort) || (tdp->td_abort)) {
+				ioep->ioe_free_slots[ioep->ioe_free_count++] = wdp;
+				issue_done = 1;
+				break;
+			}
+
+			status = xdd_io_engine_start_op(wdp);
+			if (status) {
+				fprintf(xgp->errout,"%s: xdd_target_pass_async_loop: Target %d: ERROR: The %s I/O engine could not queue operation %lld\n",
+					xgp->progname,
+					tdp->td_target_number,
+					ioep->ioe_name,
+					(long long int)wdp->wd_task.task_op_number);
+				ioep->ioe_free_slots[ioep->ioe_free_count++] = wdp;
+				tdp->td_counters.tc_current_io_status = -1;
+				issue_done = 1;
+				break;
+			}
+			// A throttled target must not hold on to an operation while it sleeps
+			if (throttled && ioep->ioe_queued)
+				ioep->ioe_submit(tdp, 0);
+		}
+
+		// Submit everything that was set up and wait for at least one completion
+		if (ioep->ioe_queued) {
+			status = ioep->ioe_submit(tdp, 1);
+			if (status)
+				tdp->td_counters.tc_current_io_status = -1;
+		}
+		if (ioep->ioe_inflight) {
+			status = ioep->ioe_reap(tdp, 1);
+			if (status < 0) {
+				fprintf(xgp->errout,"%s: xdd_target_pass_async_loop: Target %d: ERROR: Cannot reap completions from the %s I/O engine - %d operations lost\n",
+					xgp->progname,
+					tdp->td_target_number,
+					ioep->ioe_name,
+					ioep->ioe_inflight);
+				tdp->td_counters.tc_current_io_status = -1;
+				xgp->canceled = 1;
+				break;
+			}
+		}
+	} // End of WHILE loop that transfers data for a single pass
+/////////////////////////////// Loop Ends Here /////////////////////////////////
+
+	// Check to see if we've been canceled - if so, we need to leave
+	if (xgp->canceled) {
+		fprintf(xgp->errout,"\n%s: xdd_target_pass_async_loop: Target %d: ERROR: Canceled!\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return;
+	}
+	if (tdp->td_counters.tc_current_io_status != 0)
+		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
+
+	return;
+} // End of xdd_target_pass_async_loop()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
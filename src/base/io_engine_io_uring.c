@@ -0,0 +1,370 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the io_uring asynchronous I/O engine.
+ * The ring is set up and driven with the raw io_uring_setup() and
+ * io_uring_enter() system calls so that no user-space library is required.
+ */
+#include "xint.h"
+
+#if defined(LINUX) && defined(HAVE_LINUX_IO_URING_H)
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup		425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter		426
+#endif
+
+// The state of one io_uring instance
+struct xint_io_uring {
+	int					iou_ring_fd;		// File descriptor returned by io_uring_setup()
+	uint32_t			iou_sq_entries;		// Number of Submission Queue entries
+	uint32_t			*iou_sq_head;		// Submission Queue head - advanced by the kernel
+	uint32_t			*iou_sq_tail;		// Submission Queue tail - advanced by us
+	uint32_t			*iou_sq_mask;		// Submission Queue ring mask
+	uint32_t			*iou_sq_array;		// Submission Queue index array
+	uint32_t			iou_sq_local_tail;	// Tail including entries that are prepared but not yet published
+	struct io_uring_sqe	*iou_sqes;			// Submission Queue Entries
+	uint32_t			*iou_cq_head;		// Completion Queue head - advanced by us
+	uint32_t			*iou_cq_tail;		// Completion Queue tail - advanced by the kernel
+	uint32_t			*iou_cq_mask;		// Completion Queue ring mask
+	struct io_uring_cqe	*iou_cqes;			// Completion Queue Entries
+	void				*iou_sq_ring;		// mmap()ed Submission Queue ring
+	size_t				iou_sq_ring_size;
+	void				*iou_cq_ring;		// mmap()ed Completion Queue ring (may be the same as the SQ ring)
+	size_t				iou_cq_ring_size;
+	size_t				iou_sqes_size;
+	struct iovec		*iou_iov;			// One iovec per slot (indexed by worker number)
+};
+typedef struct xint_io_uring xint_io_uring_t;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_init() - Create the ring and map the submission and completion
+ * queues into our address space.
+ * Return values: 0 is good, -1 indicates an error
+ */
+static int32_t
+xdd_io_uring_init(target_data_t *tdp) {
+	xint_io_uring_t			*ioup;
+	struct io_uring_params	params;
+	unsigned char			*sqp;
+	unsigned char			*cqp;
+
+
+	ioup = (xint_io_uring_t *)malloc(sizeof(xint_io_uring_t));
+	if (ioup == NULL) {
+		fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: Cannot allocate %d bytes of memory for the io_uring\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(int)sizeof(xint_io_uring_t));
+		return(-1);
+	}
+	memset(ioup, 0, sizeof(xint_io_uring_t));
+	ioup->iou_ring_fd = -1;
+	tdp->td_ioep->ioe_private = ioup;
+
+	ioup->iou_iov = (struct iovec *)calloc(tdp->td_queue_depth, sizeof(struct iovec));
+	if (ioup->iou_iov == NULL) {
+		fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: Cannot allocate the io_uring iovecs for a queue depth of %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		return(-1);
+	}
+
+	memset(&params, 0, sizeof(params));
+	ioup->iou_ring_fd = syscall(__NR_io_uring_setup, tdp->td_queue_depth, &params);
+	if (ioup->iou_ring_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: io_uring_setup failed for %d entries\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		perror("Reason");
+		return(-1);
+	}
+	ioup->iou_sq_entries = params.sq_entries;
+
+	// Map the submission and completion rings. Newer kernels put both rings in one mapping.
+	ioup->iou_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	ioup->iou_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ioup->iou_cq_ring_size > ioup->iou_sq_ring_size)
+			ioup->iou_sq_ring_size = ioup->iou_cq_ring_size;
+		ioup->iou_cq_ring_size = ioup->iou_sq_ring_size;
+	}
+#endif
+	ioup->iou_sq_ring = mmap(0, ioup->iou_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ioup->iou_ring_fd, IORING_OFF_SQ_RING);
+	if (ioup->iou_sq_ring == MAP_FAILED) {
+		ioup->iou_sq_ring = NULL;
+		fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: Cannot map the io_uring submission queue\n",
+			xgp->progname,
+			tdp->td_target_number);
+		perror("Reason");
+		return(-1);
+	}
+	if (ioup->iou_cq_ring_size == ioup->iou_sq_ring_size && (params.features & IORING_FEAT_SINGLE_MMAP)) {
+		ioup->iou_cq_ring = ioup->iou_sq_ring;
+	} else {
+		ioup->iou_cq_ring = mmap(0, ioup->iou_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			ioup->iou_ring_fd, IORING_OFF_CQ_RING);
+		if (ioup->iou_cq_ring == MAP_FAILED) {
+			ioup->iou_cq_ring = NULL;
+			fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: Cannot map the io_uring completion queue\n",
+				xgp->progname,
+				tdp->td_target_number);
+			perror("Reason");
+			return(-1);
+		}
+	}
+	ioup->iou_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	ioup->iou_sqes = (struct io_uring_sqe *)mmap(0, ioup->iou_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ioup->iou_ring_fd, IORING_OFF_SQES);
+	if (ioup->iou_sqes == MAP_FAILED) {
+		ioup->iou_sqes = NULL;
+		fprintf(xgp->errout,"%s: xdd_io_uring_init: Target %d: ERROR: Cannot map the io_uring submission queue entries\n",
+			xgp->progname,
+			tdp->td_target_number);
+		perror("Reason");
+		return(-1);
+	}
+
+	sqp = (unsigned char *)ioup->iou_sq_ring;
+	ioup->iou_sq_head = (uint32_t *)(sqp + params.sq_off.head);
+	ioup->iou_sq_tail = (uint32_t *)(sqp + params.sq_off.tail);
+	ioup->iou_sq_mask = (uint32_t *)(sqp + params.sq_off.ring_mask);
+	ioup->iou_sq_array = (uint32_t *)(sqp + params.sq_off.array);
+	ioup->iou_sq_local_tail = *ioup->iou_sq_tail;
+	cqp = (unsigned char *)ioup->iou_cq_ring;
+	ioup->iou_cq_head = (uint32_t *)(cqp + params.cq_off.head);
+	ioup->iou_cq_tail = (uint32_t *)(cqp + params.cq_off.tail);
+	ioup->iou_cq_mask = (uint32_t *)(cqp + params.cq_off.ring_mask);
+	ioup->iou_cqes = (struct io_uring_cqe *)(cqp + params.cq_off.cqes);
+
+	return(0);
+
+} // End of xdd_io_uring_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_prep() - Fill in the next Submission Queue Entry for the task
+ * in this Worker Data struct. The entry is not visible to the kernel until
+ * xdd_io_uring_submit() publishes the new tail.
+ * Return values: 0 is good, -1 indicates the submission queue is full
+ */
+static int32_t
+xdd_io_uring_prep(worker_data_t *wdp) {
+	target_data_t		*tdp;
+	xint_io_engine_t	*ioep;
+	xint_io_uring_t		*ioup;
+	struct io_uring_sqe	*sqep;
+	struct iovec		*iovp;
+	uint32_t			index;
+
+
+	tdp = wdp->wd_tdp;
+	ioep = tdp->td_ioep;
+	ioup = (xint_io_uring_t *)ioep->ioe_private;
+
+	if ((ioup->iou_sq_local_tail - __atomic_load_n(ioup->iou_sq_head, __ATOMIC_ACQUIRE)) >= ioup->iou_sq_entries)
+		return(-1);
+
+	index = ioup->iou_sq_local_tail & *ioup->iou_sq_mask;
+	sqep = &ioup->iou_sqes[index];
+	iovp = &ioup->iou_iov[wdp->wd_worker_number];
+	iovp->iov_base = wdp->wd_task.task_datap;
+	iovp->iov_len = wdp->wd_task.task_xfer_size;
+
+	memset(sqep, 0, sizeof(struct io_uring_sqe));
+	sqep->opcode = (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) ? IORING_OP_WRITEV : IORING_OP_READV;
+	sqep->fd = wdp->wd_task.task_file_desc;
+	sqep->off = (uint64_t)wdp->wd_task.task_byte_offset;
+	sqep->addr = (uint64_t)(uintptr_t)iovp;
+	sqep->len = 1;
+	sqep->user_data = (uint64_t)(uintptr_t)wdp;
+
+	ioup->iou_sq_array[index] = index;
+	ioup->iou_sq_local_tail++;
+	ioep->ioe_queued++;
+
+	return(0);
+
+} // End of xdd_io_uring_prep()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_submit() - Publish all prepared entries and submit them with a
+ * single io_uring_enter() that optionally waits for min_complete completions.
+ * Return values: 0 is good, -1 indicates an error
+ */
+static int32_t
+xdd_io_uring_submit(target_data_t *tdp, int32_t min_complete) {
+	xint_io_engine_t	*ioep;
+	xint_io_uring_t		*ioup;
+	struct io_uring_sqe	*sqep;
+	uint32_t			flags;
+	int					submitted;
+
+
+	ioep = tdp->td_ioep;
+	ioup = (xint_io_uring_t *)ioep->ioe_private;
+
+	__atomic_store_n(ioup->iou_sq_tail, ioup->iou_sq_local_tail, __ATOMIC_RELEASE);
+	flags = (min_complete > 0) ? IORING_ENTER_GETEVENTS : 0;
+	do {
+		submitted = syscall(__NR_io_uring_enter, ioup->iou_ring_fd, ioep->ioe_queued, min_complete, flags, NULL, 0);
+	} while ((submitted < 0) && (errno == EINTR));
+
+	if (submitted < 0) {
+		fprintf(xgp->errout,"%s: xdd_io_uring_submit: Target %d: ERROR: io_uring_enter failed to submit %d operations\n",
+			xgp->progname,
+			tdp->td_target_number,
+			ioep->ioe_queued);
+		perror("Reason");
+		// Take back the entries the kernel did not consume and fail their tasks
+		submitted = errno;
+		while (ioup->iou_sq_local_tail != __atomic_load_n(ioup->iou_sq_head, __ATOMIC_ACQUIRE)) {
+			ioup->iou_sq_local_tail--;
+			sqep = &ioup->iou_sqes[ioup->iou_sq_local_tail & *ioup->iou_sq_mask];
+			ioep->ioe_queued--;
+			ioep->ioe_inflight++;
+			xdd_io_engine_complete((worker_data_t *)(uintptr_t)sqep->user_data, -(int64_t)submitted);
+		}
+		__atomic_store_n(ioup->iou_sq_tail, ioup->iou_sq_local_tail, __ATOMIC_RELEASE);
+		return(-1);
+	}
+	ioep->ioe_queued -= submitted;
+	ioep->ioe_inflight += submitted;
+	return(0);
+
+} // End of xdd_io_uring_submit()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_reap() - Process every entry on the Completion Queue, waiting
+ * in io_uring_enter() when fewer than min_complete entries are there.
+ * Return values: number of completions processed, -1 indicates an error
+ */
+static int32_t
+xdd_io_uring_reap(target_data_t *tdp, int32_t min_complete) {
+	xint_io_engine_t	*ioep;
+	xint_io_uring_t		*ioup;
+	struct io_uring_cqe	*cqep;
+	uint32_t			head;
+	uint32_t			tail;
+	int32_t				reaped;
+	int					status;
+	worker_data_t		*wdp;
+	int64_t				result;
+
+
+	ioep = tdp->td_ioep;
+	ioup = (xint_io_uring_t *)ioep->ioe_private;
+	reaped = 0;
+	while (1) {
+		head = *ioup->iou_cq_head;
+		tail = __atomic_load_n(ioup->iou_cq_tail, __ATOMIC_ACQUIRE);
+		while (head != tail) {
+			cqep = &ioup->iou_cqes[head & *ioup->iou_cq_mask];
+			wdp = (worker_data_t *)(uintptr_t)cqep->user_data;
+			result = cqep->res;
+			head++;
+			// Hand the CQE back to the kernel before the completion is processed
+			__atomic_store_n(ioup->iou_cq_head, head, __ATOMIC_RELEASE);
+			xdd_io_engine_complete(wdp, result);
+			reaped++;
+		}
+		if ((reaped >= min_complete) || (ioep->ioe_inflight == 0))
+			break;
+		status = syscall(__NR_io_uring_enter, ioup->iou_ring_fd, 0, min_complete - reaped, IORING_ENTER_GETEVENTS, NULL, 0);
+		if ((status < 0) && (errno != EINTR)) {
+			fprintf(xgp->errout,"%s: xdd_io_uring_reap: Target %d: ERROR: io_uring_enter failed while waiting for %d completions\n",
+				xgp->progname,
+				tdp->td_target_number,
+				min_complete - reaped);
+			perror("Reason");
+			return(-1);
+		}
+	}
+	return(reaped);
+
+} // End of xdd_io_uring_reap()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_cleanup() - Unmap the rings and close the ring descriptor
+ */
+static void
+xdd_io_uring_cleanup(target_data_t *tdp) {
+	xint_io_uring_t		*ioup;
+
+
+	ioup = (xint_io_uring_t *)tdp->td_ioep->ioe_private;
+	if (ioup == NULL)
+		return;
+	if (ioup->iou_sqes)
+		munmap(ioup->iou_sqes, ioup->iou_sqes_size);
+	if (ioup->iou_cq_ring && (ioup->iou_cq_ring != ioup->iou_sq_ring))
+		munmap(ioup->iou_cq_ring, ioup->iou_cq_ring_size);
+	if (ioup->iou_sq_ring)
+		munmap(ioup->iou_sq_ring, ioup->iou_sq_ring_size);
+	if (ioup->iou_ring_fd >= 0)
+		close(ioup->iou_ring_fd);
+	if (ioup->iou_iov)
+		free(ioup->iou_iov);
+	free(ioup);
+	tdp->td_ioep->ioe_private = NULL;
+
+} // End of xdd_io_uring_cleanup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_engine_setup() - Fill in the io_uring engine operations
+ * Return values: 0 is good, -1 indicates an error
+ */
+int32_t
+xdd_io_uring_engine_setup(xint_io_engine_t *ioep) {
+
+	ioep->ioe_name = "io_uring";
+	ioep->ioe_init = xdd_io_uring_init;
+	ioep->ioe_prep = xdd_io_uring_prep;
+	ioep->ioe_submit = xdd_io_uring_submit;
+	ioep->ioe_reap = xdd_io_uring_reap;
+	ioep->ioe_cleanup = xdd_io_uring_cleanup;
+	return(0);
+
+} // End of xdd_io_uring_engine_setup()
+
+#else
+/*----------------------------------------------------------------------------*/
+/* xdd_io_uring_engine_setup() - io_uring is not available on this platform
+ */
+int32_t
+xdd_io_uring_engine_setup(xint_io_engine_t *ioep) {
+
+	fprintf(xgp->errout,"%s: xdd_io_uring_engine_setup: ERROR: The io_uring I/O engine is not supported on this platform\n",
+		xgp->progname);
+	return(-1);
+
+} // End of xdd_io_uring_engine_setup()
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
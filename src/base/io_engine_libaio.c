@@ -0,0 +1,288 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the Linux native AIO asynchronous I/O engine.
+ * The io_setup(), io_submit(), io_getevents(), and io_destroy() system calls
+ * are used directly so that libaio is not required.
+ * Note that Linux native AIO is only truly asynchronous for O_DIRECT (-dio)
+ * targets; buffered I/O is performed synchronously inside io_submit().
+ */
+#include "xint.h"
+
+#if defined(LINUX) && defined(HAVE_LINUX_AIO_ABI_H)
+#include <linux/aio_abi.h>
+
+// The state of one AIO context
+struct xint_libaio {
+	aio_context_t		aio_ctx;			// Context returned by io_setup()
+	struct iocb			*aio_iocbs;			// One iocb per slot (indexed by worker number)
+	struct iocb			**aio_queued;		// iocbs prepared but not yet submitted
+	struct io_event		*aio_events;		// Completion events returned by io_getevents()
+};
+typedef struct xint_libaio xint_libaio_t;
+static int32_t	xdd_libaio_reap(target_data_t *tdp, int32_t min_complete);
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_init() - Create an AIO context for td_queue_depth operations
+ * Return values: 0 is good, -1 indicates an error
+ */
+static int32_t
+xdd_libaio_init(target_data_t *tdp) {
+	xint_libaio_t	*aiop;
+	int				status;
+
+
+	aiop = (xint_libaio_t *)malloc(sizeof(xint_libaio_t));
+	if (aiop == NULL) {
+		fprintf(xgp->errout,"%s: xdd_libaio_init: Target %d: ERROR: Cannot allocate %d bytes of memory for the AIO context\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(int)sizeof(xint_libaio_t));
+		return(-1);
+	}
+	memset(aiop, 0, sizeof(xint_libaio_t));
+	tdp->td_ioep->ioe_private = aiop;
+
+	aiop->aio_iocbs = (struct iocb *)calloc(tdp->td_queue_depth, sizeof(struct iocb));
+	aiop->aio_queued = (struct iocb **)calloc(tdp->td_queue_depth, sizeof(struct iocb *));
+	aiop->aio_events = (struct io_event *)calloc(tdp->td_queue_depth, sizeof(struct io_event));
+	if ((aiop->aio_iocbs == NULL) || (aiop->aio_queued == NULL) || (aiop->aio_events == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_libaio_init: Target %d: ERROR: Cannot allocate the AIO control blocks for a queue depth of %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		return(-1);
+	}
+
+	status = syscall(__NR_io_setup, tdp->td_queue_depth, &aiop->aio_ctx);
+	if (status < 0) {
+		aiop->aio_ctx = 0;
+		fprintf(xgp->errout,"%s: xdd_libaio_init: Target %d: ERROR: io_setup failed for %d events - check /proc/sys/fs/aio-max-nr\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		perror("Reason");
+		return(-1);
+	}
+	if (!(tdp->td_target_options & TO_DIO) && (xgp->global_options & GO_VERBOSE)) {
+		fprintf(xgp->errout,"%s: xdd_libaio_init: Target %d: WARNING: Without -dio the libaio engine performs each I/O synchronously in io_submit()\n",
+			xgp->progname,
+			tdp->td_target_number);
+	}
+	return(0);
+
+} // End of xdd_libaio_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_prep() - Fill in the iocb for the task in this Worker Data struct
+ * and add it to the list that xdd_libaio_submit() will hand to the kernel.
+ * Return values: 0 is good
+ */
+static int32_t
+xdd_libaio_prep(worker_data_t *wdp) {
+	xint_io_engine_t	*ioep;
+	xint_libaio_t		*aiop;
+	struct iocb			*iocbp;
+
+
+	ioep = wdp->wd_tdp->td_ioep;
+	aiop = (xint_libaio_t *)ioep->ioe_private;
+
+	iocbp = &aiop->aio_iocbs[wdp->wd_worker_number];
+	memset(iocbp, 0, sizeof(struct iocb));
+	iocbp->aio_data = (uint64_t)(uintptr_t)wdp;
+	iocbp->aio_lio_opcode = (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) ? IOCB_CMD_PWRITE : IOCB_CMD_PREAD;
+	iocbp->aio_fildes = wdp->wd_task.task_file_desc;
+	iocbp->aio_buf = (uint64_t)(uintptr_t)wdp->wd_task.task_datap;
+	iocbp->aio_nbytes = wdp->wd_task.task_xfer_size;
+	iocbp->aio_offset = (int64_t)wdp->wd_task.task_byte_offset;
+
+	aiop->aio_queued[ioep->ioe_queued++] = iocbp;
+	return(0);
+
+} // End of xdd_libaio_prep()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_submit() - Submit all queued iocbs with as few io_submit() calls
+ * as possible. Native AIO cannot wait for completions while submitting so
+ * min_complete is left to xdd_libaio_reap(). When the kernel is out of AIO
+ * resources (EAGAIN) this reaps a completion of its own, or waits a little
+ * if it has none in flight, before it tries again.
+ * Return values: 0 is good, -1 indicates an error
+ */
+static int32_t
+xdd_libaio_submit(target_data_t *tdp, int32_t min_complete) {
+	xint_io_engine_t	*ioep;
+	xint_libaio_t		*aiop;
+	int32_t				done;		// Number of iocbs accepted by the kernel so far
+	int32_t				counted;	// Number of those already added to ioe_inflight
+	int					submitted;
+	int					errno_save;
+	struct timespec		req;
+
+
+	ioep = tdp->td_ioep;
+	aiop = (xint_libaio_t *)ioep->ioe_private;
+	done = 0;
+	counted = 0;
+	while (done < ioep->ioe_queued) {
+		submitted = syscall(__NR_io_submit, aiop->aio_ctx, (long)(ioep->ioe_queued - done), &aiop->aio_queued[done]);
+		if (submitted > 0) {
+			done += submitted;
+			continue;
+		}
+		if ((submitted < 0) && (errno == EINTR))
+			continue;
+		if ((submitted < 0) && (errno == EAGAIN)) {
+			ioep->ioe_inflight += done - counted;
+			counted = done;
+			if (ioep->ioe_inflight > 0) {
+				if (xdd_libaio_reap(tdp, 1) >= 0)
+					continue;
+				errno = EAGAIN;
+			} else {
+				// Other processes hold all of the system-wide AIO events
+				req.tv_sec = 0;
+				req.tv_nsec = 1000000;
+				nanosleep(&req, NULL);
+				continue;
+			}
+		}
+		errno_save = (submitted < 0) ? errno : EIO;
+		fprintf(xgp->errout,"%s: xdd_libaio_submit: Target %d: ERROR: io_submit failed with %d of %d operations submitted\n",
+			xgp->progname,
+			tdp->td_target_number,
+			done,
+			ioep->ioe_queued);
+		errno = errno_save;
+		perror("Reason");
+		// Fail the tasks that the kernel did not accept
+		ioep->ioe_inflight += done - counted;
+		while (done < ioep->ioe_queued) {
+			ioep->ioe_inflight++;
+			xdd_io_engine_complete((worker_data_t *)(uintptr_t)aiop->aio_queued[done]->aio_data, -(int64_t)errno_save);
+			done++;
+		}
+		ioep->ioe_queued = 0;
+		return(-1);
+	}
+	ioep->ioe_inflight += done - counted;
+	ioep->ioe_queued = 0;
+	return(0);
+
+} // End of xdd_libaio_submit()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_reap() - Collect up to td_queue_depth completion events with a
+ * single io_getevents() call that blocks until at least min_complete are in.
+ * Return values: number of completions processed, -1 indicates an error
+ */
+static int32_t
+xdd_libaio_reap(target_data_t *tdp, int32_t min_complete) {
+	xint_io_engine_t	*ioep;
+	xint_libaio_t		*aiop;
+	int32_t				reaped;
+	int					events;
+	int					i;
+
+
+	ioep = tdp->td_ioep;
+	aiop = (xint_libaio_t *)ioep->ioe_private;
+	if (min_complete > ioep->ioe_inflight)
+		min_complete = ioep->ioe_inflight;
+	reaped = 0;
+	do {
+		events = syscall(__NR_io_getevents, aiop->aio_ctx, (long)(min_complete - reaped), (long)ioep->ioe_inflight, aiop->aio_events, NULL);
+		if (events < 0) {
+			if (errno == EINTR)
+				continue;
+			fprintf(xgp->errout,"%s: xdd_libaio_reap: Target %d: ERROR: io_getevents failed while waiting for %d completions\n",
+				xgp->progname,
+				tdp->td_target_number,
+				min_complete - reaped);
+			perror("Reason");
+			return(-1);
+		}
+		for (i = 0; i < events; i++)
+			xdd_io_engine_complete((worker_data_t *)(uintptr_t)aiop->aio_events[i].data, (int64_t)aiop->aio_events[i].res);
+		reaped += events;
+	} while (reaped < min_complete);
+	return(reaped);
+
+} // End of xdd_libaio_reap()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_cleanup() - Destroy the AIO context
+ */
+static void
+xdd_libaio_cleanup(target_data_t *tdp) {
+	xint_libaio_t	*aiop;
+
+
+	aiop = (xint_libaio_t *)tdp->td_ioep->ioe_private;
+	if (aiop == NULL)
+		return;
+	if (aiop->aio_ctx)
+		syscall(__NR_io_destroy, aiop->aio_ctx);
+	if (aiop->aio_iocbs)
+		free(aiop->aio_iocbs);
+	if (aiop->aio_queued)
+		free(aiop->aio_queued);
+	if (aiop->aio_events)
+		free(aiop->aio_events);
+	free(aiop);
+	tdp->td_ioep->ioe_private = NULL;
+
+} // End of xdd_libaio_cleanup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_engine_setup() - Fill in the libaio engine operations
+ * Return values: 0 is good, -1 indicates an error
+ */
+int32_t
+xdd_libaio_engine_setup(xint_io_engine_t *ioep) {
+
+	ioep->ioe_name = "libaio";
+	ioep->ioe_init = xdd_libaio_init;
+	ioep->ioe_prep = xdd_libaio_prep;
+	ioep->ioe_submit = xdd_libaio_submit;
+	ioep->ioe_reap = xdd_libaio_reap;
+	ioep->ioe_cleanup = xdd_libaio_cleanup;
+	return(0);
+
+} // End of xdd_libaio_engine_setup()
+
+#else
+/*----------------------------------------------------------------------------*/
+/* xdd_libaio_engine_setup() - Linux native AIO is not available on this platform
+ */
+int32_t
+xdd_libaio_engine_setup(xint_io_engine_t *ioep) {
+
+	fprintf(xgp->errout,"%s: xdd_libaio_engine_setup: ERROR: The libaio I/O engine is not supported on this platform\n",
+		xgp->progname);
+	return(-1);
+
+} // End of xdd_libaio_engine_setup()
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -133,9 +133,7 @@ if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_befor
 			status = xdd_target_ttd_before_io_op(tdp, wdp);
 			if (status != XDD_RC_GOOD) {
 				// Mark this worker_thread NOT BUSY and break out of this loop
-				pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-				wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this WORKER_Thread NOT Busy
-				pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+				xdd_worker_thread_make_available(wdp);
 				break;
 			}
 
@@ -143,10 +141,10 @@ if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_befor
 			// Set up the task for the WORKER_Thread
 			xdd_target_pass_task_setup(wdp);
 	
-			// Release the WORKER_Thread to let it start working on this task.
+			// Post the task to the WORKER_Thread to let it start working on it.
 			// This effectively causes the I/O operation to be issued.
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::wdp:%p:RELEASING_WORKER_THREAD bytes_remaining=%lld\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,wdp,(long long int)tdp->td_current_bytes_remaining);
-			xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+			xdd_task_ring_post(wdp, &wdp->wd_task);
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::wdp:%p:WORKER_THREAD_RELEASED bytes_remaining=%lld\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,wdp,(long long int)tdp->td_current_bytes_remaining);
 			ops_remaining--;
 		}
@@ -159,9 +157,7 @@ if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_befor
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::::Requesting WORKER_Thread %d\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,q);
 			wdp = xdd_get_specific_worker_thread(tdp,q);
 if (xgp->global_options & GO_DEBUG_LOCKSTEP) fprintf(stdout,"%lld:lockstep_before_io_op:p:%p:::wdp:%p:Got  WORKER_Thread %d\n",(long long int)pclk_now()-xgp->debug_base_time,tdp,wdp,q);
-			pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this WORKER_Thread NOT Busy
-			pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+			xdd_worker_thread_make_available(wdp); // Mark this WORKER_Thread NOT Busy
 		}
 		if (ops_remaining <= 0) 
 			lsp->ls_state |= LS_STATE_PASS_COMPLETE;
@@ -0,0 +1,372 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the metadata workload (-metadata).
+ * The target is a directory. Each pass runs a series of phases - create,
+ * stat, open, readdir, rename and unlink - over a set of files spread
+ * across a set of directories below it. The Target Thread hands out one
+ * file (or directory) per op to the Worker Threads as it does for normal
+ * I/O and waits for all of them at the end of each phase. The ops move no
+ * data so the standard results show the op rate, and the latency histograms
+ * keep a separate op type for each phase.
+ */
+#include "xint.h"
+#include <dirent.h>
+
+// The names of the phases for -metadata phases and the results
+static char *xdd_metadata_phase_names[XINT_MD_PHASES] = { "create", "stat", "open", "readdir", "rename", "unlink" };
+// The names of the ops for the error messages of the Worker Threads
+static char *xdd_metadata_op_strings[XINT_MD_PHASES] = { "CREATE", "STAT", "OPEN", "READDIR", "RENAME", "UNLINK" };
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_parse_phases() - set the phases of a pass from a comma
+ * separated list of phase names or "all"
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_metadata_parse_phases(xint_metadata_t *mdp, char *list) {
+	char	names[256];
+	char	*cp;
+	char	*save;
+	int32_t	phase;
+	int32_t	i;
+
+
+	if (strcmp(list, "all") == 0) {
+		for (phase = 0; phase < XINT_MD_PHASES; phase++)
+			mdp->md_phases[phase] = phase;
+		mdp->md_phase_count = XINT_MD_PHASES;
+		return(0);
+	}
+	if (strlen(list) >= sizeof(names))
+		return(-1);
+	strcpy(names, list);
+	mdp->md_phase_count = 0;
+	for (cp = strtok_r(names, ",", &save); cp; cp = strtok_r(NULL, ",", &save)) {
+		for (phase = 0; phase < XINT_MD_PHASES; phase++)
+			if (strcmp(cp, xdd_metadata_phase_names[phase]) == 0)
+				break;
+		if (phase == XINT_MD_PHASES)
+			return(-1);
+		for (i = 0; i < mdp->md_phase_count; i++)
+			if (mdp->md_phases[i] == phase)
+				return(-1);
+		mdp->md_phases[mdp->md_phase_count++] = phase;
+	}
+	return((mdp->md_phase_count > 0) ? 0 : -1);
+
+} // End of xdd_metadata_parse_phases()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_ops_per_pass() - work out the number of files and
+ * directories of the target and where each phase starts.
+ * This is called by xdd_calculate_xfer_info() once the queue depth is known.
+ * Returns the number of ops in a pass.
+ */
+int64_t
+xdd_metadata_ops_per_pass(target_data_t *tdp) {
+	xint_metadata_t	*mdp;
+	int64_t			ops;
+	int32_t			renamed;
+	int32_t			i;
+
+
+	mdp = tdp->td_mdp;
+	mdp->md_files = mdp->md_files_per_worker * tdp->td_queue_depth;
+	mdp->md_dirs = mdp->md_dirs_per_worker * tdp->td_queue_depth;
+	ops = 0;
+	renamed = 0;
+	for (i = 0; i < mdp->md_phase_count; i++) {
+		mdp->md_first_op[i] = ops;
+		mdp->md_renamed[i] = renamed;
+		if (mdp->md_phases[i] == XINT_MD_PHASE_READDIR)
+			ops += mdp->md_dirs;
+		else ops += mdp->md_files;
+		if (mdp->md_phases[i] == XINT_MD_PHASE_RENAME)
+			renamed = 1;
+	}
+	return(ops);
+
+} // End of xdd_metadata_ops_per_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_open() - Open the target directory of a metadata workload
+ * in place of the usual open and create the directories that the files go
+ * in. This is called by xdd_target_open().
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_metadata_open(target_data_t *tdp) {
+	xint_metadata_t	*mdp;
+	char			name[64];
+	int64_t			d;
+
+
+	mdp = tdp->td_mdp;
+	// The E2E and asynchronous I/O engine loops would run in place of the metadata loop
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_ASYNC_IO_ENGINE)) {
+		fprintf(xgp->errout,"%s: xdd_metadata_open: Target %d: ERROR: -metadata cannot be used with -e2e or an asynchronous I/O engine\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	if ((mkdir(tdp->td_target_full_pathname, 0777) < 0) && (errno != EEXIST)) {
+		fprintf(xgp->errout,"%s: xdd_metadata_open: Target %d: ERROR: Cannot create directory %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			strerror(errno));
+		return(-1);
+	}
+	tdp->td_file_desc = open(tdp->td_target_full_pathname, O_RDONLY|O_DIRECTORY);
+	if (tdp->td_file_desc < 0) {
+		fprintf(xgp->errout,"%s: xdd_metadata_open: Target %d: ERROR: Cannot open directory %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			strerror(errno));
+		return(-1);
+	}
+	for (d = 0; d < mdp->md_dirs; d++) {
+		sprintf(name, "d%lld", (long long int)d);
+		if ((mkdirat(tdp->td_file_desc, name, 0777) < 0) && (errno != EEXIST)) {
+			fprintf(xgp->errout,"%s: xdd_metadata_open: Target %d: ERROR: Cannot create directory %s/%s: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				tdp->td_target_full_pathname,
+				name,
+				strerror(errno));
+			return(-1);
+		}
+	}
+	tdp->td_target_options |= TO_REGULARFILE;
+	return(0);
+
+} // End of xdd_metadata_open()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_task_setup() - set up the task of a metadata op
+ */
+static void
+xdd_metadata_task_setup(worker_data_t *wdp, int32_t phase) {
+	target_data_t	*tdp;
+	xdd_ts_tte_t	*ttep;
+
+
+	tdp = wdp->wd_tdp;
+	wdp->wd_task.task_request = TASK_REQ_IO;
+	wdp->wd_task.task_file_desc = tdp->td_file_desc;
+	wdp->wd_task.task_op_type = TASK_OP_TYPE_MD_CREATE + phase;
+	wdp->wd_task.task_op_string = xdd_metadata_op_strings[phase];
+	wdp->wd_task.task_xfer_size = 0; // No data is moved
+	wdp->wd_task.task_byte_offset = 0;
+	wdp->wd_task.task_op_number = tdp->td_counters.tc_current_op_number;
+
+   	// If time stamping is on then assign a time stamp entry to this Worker Thread
+   	ttep = xdd_ts_assign_entry(tdp, wdp);
+   	if (ttep) {
+		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
+		ttep->tte_worker_thread_number = wdp->wd_worker_number;
+		ttep->tte_thread_id = wdp->wd_thread_id;
+		ttep->tte_op_type = wdp->wd_task.task_op_type;
+		ttep->tte_op_number = wdp->wd_task.task_op_number;
+		ttep->tte_byte_offset = wdp->wd_task.task_byte_offset;
+	}
+	tdp->td_counters.tc_current_op_number++;
+
+} // End of xdd_metadata_task_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_pass_loop() - run the phases of one pass of a metadata
+ * workload. This takes the place of xdd_target_pass_loop().
+ * All the ops of a phase are handed out to whichever Worker Thread is
+ * available. Before the next phase starts the Target Thread waits for all
+ * the Worker Threads so that, for example, no file is stat'ed before it
+ * has been created.
+ */
+void
+xdd_metadata_pass_loop(xdd_plan_t *planp, target_data_t *tdp) {
+	xint_metadata_t	*mdp;
+	worker_data_t	*wdp;
+	nclk_t			start_time;
+	nclk_t			end_time;
+	int64_t			ops;
+	int64_t			op;
+	int32_t			phase;
+	int32_t			status;
+	int				i;
+	int				q;
+
+
+	mdp = tdp->td_mdp;
+	status = XDD_RC_GOOD;
+	for (i = 0; (i < mdp->md_phase_count) && (status == XDD_RC_GOOD); i++) {
+		phase = mdp->md_phases[i];
+		ops = (phase == XINT_MD_PHASE_READDIR) ? mdp->md_dirs : mdp->md_files;
+		nclk_now(&start_time);
+		for (op = 0; op < ops; op++) {
+			// Get pointer to next Worker Thread to issue a task to
+			wdp = xdd_get_any_available_worker_thread(tdp);
+
+			// Things to do before an op is issued
+			status = xdd_target_ttd_before_io_op(tdp, wdp);
+			if (status != XDD_RC_GOOD) {
+				xdd_worker_thread_make_available(wdp);
+				break;
+			}
+			xdd_metadata_task_setup(wdp, phase);
+			xdd_task_ring_post(wdp, &wdp->wd_task);
+		}
+
+		// The phase is over when every Worker Thread is done with its last op
+		for (q = 0; q < tdp->td_queue_depth; q++) {
+			wdp = xdd_get_specific_worker_thread(tdp,q);
+			xdd_worker_thread_make_available(wdp);
+		}
+		nclk_now(&end_time);
+		mdp->md_phase_ops[phase] += op;
+		mdp->md_phase_time[phase] += end_time - start_time;
+	}
+	tdp->td_current_bytes_remaining = 0;
+
+	// Check to see if we've been canceled - if so, we need to leave
+	if (xgp->canceled) {
+		fprintf(xgp->errout,"\n%s: xdd_metadata_pass_loop: Target %d: ERROR: Canceled!\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return;
+	}
+	if (tdp->td_counters.tc_current_io_status != 0)
+		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
+
+} // End of xdd_metadata_pass_loop()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_io() - perform the metadata op of the current task.
+ * This is called by xdd_io_for_os() in place of the read or write.
+ * Return values: 0 is good (no data is moved), -1 is bad and errno is set
+ */
+ssize_t
+xdd_metadata_io(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_metadata_t	*mdp;
+	DIR				*dirp;
+	struct stat		statbuf;
+	char			path[64];
+	char			new_path[64];
+	int64_t			index;
+	int32_t			phase;
+	int				i;
+	int				fd;
+
+
+	tdp = wdp->wd_tdp;
+	mdp = tdp->td_mdp;
+	phase = wdp->wd_task.task_op_type - TASK_OP_TYPE_MD_CREATE;
+
+	// Find the entry of md_phases[] that this op belongs to and the file or directory it works on
+	for (i = mdp->md_phase_count - 1; i > 0; i--)
+		if ((int64_t)wdp->wd_task.task_op_number >= mdp->md_first_op[i])
+			break;
+	index = (int64_t)wdp->wd_task.task_op_number - mdp->md_first_op[i];
+	if (phase == XINT_MD_PHASE_READDIR)
+		sprintf(path, "d%lld", (long long int)index);
+	else sprintf(path, "d%lld/%c%lld", (long long int)(index % mdp->md_dirs), (mdp->md_renamed[i]) ? 'r' : 'f', (long long int)index);
+
+	switch (phase) {
+		case XINT_MD_PHASE_CREATE:
+			fd = openat(wdp->wd_task.task_file_desc, path, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+			if (fd < 0)
+				return(-1);
+			return(close(fd));
+		case XINT_MD_PHASE_STAT:
+			return(fstatat(wdp->wd_task.task_file_desc, path, &statbuf, 0));
+		case XINT_MD_PHASE_OPEN:
+			fd = openat(wdp->wd_task.task_file_desc, path, O_RDONLY);
+			if (fd < 0)
+				return(-1);
+			return(close(fd));
+		case XINT_MD_PHASE_READDIR:
+			fd = openat(wdp->wd_task.task_file_desc, path, O_RDONLY|O_DIRECTORY);
+			if ((fd < 0) || ((dirp = fdopendir(fd)) == NULL)) {
+				if (fd >= 0)
+					close(fd);
+				return(-1);
+			}
+			errno = 0;
+			while (readdir(dirp) != NULL)
+				;
+			if (errno) {
+				closedir(dirp);
+				return(-1);
+			}
+			return(closedir(dirp));
+		case XINT_MD_PHASE_RENAME:
+			sprintf(new_path, "d%lld/r%lld", (long long int)(index % mdp->md_dirs), (long long int)index);
+			return(renameat(wdp->wd_task.task_file_desc, path, wdp->wd_task.task_file_desc, new_path));
+		case XINT_MD_PHASE_UNLINK:
+			return(unlinkat(wdp->wd_task.task_file_desc, path, 0));
+	}
+	errno = EINVAL;
+	return(-1);
+
+} // End of xdd_metadata_io()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metadata_display() - display the op count, op rate and latency
+ * percentiles of each phase of a metadata workload for the whole run.
+ * The latencies come from the histograms that the Worker Threads keep
+ * for each phase.
+ */
+void
+xdd_metadata_display(target_data_t *tdp, FILE *fp) {
+	xint_metadata_t	*mdp;
+	double			seconds;
+	double			p50, p90, p99;
+	int32_t			phase;
+	int				i;
+
+
+	mdp = tdp->td_mdp;
+	for (i = 0; i < mdp->md_phase_count; i++) {
+		phase = mdp->md_phases[i];
+		seconds = (double)mdp->md_phase_time[phase] / FLOAT_BILLION;
+		p50 = p90 = p99 = -1.0;
+		if (tdp->td_lathist_runp) {
+			p50 = (double)xdd_latency_histogram_value_at(tdp->td_lathist_runp, XDD_LATHIST_MD_CREATE + phase, 50.0);
+			p90 = (double)xdd_latency_histogram_value_at(tdp->td_lathist_runp, XDD_LATHIST_MD_CREATE + phase, 90.0);
+			p99 = (double)xdd_latency_histogram_value_at(tdp->td_lathist_runp, XDD_LATHIST_MD_CREATE + phase, 99.0);
+		}
+		fprintf(fp,"METADATA       %6d %-8s %12lld ops %10.3f sec %12.1f ops/sec  latency usec p50 %10.1f p90 %10.1f p99 %10.1f\n",
+			tdp->td_target_number,
+			xdd_metadata_phase_names[phase],
+			(long long int)mdp->md_phase_ops[phase],
+			seconds,
+			(seconds > 0.0) ? (double)mdp->md_phase_ops[phase] / seconds : 0.0,
+			(p50 < 0.0) ? 0.0 : p50 / 1000.0,
+			(p90 < 0.0) ? 0.0 : p90 / 1000.0,
+			(p99 < 0.0) ? 0.0 : p99 / 1000.0);
+	}
+
+} // End of xdd_metadata_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
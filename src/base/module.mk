@@ -5,9 +5,15 @@ DIR := src/base
 
 BASE_SRC := $(DIR)/heartbeat.c \
 	$(DIR)/io_buffers.c \
+	$(DIR)/io_engine.c \
+	$(DIR)/io_engine_io_uring.c \
+	$(DIR)/io_engine_libaio.c \
 	$(DIR)/lockstep.c \
+	$(DIR)/metadata.c \
 	$(DIR)/restart.c \
+	$(DIR)/restart_journal.c \
 	$(DIR)/schedule.c \
+	$(DIR)/stripe.c \
 	$(DIR)/target_cleanup.c \
 	$(DIR)/target_init.c \
 	$(DIR)/target_offset_table.c \
@@ -19,6 +25,7 @@ BASE_SRC := $(DIR)/heartbeat.c \
 	$(DIR)/target_ttd_after_pass.c \
 	$(DIR)/target_ttd_before_io_op.c \
 	$(DIR)/target_ttd_before_pass.c \
+	$(DIR)/task_ring.c \
 	$(DIR)/verify.c \
 	$(DIR)/worker_thread.c \
 	$(DIR)/worker_thread_cleanup.c \
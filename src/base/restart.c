@@ -306,8 +306,10 @@ xdd_restart_monitor(void *data) {
 				} // End of FOR loop that scans the TOT for the restart offset to use
 	            */
 				// ...and write it to the restart file and sync sync sync
-				if (current_tdp->td_target_options & TO_E2E_DESTINATION) // Restart files are only written on the destination side
+				if (current_tdp->td_target_options & TO_E2E_DESTINATION) { // Restart files are only written on the destination side
 					xdd_restart_write_restart_file(rp);
+					xdd_restart_journal_checkpoint(current_tdp);
+				}
 
 			}
 			// UNLOCK the restart struct
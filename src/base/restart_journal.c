@@ -0,0 +1,510 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that manage the restart journal of
+ * an xddcp operation. The restart file only holds the lowest offset that
+ * was in flight. The journal holds every range of the destination file
+ * that is known to be on stable storage so that a resumed copy only sends
+ * the holes.
+ * The destination side appends the extents its Worker Threads wrote to the
+ * journal at each restart monitor checkpoint. The source side reads the
+ * same journal (or a copy of it) at startup and leaves every request that
+ * the journal covers out of its seek list.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+// Order extents by their starting offset for qsort()
+static int
+xdd_restart_extent_compare(const void *a, const void *b) {
+	const xint_restart_extent_t *ea = a;
+	const xint_restart_extent_t *eb = b;
+
+	if (ea->offset < eb->offset)
+		return(-1);
+	return(ea->offset > eb->offset);
+} // End of xdd_restart_extent_compare()
+
+/*----------------------------------------------------------------------------*/
+// Sort the extents and merge the ones that overlap or touch.
+// Returns the number of extents that remain at the front of the array.
+static int64_t
+xdd_restart_extent_merge(xint_restart_extent_t *ep, int64_t count) {
+	int64_t	i;
+	int64_t	merged;
+
+
+	if (count <= 1)
+		return(count);
+	qsort(ep, count, sizeof(*ep), xdd_restart_extent_compare);
+	merged = 0;
+	for (i = 1; i < count; i++) {
+		if (ep[i].offset <= ep[merged].offset + ep[merged].length) {
+			if (ep[i].offset + ep[i].length > ep[merged].offset + ep[merged].length)
+				ep[merged].length = ep[i].offset + ep[i].length - ep[merged].offset;
+		} else {
+			ep[++merged] = ep[i];
+		}
+	}
+	return(merged + 1);
+} // End of xdd_restart_extent_merge()
+
+/*----------------------------------------------------------------------------*/
+// Write all of the buffer to the journal, riding out short writes
+static int
+xdd_restart_journal_write(int fd, const void *buf, size_t len) {
+	const char	*p = buf;
+	ssize_t		status;
+
+
+	while (len > 0) {
+		status = write(fd, p, len);
+		if (status < 0) {
+			if (errno == EINTR)
+				continue;
+			return(-1);
+		}
+		p += status;
+		len -= status;
+	}
+	return(0);
+} // End of xdd_restart_journal_write()
+
+/*----------------------------------------------------------------------------*/
+// Rewrite the journal with only the merged extents. The new journal is
+// written next to the old one and renamed over it so that a crash leaves
+// one of the two intact. The directory is synced so that the rename itself
+// survives a crash. The journal is left open for append.
+static int
+xdd_restart_journal_compact(target_data_t *tdp) {
+	xint_restart_t	*rp;
+	char			*tmpname;
+	char			*dirname_copy;
+	int				fd;
+	int				dir_fd;
+
+
+	rp = tdp->td_restartp;
+	tmpname = malloc(strlen(rp->journal_filename) + 5);
+	if (tmpname == NULL) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_compact: Target %d: ERROR: Cannot allocate memory for the name of the new journal\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	sprintf(tmpname, "%s.tmp", rp->journal_filename);
+
+	fd = open(tmpname, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+	if (fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_compact: Target %d: ERROR: Cannot create restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tmpname);
+		perror("Reason");
+		free(tmpname);
+		return(-1);
+	}
+	if ((xdd_restart_journal_write(fd, RESTART_JOURNAL_MAGIC, RESTART_JOURNAL_MAGIC_LENGTH) < 0) ||
+		(xdd_restart_journal_write(fd, rp->journal_extents, rp->journal_extent_count * sizeof(xint_restart_extent_t)) < 0) ||
+		(fdatasync(fd) < 0) ||
+		(rename(tmpname, rp->journal_filename) < 0)) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_compact: Target %d: ERROR: Cannot write restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tmpname);
+		perror("Reason");
+		close(fd);
+		unlink(tmpname);
+		free(tmpname);
+		return(-1);
+	}
+	close(fd);
+
+	// Make the rename durable
+	strcpy(tmpname, rp->journal_filename);
+	dirname_copy = dirname(tmpname);
+	dir_fd = open(dirname_copy, O_RDONLY|O_DIRECTORY);
+	if ((dir_fd < 0) || (fsync(dir_fd) < 0)) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_compact: Target %d: ERROR: Cannot sync the directory %s of restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			dirname_copy,
+			rp->journal_filename);
+		perror("Reason");
+		if (dir_fd >= 0)
+			close(dir_fd);
+		free(tmpname);
+		return(-1);
+	}
+	close(dir_fd);
+	free(tmpname);
+
+	// Appends go to the new journal from here on
+	if (rp->journal_fd >= 0)
+		close(rp->journal_fd);
+	rp->journal_fd = open(rp->journal_filename, O_WRONLY|O_APPEND);
+	if (rp->journal_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_compact: Target %d: ERROR: Cannot reopen restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename);
+		perror("Reason");
+		return(-1);
+	}
+	rp->journal_records = rp->journal_extent_count;
+	return(0);
+} // End of xdd_restart_journal_compact()
+
+/*----------------------------------------------------------------------------*/
+// Read the extents of an existing journal into rp->journal_extents.
+// A journal that does not exist yet holds no extents. A partial record at
+// the end of the journal is what a crash in the middle of an append leaves
+// behind and is ignored.
+static int
+xdd_restart_journal_load(target_data_t *tdp) {
+	xint_restart_t	*rp;
+	char			magic[RESTART_JOURNAL_MAGIC_LENGTH];
+	struct stat		statbuf;
+	int64_t			count;
+	size_t			bytes;
+	int				fd;
+
+
+	rp = tdp->td_restartp;
+	fd = open(rp->journal_filename, O_RDONLY);
+	if (fd < 0) {
+		if (errno == ENOENT)
+			return(0);
+		fprintf(xgp->errout,"%s: xdd_restart_journal_load: Target %d: ERROR: Cannot open restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename);
+		perror("Reason");
+		return(-1);
+	}
+	if ((fstat(fd, &statbuf) < 0) ||
+		(read(fd, magic, sizeof(magic)) != sizeof(magic)) ||
+		(memcmp(magic, RESTART_JOURNAL_MAGIC, sizeof(magic)) != 0)) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_load: Target %d: ERROR: %s is not a restart journal\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename);
+		close(fd);
+		return(-1);
+	}
+
+	count = (statbuf.st_size - sizeof(magic)) / sizeof(xint_restart_extent_t);
+	rp->journal_extents = malloc((count + 1) * sizeof(xint_restart_extent_t));
+	if (rp->journal_extents == NULL) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_load: Target %d: ERROR: Cannot allocate memory for %lld restart journal records\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)count);
+		close(fd);
+		return(-1);
+	}
+	bytes = count * sizeof(xint_restart_extent_t);
+	if (read(fd, rp->journal_extents, bytes) != (ssize_t)bytes) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_load: Target %d: ERROR: Cannot read restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename);
+		perror("Reason");
+		close(fd);
+		return(-1);
+	}
+	close(fd);
+	rp->journal_records = count;
+	rp->journal_extent_count = xdd_restart_extent_merge(rp->journal_extents, count);
+	return(0);
+} // End of xdd_restart_journal_load()
+
+/*----------------------------------------------------------------------------*/
+// Returns 1 if the journal lists the whole range as complete and 0 if any
+// part of it still has to be sent
+static int
+xdd_restart_journal_covers(xint_restart_t *rp, int64_t offset, int64_t length) {
+	int64_t	low;
+	int64_t	high;
+	int64_t	mid;
+
+
+	// Find the last extent that starts at or before the offset
+	low = 0;
+	high = rp->journal_extent_count - 1;
+	while (low <= high) {
+		mid = low + (high - low) / 2;
+		if (rp->journal_extents[mid].offset <= offset)
+			low = mid + 1;
+		else high = mid - 1;
+	}
+	if (high < 0)
+		return(0);
+	return(offset + length <= rp->journal_extents[high].offset + rp->journal_extents[high].length);
+} // End of xdd_restart_journal_covers()
+
+/*----------------------------------------------------------------------------*/
+// Remove the requests that the journal covers from the seek list of the
+// source side. The remaining requests keep their order and get dense
+// operation numbers, which the destination uses to order its writes.
+// The request sizes follow from the position in the list the same way the
+// pass loop computes them, so only the last request can be short.
+static int
+xdd_restart_journal_trim_seek_list(target_data_t *tdp) {
+	xint_restart_t	*rp;
+	seekhdr_t		*sp;
+	int64_t			op;
+	int64_t			kept;
+	int64_t			offset;
+	int64_t			length;
+	int64_t			skipped;
+
+
+	rp = tdp->td_restartp;
+	sp = &tdp->td_seekhdr;
+	if ((rp->journal_extent_count == 0) || (sp->seek_options & SO_SEEK_NONE))
+		return(0);
+
+	// A lazy seek list has to be built to be able to leave entries out of it
+	if (sp->seeks == NULL) {
+		sp->seeks = calloc((size_t)sp->seek_total_ops, sizeof(seek_t));
+		if (sp->seeks == NULL) {
+			fprintf(xgp->errout,"%s: xdd_restart_journal_trim_seek_list: Target %d: ERROR: Cannot allocate memory for the seek list\n",
+				xgp->progname,
+				tdp->td_target_number);
+			return(-1);
+		}
+		for (op = 0; op < sp->seek_total_ops; op++)
+			xdd_seek_generate(tdp, op, &sp->seeks[op]);
+		sp->seek_options &= ~SO_SEEK_LAZY;
+	}
+
+	kept = 0;
+	skipped = 0;
+	for (op = 0; op < sp->seek_total_ops; op++) {
+		offset = ((tdp->td_target_number * tdp->td_planp->target_offset) + sp->seeks[op].block_location) * tdp->td_block_size;
+		length = tdp->td_target_bytes_to_xfer_per_pass - (op * tdp->td_xfer_size);
+		if (length > tdp->td_xfer_size)
+			length = tdp->td_xfer_size;
+		if (xdd_restart_journal_covers(rp, offset, length)) {
+			skipped += length;
+			continue;
+		}
+		sp->seeks[kept++] = sp->seeks[op];
+	}
+	if (skipped == 0)
+		return(0);
+
+	fprintf(xgp->output,"%s: xdd_restart_journal_trim_seek_list: Target %d: INFO: Skipping %lld bytes in %lld requests that the restart journal lists as complete\n",
+		xgp->progname,
+		tdp->td_target_number,
+		(long long int)skipped,
+		(long long int)(sp->seek_total_ops - kept));
+	sp->seek_total_ops = kept;
+	sp->seek_num_rw_ops = kept;
+	tdp->td_target_ops = kept;
+	tdp->td_target_bytes_to_xfer_per_pass -= skipped;
+	return(0);
+} // End of xdd_restart_journal_trim_seek_list()
+
+/*----------------------------------------------------------------------------*/
+// xdd_restart_journal_open() - Set up the restart journal of an E2E target
+//
+// Both sides load the extents that an earlier run left in the journal.
+// The destination side then rewrites the journal with the merged extents and
+// keeps it open to append to. The source side only reads it and takes the
+// covered requests out of its seek list.
+// This routine is called from xdd_e2e_target_init() after the seek list has
+// been built and before any I/O is issued.
+//
+// Return values: 0 is good, -1 is bad
+//
+int
+xdd_restart_journal_open(target_data_t *tdp) {
+	xint_restart_t	*rp;
+	int64_t			bytes;
+	int64_t			i;
+
+
+	rp = tdp->td_restartp;
+	rp->journal_fd = -1;
+	pthread_mutex_init(&rp->journal_lock, 0);
+	// The offsets of an E2E files mode operation are not offsets in one file
+	if (tdp->td_target_options & TO_E2E_FILES) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_open: Target %d: WARNING: The restart journal does not apply to -e2e files and is ignored\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(0);
+	}
+	if (xdd_restart_journal_load(tdp) < 0)
+		return(-1);
+
+	if (rp->journal_extent_count > 0) {
+		bytes = 0;
+		for (i = 0; i < rp->journal_extent_count; i++)
+			bytes += rp->journal_extents[i].length;
+		fprintf(xgp->output,"%s: xdd_restart_journal_open: Target %d: INFO: Restart journal %s lists %lld bytes in %lld extents as complete\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename,
+			(long long int)bytes,
+			(long long int)rp->journal_extent_count);
+	}
+
+	if (tdp->td_target_options & TO_E2E_DESTINATION) {
+		if (xdd_restart_journal_compact(tdp) < 0)
+			return(-1);
+		rp->flags |= RESTART_FLAG_JOURNAL;
+	} else if (xdd_restart_journal_trim_seek_list(tdp) < 0) {
+		return(-1);
+	}
+	return(0);
+} // End of xdd_restart_journal_open()
+
+/*----------------------------------------------------------------------------*/
+// xdd_restart_journal_record() - Remember that a range of the destination
+// file has been written. The range is not in the journal until the next
+// checkpoint has made the data itself stable.
+// This routine is called within the context of a destination Worker Thread.
+//
+void
+xdd_restart_journal_record(xint_restart_t *rp, int64_t offset, int64_t length) {
+	xint_restart_extent_t	*ep;
+	int64_t					size;
+
+
+	pthread_mutex_lock(&rp->journal_lock);
+	// Extend the previous extent when the data arrives in order
+	if (rp->journal_pending_count > 0) {
+		ep = &rp->journal_pending[rp->journal_pending_count - 1];
+		if (ep->offset + ep->length == offset) {
+			ep->length += length;
+			pthread_mutex_unlock(&rp->journal_lock);
+			return;
+		}
+	}
+	if (rp->journal_pending_count == rp->journal_pending_size) {
+		size = (rp->journal_pending_size == 0) ? 256 : 2 * rp->journal_pending_size;
+		ep = realloc(rp->journal_pending, size * sizeof(*ep));
+		if (ep == NULL) { // The range is simply sent again after a restart
+			pthread_mutex_unlock(&rp->journal_lock);
+			return;
+		}
+		rp->journal_pending = ep;
+		rp->journal_pending_size = size;
+	}
+	rp->journal_pending[rp->journal_pending_count].offset = offset;
+	rp->journal_pending[rp->journal_pending_count].length = length;
+	rp->journal_pending_count++;
+	pthread_mutex_unlock(&rp->journal_lock);
+} // End of xdd_restart_journal_record()
+
+/*----------------------------------------------------------------------------*/
+// xdd_restart_journal_checkpoint() - Append the extents written since the
+// last checkpoint to the journal.
+// The destination file is synced first so that the journal never lists data
+// that a crash could still lose. The journal is compacted when it has grown
+// RESTART_JOURNAL_COMPACT_RECORDS past the number of merged extents.
+// This routine is called by the restart monitor with the restart_lock held.
+//
+// Return values: 0 is good, -1 is bad
+//
+int
+xdd_restart_journal_checkpoint(target_data_t *tdp) {
+	xint_restart_t			*rp;
+	xint_restart_extent_t	*pending;
+	xint_restart_extent_t	*ep;
+	int64_t					count;
+	int64_t					size;
+
+
+	rp = tdp->td_restartp;
+	if (!(rp->flags & RESTART_FLAG_JOURNAL))
+		return(0);
+
+	// Swap in the spare array so that the Worker Threads are not held up
+	pthread_mutex_lock(&rp->journal_lock);
+	pending = rp->journal_pending;
+	count = rp->journal_pending_count;
+	size = rp->journal_pending_size;
+	rp->journal_pending = rp->journal_spare;
+	rp->journal_pending_size = rp->journal_spare_size;
+	rp->journal_pending_count = 0;
+	pthread_mutex_unlock(&rp->journal_lock);
+	rp->journal_spare = pending;
+	rp->journal_spare_size = size;
+	if (count == 0)
+		return(0);
+
+	count = xdd_restart_extent_merge(pending, count);
+	if ((fdatasync(tdp->td_file_desc) < 0) ||
+		(xdd_restart_journal_write(rp->journal_fd, pending, count * sizeof(*pending)) < 0) ||
+		(fdatasync(rp->journal_fd) < 0)) {
+		fprintf(xgp->errout,"%s: xdd_restart_journal_checkpoint: Target %d: ERROR: Cannot update restart journal %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			rp->journal_filename);
+		perror("Reason");
+		rp->flags &= ~RESTART_FLAG_JOURNAL;
+		return(-1);
+	}
+	rp->journal_records += count;
+
+	// Fold the new extents into the merged list
+	ep = realloc(rp->journal_extents, (rp->journal_extent_count + count) * sizeof(*ep));
+	if (ep == NULL)
+		return(0); // The journal is still complete, it just does not get compacted
+	memcpy(ep + rp->journal_extent_count, pending, count * sizeof(*ep));
+	rp->journal_extents = ep;
+	rp->journal_extent_count = xdd_restart_extent_merge(ep, rp->journal_extent_count + count);
+
+	if (rp->journal_records - rp->journal_extent_count >= RESTART_JOURNAL_COMPACT_RECORDS) {
+		if (xdd_restart_journal_compact(tdp) < 0) {
+			rp->flags &= ~RESTART_FLAG_JOURNAL;
+			return(-1);
+		}
+	}
+	return(0);
+} // End of xdd_restart_journal_checkpoint()
+
+/*----------------------------------------------------------------------------*/
+// xdd_restart_journal_close() - Write the last extents of a copy that
+// completed, leave the journal compacted, and close it.
+// This routine is called with the restart_lock held.
+//
+void
+xdd_restart_journal_close(target_data_t *tdp) {
+	xint_restart_t	*rp;
+
+
+	rp = tdp->td_restartp;
+	if (!(rp->flags & RESTART_FLAG_JOURNAL))
+		return;
+	if (xdd_restart_journal_checkpoint(tdp) == 0)
+		xdd_restart_journal_compact(tdp);
+	if (rp->journal_fd >= 0)
+		close(rp->journal_fd);
+	rp->journal_fd = -1;
+	rp->flags &= ~RESTART_FLAG_JOURNAL;
+} // End of xdd_restart_journal_close()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,307 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of a striped target (-stripe).
+ * A striped target spreads the offsets of its seek list round-robin across
+ * several files or devices in units of the stripe unit. The Target Thread
+ * opens all of them and keeps a table of their file descriptors that the
+ * Worker Threads share the same way they share td_file_desc. Each op is
+ * split at the stripe unit boundaries into one pread/pwrite per piece.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_names() - build the names of the files of a striped target
+ * from the -stripe files list or from the target name.
+ * Return values: 0 is good, -1 is bad
+ */
+static int32_t
+xdd_stripe_names(target_data_t *tdp) {
+	xint_stripe_t	*stp;
+	char			*list;
+	char			*cp;
+	char			*save;
+	int32_t			i;
+
+
+	stp = tdp->td_stripep;
+	if (stp->stripe_names) {
+		for (i = 0; i < stp->stripe_count; i++)
+			free(stp->stripe_names[i]);
+		free(stp->stripe_names);
+	}
+	stp->stripe_names = calloc(stp->stripe_count, sizeof(char *));
+	if (stp->stripe_names == NULL)
+		return(-1);
+	if (stp->stripe_file_list) {
+		list = strdup(stp->stripe_file_list);
+		if (list == NULL)
+			return(-1);
+		i = 0;
+		for (cp = strtok_r(list, ",", &save); cp && (i < stp->stripe_count); cp = strtok_r(NULL, ",", &save))
+			stp->stripe_names[i++] = strdup(cp);
+		free(list);
+	} else {
+		for (i = 0; i < stp->stripe_count; i++) {
+			stp->stripe_names[i] = malloc(strlen(tdp->td_target_full_pathname) + 16);
+			if (stp->stripe_names[i])
+				sprintf(stp->stripe_names[i], "%s.%d", tdp->td_target_full_pathname, i);
+		}
+	}
+	for (i = 0; i < stp->stripe_count; i++)
+		if (stp->stripe_names[i] == NULL)
+			return(-1);
+	return(0);
+
+} // End of xdd_stripe_names()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_open() - Open all the files of a striped target in place of
+ * the usual open. Each file goes through the same existence check and
+ * OS-specific open as a normal target. td_file_desc is left set to the
+ * first file. This is called by xdd_target_open().
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_stripe_open(target_data_t *tdp) {
+	xint_stripe_t	*stp;
+	char			*target_full_pathname;
+	uint64_t		target_bytes;
+	uint64_t		units;
+	int32_t			status;
+	int32_t			i;
+
+
+	stp = tdp->td_stripep;
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_ASYNC_IO_ENGINE)) {
+		fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: -stripe cannot be used with -e2e or an asynchronous I/O engine\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	if (tdp->td_target_options & TO_SGIO) {
+		fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: -stripe cannot be used with SCSI Generic devices\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	if ((stp->stripe_unit <= 0) || (stp->stripe_unit % tdp->td_block_size)) {
+		fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: The stripe unit of %lld bytes must be a multiple of the block size of %d bytes\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)stp->stripe_unit,
+			tdp->td_block_size);
+		return(-1);
+	}
+	if (xdd_stripe_names(tdp) < 0) {
+		fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: Cannot allocate the names of %d stripe files\n",
+			xgp->progname,
+			tdp->td_target_number,
+			stp->stripe_count);
+		return(-1);
+	}
+	if (stp->stripe_fds == NULL) {
+		stp->stripe_fds = malloc(stp->stripe_count * sizeof(int));
+		if (stp->stripe_fds == NULL) {
+			fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: Cannot allocate the file descriptors of %d stripe files\n",
+				xgp->progname,
+				tdp->td_target_number,
+				stp->stripe_count);
+			return(-1);
+		}
+	}
+
+	// The existence check compares the size of each file with its share of the pass
+	target_full_pathname = tdp->td_target_full_pathname;
+	target_bytes = tdp->td_target_bytes_to_xfer_per_pass;
+	units = (target_bytes + stp->stripe_unit - 1) / stp->stripe_unit;
+	tdp->td_target_bytes_to_xfer_per_pass = ((units + stp->stripe_count - 1) / stp->stripe_count) * stp->stripe_unit;
+	status = 0;
+	for (i = 0; i < stp->stripe_count; i++) {
+		tdp->td_target_full_pathname = stp->stripe_names[i];
+		if (xdd_target_existence_check(tdp) < 0) {
+			status = -1;
+			break;
+		}
+		tdp->td_open_flags |= O_CREAT;
+		xdd_target_open_for_os(tdp);
+		if (tdp->td_file_desc < 0) {
+			fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: Could not open stripe file %d name %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				i,
+				stp->stripe_names[i]);
+			fflush(xgp->errout);
+			perror("reason");
+			status = -1;
+			break;
+		}
+		stp->stripe_fds[i] = tdp->td_file_desc;
+		// The open turns SGIO on by itself for a /dev/sg device
+		if (tdp->td_target_options & TO_SGIO) {
+			fprintf(xgp->errout,"%s: xdd_stripe_open: Target %d: ERROR: -stripe cannot be used with SCSI Generic devices such as stripe file %d name %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				i,
+				stp->stripe_names[i]);
+			i++;
+			status = -1;
+			break;
+		}
+	}
+	tdp->td_target_full_pathname = target_full_pathname;
+	tdp->td_target_bytes_to_xfer_per_pass = target_bytes;
+	if (status < 0) {
+		while (--i >= 0) {
+			close(stp->stripe_fds[i]);
+			stp->stripe_fds[i] = -1;
+		}
+		tdp->td_file_desc = -1;
+		return(-1);
+	}
+	tdp->td_file_desc = stp->stripe_fds[0];
+	return(0);
+
+} // End of xdd_stripe_open()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_close() - Close all the files of a striped target
+ * Return values: 0 is good, -1 if any of the closes failed
+ */
+int32_t
+xdd_stripe_close(target_data_t *tdp) {
+	xint_stripe_t	*stp;
+	int32_t			status;
+	int32_t			i;
+
+
+	stp = tdp->td_stripep;
+	status = 0;
+	if (stp->stripe_fds == NULL)
+		return(0);
+	for (i = 0; i < stp->stripe_count; i++) {
+		if ((stp->stripe_fds[i] >= 0) && (close(stp->stripe_fds[i]) < 0))
+			status = -1;
+		stp->stripe_fds[i] = -1;
+	}
+	tdp->td_file_desc = -1;
+	return(status);
+
+} // End of xdd_stripe_close()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_unlink() - Delete all the files of a striped target for the
+ * -deletefile and -recreatefiles options
+ */
+void
+xdd_stripe_unlink(target_data_t *tdp) {
+	xint_stripe_t	*stp;
+	int32_t			i;
+
+
+	stp = tdp->td_stripep;
+	if (stp->stripe_names == NULL)
+		return;
+	for (i = 0; i < stp->stripe_count; i++)
+		unlink(stp->stripe_names[i]);
+
+} // End of xdd_stripe_unlink()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_sync() - Flush the write buffers of all the files of a
+ * striped target for the -syncwrite option
+ * Return values: 0 is good, -1 if any of the syncs failed
+ */
+int32_t
+xdd_stripe_sync(target_data_t *tdp) {
+	xint_stripe_t	*stp;
+	int32_t			status;
+	int32_t			i;
+
+
+	stp = tdp->td_stripep;
+	status = 0;
+	for (i = 0; i < stp->stripe_count; i++) {
+#if (LINUX || AIX)
+		if (fdatasync(stp->stripe_fds[i]) < 0)
+#else
+		if (fsync(stp->stripe_fds[i]) < 0)
+#endif
+			status = -1;
+	}
+	return(status);
+
+} // End of xdd_stripe_sync()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_stripe_io() - Read or write the current task of a striped target.
+ * The op is split at the stripe unit boundaries and each piece is read or
+ * written at its place in its own file.
+ * This is called by xdd_io_for_os() in place of the pread/pwrite.
+ * Return values: the number of bytes transferred, which is less than the
+ * transfer size at the end of a file, or -1 with errno set
+ */
+ssize_t
+xdd_stripe_io(worker_data_t *wdp) {
+	xint_stripe_t	*stp;
+	unsigned char	*bufp;
+	off_t			offset;
+	off_t			file_offset;
+	int64_t			unit_number;
+	int64_t			unit_offset;
+	size_t			remaining;
+	size_t			length;
+	ssize_t			status;
+	ssize_t			done;
+	int				fd;
+
+
+	stp = wdp->wd_tdp->td_stripep;
+	bufp = wdp->wd_task.task_datap;
+	offset = wdp->wd_task.task_byte_offset;
+	remaining = wdp->wd_task.task_xfer_size;
+	done = 0;
+	while (remaining > 0) {
+		unit_number = offset / stp->stripe_unit;
+		unit_offset = offset % stp->stripe_unit;
+		fd = stp->stripe_fds[unit_number % stp->stripe_count];
+		file_offset = ((unit_number / stp->stripe_count) * stp->stripe_unit) + unit_offset;
+		length = stp->stripe_unit - unit_offset;
+		if (length > remaining)
+			length = remaining;
+		if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE)
+			status = pwrite(fd, bufp, length, file_offset);
+		else status = pread(fd, bufp, length, file_offset);
+		if (status < 0)
+			return(-1);
+		done += status;
+		if ((size_t)status < length) // End of this file
+			break;
+		bufp += length;
+		offset += length;
+		remaining -= length;
+	}
+	return(done);
+
+} // End of xdd_stripe_io()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -27,15 +27,24 @@ xdd_target_thread_cleanup(target_data_t *tdp) {
 
 	wdp = tdp->td_next_wdp;
 	while (wdp) {
+		if (tdp->td_target_options & TO_ASYNC_IO_ENGINE) {
+			// There is no Worker Thread to release when an asynchronous I/O engine is used
+			xdd_worker_thread_cleanup(wdp);
+			wdp = wdp->wd_next_wdp;
+			continue;
+		}
 		wdp->wd_task.task_request = TASK_REQ_STOP;
-		tdp->td_occupant.occupant_type |= XDD_OCCUPANT_TYPE_CLEANUP;
-		// Release this Worker Thread
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		// Post the STOP task to this Worker Thread
+		xdd_task_ring_post(wdp, &wdp->wd_task);
 
 		// get the next Worker in this chain
 		wdp = wdp->wd_next_wdp;
 	}
-	if (tdp->td_target_options & TO_DELETEFILE) {
+	xdd_io_engine_cleanup(tdp);
+
+	if ((tdp->td_target_options & TO_DELETEFILE) && (tdp->td_target_options & TO_STRIPE)) {
+		xdd_stripe_unlink(tdp);
+	} else if (tdp->td_target_options & TO_DELETEFILE) {
 #ifdef WIN32
 		DeleteFile(tdp->td_target_full_pathname);
 #else
@@ -51,7 +60,9 @@ xdd_target_thread_cleanup(target_data_t *tdp) {
 
 	/* On non e2e, close the descriptor */
 	if (!(TO_ENDTOEND & tdp->td_target_options)) {
-		rc = close(tdp->td_file_desc);
+		if (TO_STRIPE & tdp->td_target_options)
+			rc = xdd_stripe_close(tdp);
+		else rc = close(tdp->td_file_desc);
 		// Check the status of the CLOSE operation to see if it worked
 		if (rc != 0) {
 			fprintf(xgp->errout,"%s: xdd_target_open: ERROR: Could not close target number %d name %s\n",
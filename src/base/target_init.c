@@ -66,9 +66,26 @@ xint_target_init(target_data_t *tdp) {
 	// during a single pass. 
 	// It is this list that is used by xdd_issue() to assign I/O tasks to the WorkerThreads.
 	//
+	// With -seek lazy the list is not built and each entry is generated by 
+	// xdd_seek_entry() when it is needed. A loaded seek list has to be built.
+	//
 	tdp->td_seekhdr.seek_total_ops = tdp->td_target_ops;
-	tdp->td_seekhdr.seeks = (seek_t *)calloc((int32_t)tdp->td_seekhdr.seek_total_ops,sizeof(seek_t));
-	if (tdp->td_seekhdr.seeks == 0) {
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_LAZY) && (tdp->td_seekhdr.seek_options & SO_SEEK_LOAD)) {
+		fprintf(xgp->errout,"%s: xdd_target_thread_init: Target %d: WARNING: -seek lazy cannot be used with -seek load - building the seek list\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_seekhdr.seek_options &= ~SO_SEEK_LAZY;
+	}
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_LAZY) && (tdp->td_seekhdr.seek_options & SO_SEEK_PHYSICAL)) {
+		fprintf(xgp->errout,"%s: xdd_target_thread_init: Target %d: WARNING: -seek lazy cannot be used with -seek physical - building the seek list\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_seekhdr.seek_options &= ~SO_SEEK_LAZY;
+	}
+	if (tdp->td_seekhdr.seek_options & SO_SEEK_LAZY)
+		tdp->td_seekhdr.seeks = NULL;
+	else tdp->td_seekhdr.seeks = (seek_t *)calloc((size_t)tdp->td_seekhdr.seek_total_ops,sizeof(seek_t));
+	if ((tdp->td_seekhdr.seeks == 0) && !(tdp->td_seekhdr.seek_options & SO_SEEK_LAZY)) {
 		fprintf(xgp->errout,"%s: xdd_target_thread_init: ERROR: Cannot allocate memory for access list for Target %d name '%s' - terminating\n",
 			xgp->progname,
 			tdp->td_target_number,
@@ -131,6 +148,11 @@ xint_target_init(target_data_t *tdp) {
 			return(-1);
 	}
 
+	// Set up the asynchronous I/O engine if one was requested
+	status = xdd_io_engine_init(tdp);
+	if (status)
+		return(-1);
+
 	// Start the WorkerThreads
 	status = xint_target_init_start_worker_threads(tdp);
 	if (status) 
@@ -206,11 +228,8 @@ xint_target_init_barriers(target_data_t *tdp) {
 		status += xdd_init_barrier(tdp->td_planp, &tdp->td_trigp->target_target_starttrigger_barrier,2,tmpname);
 	}
 
-	// The "td_counters_mutex" is used by the WorkerThreads when updating the counter information in the Target Thread Data
-	status += pthread_mutex_init(&tdp->td_counters_mutex, 0);
-
 	if (status) {
-		fprintf(xgp->errout,"%s: xdd_target_init_barriers: ERROR: Cannot create td_counters_mutex for target number %d name '%s'\n",
+		fprintf(xgp->errout,"%s: xdd_target_init_barriers: ERROR: Cannot create the barriers for target number %d name '%s'\n",
 			xgp->progname, 
 			tdp->td_target_number,
 			tdp->td_target_full_pathname);
@@ -219,7 +238,6 @@ xint_target_init_barriers(target_data_t *tdp) {
 	}
 
 	// Initialize the semaphores used to control WorkerThread selection
-	tdp->td_any_worker_thread_available = 0;
 	status = pthread_mutex_init(&tdp->td_any_worker_thread_available_mutex, NULL);
 	status = pthread_cond_init(&tdp->td_any_worker_thread_available_condition, NULL);
 	if (status) {
@@ -230,6 +248,13 @@ xint_target_init_barriers(target_data_t *tdp) {
 		return(-1);
 	}
 
+	// The map of available WorkerThreads
+	status = xdd_idle_worker_map_init(tdp);
+	if (status) {
+		fflush(xgp->errout);
+		return(-1);
+	}
+
 	return(0);
 } // End of xdd_target_init_barriers()
 
@@ -261,6 +286,22 @@ xint_target_init_start_worker_threads(target_data_t *tdp) {
 	    
 	    // Start a WorkerThread and wait for it to initialize
 	    wdp->wd_worker_number = q;
+	    if (tdp->td_target_options & TO_ASYNC_IO_ENGINE) {
+		// The asynchronous I/O engine issues all I/O from the Target Thread 
+		// so the Worker Data is initialized here and no WorkerThread is created
+		status = xdd_worker_thread_init(wdp);
+		if (status) {
+		    fprintf(xgp->errout,"%s: xdd_target_init_start_worker_threads: ERROR: Cannot initialize I/O slot %d for target number %d name '%s'\n",
+			    xgp->progname, 
+			    q,
+			    tdp->td_target_number,
+			    tdp->td_target_full_pathname);
+		    fflush(xgp->errout);
+		    return(-1);
+		}
+		wdp = wdp->wd_next_wdp;
+		continue;
+	    }
 	    if (tdp->td_target_options & TO_ENDTOEND) {
 
 		// Find an e2e entry that has a valid port count
@@ -16,6 +16,10 @@
 #include "config.h"
 #include "xint.h"
 
+#if defined(LINUX)
+#include <linux/futex.h>
+#endif
+
 #define DEFAULT_TOT_MULTIPLIER 20
 
 /**
@@ -62,9 +66,12 @@ int tot_init(tot_t** table, size_t queue_depth, size_t num_reqs)
 			return -1;
     	tp = *table;
     	tp->tot_entries = num_entries;
+#if !defined(LINUX)
     	for (i = 0; i < tp->tot_entries; i++) {
-			// Initialize the mutex
+			// Initialize the mutex and condition variable
         	rc = pthread_mutex_init(&tp->tot_entry[i].tot_mutex, 0);
+        	if (0 == rc)
+        		rc = pthread_cond_init(&tp->tot_entry[i].tot_condition, 0);
         	if (0 != rc) {
 	    		tp->tot_entries = i;
 	    		break;
@@ -72,18 +79,19 @@ int tot_init(tot_t** table, size_t queue_depth, size_t num_reqs)
 		}
     	if (0 != rc)
 			return -1;
+#endif
 	}
     
     // Initialize all the table entries
-	// Note: The TOT wait structures reside in the Worker Data Structure
-	// and are initialized as part of worker_thread_init().
+	// This is done at the start of every pass when no Worker Thread is
+	// waiting on the table.
 	tp = *table;
     for (i = 0; i < tp->tot_entries; i++) {
-        tp->tot_entry[i].tot_waitp = 0;
         tp->tot_entry[i].tot_op_number = -1;
+        tp->tot_entry[i].tot_seq = 0;
+        tp->tot_entry[i].tot_waiters = 0;
         tp->tot_entry[i].tot_byte_offset = -1;
         tp->tot_entry[i].tot_io_size = 0;
-        tp->tot_entry[i].tot_status = TOT_ENTRY_AVAILABLE;
     }
 
     // Perform cleanup if inititalization did not complete successfully
@@ -95,16 +103,20 @@ int tot_init(tot_t** table, size_t queue_depth, size_t num_reqs)
 
 int tot_destroy(tot_t* tp)
 {
-    int i, status;
+    int status;
 
     // Preconditions check
     assert(NULL != tp);
     
-    // Release the semaphores in the table
+    // Release the mutexes and condition variables in the table
     status = 0;
+#if !defined(LINUX)
+    int i;
     for (i = 0; i < tp->tot_entries; i++) {
         status += pthread_mutex_destroy(&tp->tot_entry[i].tot_mutex);
+        status += pthread_cond_destroy(&tp->tot_entry[i].tot_condition);
     } 
+#endif
 
     // Free the memory
     free(tp);
@@ -112,6 +124,127 @@ int tot_destroy(tot_t* tp)
     return status;
 }
 
+/**
+ * Put the calling Worker Thread to sleep until tot_seq of the entry is no
+ * longer equal to the specified value. This may return early so the caller
+ * must check the entry again.
+ */
+static void tot_sleep(tot_entry_t* tep, uint32_t seq)
+{
+#if defined(LINUX)
+    syscall(SYS_futex, &tep->tot_seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&tep->tot_mutex);
+    while (__atomic_load_n(&tep->tot_seq, __ATOMIC_SEQ_CST) == seq)
+		pthread_cond_wait(&tep->tot_condition, &tep->tot_mutex);
+    pthread_mutex_unlock(&tep->tot_mutex);
+#endif
+}
+
+/**
+ * Wake the Worker Thread sleeping on the entry. A lone sleeper is the one
+ * waiting for the op that was just released. With more than one sleeper
+ * (ops a whole table apart) all of them are woken to recheck the entry.
+ */
+static void tot_wake(tot_entry_t* tep, uint32_t waiters)
+{
+#if defined(LINUX)
+    syscall(SYS_futex, &tep->tot_seq, FUTEX_WAKE_PRIVATE, (waiters == 1) ? 1 : INT_MAX, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&tep->tot_mutex);
+    if (waiters == 1)
+		pthread_cond_signal(&tep->tot_condition);
+    else pthread_cond_broadcast(&tep->tot_condition);
+    pthread_mutex_unlock(&tep->tot_mutex);
+#endif
+}
+
+/**
+ * Raise tot_op_number of the entry to req_number. The op number never goes
+ * backwards so a late second release of an op with Loose Ordering cannot
+ * undo the release of a later op that uses the same entry.
+ *
+ * @return 0 if the op number was raised, -1 if it was already req_number or higher
+ */
+static int tot_raise_op_number(tot_entry_t* tep, int64_t req_number)
+{
+    int64_t current;
+
+    current = __atomic_load_n(&tep->tot_op_number, __ATOMIC_RELAXED);
+    while (current < req_number) {
+		if (__atomic_compare_exchange_n(&tep->tot_op_number, &current, req_number,
+						0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			return 0;
+    }
+    return -1;
+}
+
+int tot_wait(tot_t* table,
+	     int64_t req_number,
+	     int worker_thread_number)
+{
+    tot_entry_t* tep;
+    uint32_t seq;
+
+    // Check preconditions
+    assert(NULL != table);
+    assert(0 <= req_number);
+
+    tep = &(table->tot_entry[req_number % table->tot_entries]);
+
+    // The common case is that the op has already been released
+    if (__atomic_load_n(&tep->tot_op_number, __ATOMIC_ACQUIRE) >= req_number)
+		return 0;
+
+    nclk_now(&tep->tot_wait_ts);
+    tep->tot_wait_worker_thread_number = worker_thread_number;
+
+    // The load of tot_seq must come before the check of tot_op_number and the
+    // increment of tot_waiters must come before the second check so that a 
+    // release in between either changes tot_seq or sees tot_waiters
+    while (__atomic_load_n(&tep->tot_op_number, __ATOMIC_ACQUIRE) < req_number) {
+		seq = __atomic_load_n(&tep->tot_seq, __ATOMIC_SEQ_CST);
+		__atomic_add_fetch(&tep->tot_waiters, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&tep->tot_op_number, __ATOMIC_SEQ_CST) < req_number)
+			tot_sleep(tep, seq);
+		__atomic_sub_fetch(&tep->tot_waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    return 0;
+}
+
+int tot_release(tot_t* table,
+		int64_t req_number,
+		int worker_thread_number,
+		int64_t offset,
+		int32_t size)
+{
+    tot_entry_t* tep;
+    uint32_t waiters;
+
+    // Check preconditions
+    assert(NULL != table);
+    assert(0 <= req_number);
+    assert(0 <= worker_thread_number);
+
+    tep = &(table->tot_entry[req_number % table->tot_entries]);
+
+    // Update the informational fields first so that they are current by the
+    // time the next Worker Thread sees the op number
+    nclk_now(&tep->tot_update_ts);
+    tep->tot_post_ts = tep->tot_update_ts;
+    tep->tot_post_worker_thread_number = worker_thread_number;
+    tep->tot_update_worker_thread_number = worker_thread_number;
+    tep->tot_byte_offset = offset;
+    tep->tot_io_size = size;
+
+    tot_raise_op_number(tep, req_number);
+    __atomic_add_fetch(&tep->tot_seq, 1, __ATOMIC_SEQ_CST);
+    waiters = __atomic_load_n(&tep->tot_waiters, __ATOMIC_SEQ_CST);
+    if (waiters)
+		tot_wake(tep, waiters);
+    return 0;
+}
+
 int tot_update(tot_t* table,
 	       int64_t req_number,
 	       int worker_thread_number,
@@ -131,11 +264,8 @@ int tot_update(tot_t* table,
     idx = req_number % table->tot_entries;
     tep = &(table->tot_entry[idx]);
 
-    // Lock entry
-    pthread_mutex_lock(&tep->tot_mutex);
-
     // Do not update if a newer entry is using this slot
-    if (tep->tot_op_number >= req_number) {
+    if (tot_raise_op_number(tep, req_number)) {
 		rc = -1;
 		fprintf(xgp->errout,
 			"%s: tot_update: Worker Thread %d: "
@@ -153,13 +283,10 @@ int tot_update(tot_t* table,
     } else {
 		nclk_now(&tep->tot_update_ts);
 		tep->tot_update_worker_thread_number = worker_thread_number;
-		tep->tot_op_number = req_number;
 		tep->tot_byte_offset = offset;
 		tep->tot_io_size = size;
     }
 
-    // Unlock entry
-    pthread_mutex_unlock(&tep->tot_mutex);
     return rc;
 }
 /*
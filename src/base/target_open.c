@@ -39,6 +39,30 @@ xdd_target_open(target_data_t *tdp) {
 	/* create the fully qualified target name */
 	xdd_target_name(tdp);
 
+	// The target of an E2E files mode operation is a directory
+	if (tdp->td_target_options & TO_E2E_FILES) {
+		nclk_now(&tdp->td_open_start_time);
+		status = xdd_e2e_files_open(tdp);
+		nclk_now(&tdp->td_open_end_time);
+		return(status);
+	}
+
+	// The target of a metadata workload is a directory
+	if (tdp->td_target_options & TO_METADATA) {
+		nclk_now(&tdp->td_open_start_time);
+		status = xdd_metadata_open(tdp);
+		nclk_now(&tdp->td_open_end_time);
+		return(status);
+	}
+
+	// A striped target opens each of its files
+	if (tdp->td_target_options & TO_STRIPE) {
+		nclk_now(&tdp->td_open_start_time);
+		status = xdd_stripe_open(tdp);
+		nclk_now(&tdp->td_open_end_time);
+		return(status);
+	}
+
 	// Check to see if this target really exists and record what kind of target it is
 	status = xdd_target_existence_check(tdp);
 	if (status < 0)
@@ -78,6 +102,9 @@ xdd_target_reopen(target_data_t *tdp) {
 
 
 	// Close the existing target
+	if (tdp->td_target_options & TO_STRIPE)
+		xdd_stripe_close(tdp);
+	else
 #if (WIN32)
 	CloseHandle(tdp->td_file_desc);
 #else
@@ -85,7 +112,9 @@ xdd_target_reopen(target_data_t *tdp) {
 #endif
 
 	// If we need to "recreate" the file for each pass then we should delete it here before we re-open it 
-	if (tdp->td_target_options & TO_RECREATE)	
+	if ((tdp->td_target_options & TO_RECREATE) && (tdp->td_target_options & TO_STRIPE))
+		xdd_stripe_unlink(tdp);
+	else if (tdp->td_target_options & TO_RECREATE)	
 #ifdef WIN32
 		DeleteFile(tdp->td_target_full_pathname);
 #else
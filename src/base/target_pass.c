@@ -65,6 +65,10 @@ xdd_target_pass(xdd_plan_t* planp, target_data_t *tdp) {
 		if (tdp->td_target_options & TO_E2E_SOURCE)
 		    xdd_targetpass_e2e_loop_src(planp, tdp);
 		else xdd_targetpass_e2e_loop_dst(planp, tdp);
+	} else if (tdp->td_target_options & TO_METADATA) { // The phases of a metadata workload
+	    xdd_metadata_pass_loop(planp, tdp);
+	} else if (tdp->td_target_options & TO_ASYNC_IO_ENGINE) { // The Target Thread does all the I/O
+	    xdd_target_pass_async_loop(planp, tdp);
 	} else { // Normal operations (other than E2E)
 	    xdd_target_pass_loop(planp, tdp);
 	}
@@ -135,18 +139,16 @@ xdd_target_pass_loop(xdd_plan_t* planp, target_data_t *tdp) {
 		status = xdd_target_ttd_before_io_op(tdp, wdp);
 		if (status != XDD_RC_GOOD) {
 			// Mark this worker thread NOT BUSY and break out of this loop
-			pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
-			pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+			xdd_worker_thread_make_available(wdp);
 			break;
 		}
 
 		// Set up the task for the Worker Thread
 		xdd_target_pass_task_setup(wdp);
 
-		// Release the Worker Thread to let it start working on this task.
+		// Post the task to the Worker Thread to let it start working on it.
 		// This effectively causes the I/O operation to be issued.
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		xdd_task_ring_post(wdp, &wdp->wd_task);
 
 	} // End of WHILE loop that transfers data for a single pass
 //
@@ -164,10 +166,7 @@ xdd_target_pass_loop(xdd_plan_t* planp, target_data_t *tdp) {
 	// Worker Thread specifically and then reset it's "busy" bit to 0.
 	for (q = 0; q < tdp->td_queue_depth; q++) {
 		wdp = xdd_get_specific_worker_thread(tdp,q);
-		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
-		tdp->td_any_worker_thread_available++;
-		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+		xdd_worker_thread_make_available(wdp);
 	}
 	if (tdp->td_counters.tc_current_io_status != 0) 
 		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
@@ -182,6 +181,8 @@ void
 xdd_target_pass_task_setup(worker_data_t *wdp) {
 	target_data_t	*tdp;
 	xdd_ts_tte_t	*ttep;
+	seek_t			*seekp;
+	seek_t			seek_scratch;
 
 	tdp = wdp->wd_tdp;
 	// Assign an IO task to this worker thread
@@ -191,10 +192,11 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	wdp->wd_task.task_file_desc = tdp->td_file_desc;
 
 	// Set the Operation Type
-	if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) { // Write Operation
+	seekp = xdd_seek_entry(tdp, tdp->td_counters.tc_current_op_number, &seek_scratch);
+	if (seekp->operation == SO_OP_WRITE) { // Write Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
 		wdp->wd_task.task_op_string = "WRITE";
-	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) { // READ Operation
+	} else if (seekp->operation == SO_OP_READ) { // READ Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_READ;
 		wdp->wd_task.task_op_string = "READ";
 	} else { 
@@ -214,16 +216,8 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	wdp->wd_task.task_op_number = tdp->td_counters.tc_current_op_number;
 
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
-   	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
+   	ttep = xdd_ts_assign_entry(tdp, wdp);
+   	if (ttep) {
 		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 		ttep->tte_worker_thread_number = wdp->wd_worker_number;
 		ttep->tte_thread_id = wdp->wd_thread_id;
@@ -49,7 +49,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 	// At that point this routine will return.
 
 	// Get the first Worker Thread pointer for this Target
-	wdp = xdd_get_any_available_worker_thread(tdp);
+	wdp = xdd_get_any_available_worker_thread_before_eof(tdp);
 
 	//////////////////////////// BEGIN I/O LOOP FOR ENTIRE PASS ///////////////////////////////////////////
 	while (wdp) { 
@@ -58,8 +58,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 		if ((xgp->canceled) || (xgp->abort) || (tdp->td_abort)) {
 			// When we got this Worker Thread the WTSYNC_BUSY flag was set by get_any_available_worker_thread()
 			// We need to reset it so that the subsequent loop will find it with get_specific_worker_thread()
-			// Normally we would get the mutex lock to do this update but at this point it is not necessary.
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY;
+			xdd_worker_thread_make_available(wdp);
 			break;
 		}
 
@@ -79,16 +78,8 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 //		}
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
-   		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
+   		ttep = xdd_ts_assign_entry(tdp, wdp);
+   		if (ttep) {
 			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 			ttep->tte_worker_thread_number = wdp->wd_worker_number;
 			ttep->tte_thread_id     = wdp->wd_thread_id;
@@ -99,8 +90,8 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 			ttep->tte_net_xfer_size = 0; 	// to be filled in after data received
 		}
 
-		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		// Post this task to the Worker Thread to let it start working on it
+		xdd_task_ring_post(wdp, &wdp->wd_task);
 		// At this point the Worker Thread is running. The first thing it will do is perform all the 
 		// Things To Do (ttd) before the I/O operation. This includes receiving data from the Source
 		// which will block until it gets the data. Once the data is received, the Worker Thread will
@@ -110,7 +101,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 	
 		tdp->td_counters.tc_current_op_number++;
 		// Get another Worker Thread and lets keepit roling...
-		wdp = xdd_get_any_available_worker_thread(tdp);
+		wdp = xdd_get_any_available_worker_thread_before_eof(tdp);
 	
 	} // End of WHILE loop
 	//////////////////////////// END OF I/O LOOP FOR ENTIRE PASS ///////////////////////////////////////////
@@ -127,9 +118,7 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 	// Worker Thread specifically and then reset it's "busy" bit to 0.
 	for (q = 0; q < tdp->td_queue_depth; q++) {
 		wdp = xdd_get_specific_worker_thread(tdp,q);
-		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
-		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+		xdd_worker_thread_make_available(wdp); // Mark this Worker Thread NOT Busy
 		// Check to see if we've been canceled - if so, we need to leave 
 		if (xgp->canceled) {
 			fprintf(xgp->errout,"\n%s: xdd_targetpass_e2e_loop_src: Target %d: ERROR: Canceled!\n",
@@ -142,6 +131,10 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 	if (tdp->td_counters.tc_current_io_status != 0) 
 		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
 
+	// The files and directories of -e2e files get their own mode back
+	if ((tdp->td_target_options & TO_E2E_FILES) && !(xgp->canceled) && (xdd_e2e_files_restore_modes(tdp) < 0))
+		planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
+
 	return;
 
 } // End of xdd_targetpass_e2e_loop_dst()
@@ -169,14 +162,16 @@ xdd_targetpass_e2e_loop_src(xdd_plan_t* planp, target_data_t *tdp) {
 		// Things to do before an I/O is issued
 		status = xdd_target_ttd_before_io_op(tdp,wdp);
 		// Check to see if either the pass or run time limit has expired - if so, we need to leave this loop
-		if (status != XDD_RC_GOOD)
+		if (status != XDD_RC_GOOD) {
+			xdd_worker_thread_make_available(wdp);
 			break;
+		}
 
 		// Set up the task for the Worker Thread
 		xdd_targetpass_e2e_task_setup_src(wdp);
 
-		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		// Post this task to the Worker Thread to let it start working on it
+		xdd_task_ring_post(wdp, &wdp->wd_task);
 
 	} // End of WHILE loop that transfers data for a single pass
 
@@ -197,9 +192,7 @@ xdd_targetpass_e2e_loop_src(xdd_plan_t* planp, target_data_t *tdp) {
 	// Worker Thread specifically and then reset it's "busy" bit to 0.
 	for (q = 0; q < tdp->td_queue_depth; q++) {
 		wdp = xdd_get_specific_worker_thread(tdp,q);
-		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
-		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+		xdd_worker_thread_make_available(wdp); // Mark this Worker Thread NOT Busy
 	}
 
 	if (tdp->td_counters.tc_current_io_status != 0) 
@@ -215,6 +208,8 @@ void
 xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	target_data_t	*tdp;
 	xdd_ts_tte_t	*ttep;
+	seek_t			*seekp;
+	seek_t			seek_scratch;
 
 	tdp = wdp->wd_tdp;
 	// Assign an IO task to this worker thread
@@ -224,10 +219,11 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	wdp->wd_task.task_file_desc = tdp->td_file_desc;
 
 	// Set the Operation Type
-	if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) { // Write Operation
+	seekp = xdd_seek_entry(tdp, tdp->td_counters.tc_current_op_number, &seek_scratch);
+	if (seekp->operation == SO_OP_WRITE) { // Write Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
 		wdp->wd_task.task_op_string = "WRITE";
-	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) { // READ Operation
+	} else if (seekp->operation == SO_OP_READ) { // READ Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_READ;
 		wdp->wd_task.task_op_string = "READ";
 	} else { 
@@ -255,16 +251,8 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	wdp->wd_task.task_op_number = tdp->td_counters.tc_current_op_number;
 
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
-   	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
+   	ttep = xdd_ts_assign_entry(tdp, wdp);
+   	if (ttep) {
 		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 		ttep->tte_worker_thread_number = wdp->wd_worker_number;
 		ttep->tte_thread_id = wdp->wd_thread_id;
@@ -310,16 +298,8 @@ xdd_targetpass_e2e_eof_src(target_data_t *tdp) {
 		wdp->wd_task.task_request = TASK_REQ_EOF;
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
-   		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
+   		ttep = xdd_ts_assign_entry(tdp, wdp);
+   		if (ttep) {
 			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 			ttep->tte_worker_thread_number = wdp->wd_worker_number;
 			ttep->tte_thread_id = wdp->wd_thread_id;
@@ -328,8 +308,8 @@ xdd_targetpass_e2e_eof_src(target_data_t *tdp) {
 			ttep->tte_byte_offset = -1;
 		}
 	
-		// Release the Worker Thread to let it start working on this task
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&tdp->td_occupant,0);
+		// Post this task to the Worker Thread to let it start working on it
+		xdd_task_ring_post(wdp, &wdp->wd_task);
 	
 	}
 } // End of xdd_targetpass_eof_source_side()
@@ -11,11 +11,161 @@
  *
  */
 /*
- * This file contains the subroutine that locates an available Worker Thread for
+ * This file contains the subroutines that locate an available Worker Thread for
  * a specific target.
  */
 #include "xint.h"
 
+/*----------------------------------------------------------------------------*/
+/* xdd_idle_worker_map_init() - Allocate the map of available Worker Threads
+ * for a target. There is one bit per Worker Thread. A Worker Thread sets its
+ * bit when it becomes available and the Target Thread clears it when the
+ * Worker Thread is assigned a task. Since only the Target Thread ever clears
+ * a bit, finding and claiming an available Worker Thread takes no locks.
+ * This is called by xint_target_init_barriers() before the Worker Threads
+ * are started.
+ * Return values: 0 is good, -1 indicates an error
+ */
+int32_t
+xdd_idle_worker_map_init(target_data_t *tdp) {
+	worker_data_t	*wdp;		// Pointer to a Worker Thread Data Struct
+	int32_t			q;
+
+
+	tdp->td_idle_worker_words = (tdp->td_queue_depth + 63) / 64;
+	tdp->td_idle_worker_hint = 0;
+	tdp->td_idle_worker_eof_count = 0;
+	tdp->td_any_worker_thread_waiting = 0;
+	tdp->td_idle_worker_map = (uint64_t *)calloc(tdp->td_idle_worker_words, sizeof(uint64_t));
+	tdp->td_idle_worker_table = (worker_data_t **)calloc(tdp->td_queue_depth, sizeof(worker_data_t *));
+	if ((tdp->td_idle_worker_map == NULL) || (tdp->td_idle_worker_table == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_idle_worker_map_init: Target %d: ERROR: Cannot allocate the available Worker Thread map for a queue depth of %d\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_queue_depth);
+		return(-1);
+	}
+	// The bit number of a Worker Thread is its position on the Worker Data chain
+	wdp = tdp->td_next_wdp;
+	for (q = 0; (q < tdp->td_queue_depth) && wdp; q++) {
+		tdp->td_idle_worker_table[q] = wdp;
+		wdp = wdp->wd_next_wdp;
+	}
+	return(0);
+
+} // End of xdd_idle_worker_map_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_idle_worker_map_empty() - Return 1 if no Worker Thread is available
+ */
+static int
+xdd_idle_worker_map_empty(target_data_t *tdp) {
+	int32_t		w;
+
+
+	for (w = 0; w < tdp->td_idle_worker_words; w++) 
+		if (__atomic_load_n(&tdp->td_idle_worker_map[w], __ATOMIC_SEQ_CST))
+			return(0);
+	return(1);
+
+} // End of xdd_idle_worker_map_empty()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_idle_worker_claim() - Find an available Worker Thread, clear its bit in
+ * the available Worker Thread map, and return its pointer. If no Worker
+ * Thread is available then wait for one.
+ * Only the Target Thread may call this subroutine.
+ */
+static worker_data_t *
+xdd_idle_worker_claim(target_data_t *tdp) {
+	uint64_t	bits;		// One word of the available Worker Thread map
+	int32_t		w;			// Word number in the map
+	int32_t		i;
+	int32_t		bit;
+
+
+	while (1) {
+		// Start looking where the last available Worker Thread was found
+		w = tdp->td_idle_worker_hint;
+		for (i = 0; i < tdp->td_idle_worker_words; i++) {
+			bits = __atomic_load_n(&tdp->td_idle_worker_map[w], __ATOMIC_ACQUIRE);
+			if (bits) {
+				bit = __builtin_ctzll(bits);
+				__atomic_fetch_and(&tdp->td_idle_worker_map[w], ~(1ULL << bit), __ATOMIC_ACQ_REL);
+				tdp->td_idle_worker_hint = w;
+				return(tdp->td_idle_worker_table[(w * 64) + bit]);
+			}
+			if (++w == tdp->td_idle_worker_words)
+				w = 0;
+		}
+
+		// Nothing is available so wait for a Worker Thread to finish its task.
+		// The waiting flag must be visible before the map is checked again or
+		// a Worker Thread that becomes available right now would not wake us.
+		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
+		__atomic_store_n(&tdp->td_any_worker_thread_waiting, 1, __ATOMIC_SEQ_CST);
+		while (xdd_idle_worker_map_empty(tdp)) {
+			tdp->td_current_state |= TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
+			pthread_cond_wait(&tdp->td_any_worker_thread_available_condition, &tdp->td_any_worker_thread_available_mutex);
+			tdp->td_current_state &= ~TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
+		}
+		__atomic_store_n(&tdp->td_any_worker_thread_waiting, 0, __ATOMIC_RELAXED);
+		pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
+	}
+
+} // End of xdd_idle_worker_claim()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_thread_make_available() - Mark the specified Worker Thread NOT
+ * busy and put it back in the available Worker Thread map. 
+ * This is called by a Worker Thread when it finishes a task and by the
+ * Target Thread to give back a Worker Thread that it did not use.
+ */
+void
+xdd_worker_thread_make_available(worker_data_t *wdp) {
+	target_data_t	*tdp;		// Pointer to the Target Data Struct of this Worker Thread
+	int32_t			status;
+
+
+	tdp = wdp->wd_tdp;
+	// Clearing the BUSY flag and setting the available bit are done under the
+	// sync mutex so that xdd_get_specific_worker_thread() sees both or neither
+	pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+	wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this Worker Thread NOT Busy
+	if (wdp->wd_worker_thread_target_sync & WTSYNC_TARGET_WAITING) {
+		// Release the target that is waiting on this Worker Thread
+		status = pthread_cond_broadcast(&wdp->wd_this_worker_thread_is_available_condition);
+		if (status) {
+			fprintf(xgp->errout,"%s: xdd_worker_thread_make_available: Target %d WorkerThread %d: WARNING: Bad status from pthread_cond_broadcast on this_worker_thread_is_available condition: status=%d, errno=%d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				status,
+				errno);
+		}
+		// Turn off the TARGET_WAITING Flag
+		wdp->wd_worker_thread_target_sync &= ~WTSYNC_TARGET_WAITING; 
+	}
+	__atomic_fetch_or(&tdp->td_idle_worker_map[wdp->wd_worker_number / 64], 1ULL << (wdp->wd_worker_number % 64), __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+
+	// Wake up the Worker Thread Locator if it is waiting for ANY available Worker Thread
+	if (__atomic_load_n(&tdp->td_any_worker_thread_waiting, __ATOMIC_SEQ_CST)) {
+		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
+		status = pthread_cond_signal(&tdp->td_any_worker_thread_available_condition);
+		pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
+		if (status) {
+			fprintf(xgp->errout,"%s: xdd_worker_thread_make_available: Target %d WorkerThread %d: WARNING: Bad status from pthread_cond_signal on any_worker_thread_available condition: status=%d, errno=%d\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				status,
+				errno);
+		}
+	}
+
+} // End of xdd_worker_thread_make_available()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_get_specific_worker_thread() - This subroutine will locate the specified
  * Worker Thread and wait for it to become available then return its pointer.
@@ -24,7 +174,6 @@
 worker_data_t *
 xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q) {
 	worker_data_t *wdp;					// Pointer to a Worker Thread Data Struct
-	int i;
 	nclk_t checktime;
 
 	nclk_now(&checktime);
@@ -39,11 +188,7 @@ xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q) {
 	}
 	
 	// Locate the pointer to the requested Worker Thread Data Struct
-	// The Worker Threads are on an ordered linked list anchored on the Target Thread Data Struct 
-	wdp = tdp->td_next_wdp;
-	for (i=0; i<q; i++) 
-		wdp = wdp->wd_next_wdp;
-	// wdp should now point to the desired Worker Thread
+	wdp = tdp->td_idle_worker_table[q];
 
 	// Wait for this specific Worker Thread to become available
 	pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
@@ -61,8 +206,9 @@ xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q) {
             tdp->td_current_state &= ~TARGET_CURRENT_STATE_WAITING_THIS_WORKER_THREAD_AVAILABLE;
         }
         
-        // Indicate that this Worker Thread is now busy, and unlock
+        // Indicate that this Worker Thread is now busy and no longer available, and unlock
         wdp->wd_worker_thread_target_sync |= WTSYNC_BUSY; 
+        __atomic_fetch_and(&tdp->td_idle_worker_map[q / 64], ~(1ULL << (q % 64)), __ATOMIC_ACQ_REL);
         pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
 
 	// At this point we have a pointer to the specified Worker Thread
@@ -71,68 +217,72 @@ xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q) {
 } // End of  xdd_get_specific_worker_thread()
 
 /*----------------------------------------------------------------------------*/
-/* xdd_get_any_available_worker_thread() - This subroutine will scan the list of
- * Worker Threads and return a pointer to a Worker Thread that is available to be assigned a task.
+/* xdd_get_any_available_worker_thread() - This subroutine will return a
+ * pointer to a Worker Thread that is available to be assigned a task. If no
+ * Worker Thread is available then it waits for one to finish its task.
  * This subroutine is called by xdd_target_pass()
  */
 worker_data_t *
 xdd_get_any_available_worker_thread(target_data_t *tdp) {
-    worker_data_t		*wdp; // Pointer to a Worker Thread Data Struct
-    int eof;	// Number of Worker Threads that have reached End-of-File on the destination side of an E2E operation        
-
-    // Use a polling strategy to find available worker_threads -- this might be a good
-    // candidate for asynchronous messages in the future    
-    wdp = 0;
-    eof = 0;
-    while (0 == wdp && eof != tdp->td_queue_depth) {
-		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
-		while (tdp->td_any_worker_thread_available <= 0) {
-	    	tdp->td_current_state |= TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
-	    	pthread_cond_wait(&tdp->td_any_worker_thread_available_condition, &tdp->td_any_worker_thread_available_mutex);
-	    	tdp->td_current_state &= ~TARGET_CURRENT_STATE_WAITING_ANY_WORKER_THREAD_AVAILABLE;
-		}
-		tdp->td_any_worker_thread_available--;
-        
-		// Locate an idle worker_thread
-		wdp = tdp->td_next_wdp;
-    	eof = 0;
-		while (wdp) {
-	    	pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-	    	// Ignore busy worker threads
-	    	if (wdp->wd_worker_thread_target_sync & WTSYNC_BUSY) {
-				pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
-				wdp = wdp->wd_next_wdp;
-				continue;
-	    	}
-
-	    	// Ignore e2e threads that have received their eof
-	    	if ((tdp->td_target_options & TO_E2E_DESTINATION) && 
-				(wdp->wd_worker_thread_target_sync & WTSYNC_EOF_RECEIVED)) {
-				eof++;
-				// Multi-level short circuit hack for when all threads
-				// have recieved an EOF
-				pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
-				if (eof == tdp->td_queue_depth) {
-		    		wdp = 0;
-		    		break;
-				}
-				wdp = wdp->wd_next_wdp;            
-	    	} else {
-				// Got a Worker Thread - mark it BUSY
-				// Indicate that this Worker Thread is now busy
-				wdp->wd_worker_thread_target_sync |= WTSYNC_BUSY; 
-				pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
-				break;
-	    	}
-		}
-	//unlock_and_return:	    
-	pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
-    }
+	worker_data_t	*wdp; // Pointer to a Worker Thread Data Struct
+
 
+	wdp = xdd_idle_worker_claim(tdp);
+
+	// Got a Worker Thread - mark it BUSY
+	pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+	wdp->wd_worker_thread_target_sync |= WTSYNC_BUSY; 
+	pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+
+	return(wdp);
 
-    return wdp;        
 } // End of xdd_get_any_available_worker_thread()
 
+/*----------------------------------------------------------------------------*/
+/* xdd_get_any_available_worker_thread_before_eof() - This is the Destination
+ * Side of an E2E operation version of xdd_get_any_available_worker_thread().
+ * A Worker Thread that has received its EOF packet from the Source Side is
+ * set aside rather than being assigned another task. Once every Worker
+ * Thread has received its EOF this returns 0 and puts all the Worker Threads
+ * back in the available Worker Thread map with their EOF flags cleared.
+ * This subroutine is called by xdd_targetpass_e2e_loop_dst()
+ */
+worker_data_t *
+xdd_get_any_available_worker_thread_before_eof(target_data_t *tdp) {
+	worker_data_t	*wdp; // Pointer to a Worker Thread Data Struct
+	int32_t			q;
+
+
+	while (tdp->td_idle_worker_eof_count < tdp->td_queue_depth) {
+		wdp = xdd_idle_worker_claim(tdp);
+
+		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+		if (wdp->wd_worker_thread_target_sync & WTSYNC_EOF_RECEIVED) {
+			// Leave this Worker Thread out of the map until all of them are done
+			pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+			tdp->td_idle_worker_eof_count++;
+			continue;
+		}
+		// Got a Worker Thread - mark it BUSY
+		wdp->wd_worker_thread_target_sync |= WTSYNC_BUSY; 
+		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+		return(wdp);
+	}
+
+	// All Worker Threads have received an EOF and are idle so this pass is
+	// over. Get them ready to receive data again on the next pass.
+	for (q = 0; q < tdp->td_queue_depth; q++) {
+		wdp = tdp->td_idle_worker_table[q];
+		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
+		wdp->wd_worker_thread_target_sync &= ~WTSYNC_EOF_RECEIVED;
+		__atomic_fetch_or(&tdp->td_idle_worker_map[q / 64], 1ULL << (q % 64), __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
+	}
+	tdp->td_idle_worker_eof_count = 0;
+	return(0);
+
+} // End of xdd_get_any_available_worker_thread_before_eof()
+
 /*
  * Local variables:
  *  indent-tabs-mode: t
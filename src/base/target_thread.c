@@ -88,6 +88,7 @@ xdd_target_thread(void *pin) {
 			if( tdp->td_restartp) {
 				pthread_mutex_lock(&tdp->td_restartp->restart_lock);
 				tdp->td_restartp->flags |= RESTART_FLAG_SUCCESSFUL_COMPLETION;
+				xdd_restart_journal_close(tdp);
 				if (tdp->td_restartp->fp) {
 					// Display an appropriate Successful Completion in the restart file and close it
 					// Seek to the beginning of the file 
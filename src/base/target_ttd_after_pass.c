@@ -30,7 +30,9 @@ xdd_target_ttd_after_pass(target_data_t *tdp) {
 
 	status = 0;
 	// Issue an fdatasync() to flush all the write buffers to disk for this file if the -syncwrite option was specified
-	if (tdp->td_target_options & TO_SYNCWRITE) {
+	if ((tdp->td_target_options & TO_SYNCWRITE) && (tdp->td_target_options & TO_STRIPE)) {
+		status = xdd_stripe_sync(tdp);
+	} else if (tdp->td_target_options & TO_SYNCWRITE) {
 #if (LINUX || AIX)
             status = fdatasync(tdp->td_file_desc);
 #else
@@ -55,10 +57,36 @@ xdd_target_ttd_after_pass(target_data_t *tdp) {
 			tdp->td_counters.tc_pass_end_time = wdp->wd_counters.tc_pass_end_time;
 		wdp = wdp->wd_next_wdp;
 	}
+
+	// Add up the counters and extended stats of all the Worker Threads
+	xdd_target_counters_sum(tdp, &tdp->td_counters);
+	tdp->td_counters.tc_current_error_count = tdp->td_counters.tc_accumulated_error_count;
+	tdp->td_current_bytes_completed = tdp->td_counters.tc_accumulated_bytes_xfered;
+	if (tdp->td_esp) {
+		wdp = tdp->td_next_wdp;
+		while (wdp) {
+			xdd_extended_stats_merge(tdp->td_esp, &wdp->wd_extended_stats);
+			wdp = wdp->wd_next_wdp;
+		}
+	}
+	// Merge the latency histograms of all the Worker Threads for this pass and the whole run
+	if (tdp->td_lathistp) {
+		xdd_latency_histogram_reset(tdp->td_lathistp);
+		wdp = tdp->td_next_wdp;
+		while (wdp) {
+			if (wdp->wd_lathistp)
+				xdd_latency_histogram_merge(tdp->td_lathistp, wdp->wd_lathistp);
+			wdp = wdp->wd_next_wdp;
+		}
+		if (tdp->td_lathist_runp)
+			xdd_latency_histogram_merge(tdp->td_lathist_runp, tdp->td_lathistp);
+	}
 	if (tdp->td_target_options & TO_ENDTOEND) { 
 		// Average the Send/Receive Time 
-		tdp->td_e2ep->e2e_sr_time /= tdp->td_queue_depth;
+		tdp->td_e2ep->e2e_sr_time = tdp->td_counters.tc_accumulated_sr_time / tdp->td_queue_depth;
 	}
+	// The last interval of this pass for -heartbeat timeseries
+	xdd_heartbeat_timeseries_pass_end(tdp);
 
 	return(status);
 } // End of xdd_target_ttd_after_pass()
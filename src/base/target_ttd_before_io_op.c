@@ -50,6 +50,7 @@ xdd_start_trigger_before_io_op(target_data_t *tdp) {
 	xint_triggers_t	*trigp1;
 	xint_triggers_t	*trigp2;
 	nclk_t			tt;	// Trigger Time
+	xint_target_counters_t	counters;	// The sum of the Worker Thread counters
 
 
 	/* Check to see if we need to wait for another target to trigger us to start.
@@ -88,10 +89,14 @@ xdd_start_trigger_before_io_op(target_data_t *tdp) {
 			}
 			if (trigp1->trigger_types & TRIGGER_STARTBYTES) {
 				/* If we have completed transferring the specified number of bytes, then signal the 
-				* specified target to start 
+				* specified target to start. No more bytes can have completed than were issued
+				* so the Worker Thread counters are only summed once enough have been issued.
 				*/
-				if (tdp->td_current_bytes_completed > trigp1->start_trigger_bytes) {
-					xdd_barrier(&trigp2->target_target_starttrigger_barrier,&tdp->td_occupant,0);
+				if (tdp->td_current_bytes_issued > trigp1->start_trigger_bytes) {
+					xdd_target_counters_sum(tdp, &counters);
+					if (counters.tc_accumulated_bytes_xfered > trigp1->start_trigger_bytes) {
+						xdd_barrier(&trigp2->target_target_starttrigger_barrier,&tdp->td_occupant,0);
+					}
 				}
 			}
 		}
@@ -181,6 +186,8 @@ xdd_runtime_before_io_op(target_data_t *tdp) {
 int32_t
 xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp) {
 	int32_t	status;	// Return status from various subroutines
+	seek_t	*seekp;	// The seek list entry for this operation
+	seek_t	seek_scratch;	// Generated seek list entry when there is no seek list
 
 	// Syncio barrier - wait for all others to get here 
 	xdd_syncio_before_io_op(tdp);
@@ -202,11 +209,10 @@ xdd_target_ttd_before_io_op(target_data_t *tdp, worker_data_t *wdp) {
 	errno = 0;
 	/* Get the location to seek to */
 	if (tdp->td_seekhdr.seek_options & SO_SEEK_NONE) /* reseek to starting offset if noseek is set */
-		tdp->td_counters.tc_current_byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + 
-											tdp->td_seekhdr.seeks[0].block_location) * 
-											tdp->td_block_size;
-	else tdp->td_counters.tc_current_byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + 
-											tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].block_location) * 
+		seekp = xdd_seek_entry(tdp, 0, &seek_scratch);
+	else seekp = xdd_seek_entry(tdp, tdp->td_counters.tc_current_op_number, &seek_scratch);
+	tdp->td_counters.tc_current_byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + 
+											seekp->block_location) * 
 											tdp->td_block_size;
 
 	if (xgp->global_options & GO_INTERACTIVE)	
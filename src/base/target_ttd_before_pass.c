@@ -209,20 +209,8 @@ xdd_init_target_data_before_pass(target_data_t *tdp) {
 	tdp->td_counters.tc_current_error_count = 0;		// The number of I/O errors for this Worker Thread
 	//
 	// Longest and shortest op times - RESET AT THE START OF EACH PASS
-	if (tdp->td_esp) {
-		tdp->td_esp->my_longest_op_time = 0;			// Longest op time that occured during this pass
-		tdp->td_esp->my_longest_op_number = 0; 		// Number of the operation where the longest op time occured during this pass
-		tdp->td_esp->my_longest_read_op_time = 0; 	// Longest read op time that occured during this pass
-		tdp->td_esp->my_longest_read_op_number = 0; 	// Number of the read operation where the longest op time occured during this pass
-		tdp->td_esp->my_longest_write_op_time = 0; 	// Longest write op time that occured during this pass
-		tdp->td_esp->my_longest_write_op_number = 0; 	// Number of the write operation where the longest op time occured during this pass
-		tdp->td_esp->my_shortest_op_time = NCLK_MAX; 	// Shortest op time that occurred during this pass
-		tdp->td_esp->my_shortest_op_number = 0; 		// Number of the operation where the shortest op time occured during this pass
-		tdp->td_esp->my_shortest_read_op_time = NCLK_MAX;	// Shortest read op time that occured during this pass
-		tdp->td_esp->my_shortest_read_op_number = 0; 	// Number of the read operation where the shortest op time occured during this pass
-		tdp->td_esp->my_shortest_write_op_time = NCLK_MAX;// Shortest write op time that occured during this pass
-		tdp->td_esp->my_shortest_write_op_number = 0;	// Number of the write operation where the shortest op time occured during this pass
-	}
+	if (tdp->td_esp)
+		xdd_extended_stats_reset(tdp->td_esp);
 
 	tdp->td_time_limit_expired = 0;		// The time limit expiration indicator
 	tdp->td_abort = 0;	
@@ -241,7 +229,10 @@ xdd_init_target_data_before_pass(target_data_t *tdp) {
 	} 
 
 	wdp = tdp->td_next_wdp;
-	while (wdp) { // Set up the pass_start_times for all the Worker Threads 
+	while (wdp) { // Set up the pass_start_times and reset the counters for all the Worker Threads 
+		xdd_worker_counters_reset(wdp);
+		if (wdp->wd_lathistp)
+			xdd_latency_histogram_reset(wdp->wd_lathistp);
 		wdp->wd_counters.tc_pass_start_time = tdp->td_counters.tc_pass_start_time;
 		if (tdp->td_counters.tc_pass_number == 1) 
 			times(&wdp->wd_counters.tc_starting_cpu_times_this_run);
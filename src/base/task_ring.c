@@ -0,0 +1,154 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that pass tasks from a Target Thread
+ * to a Worker Thread through the Worker Thread's task ring.
+ * The Target Thread is the only producer and the Worker Thread is the only
+ * consumer of a given ring so posting and taking a task only requires
+ * atomic loads and stores of the ring indices. The Worker Thread only
+ * enters the kernel when it has to sleep on an empty ring and the Target
+ * Thread only enters the kernel to wake a Worker Thread that is asleep.
+ */
+#include "xint.h"
+
+#if defined(LINUX)
+#include <linux/futex.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* xdd_task_ring_sleep() - Put the Worker Thread to sleep until tr_tail is no
+ * longer equal to the specified value. This may return early so the caller
+ * must check the ring again.
+ */
+static void
+xdd_task_ring_sleep(xint_task_ring_t *rp, uint32_t tail) {
+#if defined(LINUX)
+	syscall(SYS_futex, &rp->tr_tail, FUTEX_WAIT_PRIVATE, tail, NULL, NULL, 0);
+#else
+	pthread_mutex_lock(&rp->tr_mutex);
+	while (__atomic_load_n(&rp->tr_tail, __ATOMIC_SEQ_CST) == tail)
+		pthread_cond_wait(&rp->tr_cond, &rp->tr_mutex);
+	pthread_mutex_unlock(&rp->tr_mutex);
+#endif
+} // End of xdd_task_ring_sleep()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_task_ring_wake() - Wake up the Worker Thread sleeping on this ring
+ */
+static void
+xdd_task_ring_wake(xint_task_ring_t *rp) {
+#if defined(LINUX)
+	syscall(SYS_futex, &rp->tr_tail, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+	pthread_mutex_lock(&rp->tr_mutex);
+	pthread_cond_signal(&rp->tr_cond);
+	pthread_mutex_unlock(&rp->tr_mutex);
+#endif
+} // End of xdd_task_ring_wake()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_task_ring_init() - Initialize the task ring for a Worker Thread
+ * This is called by xdd_worker_thread_init().
+ * Return values: 0 is good, -1 indicates an error
+ */
+int32_t
+xdd_task_ring_init(worker_data_t *wdp) {
+	xint_task_ring_t	*rp;
+
+
+	rp = &wdp->wd_task_ring;
+	memset(rp, 0, sizeof(xint_task_ring_t));
+	rp->tr_spin = wdp->wd_tdp->td_task_ring_spin;
+#if !defined(LINUX)
+	if (pthread_mutex_init(&rp->tr_mutex, 0) || pthread_cond_init(&rp->tr_cond, 0)) {
+		fprintf(xgp->errout,"%s: xdd_task_ring_init: Target %d WorkerThread %d: ERROR: Cannot initialize the task ring mutex/condition variable\n",
+			xgp->progname,
+			wdp->wd_tdp->td_target_number,
+			wdp->wd_worker_number);
+		return(-1);
+	}
+#endif
+	return(0);
+
+} // End of xdd_task_ring_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_task_ring_post() - Called by the Target Thread to post a copy of the
+ * specified task to a Worker Thread. If the ring is full then this will
+ * wait for the Worker Thread to take a task off of the ring.
+ */
+void
+xdd_task_ring_post(worker_data_t *wdp, xint_task_t *taskp) {
+	xint_task_ring_t	*rp;
+	uint32_t			tail;
+
+
+	rp = &wdp->wd_task_ring;
+	tail = rp->tr_tail;
+	while ((tail - __atomic_load_n(&rp->tr_head, __ATOMIC_ACQUIRE)) >= XINT_TASK_RING_ENTRIES)
+		sched_yield();
+
+	rp->tr_task[tail & XINT_TASK_RING_MASK] = *taskp;
+
+	// The store of tr_tail and the load of tr_sleeping must not be reordered
+	// or a Worker Thread that is just going to sleep could miss this task
+	__atomic_store_n(&rp->tr_tail, tail + 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&rp->tr_sleeping, __ATOMIC_SEQ_CST))
+		xdd_task_ring_wake(rp);
+
+} // End of xdd_task_ring_post()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_task_ring_get() - Called by a Worker Thread to wait for the next task
+ * on its ring. The task is copied into wd_task.
+ */
+void
+xdd_task_ring_get(worker_data_t *wdp) {
+	xint_task_ring_t	*rp;
+	uint32_t			head;
+	int32_t				spin;
+
+
+	rp = &wdp->wd_task_ring;
+	head = rp->tr_head;
+	spin = rp->tr_spin;
+	while (__atomic_load_n(&rp->tr_tail, __ATOMIC_ACQUIRE) == head) {
+		if (spin > 0) {
+			spin--;
+			continue;
+		}
+		__atomic_or_fetch(&wdp->wd_current_state, WORKER_CURRENT_STATE_WAITING_FOR_TASK, __ATOMIC_RELAXED);
+
+		__atomic_store_n(&rp->tr_sleeping, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&rp->tr_tail, __ATOMIC_SEQ_CST) == head)
+			xdd_task_ring_sleep(rp, head);
+		__atomic_store_n(&rp->tr_sleeping, 0, __ATOMIC_RELAXED);
+
+		__atomic_and_fetch(&wdp->wd_current_state, ~WORKER_CURRENT_STATE_WAITING_FOR_TASK, __ATOMIC_RELAXED);
+	}
+
+	wdp->wd_task = rp->tr_task[head & XINT_TASK_RING_MASK];
+	__atomic_store_n(&rp->tr_head, head + 1, __ATOMIC_RELEASE);
+
+} // End of xdd_task_ring_get()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -26,60 +26,148 @@ xdd_verify_checksum(worker_data_t *wdp, int64_t current_op) {
 } // end of xdd_verify_checksum()
 
 /*----------------------------------------------------------------------------*/
-/* xdd_Verify_hex() - Verify hex data pattern in the data buffer  
- * Returns the number of miscompare errors.
- * This routine assumes that the specified hex data pattern and replication 
- * factor has been previously written to the media that was just read and 
- * is being verified. 
- * It is further assumed that the data pattern and data pattern lenggth
- * are in tdp->td_dpp->data_pattern and tdp->td_dpp->data_pattern_length respectively. This is
- * done by the datapattern function in the parse.c file. If the data_pattern_option
- * of "DP_REPLICATE_PATTERN" was specified as well, then the data comparison is
- * made throughout the data buffer. Otherwise only the first N bytes are compared
- * against the data pattern where N is equal to tdp->td_dpp->data_pattern_length. Cool, huh?
+/* Data verification kernels
+ * Each kernel returns the index of the first element of the buffer that is
+ * not what was expected, or the number of elements if they all are. There is
+ * a portable version of each kernel and, on x86 processors, AVX2 and AVX-512
+ * versions that are selected at run time by xdd_verify_select_kernels().
+ * The kernels only find mismatches - xdd_verify_sequence() and 
+ * xdd_verify_bytes() work out and report the extent of each mismatch.
  */
-int32_t
-xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
-	target_data_t	*tdp;
-	size_t i;
-	int32_t errors;
-	int32_t remaining;
-	int32_t offset;
-	unsigned char *patternp, *bufferp;
+typedef size_t (*xdd_verify_sequence_func_t)(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert);
+typedef size_t (*xdd_verify_bytes_func_t)(unsigned char *bufp, unsigned char *expectedp, size_t length);
+
+/* Word "j" of a sequenced pattern is its byte offset OR'd with the prefix 
+ * and then XOR'd with "invert" which is either 0 or all ones 
+ */
+#define XDD_VERIFY_SEQUENCE_WORD(_offset, _j, _prefix, _invert) ((((_offset) + ((_j) * sizeof(uint64_t))) | (_prefix)) ^ (_invert))
 
+static size_t
+xdd_verify_sequence_generic(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	size_t		j;
 
-	tdp = wdp->wd_tdp;
 
-	if (tdp->td_dpp->data_pattern_options & DP_REPLICATE_PATTERN) 
-		remaining = wdp->wd_task.task_xfer_size;
-	else remaining = tdp->td_dpp->data_pattern_length;
+	for (j = 0; j < words; j++)
+		if (bufp[j] != XDD_VERIFY_SEQUENCE_WORD(offset, j, prefix, invert))
+			break;
+	return(j);
+} // End of xdd_verify_sequence_generic()
 
-	offset = 0;
-	bufferp = wdp->wd_task.task_datap;
-	errors = 0;
-	while (remaining) {
-		patternp = tdp->td_dpp->data_pattern;
-		for (i=0; i<tdp->td_dpp->data_pattern_length; i++, patternp++, bufferp++) {
-			if (*patternp != *bufferp) {
-				fprintf(xgp->errout,"%s: xdd_verify_hex: Target %d Worker Thread %d: ERROR: Content mismatch on op %lld at %d bytes into block %lld, expected 0x%02x, got 0x%02x\n",
-					xgp->progname, 
-					tdp->td_target_number, 
-					wdp->wd_worker_number, 
-					(long long int)current_op,
-					offset, 
-					(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
-					*patternp, 
-					*bufferp);
+static size_t
+xdd_verify_bytes_generic(unsigned char *bufp, unsigned char *expectedp, size_t length) {
+	uint64_t	a, b;
+	size_t		i;
 
-				errors++;
-			}
-			offset++;
-			remaining--;
-			if (remaining <= 0) break;
-		}
+
+	// Compare a word at a time and then find the byte within the word
+	for (i = 0; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+		memcpy(&a, bufp + i, sizeof(uint64_t));
+		memcpy(&b, expectedp + i, sizeof(uint64_t));
+		if (a != b)
+			break;
 	}
-	return(errors);
-} // end of xdd_verify_hex()
+	for (; i < length; i++)
+		if (bufp[i] != expectedp[i])
+			break;
+	return(i);
+} // End of xdd_verify_bytes_generic()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define XDD_VERIFY_X86_KERNELS
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) static size_t
+xdd_verify_sequence_avx2(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	__m256i		v, w, step, pre, inv;
+	size_t		j;
+
+
+	v = _mm256_set_epi64x(offset+24, offset+16, offset+8, offset);
+	step = _mm256_set1_epi64x(4 * sizeof(uint64_t));
+	pre = _mm256_set1_epi64x(prefix);
+	inv = _mm256_set1_epi64x(invert);
+	for (j = 0; j + 4 <= words; j += 4) {
+		w = _mm256_xor_si256(_mm256_or_si256(v, pre), inv);
+		w = _mm256_xor_si256(w, _mm256_loadu_si256((__m256i *)&bufp[j]));
+		if (!_mm256_testz_si256(w, w))
+			break;
+		v = _mm256_add_epi64(v, step);
+	}
+	return(j + xdd_verify_sequence_generic(&bufp[j], words - j, offset + (j * sizeof(uint64_t)), prefix, invert));
+} // End of xdd_verify_sequence_avx2()
+
+__attribute__((target("avx2"))) static size_t
+xdd_verify_bytes_avx2(unsigned char *bufp, unsigned char *expectedp, size_t length) {
+	__m256i		a, b;
+	uint32_t	mask;
+	size_t		i;
+
+
+	for (i = 0; i + 32 <= length; i += 32) {
+		a = _mm256_loadu_si256((__m256i *)(bufp + i));
+		b = _mm256_loadu_si256((__m256i *)(expectedp + i));
+		mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+		if (mask)
+			return(i + __builtin_ctz(mask));
+	}
+	return(i + xdd_verify_bytes_generic(bufp + i, expectedp + i, length - i));
+} // End of xdd_verify_bytes_avx2()
+
+__attribute__((target("avx512f"))) static size_t
+xdd_verify_sequence_avx512(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	__m512i		v, w, step, pre, inv;
+	__mmask8	mask;
+	size_t		j;
+
+
+	v = _mm512_set_epi64(offset+56, offset+48, offset+40, offset+32, offset+24, offset+16, offset+8, offset);
+	step = _mm512_set1_epi64(8 * sizeof(uint64_t));
+	pre = _mm512_set1_epi64(prefix);
+	inv = _mm512_set1_epi64(invert);
+	for (j = 0; j + 8 <= words; j += 8) {
+		w = _mm512_xor_si512(_mm512_or_si512(v, pre), inv);
+		mask = _mm512_cmpneq_epu64_mask(w, _mm512_loadu_si512((void *)&bufp[j]));
+		if (mask)
+			return(j + __builtin_ctz(mask));
+		v = _mm512_add_epi64(v, step);
+	}
+	return(j + xdd_verify_sequence_generic(&bufp[j], words - j, offset + (j * sizeof(uint64_t)), prefix, invert));
+} // End of xdd_verify_sequence_avx512()
+
+__attribute__((target("avx512f,avx512bw"))) static size_t
+xdd_verify_bytes_avx512(unsigned char *bufp, unsigned char *expectedp, size_t length) {
+	__mmask64	mask;
+	size_t		i;
+
+
+	for (i = 0; i + 64 <= length; i += 64) {
+		mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void *)(bufp + i)), _mm512_loadu_si512((void *)(expectedp + i)));
+		if (mask)
+			return(i + __builtin_ctzll(mask));
+	}
+	return(i + xdd_verify_bytes_generic(bufp + i, expectedp + i, length - i));
+} // End of xdd_verify_bytes_avx512()
+#endif
+
+static pthread_once_t				xdd_verify_kernels_once = PTHREAD_ONCE_INIT;
+static xdd_verify_sequence_func_t	xdd_verify_sequence_kernel = xdd_verify_sequence_generic;
+static xdd_verify_bytes_func_t		xdd_verify_bytes_kernel = xdd_verify_bytes_generic;
+
+static void
+xdd_verify_select_kernels(void) {
+#if defined(XDD_VERIFY_X86_KERNELS)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		xdd_verify_sequence_kernel = xdd_verify_sequence_avx2;
+		xdd_verify_bytes_kernel = xdd_verify_bytes_avx2;
+	}
+	if (__builtin_cpu_supports("avx512f"))
+		xdd_verify_sequence_kernel = xdd_verify_sequence_avx512;
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+		xdd_verify_bytes_kernel = xdd_verify_bytes_avx512;
+#endif
+} // End of xdd_verify_select_kernels()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_sequence() - Verify data contents  of a sequenced data pattern 
  * Returns the number of miscompare errors.
@@ -91,102 +179,234 @@ xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
  * For example, if the prefix is 0x0123 then the hex representation of the sequenced data pattern would look like so:
  *      0123000000000000 0123000000000008 0123000000000010 0123000000000018...
  * Keep in mind that this example is shown in BIG endian so as not to confuse myself.
+ * Each run of consecutive 8-byte words that are wrong is reported once along with
+ * the byte offset that the first wrong word would have been written to if it is 
+ * part of a sequenced data pattern - stale or misplaced data shows up that way.
  */
 int32_t
 xdd_verify_sequence(worker_data_t *wdp, int64_t current_op) {
 	target_data_t	*tdp;
 	size_t  		i,j;
-	uint64_t	  		errors;
-	uint64_t 		expected_data;
+	size_t			words;		// Number of 8-byte words in the buffer
+	uint64_t	  	errors;		// Number of 8-byte words that are wrong
+	uint64_t	  	ranges;		// Number of runs of 8-byte words that are wrong
+	uint64_t 		offset;		// Byte offset of the first word of the buffer
+	uint64_t 		prefix;		// Data pattern prefix
+	uint64_t 		invert;		// All ones for an inverse data pattern
+	uint64_t 		found;		// First wrong word of a range with the pattern removed
 	uint64_t 		*uint64p;
-	unsigned char 	*ucp;        /* A temporary unsigned char pointer */
  
 
 	tdp = wdp->wd_tdp;
+	pthread_once(&xdd_verify_kernels_once, xdd_verify_select_kernels);
 
 	uint64p = (uint64_t *)wdp->wd_task.task_datap;
+	words = wdp->wd_task.task_xfer_size / sizeof(uint64_t);
+	offset = wdp->wd_task.task_byte_offset;
+	if (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) // OR-in the pattern prefix
+		prefix = tdp->td_dpp->data_pattern_prefix_binary;
+	else prefix = 0;
+	if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
+		invert = 0xffffffffffffffffULL; // 1's compliment of the expected data 
+	else invert = 0;
+
 	errors = 0;
-	for (i = 0; i < wdp->wd_task.task_xfer_size; i+=(sizeof(wdp->wd_task.task_byte_offset))) {
-		expected_data = wdp->wd_task.task_byte_offset + i;
-		if (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) { // OR-in the pattern prefix
-			expected_data |= tdp->td_dpp->data_pattern_prefix_binary;
-		} 
-		if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
-			expected_data ^= 0xffffffffffffffffLL; // 1's compliment of the expected data 
-
-		if (*uint64p != expected_data) { // If the expected_data pattern is not what we think it should be then scream!
-			//Check how many errors we've had, if too many, then don't print data
-			if (errors <= xgp->max_errors_to_print) {
-				fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: Sequence mismatch on op number %lld at %zd bytes into block %lld\n",
+	ranges = 0;
+	i = 0;
+	while (i < words) {
+		i += xdd_verify_sequence_kernel(&uint64p[i], words - i, offset + (i * sizeof(uint64_t)), prefix, invert);
+		if (i >= words) 
+			break;
+		// Find the end of this run of wrong words
+		for (j = i + 1; j < words; j++)
+			if (uint64p[j] == XDD_VERIFY_SEQUENCE_WORD(offset, j, prefix, invert))
+				break;
+		errors += (j - i);
+		ranges++;
+		//Check how many errors we've had, if too many, then don't print data
+		if (ranges <= xgp->max_errors_to_print) {
+			// It only looks like sequenced data from somewhere else if the word is 
+			// 8-byte aligned and the next word is wrong too and follows on from it
+			found = uint64p[i] ^ invert;
+			if (((found & prefix) == prefix) && 
+				(((found & ~prefix) % sizeof(uint64_t)) == 0) &&
+				(j > i + 1) && ((uint64p[i+1] ^ invert) == (((found & ~prefix) + sizeof(uint64_t)) | prefix))) {
+				fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: Sequence mismatch on op number %lld: bytes %zd-%zd wrong at byte offset %llu, looks like data from byte offset %llu\n",
 					xgp->progname, 
 					tdp->td_target_number, 
 					wdp->wd_worker_number, 
 					(long long int)current_op,
-					i, 
-					(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size));
-
-				fprintf(xgp->errout, "expected 0x");
-				for (j=0, ucp=(unsigned char *)&expected_data; j<sizeof(uint64_t); j++, ucp++) {
-					fprintf(xgp->errout, "%02x",*ucp);
-				}
-				fprintf(xgp->errout, ", got 0x");
-				for (j=0, ucp=(unsigned char *)uint64p; j<sizeof(uint64_t); j++, ucp++) {
-					fprintf(xgp->errout, "%02x",*ucp);
-				}
-				fprintf(xgp->errout, "\n");
+					i * sizeof(uint64_t),
+					(j * sizeof(uint64_t)) - 1,
+					(unsigned long long)(offset + (i * sizeof(uint64_t))),
+					(unsigned long long)(found & ~prefix));
+			} else {
+				fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: Sequence mismatch on op number %lld: bytes %zd-%zd wrong at byte offset %llu, expected 0x%016llx, got 0x%016llx\n",
+					xgp->progname, 
+					tdp->td_target_number, 
+					wdp->wd_worker_number, 
+					(long long int)current_op,
+					i * sizeof(uint64_t),
+					(j * sizeof(uint64_t)) - 1,
+					(unsigned long long)(offset + (i * sizeof(uint64_t))),
+					(unsigned long long)XDD_VERIFY_SEQUENCE_WORD(offset, i, prefix, invert),
+					(unsigned long long)uint64p[i]);
 			}
-			errors++;
 		}
-		uint64p++;
-	} // end of FOR loop that looks at all locations 
+		i = j;
+	} // end of WHILE loop that looks at all locations 
 	//print out remaining error count if exceeded max
-    if (errors > xgp->max_errors_to_print) {
+    if (ranges > xgp->max_errors_to_print) {
 		fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: ADDITIONAL Data Buffer Content mismatches = %lld\n",
 			    xgp->progname, 
 				tdp->td_target_number, 
 				wdp->wd_worker_number, 
-				(long long int)(errors - (xgp->max_errors_to_print)));
+				(long long int)(ranges - (xgp->max_errors_to_print)));
 	}
 	return(errors);
 } // end of xdd_verify_sequence() 
 
 /*----------------------------------------------------------------------------*/
-/* xdd_verify_singlechar() - Verify data contents of a single character data pattern 
- * Returns the number of miscompare errors. 
- * The single-byte data pattern is specified simply by giving the -datapattern a single character to write to the device. 
- * If that same character is specified for a read operation with the -verify option then that character will be compared with the
- * contents of the I/O buffer for every block read.
+/* xdd_verify_bytes() - Compare the I/O buffer against the expected contents
+ * Returns the number of bytes that are wrong.
+ * Wrong bytes that are less than XDD_VERIFY_RANGE_GAP bytes apart are 
+ * reported as one range so that a bad block is one message rather than 
+ * one message for every byte that happens to differ.
  */
-int32_t
-xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
+#define XDD_VERIFY_RANGE_GAP	64
+static int32_t
+xdd_verify_bytes(worker_data_t *wdp, int64_t current_op, char *caller, unsigned char *expectedp, size_t length) {
 	target_data_t	*tdp;
-	size_t  i;
-	int32_t  errors;
-	unsigned char *ucp;
- 
+	size_t  		i,j;
+	size_t			last;		// Last wrong byte of a range
+	int32_t  		errors;		// Number of bytes that are wrong
+	int64_t			ranges;		// Number of ranges of bytes that are wrong
+	unsigned char 	*bufferp;
+
 
 	tdp = wdp->wd_tdp;
+	pthread_once(&xdd_verify_kernels_once, xdd_verify_select_kernels);
 
-	ucp = wdp->wd_task.task_datap;
+	bufferp = wdp->wd_task.task_datap;
 	errors = 0;
-	for (i = 0; i < wdp->wd_task.task_xfer_size; i++) {
-		if (*ucp != *(tdp->td_dpp->data_pattern)) {
-			fprintf(xgp->errout,"%s: xdd_verify_singlechar: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld at %zd bytes into block %lld, expected 0x%02x, got 0x%02x\n",
+	ranges = 0;
+	i = 0;
+	while (i < length) {
+		i += xdd_verify_bytes_kernel(bufferp + i, expectedp + i, length - i);
+		if (i >= length)
+			break;
+		// Find the end of this range of wrong bytes
+		last = i;
+		errors++;
+		for (j = i + 1; (j < length) && ((j - last) < XDD_VERIFY_RANGE_GAP); j++) {
+			if (bufferp[j] != expectedp[j]) {
+				last = j;
+				errors++;
+			}
+		}
+		ranges++;
+		if (ranges <= (int64_t)xgp->max_errors_to_print) {
+			fprintf(xgp->errout,"%s: %s: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld: bytes %zd-%zd wrong at byte offset %llu, expected 0x%02x, got 0x%02x\n",
 				xgp->progname, 
+				caller,
 				tdp->td_target_number, 
 				wdp->wd_worker_number, 
 				(long long int)current_op,
 				i, 
-				(unsigned long long)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
-				*(tdp->td_dpp->data_pattern), 
-				*ucp);
-		errors++;
-		} /* End printing error message */
-		ucp++;
-	} // end of FOR statement that looks at all bytes
-
+				last, 
+				(unsigned long long)(wdp->wd_task.task_byte_offset + i), 
+				expectedp[i], 
+				bufferp[i]);
+		}
+		i = last + 1;
+	}
+    if (ranges > (int64_t)xgp->max_errors_to_print) {
+		fprintf(xgp->errout,"%s: %s: Target %d Worker Thread %d: ERROR: ADDITIONAL Data Buffer Content mismatches = %lld\n",
+			    xgp->progname, 
+				caller,
+				tdp->td_target_number, 
+				wdp->wd_worker_number, 
+				(long long int)(ranges - (xgp->max_errors_to_print)));
+	}
 	return(errors);
+} // end of xdd_verify_bytes()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_expected_buffer() - Return the buffer that holds what a 
+ * single-character, hex, or ascii data pattern should look like for this
+ * Worker Thread. The buffer is built the first time it is needed.
+ */
+static unsigned char *
+xdd_verify_expected_buffer(worker_data_t *wdp) {
+	target_data_t	*tdp;
+
+
+	tdp = wdp->wd_tdp;
+	if (wdp->wd_verify_bufp)
+		return(wdp->wd_verify_bufp);
+	wdp->wd_verify_bufp = (unsigned char *)malloc(tdp->td_xfer_size);
+	if (wdp->wd_verify_bufp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_verify_expected_buffer: Target %d Worker Thread %d: ERROR: Cannot allocate %d bytes for the expected data pattern - No verification performed.\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			tdp->td_xfer_size);
+		return(NULL);
+	}
+	if (tdp->td_dpp->data_pattern_options & DP_SINGLECHAR_PATTERN)
+		xdd_datapattern_replicate(wdp->wd_verify_bufp, tdp->td_xfer_size, tdp->td_dpp->data_pattern, 1);
+	else xdd_datapattern_replicate(wdp->wd_verify_bufp, tdp->td_xfer_size, tdp->td_dpp->data_pattern, tdp->td_dpp->data_pattern_length);
+	return(wdp->wd_verify_bufp);
+} // end of xdd_verify_expected_buffer()
 
+/*----------------------------------------------------------------------------*/
+/* xdd_Verify_hex() - Verify hex data pattern in the data buffer  
+ * Returns the number of miscompare errors.
+ * This routine assumes that the specified hex data pattern and replication 
+ * factor has been previously written to the media that was just read and 
+ * is being verified. 
+ * It is further assumed that the data pattern and data pattern lenggth
+ * are in tdp->td_dpp->data_pattern and tdp->td_dpp->data_pattern_length respectively. This is
+ * done by the datapattern function in the parse.c file. If the data_pattern_option
+ * of "DP_REPLICATE_PATTERN" was specified as well, then the data comparison is
+ * made throughout the data buffer. Otherwise only the first N bytes are compared
+ * against the data pattern where N is equal to tdp->td_dpp->data_pattern_length. Cool, huh?
+ * An ascii data pattern is verified the same way.
+ */
+int32_t
+xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
+	target_data_t	*tdp;
+	size_t			length;
+	unsigned char	*expectedp;
+
+
+	tdp = wdp->wd_tdp;
+	expectedp = xdd_verify_expected_buffer(wdp);
+	if (expectedp == NULL)
+		return(0);
+
+	length = wdp->wd_task.task_xfer_size;
+	if (!(tdp->td_dpp->data_pattern_options & DP_REPLICATE_PATTERN) && (tdp->td_dpp->data_pattern_length < length))
+		length = tdp->td_dpp->data_pattern_length;
+	return(xdd_verify_bytes(wdp, current_op, "xdd_verify_hex", expectedp, length));
+} // end of xdd_verify_hex()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_singlechar() - Verify data contents of a single character data pattern 
+ * Returns the number of miscompare errors. 
+ * The single-byte data pattern is specified simply by giving the -datapattern a single character to write to the device. 
+ * If that same character is specified for a read operation with the -verify option then that character will be compared with the
+ * contents of the I/O buffer for every block read.
+ */
+int32_t
+xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
+	unsigned char	*expectedp;
+ 
+
+	expectedp = xdd_verify_expected_buffer(wdp);
+	if (expectedp == NULL)
+		return(0);
+	return(xdd_verify_bytes(wdp, current_op, "xdd_verify_singlechar", expectedp, wdp->wd_task.task_xfer_size));
 } // end of xdd_verify_singlechar() 
 
 /*----------------------------------------------------------------------------*/
@@ -213,7 +433,7 @@ xdd_verify_contents(worker_data_t *wdp, int64_t current_op) {
 		return(errors);
 	}
 
-	if (tdp->td_dpp->data_pattern_options & DP_HEX_PATTERN) { // Lets look at a HEX data pattern
+	if (tdp->td_dpp->data_pattern_options & (DP_HEX_PATTERN | DP_ASCII_PATTERN)) { // Lets look at a HEX or ASCII data pattern
 		errors = xdd_verify_hex(wdp, current_op);
 		return(errors);
 	}
@@ -236,7 +456,7 @@ xdd_verify_contents(worker_data_t *wdp, int64_t current_op) {
 /* xdd_verify_location() - Verify data location 
  * This routine gets the current bytes location that is located in the first
  * 8-bytes of the rw buffer and compares it to the current byte location that
- * the calling routine specified in the worker_data_t->my_current_byte_location. If the
+ * the calling routine specified in the task for this Worker Thread. If the
  * two do not match then we are not in Kansas anymore. Print an error message
  * and return a 1. Otherwise, everything is peachy, simply return a 0.
  * Returns the number of miscompare errors - 0 or 1 in this case.
@@ -251,14 +471,14 @@ xdd_verify_location(worker_data_t *wdp, int64_t current_op) {
 
 	errors = 0;
 	current_position = *(uint64_t *)wdp->wd_task.task_datap;
-	if (current_position != tdp->td_counters.tc_current_byte_offset) {
+	if (current_position != (uint64_t)wdp->wd_task.task_byte_offset) {
 		errors++;
 		fprintf(xgp->errout,"%s: xdd_verify_location: Target %d Worker Thread %d: ERROR: op number %lld: Data Buffer Sequence mismatch - expected %lld, got %lld\n",
 			xgp->progname, 
 			tdp->td_target_number, 
 			wdp->wd_worker_number, 
-			(long long int)tdp->td_counters.tc_current_op_number, 
-			(long long int)tdp->td_counters.tc_current_byte_offset, 
+			(long long int)current_op, 
+			(long long int)wdp->wd_task.task_byte_offset, 
 			(long long int)current_position);
 
 		fflush(xgp->errout);
@@ -297,5 +517,40 @@ xdd_verify(worker_data_t *wdp, int64_t current_op) {
 
 	return(errors);
 } /* End of xdd_verify() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_after_io_op() - Verify the data that was just read if -verify 
+ * was specified. This is called for every I/O right after the Worker Thread's 
+ * local counters are updated so that a miscompare is counted as an error for 
+ * this operation the same way an I/O error is. It is called for both the 
+ * synchronous I/O path and the asynchronous I/O engines.
+ * 
+ * This subroutine is called within the context of a Worker Thread or, for 
+ * the asynchronous I/O engines, the Target Thread that reaped the operation.
+ */
+void
+xdd_verify_after_io_op(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	int32_t			errors;
+
+
+	tdp = wdp->wd_tdp;
+	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)))
+		return;
+	if ((wdp->wd_task.task_op_type != TASK_OP_TYPE_READ) || 
+		(wdp->wd_task.task_io_status != (ssize_t)wdp->wd_task.task_xfer_size))
+		return;
+
+	errors = xdd_verify(wdp, wdp->wd_task.task_op_number);
+	if (errors == 0)
+		return;
+
+	__atomic_add_fetch(&tdp->td_dpp->data_pattern_compare_errors, errors, __ATOMIC_RELAXED);
+	wdp->wd_counters.tc_current_error_count = 1;
+	wdp->wd_counters.tc_accumulated_error_count++;
+	tdp->td_planp->target_errno[tdp->td_target_number] = XDD_RETURN_VALUE_IOERROR;
+	if (xgp->global_options & GO_STOP_ON_ERROR)
+		tdp->td_abort = 1;
+} // End of xdd_verify_after_io_op()
  
  
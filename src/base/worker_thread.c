@@ -57,9 +57,9 @@ xdd_worker_thread(void *pin) {
 	// indicate that there was a condition that warrants canceling the entire run
 	while (1) {
 		status = 0;
-		// Enter the WorkerThread_TargetPass_Wait barrier until we are assigned something to do by targetpass()
+		// Wait on the task ring until we are assigned something to do by targetpass()
 		nclk_now(&checktime);
-		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&wdp->wd_occupant,1);
+		xdd_task_ring_get(wdp);
 
 		// Look at Task request 
 		switch (wdp->wd_task.task_request) {
@@ -115,44 +115,12 @@ xdd_worker_thread(void *pin) {
 //			p->ttp->tte[wdp->tsp->ts_current_entry].nivcsw = usage.ru_nivcsw;
 //		}
 
-		// Mark this WorkerThread Available
-		pthread_mutex_lock(&wdp->wd_worker_thread_target_sync_mutex);
-		nclk_now(&checktime);
-		wdp->wd_worker_thread_target_sync &= ~WTSYNC_BUSY; // Mark this WorkerThread NOT Busy
-		if (wdp->wd_worker_thread_target_sync & WTSYNC_TARGET_WAITING) {
-		    // Release the target that is waiting on this WorkerThread
-		    //status = sem_post(&wdp->this_worker_thread_is_available_sem);
-		    status = pthread_cond_broadcast(&wdp->wd_this_worker_thread_is_available_condition);
-		    if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread: Target %d WorkerThread %d: WARNING: Bad status from sem_post on this_worker_thread_is_available semaphore: status=%d, errno=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno);
-		    }
-			// Turn off the TARGET_WAITING Flag
-			wdp->wd_worker_thread_target_sync &= ~WTSYNC_TARGET_WAITING; 
-		}
+		// Let the timestamp stream have the entry for this task
+		xdd_ts_entry_done(wdp);
 
+		// Mark this WorkerThread Available
 		nclk_now(&checktime);
-		
-		// Unlock the worker_thread-target synchronization mutex
-		pthread_mutex_unlock(&wdp->wd_worker_thread_target_sync_mutex);
-
-		// Release the WorkerThread Locator which might be waiting for ANY available WorkerThread
-		pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
-		tdp->td_any_worker_thread_available++;
-		status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
-		pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
-		if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread: Target %d WorkerThread %d: WARNING: Bad status from sem_post on sem_any_worker_thread_available semaphore: status=%d, errno=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno);
-		}
+		xdd_worker_thread_make_available(wdp);
 
 	} // end of WHILE loop 
 
@@ -17,7 +17,13 @@
  */
 void
 xdd_worker_thread_cleanup(worker_data_t *wdp) {
-    return;
+
+	// Close the pipe used for End-to-End zero copy
+	if ((wdp->wd_e2ep) && (wdp->wd_e2ep->e2e_pipe_size)) {
+		close(wdp->wd_e2ep->e2e_pipe[0]);
+		close(wdp->wd_e2ep->e2e_pipe[1]);
+		wdp->wd_e2ep->e2e_pipe_size = 0;
+	}
 } // End of xdd_worker_thread_cleanup()
 
 /*
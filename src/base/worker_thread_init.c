@@ -26,7 +26,6 @@ int32_t
 xdd_worker_thread_init(worker_data_t *wdp) {
     int32_t  		status;
     target_data_t	*tdp;			// Pointer to this worker_thread's target Data Struct
-    char			tmpname[XDD_BARRIER_MAX_NAME_LENGTH];	// Used to create unique names for the barriers
 	unsigned char	*bufp;		// Generic Buffer pointer
 
 #if defined(HAVE_CPUSET_T) && defined(HAVE_PTHREAD_ATTR_SETAFFINITY_NP)
@@ -91,19 +90,6 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 		return(-1);
 	}
 	
-	// Initialize the tot_wait structure 
-	status = pthread_cond_init(&wdp->wd_tot_wait.totw_condition, 0);
-	if (0 != status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: ERROR: Failed to initialize tot condition variable\n",
-			xgp->progname,
-			tdp->td_target_number,
-			wdp->wd_worker_number);
-		return(-1);
-	}
-	wdp->wd_tot_wait.totw_wdp = wdp;
-	wdp->wd_tot_wait.totw_is_released = 0;
-	wdp->wd_tot_wait.totw_nextp = 0;
-
 	// Get the I/O buffer
 	// The xdd_init_io_buffers() routine will set wd_bufp and wd_buf_size to appropriate values.
 	// The size of the buffer depends on whether it is being used for network
@@ -168,14 +154,9 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 	// Set proper data pattern in Data buffer
 	xdd_datapattern_buffer_init(wdp);
 
-	// Init the WorkerThread-TargetPass WAIT Barrier for this WorkerThread
-	sprintf(tmpname,"T%04d:W%04d>worker_thread_targetpass_wait_barrier",tdp->td_target_number,wdp->wd_worker_number);
-	status = xdd_init_barrier(tdp->td_planp, &wdp->wd_thread_targetpass_wait_for_task_barrier, 2, tmpname);
+	// Init the task ring where this WorkerThread waits for targetpass() to post a task
+	status = xdd_task_ring_init(wdp);
 	if (status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: ERROR: Cannot initialize WorkerThread TargetPass WAIT barrier.\n",
-			xgp->progname, 
-			tdp->td_target_number,
-			wdp->wd_worker_number);
 		fflush(xgp->errout);
 		return(-1);
 	}
@@ -192,18 +173,7 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 	}
 
 	// Indicate to the Target Thread that this WorkerThread is available
-	pthread_mutex_lock(&tdp->td_any_worker_thread_available_mutex);
-	tdp->td_any_worker_thread_available++;
-	status = pthread_cond_broadcast(&tdp->td_any_worker_thread_available_condition);
-	pthread_mutex_unlock(&tdp->td_any_worker_thread_available_mutex);
-	if (status) {
-		fprintf(xgp->errout,"%s: xdd_worker_thread_init: Target %d WorkerThread %d: WARNING: Bad status from sem_post on any_worker_thread_available semaphore: status=%d, errno=%d\n",
-			xgp->progname,
-			tdp->td_target_number,
-			wdp->wd_worker_number,
-			status,
-			errno);
-	}
+	xdd_worker_thread_make_available(wdp);
 
 	// Set up for an End-to-End operation (if requested)
 	if (tdp->td_target_options & TO_ENDTOEND) {
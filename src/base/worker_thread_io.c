@@ -105,8 +105,8 @@ xdd_worker_thread_io(worker_data_t *wdp) {
 	// Update counters and status in this Worker Thread's Data
 	xdd_worker_thread_update_local_counters(wdp);
 
-	// Update the Target's Data counters and timers and the TOT
-	xdd_worker_thread_update_target_counters(wdp);
+	// Verify the data that was just read
+	xdd_verify_after_io_op(wdp);
 
 	// If Loose or Serial Ordering is in effect then we need to release the Next Worker Thread.
 	// For Loose Ordering, the Next Worker Thread has issued its I/O operation and it may have completed
@@ -133,121 +133,51 @@ int32_t
 xdd_worker_thread_wait_for_previous_io(worker_data_t *wdp) {
 	target_data_t		*tdp;				// Pointer to the Target Data for this Worker Thread
 	int32_t		tot_offset;		// Offset into the TOT
-	tot_entry_t	*tep;			// Pointer to the TOT entry to use
-	tot_wait_t	*totwp,*tmpwp;	// A TOT Wait struct pointer
+	int32_t 	status;
 
 
 	tdp = wdp->wd_tdp;
-	// Wait for the I/O operation ahead of this one to complete (if necessary)
-	tot_offset = (wdp->wd_task.task_op_number % tdp->td_totp->tot_entries) - 1;
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: task_op_number: %lld: tot_entries: %d: tot_offset: %d: ENTER \n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number, (long long int)wdp->wd_task.task_op_number, tdp->td_totp->tot_entries, tot_offset);
-	if (tot_offset < 0) 
-		tot_offset = tdp->td_totp->tot_entries - 1; // The last TOT_ENTRY
-	
-//	if (tdp->td_target_options & TO_E2E_DESTINATION) {
-//		if (tdp->td_counters.tc_current_op_number == 0)
-		if (wdp->wd_task.task_op_number == 0)
+	if (wdp->wd_task.task_op_number == 0)
 		return(0);	// Dont need to wait for op minus 1 ;)
-//	} else {
-//		if (tdp->td_counters.tc_current_op_number == 0)
-//			return(0);	// Dont need to wait for op minus 1 ;)
-//	}
-
-
-	tep = &tdp->td_totp->tot_entry[tot_offset];
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
-	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
-	nclk_now(&tep->tot_wait_ts);
 
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM WAITING FOR PREVIOUS IO starting at %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,(long long int)tep->tot_wait_ts);
+	// Wait for the I/O operation ahead of this one to complete (if necessary)
+	tot_offset = ((wdp->wd_task.task_op_number - 1) % tdp->td_totp->tot_entries);
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: task_op_number: %lld: tot_entries: %d: tot_offset: %d: I AM WAITING FOR PREVIOUS IO\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number, (long long int)wdp->wd_task.task_op_number, tdp->td_totp->tot_entries, tot_offset);
 if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offset);
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
 
-	totwp = &wdp->wd_tot_wait;
-	if (TOT_ENTRY_UNAVAILABLE == tep->tot_status) {
-		if (tep->tot_waitp == 0) 
-			tep->tot_waitp = totwp;
-		else { // Put this worker thread at the end of the chain
-			tmpwp = tep->tot_waitp;
-			while (tmpwp->totw_nextp != 0) 
-				tmpwp = tmpwp->totw_nextp;
-			tmpwp->totw_nextp = totwp;
-		}
-		// Wait for this tot_entry to become available
-		while (1 != totwp->totw_is_released) {
-	    	pthread_cond_wait(&totwp->totw_condition, &tep->tot_mutex);
-		}
-		totwp->totw_is_released = 0; 
-	}
+	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
+	status = tot_wait(tdp->td_totp, wdp->wd_task.task_op_number - 1, wdp->wd_worker_number);
 	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
-	tep->tot_status = TOT_ENTRY_UNAVAILABLE;
-	pthread_mutex_unlock(&tep->tot_mutex);
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM DONE WAITING FOR PREVIOUS IO - released by worker %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tep->tot_post_worker_thread_number);
 
-	return(0);
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM DONE WAITING FOR PREVIOUS IO - released by worker %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tdp->td_totp->tot_entry[tot_offset].tot_post_worker_thread_number);
+
+	return(status);
 } // End of xdd_worker_thread_wait_for_previous_io()
 
 /*----------------------------------------------------------------------------*/
-/* xdd_worker_thread_release_next_io() - This subroutine will check to
- * see if we need to release the next Worker Thread that might be waiting for
- * this Worker Thread to complete. 
+/* xdd_worker_thread_release_next_io() - This subroutine will release the 
+ * next Worker Thread that might be waiting for this Worker Thread to complete. 
  * 
  * Return value of 0 is good, -1 indicates there was an error
  */
 int32_t
 xdd_worker_thread_release_next_io(worker_data_t *wdp) {
-	int32_t 	status;
 	target_data_t		*tdp;				// Pointer to the Target Data for this Worker Thread
 	int32_t		tot_offset;		// Offset into the TOT
-	tot_entry_t	*tep;			// Pointer to the TOT entry to use
-	tot_wait_t	*totwp;			// A TOT Wait struct pointer
+	int32_t 	status;
 
 
 	tdp = wdp->wd_tdp;
 	tot_offset = (wdp->wd_task.task_op_number % tdp->td_totp->tot_entries);
 
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: ENTER\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset);
-	// Wait for the I/O operation ahead of this one to complete (if necessary)
-
-	tep = &tdp->td_totp->tot_entry[tot_offset];
-	totwp = &wdp->wd_tot_wait;
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
-	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
-	tep->tot_post_worker_thread_number = wdp->wd_worker_number;
-	nclk_now(&tep->tot_post_ts);
-
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: RELEASING worker number %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset,tep->tot_wait_worker_thread_number);
-	// Update the TOT Entry counters
-	nclk_now(&tep->tot_update_ts);
-	tep->tot_update_worker_thread_number = wdp->wd_worker_number;
-	tep->tot_op_number = wdp->wd_task.task_op_number;
-	tep->tot_byte_offset = wdp->wd_task.task_byte_offset;
-	tep->tot_io_size = wdp->wd_task.task_xfer_size;
-	tep->tot_status = TOT_ENTRY_AVAILABLE;
-	pthread_mutex_unlock(&tep->tot_mutex); //TMR
-	if (tep->tot_waitp) { // Check to see if another Worker is waiting for this tot entry
-		totwp = tep->tot_waitp;
-		tep->tot_waitp = totwp->totw_nextp;
-		totwp->totw_is_released = 1;
-		totwp->totw_nextp = 0;
-		status = pthread_cond_signal(&totwp->totw_condition);
-		if (status) {
-			fprintf(xgp->errout,"%s: xdd_worker_thread_release_next_io: Target %d Worker Thread %d: ERROR: Bad status from pthread_cond_signal: status=%d, errno=%d, task_op_number=%lld, tot_offset=%d\n",
-				xgp->progname,
-				tdp->td_target_number,
-				wdp->wd_worker_number,
-				status,
-				errno,
-				(long long int)wdp->wd_task.task_op_number,
-				tot_offset);
-			return(-1);
-		}
-	}
-if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: tot_offset: %d: worker %d has been RELEASED\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tep->tot_wait_worker_thread_number);
+if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_release_next_io: Target: %d: Worker: %d: task_op_number: %lld: tot_offset: %d: RELEASING worker number %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)wdp->wd_task.task_op_number,tot_offset,tdp->td_totp->tot_entry[tot_offset].tot_wait_worker_thread_number);
+	status = tot_release(tdp->td_totp,
+			wdp->wd_task.task_op_number,
+			wdp->wd_worker_number,
+			wdp->wd_task.task_byte_offset,
+			wdp->wd_task.task_xfer_size);
 if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offset);
-	return(0);
+	return(status);
 } // End of xdd_worker_thread_release_next_io()
 
 /*----------------------------------------------------------------------------*/
@@ -291,6 +221,8 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 		wdp->wd_counters.tc_current_bytes_xfered_this_op = wdp->wd_task.task_xfer_size;
 		wdp->wd_counters.tc_accumulated_bytes_xfered += wdp->wd_counters.tc_current_bytes_xfered_this_op;
 		wdp->wd_counters.tc_accumulated_op_count++;
+		if (wdp->wd_e2ep)
+			wdp->wd_counters.tc_accumulated_sr_time += wdp->wd_e2ep->e2e_sr_time; // E2E Send/Receive Time
 		// Operation-specific counters
 		switch (wdp->wd_task.task_op_type) { 
 			case TASK_OP_TYPE_READ: 
@@ -309,6 +241,8 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 				wdp->wd_counters.tc_accumulated_noop_op_count++;
 				break;
 		} // End of SWITCH
+		if (wdp->wd_lathistp) // Only kept when latency percentiles are requested
+			xdd_latency_histogram_record(wdp->wd_lathistp, wdp->wd_task.task_op_type, wdp->wd_counters.tc_current_op_elapsed_time);
 	} else {// Something went wrong - issue error message
 		if (xgp->global_options & GO_STOP_ON_ERROR) {
 			tdp->td_abort = 1; // This tells all the other Worker Threads and the Target Thread to abort
@@ -334,81 +268,99 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 			}
 		}
 		wdp->wd_counters.tc_current_error_count = 1;
+		wdp->wd_counters.tc_accumulated_error_count++;
 	} // Done checking status
+
+	// Pattern fill time is counted whether or not the I/O succeeded
+	wdp->wd_counters.tc_accumulated_pattern_fill_time += wdp->wd_counters.tc_current_pattern_fill_time;
+	wdp->wd_counters.tc_current_pattern_fill_time = 0;
 } // End of xdd_worker_thread_update_local_counters()
 
 /*----------------------------------------------------------------------------*/
-/* xdd_worker_thread_update_target_counters() - This subroutine will update the Target
- * Data counters and timers 
- * NOTE: This routine locks the Target Data so that no other Worker Threads can be
- * making simultaneous updates. The lock is only held in this routine.
+/* xdd_target_counters_sum() - Set the accumulated counters in the specified
+ * counters struct to the sum of the accumulated counters of all the Worker
+ * Threads of this Target. 
+ * Each Worker Thread only updates its own counters so no lock is needed. This
+ * may be called while the Worker Threads are running (by the heartbeat for
+ * example) in which case the sum includes all the operations that have 
+ * completed up to about the time of the call. 
  */
 void
-xdd_worker_thread_update_target_counters(worker_data_t *wdp) {
-	target_data_t	*tdp;			// Pointer to the Tartget's Data
-
-	// Get the pointer to the Target's Data
-	tdp = wdp->wd_tdp;
+xdd_target_counters_sum(target_data_t *tdp, xint_target_counters_t *tcp) {
+	worker_data_t			*wdp;
+	xint_target_counters_t	*wcp;
+
+
+	tcp->tc_accumulated_op_count = 0;
+	tcp->tc_accumulated_read_op_count = 0;
+	tcp->tc_accumulated_write_op_count = 0;
+	tcp->tc_accumulated_noop_op_count = 0;
+	tcp->tc_accumulated_bytes_xfered = 0;
+	tcp->tc_accumulated_bytes_read = 0;
+	tcp->tc_accumulated_bytes_written = 0;
+	tcp->tc_accumulated_bytes_noop = 0;
+	tcp->tc_accumulated_op_time = 0;
+	tcp->tc_accumulated_read_op_time = 0;
+	tcp->tc_accumulated_write_op_time = 0;
+	tcp->tc_accumulated_noop_op_time = 0;
+	tcp->tc_accumulated_pattern_fill_time = 0;
+	tcp->tc_accumulated_sr_time = 0;
+	tcp->tc_accumulated_error_count = 0;
+
+	wdp = tdp->td_next_wdp;
+	while (wdp) {
+		wcp = &wdp->wd_counters;
+		tcp->tc_accumulated_op_count += __atomic_load_n(&wcp->tc_accumulated_op_count, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_read_op_count += __atomic_load_n(&wcp->tc_accumulated_read_op_count, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_write_op_count += __atomic_load_n(&wcp->tc_accumulated_write_op_count, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_noop_op_count += __atomic_load_n(&wcp->tc_accumulated_noop_op_count, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_bytes_xfered += __atomic_load_n(&wcp->tc_accumulated_bytes_xfered, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_bytes_read += __atomic_load_n(&wcp->tc_accumulated_bytes_read, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_bytes_written += __atomic_load_n(&wcp->tc_accumulated_bytes_written, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_bytes_noop += __atomic_load_n(&wcp->tc_accumulated_bytes_noop, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_op_time += __atomic_load_n(&wcp->tc_accumulated_op_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_read_op_time += __atomic_load_n(&wcp->tc_accumulated_read_op_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_write_op_time += __atomic_load_n(&wcp->tc_accumulated_write_op_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_noop_op_time += __atomic_load_n(&wcp->tc_accumulated_noop_op_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_pattern_fill_time += __atomic_load_n(&wcp->tc_accumulated_pattern_fill_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_sr_time += __atomic_load_n(&wcp->tc_accumulated_sr_time, __ATOMIC_RELAXED);
+		tcp->tc_accumulated_error_count += __atomic_load_n(&wcp->tc_accumulated_error_count, __ATOMIC_RELAXED);
+		wdp = wdp->wd_next_wdp;
+	}
+} // End of xdd_target_counters_sum()
 
-	///////////////////////////////////////////////////////////////////////////////////	
-	// The following section gets the "counter_mutex" of the Target Data 
-	// in order to update the various counters and timers.
-	//
-	// LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK LOCK
-	pthread_mutex_lock(&tdp->td_counters_mutex);
-	// Update counters and status in the Worker Thread Data
-	tdp->td_counters.tc_accumulated_op_time += tdp->td_counters.tc_current_op_elapsed_time;
-	if (wdp->wd_task.task_io_status == (ssize_t) wdp->wd_task.task_xfer_size) { // Only update counters if I/O succeeded
-		tdp->td_current_bytes_completed += wdp->wd_task.task_xfer_size;
-		tdp->td_counters.tc_accumulated_bytes_xfered += wdp->wd_task.task_xfer_size;
-		tdp->td_counters.tc_accumulated_op_count++;
-		if (tdp->td_e2ep && wdp->wd_e2ep)
-			tdp->td_e2ep->e2e_sr_time += wdp->wd_e2ep->e2e_sr_time; // E2E Send/Receive Time
-		// Operation-specific counters
-		switch (wdp->wd_task.task_op_type) { 
-			case TASK_OP_TYPE_READ: 
-				tdp->td_counters.tc_accumulated_read_op_time += wdp->wd_counters.tc_current_op_elapsed_time;
-				tdp->td_counters.tc_accumulated_bytes_read += wdp->wd_task.task_xfer_size;
-				tdp->td_counters.tc_accumulated_read_op_count++;
-				break;
-			case TASK_OP_TYPE_WRITE: 
-				tdp->td_counters.tc_accumulated_write_op_time += wdp->wd_counters.tc_current_op_elapsed_time;
-				tdp->td_counters.tc_accumulated_bytes_written += wdp->wd_task.task_xfer_size;
-				tdp->td_counters.tc_accumulated_write_op_count++;
-				break;
-			case TASK_OP_TYPE_NOOP: 
-				tdp->td_counters.tc_accumulated_noop_op_time += wdp->wd_counters.tc_current_op_elapsed_time;
-				tdp->td_counters.tc_accumulated_bytes_noop += wdp->wd_task.task_xfer_size;
-				tdp->td_counters.tc_accumulated_noop_op_count++;
-				break;
-			default:
-				break;
-		} // End of SWITCH
-	} // End of IF clause that updates counters
-
-	// If this Worker Thread got an I/O error then its error count will be 1, otherwise it will be zero
-	tdp->td_counters.tc_current_error_count += wdp->wd_counters.tc_current_error_count;
-
-	pthread_mutex_unlock(&tdp->td_counters_mutex);
-	// UNLOCKED UNLOCKED UNLOCKED UNLOCKED UNLOCKED UNLOCKED UNLOCKED UNLOCKED UNLOCKED
-
-	// If this Worker Thread got an I/O error then we do not want to update the TOT
-	if (tdp->td_counters.tc_current_error_count) 
-		return; 
-
-	// Update the TOT entry for this last I/O if ordering is NONE
-	// Only do it in the no ordering case, because the TOT is now updated
-	// during the thread release
-	//if (!(tdp->td_target_options & (TO_ORDERING_STORAGE_SERIAL | TO_ORDERING_STORAGE_LOOSE))) {
-	//	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE;
-	//	tot_update(tdp->td_totp,
-	//			   wdp->wd_task.task_op_number,
-	//			   wdp->wd_worker_number,
-	//			   wdp->wd_task.task_byte_offset,
-	//			   wdp->wd_task.task_xfer_size);
-	//	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE;
-	//}
-} // End of xdd_worker_thread_update_target_counters()
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_counters_reset() - Reset the accumulated counters and the
+ * extended stats of a Worker Thread at the start of a pass.
+ * This is called by the Target Thread before the Worker Threads are given 
+ * any tasks for the pass.
+ */
+void
+xdd_worker_counters_reset(worker_data_t *wdp) {
+	xint_target_counters_t	*wcp;
+
+
+	wcp = &wdp->wd_counters;
+	wcp->tc_current_error_count = 0;
+	wcp->tc_current_pattern_fill_time = 0;
+	wcp->tc_accumulated_op_count = 0;
+	wcp->tc_accumulated_read_op_count = 0;
+	wcp->tc_accumulated_write_op_count = 0;
+	wcp->tc_accumulated_noop_op_count = 0;
+	wcp->tc_accumulated_bytes_xfered = 0;
+	wcp->tc_accumulated_bytes_read = 0;
+	wcp->tc_accumulated_bytes_written = 0;
+	wcp->tc_accumulated_bytes_noop = 0;
+	wcp->tc_accumulated_op_time = 0;
+	wcp->tc_accumulated_read_op_time = 0;
+	wcp->tc_accumulated_write_op_time = 0;
+	wcp->tc_accumulated_noop_op_time = 0;
+	wcp->tc_accumulated_pattern_fill_time = 0;
+	wcp->tc_accumulated_flush_time = 0;
+	wcp->tc_accumulated_sr_time = 0;
+	wcp->tc_accumulated_error_count = 0;
+	xdd_extended_stats_reset(&wdp->wd_extended_stats);
+} // End of xdd_worker_counters_reset()
 
 /*
  * Local variables:
@@ -42,7 +42,9 @@ xdd_io_for_os(worker_data_t *wdp) {
 
 	/* Do the deed .... */
 	wdp->wd_counters.tc_current_op_end_time = 0;
-	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
+	if (tdp->td_target_options & TO_METADATA) { // Metadata op - no data is moved
+		wdp->wd_task.task_io_status = xdd_metadata_io(wdp);
+	} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
 		wdp->wd_task.task_op_string = "WRITE";
 		// Call xdd_datapattern_fill() to fill the buffer with any required patterns
 		xdd_datapattern_fill(wdp);
@@ -52,6 +54,12 @@ xdd_io_for_os(worker_data_t *wdp) {
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'w'); // Issue the SGIO operation 
+			else if (tdp->td_target_options & TO_E2E_FILES)
+				wdp->wd_task.task_io_status = xdd_e2e_files_write(wdp); // Write each file record of the message
+			else if (tdp->td_target_options & TO_STRIPE)
+				wdp->wd_task.task_io_status = xdd_stripe_io(wdp); // Write each stripe unit piece to its file
+			else if ((tdp->td_target_options & TO_E2E_ZEROCOPY) && (wdp->wd_e2ep) && (wdp->wd_e2ep->e2e_pipe_bytes))
+				wdp->wd_task.task_io_status = xdd_e2e_dest_zerocopy_write(wdp); // Splice the data from the E2E pipe
 			else if (!(tdp->td_target_options & TO_NULL_TARGET)) {
 
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_for_os: Target: %d: Worker: %d: WRITE: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
@@ -74,6 +82,12 @@ if (xgp->global_options & GO_DEBUG_IO) xdd_show_task(&wdp->wd_task);
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'r'); // Issue the SGIO operation 
+			else if (tdp->td_target_options & TO_E2E_FILES)
+				wdp->wd_task.task_io_status = xdd_e2e_files_read(wdp); // Pack the file records of this request
+			else if (tdp->td_target_options & TO_STRIPE)
+				wdp->wd_task.task_io_status = xdd_stripe_io(wdp); // Read each stripe unit piece from its file
+			else if ((tdp->td_target_options & TO_E2E_ZEROCOPY) && (wdp->wd_e2ep) && (wdp->wd_e2ep->e2e_pipe_size))
+				wdp->wd_task.task_io_status = xdd_e2e_src_zerocopy_read(wdp); // Splice the data into the E2E pipe
 			else if (!(tdp->td_target_options & TO_NULL_TARGET)) {
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_for_os: Target: %d: Worker: %d: READ: file_desc: %d: datap: %p: xfer_size: %d: byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
                             wdp->wd_task.task_io_status = pread(wdp->wd_task.task_file_desc,
@@ -84,12 +98,7 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_io_fo
                                                               wdp->wd_task.task_datap,
                                                               wdp->wd_task.task_xfer_size);// Issue a normal read() operation
 		}
-	
-// FIXME _ NEED TO FIX THIS 
-//		if (p->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
-//			wdp->dpp->data_pattern_compare_errors += xdd_verify(wdp, wdp->wdrget_op_number);
-//		}
-	
+		// The data is verified by xdd_verify_after_io_op() once the counters are updated
 	} else {  // Must be a NOOP
 		// The NOOP is used to test the overhead usage of XDD when no actual I/O is done
 		wdp->wd_task.task_op_string = "NOOP";
@@ -136,7 +145,9 @@ xdd_io_for_os(worker_data_t *wdp) {
 
 	/* Do the deed .... */
 	wdp->wd_counters.tc_current_op_end_time = 0;
-	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
+	if (tdp->td_target_options & TO_METADATA) { // Metadata op - no data is moved
+		wdp->wd_task.task_io_status = xdd_metadata_io(wdp);
+	} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
 		wdp->wd_task.task_op_string = "WRITE";
 		// Call xdd_datapattern_fill() to fill the buffer with any required patterns
 		xdd_datapattern_fill(wdp);
@@ -144,7 +155,9 @@ xdd_io_for_os(worker_data_t *wdp) {
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
 		} else { // Issue the actual operation
-			if (!(tdp->td_target_options & TO_NULL_TARGET))
+			if (tdp->td_target_options & TO_STRIPE)
+				wdp->wd_task.task_io_status = xdd_stripe_io(wdp); // Write each stripe unit piece to its file
+			else if (!(tdp->td_target_options & TO_NULL_TARGET))
                             wdp->wd_task.task_io_status = pwrite(wdp->wd_task.task_file_desc,
                                                                wdp->wd_task.task_datap,
                                                                wdp->wd_task.task_xfer_size,
@@ -158,7 +171,9 @@ xdd_io_for_os(worker_data_t *wdp) {
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
 		} else { // Issue the actual operation
-			if (!(tdp->td_target_options & TO_NULL_TARGET))
+			if (tdp->td_target_options & TO_STRIPE)
+				wdp->wd_task.task_io_status = xdd_stripe_io(wdp); // Read each stripe unit piece from its file
+			else if (!(tdp->td_target_options & TO_NULL_TARGET))
                             wdp->wd_task.task_io_status = pread(wdp->wd_task.task_file_desc,
 							     wdp->wd_task.task_datap,
 							     wdp->wd_task.task_xfer_size,
@@ -167,11 +182,7 @@ xdd_io_for_os(worker_data_t *wdp) {
                                                               wdp->wd_task.task_datap,
                                                               wdp->wd_task.task_xfer_size);// Issue a normal read() operation
 		}
-/* FIXME	
-		if (tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
-			wdp->wd_tdp->data_pattern_compare_errors += xdd_verify(wdp, wdp->wdrget_op_number);
-		}
-*/	
+		// The data is verified by xdd_verify_after_io_op() once the counters are updated
 	} else {  // Must be a NOOP
 		// The NOOP is used to test the overhead usage of XDD when no actual I/O is done
 		wdp->wd_task.task_op_string = "NOOP";
@@ -81,7 +81,8 @@ xdd_status_after_io_op(worker_data_t *wdp) {
 			(long long int)xgp->max_errors);
 	}
 
-	if ((wdp->wd_task.task_io_status == 0) && (wdp->wd_task.task_errno == 0)) {
+	// The ops of a metadata workload move no data so a status of 0 is not an end-of-file
+	if ((wdp->wd_task.task_io_status == 0) && (wdp->wd_task.task_errno == 0) && !(tdp->td_target_options & TO_METADATA)) {
 		fprintf(xgp->errout, "%s: status_after_io_op: Target %d Worker Thread %d: WARNING: End-Of-File reached on target named '%s' status=%d, errno=%d\n",
 			xgp->progname,
 			tdp->td_target_number,
@@ -236,14 +237,20 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 			wdp->wd_current_state &= ~WORKER_CURRENT_STATE_SRC_SEND;
 
 		} // End of me being the SOURCE in an End-to-End test 
+		else if ((tdp->td_restartp) && (tdp->td_restartp->flags & RESTART_FLAG_JOURNAL) &&
+				 (wdp->wd_task.task_io_status == (ssize_t)wdp->wd_task.task_xfer_size)) {
+			// Remember the range that was written for the restart journal
+			xdd_restart_journal_record(tdp->td_restartp, wdp->wd_task.task_byte_offset, wdp->wd_task.task_xfer_size);
+		}
 	} // End of processing a End-to-End
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_after_io_op: Target: %d: Worker: %d: EXIT...\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number);
 } // End of xdd_e2e_after_io_op(wdp) 
 
 /*----------------------------------------------------------------------------*/
 /* xdd_extended_stats() - 
- * Used to update the longest/shorts operation statistics of the -extstats 
- * options was specified
+ * Used to update the longest/shortest operation statistics if the -extstats 
+ * option was specified. Each Worker Thread keeps its own statistics which are
+ * merged into the Target's Extended Stats by xdd_target_ttd_after_pass().
  * 
  * This subroutine is called within the context of a Worker Thread.
  *
@@ -252,64 +259,156 @@ void
 xdd_extended_stats(worker_data_t *wdp) {
 	xint_extended_stats_t	*esp;
 	target_data_t	*tdp;
+	nclk_t			op_time;
+	int64_t			op_number;
+	int64_t			op_bytes;
+	int32_t			pass_number;
 
 
 	tdp = wdp->wd_tdp;
 	if ((xgp->global_options & GO_EXTENDED_STATS) == 0)
 		return;
 
-	if (tdp->td_esp == NULL) {
-		fprintf(xgp->errout, "%s: xdd_extended_stats: Target %d Worker Thread %d: INTERNAL ERROR: No pointer to Extended Stats Structure for target named '%s'\n",
-			xgp->progname,
-			tdp->td_target_number,
-			wdp->wd_worker_number,
-			tdp->td_target_full_pathname);
+	// Only operations that completed normally are counted
+	if (wdp->wd_task.task_io_status != (ssize_t)wdp->wd_task.task_xfer_size)
 		return;
+
+	esp = &wdp->wd_extended_stats;
+	op_time = wdp->wd_counters.tc_current_op_elapsed_time;
+	op_number = wdp->wd_task.task_op_number;
+	op_bytes = wdp->wd_task.task_xfer_size;
+	pass_number = tdp->td_counters.tc_pass_number;
+
+	// Longest and shortest op time of any type
+	if (op_time > esp->my_longest_op_time) {
+		esp->my_longest_op_time = op_time;
+		esp->my_longest_op_number = op_number;
+		esp->my_longest_op_bytes = op_bytes;
+		esp->my_longest_op_pass_number = pass_number;
+	}
+	if (op_time < esp->my_shortest_op_time) {
+		esp->my_shortest_op_time = op_time;
+		esp->my_shortest_op_number = op_number;
+		esp->my_shortest_op_bytes = op_bytes;
+		esp->my_shortest_op_pass_number = pass_number;
 	}
-	esp = tdp->td_esp;
-	// Longest op time
-	if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_op_time) {
-		esp->my_longest_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-		esp->my_longest_op_number = tdp->td_counters.tc_current_op_number;
-		if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) {  		// Write Operation
-			if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_write_op_time) {
-				esp->my_longest_write_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_longest_write_op_number = tdp->td_counters.tc_current_op_number;
+	// Longest and shortest op time of this type
+	switch (wdp->wd_task.task_op_type) {
+		case TASK_OP_TYPE_WRITE:
+			if (op_time > esp->my_longest_write_op_time) {
+				esp->my_longest_write_op_time = op_time;
+				esp->my_longest_write_op_number = op_number;
+				esp->my_longest_write_op_bytes = op_bytes;
+				esp->my_longest_write_op_pass_number = pass_number;
 			}
-		} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) {  // READ Operation
-			if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_read_op_time) {
-				esp->my_longest_read_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_longest_read_op_number = tdp->td_counters.tc_current_op_number;
+			if (op_time < esp->my_shortest_write_op_time) {
+				esp->my_shortest_write_op_time = op_time;
+				esp->my_shortest_write_op_number = op_number;
+				esp->my_shortest_write_op_bytes = op_bytes;
+				esp->my_shortest_write_op_pass_number = pass_number;
 			}
-		} else { 																		// NOOP 
-			if (tdp->td_counters.tc_current_op_elapsed_time > esp->my_longest_noop_op_time) {
-				esp->my_longest_noop_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_longest_noop_op_number = tdp->td_counters.tc_current_op_number;
+			break;
+		case TASK_OP_TYPE_READ:
+			if (op_time > esp->my_longest_read_op_time) {
+				esp->my_longest_read_op_time = op_time;
+				esp->my_longest_read_op_number = op_number;
+				esp->my_longest_read_op_bytes = op_bytes;
+				esp->my_longest_read_op_pass_number = pass_number;
 			}
-		}
-	}
-	// Shortest op time
-	if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_op_time) {
-		esp->my_shortest_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-		esp->my_shortest_op_number = tdp->td_counters.tc_current_op_number;
-		if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE) {  		// Write Operation
-			if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_write_op_time) {
-				esp->my_shortest_write_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_shortest_write_op_number = tdp->td_counters.tc_current_op_number;
+			if (op_time < esp->my_shortest_read_op_time) {
+				esp->my_shortest_read_op_time = op_time;
+				esp->my_shortest_read_op_number = op_number;
+				esp->my_shortest_read_op_bytes = op_bytes;
+				esp->my_shortest_read_op_pass_number = pass_number;
 			}
-		} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) {  // READ Operation
-			if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_read_op_time) {
-				esp->my_shortest_read_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_shortest_read_op_number = tdp->td_counters.tc_current_op_number;
+			break;
+		default: 		// NOOP
+			if (op_time > esp->my_longest_noop_op_time) {
+				esp->my_longest_noop_op_time = op_time;
+				esp->my_longest_noop_op_number = op_number;
+				esp->my_longest_noop_op_bytes = op_bytes;
+				esp->my_longest_noop_op_pass_number = pass_number;
 			}
-		} else { 																		// NOOP 
-			if (tdp->td_counters.tc_current_op_elapsed_time < esp->my_shortest_noop_op_time) {
-				esp->my_shortest_noop_op_time = tdp->td_counters.tc_current_op_elapsed_time;
-				esp->my_shortest_noop_op_number = tdp->td_counters.tc_current_op_number;
+			if (op_time < esp->my_shortest_noop_op_time) {
+				esp->my_shortest_noop_op_time = op_time;
+				esp->my_shortest_noop_op_number = op_number;
+				esp->my_shortest_noop_op_bytes = op_bytes;
+				esp->my_shortest_noop_op_pass_number = pass_number;
 			}
-		}
+			break;
 	}
 } // End of xdd_extended_stats()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extended_stats_reset() - Reset the longest/shortest operation statistics
+ * at the start of a pass
+ */
+void 
+xdd_extended_stats_reset(xint_extended_stats_t *esp) {
+
+	memset(esp, 0, sizeof(xint_extended_stats_t));
+	esp->my_shortest_op_time = NCLK_MAX;
+	esp->my_shortest_read_op_time = NCLK_MAX;
+	esp->my_shortest_write_op_time = NCLK_MAX;
+	esp->my_shortest_noop_op_time = NCLK_MAX;
+} // End of xdd_extended_stats_reset()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extended_stats_merge() - Merge the longest/shortest operation statistics
+ * of a Worker Thread into those of its Target
+ */
+void 
+xdd_extended_stats_merge(xint_extended_stats_t *to, xint_extended_stats_t *from) {
+
+	if (from->my_longest_op_time > to->my_longest_op_time) {
+		to->my_longest_op_time = from->my_longest_op_time;
+		to->my_longest_op_number = from->my_longest_op_number;
+		to->my_longest_op_bytes = from->my_longest_op_bytes;
+		to->my_longest_op_pass_number = from->my_longest_op_pass_number;
+	}
+	if (from->my_longest_read_op_time > to->my_longest_read_op_time) {
+		to->my_longest_read_op_time = from->my_longest_read_op_time;
+		to->my_longest_read_op_number = from->my_longest_read_op_number;
+		to->my_longest_read_op_bytes = from->my_longest_read_op_bytes;
+		to->my_longest_read_op_pass_number = from->my_longest_read_op_pass_number;
+	}
+	if (from->my_longest_write_op_time > to->my_longest_write_op_time) {
+		to->my_longest_write_op_time = from->my_longest_write_op_time;
+		to->my_longest_write_op_number = from->my_longest_write_op_number;
+		to->my_longest_write_op_bytes = from->my_longest_write_op_bytes;
+		to->my_longest_write_op_pass_number = from->my_longest_write_op_pass_number;
+	}
+	if (from->my_longest_noop_op_time > to->my_longest_noop_op_time) {
+		to->my_longest_noop_op_time = from->my_longest_noop_op_time;
+		to->my_longest_noop_op_number = from->my_longest_noop_op_number;
+		to->my_longest_noop_op_bytes = from->my_longest_noop_op_bytes;
+		to->my_longest_noop_op_pass_number = from->my_longest_noop_op_pass_number;
+	}
+	if (from->my_shortest_op_time < to->my_shortest_op_time) {
+		to->my_shortest_op_time = from->my_shortest_op_time;
+		to->my_shortest_op_number = from->my_shortest_op_number;
+		to->my_shortest_op_bytes = from->my_shortest_op_bytes;
+		to->my_shortest_op_pass_number = from->my_shortest_op_pass_number;
+	}
+	if (from->my_shortest_read_op_time < to->my_shortest_read_op_time) {
+		to->my_shortest_read_op_time = from->my_shortest_read_op_time;
+		to->my_shortest_read_op_number = from->my_shortest_read_op_number;
+		to->my_shortest_read_op_bytes = from->my_shortest_read_op_bytes;
+		to->my_shortest_read_op_pass_number = from->my_shortest_read_op_pass_number;
+	}
+	if (from->my_shortest_write_op_time < to->my_shortest_write_op_time) {
+		to->my_shortest_write_op_time = from->my_shortest_write_op_time;
+		to->my_shortest_write_op_number = from->my_shortest_write_op_number;
+		to->my_shortest_write_op_bytes = from->my_shortest_write_op_bytes;
+		to->my_shortest_write_op_pass_number = from->my_shortest_write_op_pass_number;
+	}
+	if (from->my_shortest_noop_op_time < to->my_shortest_noop_op_time) {
+		to->my_shortest_noop_op_time = from->my_shortest_noop_op_time;
+		to->my_shortest_noop_op_number = from->my_shortest_noop_op_number;
+		to->my_shortest_noop_op_bytes = from->my_shortest_noop_op_bytes;
+		to->my_shortest_noop_op_pass_number = from->my_shortest_noop_op_pass_number;
+	}
+} // End of xdd_extended_stats_merge()
 /*----------------------------------------------------------------------------*/
 /* xdd_worker_thread_ttd_after_io_op() - This subroutine will call all the 
  * subroutines that need to get involved after each I/O Operation.
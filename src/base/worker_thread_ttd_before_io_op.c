@@ -253,6 +253,8 @@ xdd_throttle_before_io_op(worker_data_t *wdp) {
 	int32_t  sleep_time_dw;     /* This is the amount of time to sleep in milliseconds */
 	nclk_t	now;
 	target_data_t	*tdp;
+	seek_t	*seekp;
+	seek_t	seek_scratch;
 
 
 	tdp = wdp->wd_tdp;
@@ -271,9 +273,10 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 			sleep_time = tdp->td_throtp->throttle*1000000;
 		} else { // Process the throttle for IOPS or BW
 			now -= wdp->wd_counters.tc_pass_start_time;
-			if (now < tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1) { /* Then we may need to sleep */
-				sleep_time = (tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1 - now); /* sleep time in microseconds */
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_throttle_before_io_op: Target: %d: Worker: %d: OPS/BW: time1: %lld: now: %lld: sleep_time: %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].time1,(long long int)now,(long long int)sleep_time);
+			seekp = xdd_seek_entry(tdp, wdp->wd_task.task_op_number, &seek_scratch);
+			if (now < seekp->time1) { /* Then we may need to sleep */
+				sleep_time = (seekp->time1 - now); /* sleep time in microseconds */
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_throttle_before_io_op: Target: %d: Worker: %d: OPS/BW: time1: %lld: now: %lld: sleep_time: %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,(long long int)seekp->time1,(long long int)now,(long long int)sleep_time);
 				if (sleep_time > 0) {
 					sleep_time_dw = sleep_time;
 #ifdef WIN32
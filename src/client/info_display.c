@@ -248,6 +248,10 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	} else {
 		fprintf(out,"\t\tThrottle is unrestricted\n");
 	}
+	if (tdp->td_stripep) {
+		fprintf(out,"\t\tStriped across, %d files, stripe unit in bytes, %lld\n",
+			tdp->td_stripep->stripe_count, (long long int)tdp->td_stripep->stripe_unit);
+	}
 	fprintf(out,"\t\tPer-pass time limit in seconds, %f\n",tdp->td_time_limit);
 	fprintf(out,"\t\tPass seek randomization, %s", (tdp->td_target_options & TO_PASS_RANDOMIZE)?"enabled\n":"disabled\n");
 	fprintf(out,"\t\tFile write synchronization, %s", (tdp->td_target_options & TO_SYNCWRITE)?"enabled\n":"disabled\n");
@@ -273,6 +277,10 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 		xdd_display_kmgt(out, tdp->td_seekhdr.seek_range*tdp->td_block_size, tdp->td_block_size);
 	}
 	fprintf(out, "\t\tSeek pattern, %s\n", tdp->td_seekhdr.seek_pattern);
+	if (tdp->td_seekhdr.seek_options & SO_SEEK_PHYSICAL)
+		fprintf(out, "\t\tSeek order, physical\n");
+	if (tdp->td_seekhdr.seek_options & SO_SEEK_LAZY)
+		fprintf(out, "\t\tSeek list, generated as needed\n");
 	if (tdp->td_seekhdr.seek_stride > tdp->td_reqsize) 
 		fprintf(out, "\t\tSeek Stride, %d, %d-byte blocks, %d, bytes\n",tdp->td_seekhdr.seek_stride,tdp->td_block_size,tdp->td_seekhdr.seek_stride*tdp->td_block_size);
 	fprintf(out, "\t\tFlushwrite interval, %lld\n", (long long)tdp->td_flushwrite);
@@ -316,9 +324,14 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	fprintf(out, "\t\tPreallocation, %lld\n",(long long int)tdp->td_preallocate);
 	fprintf(out, "\t\tPretruncation, %lld\n",(long long int)tdp->td_pretruncate);
 	fprintf(out, "\t\tQueue Depth, %d\n",tdp->td_queue_depth);
+	if (tdp->td_task_ring_spin)
+		fprintf(out, "\t\tTask Spin, %d\n",tdp->td_task_ring_spin);
+	fprintf(out, "\t\tI/O Engine, %s\n",(tdp->td_target_options & TO_IO_URING)?"io_uring":((tdp->td_target_options & TO_LIBAIO)?"libaio":"pthread"));
 	/* Timestamp options */
 	if (tdp->td_ts_table.ts_options & TS_ON) {
-                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s\n",
+                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s %s %s\n",
+                   ( tdp->td_ts_table.ts_options & TS_STREAM     )?"STREAM":"",
+                   ( tdp->td_ts_table.ts_options & TS_COMPACT    )?"COMPACT":"",
                    ( tdp->td_ts_table.ts_options & TS_DETAILED   )?"DETAILED":"", 
                    ( tdp->td_ts_table.ts_options & TS_SUMMARY    )?"SUMMARY":"",
                    ( tdp->td_ts_table.ts_options & TS_NORMALIZE  )?"NORMALIZE":"",
@@ -333,7 +346,7 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 
 	// Print the heartbeat interval and options
 	if (tdp->td_hb.hb_interval > 0) { // Display the Heartbeat information
-		fprintf(out, "\t\tHeartbeat Interval, %d, options, ", tdp->td_hb.hb_interval);
+		fprintf(out, "\t\tHeartbeat Interval, %.3f, options, ", (double)tdp->td_hb.hb_interval / FLOAT_BILLION);
 		if (tdp->td_hb.hb_options & HB_TOD)  // Time of Day
 			fprintf(out,"/TOD");
 		if (tdp->td_hb.hb_options & HB_ELAPSED)  // Elapsed Seconds for run
@@ -362,10 +375,14 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 			fprintf(out,"/EstimatedTimeLeft");
 		if (tdp->td_hb.hb_options & HB_LF)  		// LineFeed or Carriage Return
 			fprintf(out,"/LF");
+		if (tdp->td_hb.hb_options & HB_TIMESERIES)	// Statistics of each interval
+			fprintf(out,"/TimeSeries");
 		fprintf(out,"\n");
 		if (tdp->td_hb.hb_filename)  			// display name of the file that Heartbeat will send data
 		 	fprintf(out,"\t\tHeartbeart Output File, %s\n",tdp->td_hb.hb_filename);
 		else fprintf(out,"\t\tHeartbeart Output File, stderr\n");
+		if (tdp->td_hb.hb_ts_filename)  		// display name of the time series file
+		 	fprintf(out,"\t\tHeartbeat Time Series File, %s\n",tdp->td_hb.hb_ts_filename);
 	} else {
 		fprintf(out, "\t\tHeartbeat Disabled, \n");
 	}
@@ -400,6 +417,8 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 		// Display info
 		fprintf(out,"\t\tEnd-to-End ACTIVE: this target is the %s side\n",
 			(tdp->td_target_options & TO_E2E_DESTINATION) ? "DESTINATION":"SOURCE");
+		if (tdp->td_target_options & TO_E2E_ZEROCOPY)
+			fprintf(out,"\t\tEnd-to-End zero copy requested\n");
 		// Display all the hostname:base_port,port_count entries in the e2e_address_table
 		for (i = 0; i < (size_t)tdp->td_e2ep->e2e_address_table_host_count; i++) {
 			fprintf(out,"\t\tEnd-to-End Destination Address %ld of %d '%s' base port %d for %d ports [ports %d - %d]\n",
@@ -40,7 +40,7 @@ xdd_initialization(int32_t argc,char *argv[], xdd_plan_t *planp) {
 
 	// Init output format header
 	if (planp->plan_options & PLAN_ENDTOEND) 
-		xdd_results_format_id_add("+E2ESRTIME+E2EIOTIME+E2EPERCENTSRTIME ", planp->format_string);
+		planp->format_string = xdd_results_format_id_add("+E2ESRTIME+E2EIOTIME+E2EPERCENTSRTIME ", planp->format_string);
 
 	// Optimize runtime priorities and all that 
 	// See schedule.c
@@ -348,34 +348,8 @@ xdd_interactive_display_state_info(worker_data_t *wdp) {
 			(long long int)(tep->tot_byte_offset / tdp->td_xfer_size),
 			(long long int)((long long int)(wdp->wd_counters.tc_current_byte_offset - tep->tot_byte_offset) / tdp->td_xfer_size));
 	}
-	if (wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE) {
-		tot_offset = ((wdp->wd_counters.tc_current_byte_offset/tdp->td_xfer_size) % tdp->td_totp->tot_entries);
-		tep = &tdp->td_totp->tot_entry[tot_offset];
-		fprintf(xgp->output,"    Waiting for TOT lock to release TOT Offset %d: \n",tot_offset);
-		fprintf(xgp->output,"    TOT Offset, %d, tot_op_number, %lld, tot_byte_offset, %lld, block, %lld, delta, %lld, ops/blocks\n",
-			tot_offset,
-			(long long int)tep->tot_op_number,
-			(long long int)tep->tot_byte_offset,
-			(long long int)(tep->tot_byte_offset / tdp->td_xfer_size),
-			(long long int)((long long int)(wdp->wd_counters.tc_current_byte_offset - tep->tot_byte_offset) / tdp->td_xfer_size));
-	}
-	if (wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS) {
-		tot_offset = ((wdp->wd_counters.tc_current_byte_offset/tdp->td_xfer_size) % tdp->td_totp->tot_entries) - 1;
-		if (tot_offset < 0) 
-			tot_offset = tdp->td_totp->tot_entries - 1; // The last TOT_ENTRY
-		tep = &tdp->td_totp->tot_entry[tot_offset];
-		fprintf(xgp->output,"    Waiting for TOT lock to time stamp TOT Offset %d before waiting\n", tot_offset);
-		fprintf(xgp->output,"    TOT Offset, %d, tot_op_number, %lld, tot_byte_offset, %lld, block, %lld, delta, %lld, ops/blocks\n",
-			tot_offset,
-			(long long int)tep->tot_op_number,
-			(long long int)tep->tot_byte_offset,
-			(long long int)(tep->tot_byte_offset / tdp->td_xfer_size),
-			(long long int)((long long int)(wdp->wd_counters.tc_current_byte_offset - tep->tot_byte_offset) / tdp->td_xfer_size));
-	}
-	if (wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO) {
-		tot_offset = ((wdp->wd_counters.tc_current_byte_offset/tdp->td_xfer_size) % tdp->td_totp->tot_entries) - 1;
-		if (tot_offset < 0) 
-			tot_offset = tdp->td_totp->tot_entries - 1; // The last TOT_ENTRY
+	if ((wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO) && (wdp->wd_task.task_op_number > 0)) {
+		tot_offset = ((wdp->wd_task.task_op_number - 1) % tdp->td_totp->tot_entries);
 		tep = &tdp->td_totp->tot_entry[tot_offset];
 		fprintf(xgp->output,"    Waiting for previous I/O at TOT Offset, %d, my current op number, %lld, my current byte offset, %lld, my current block offset, %lld, waiting for block, %lld\n",
 			tot_offset,
@@ -490,46 +464,24 @@ xdd_interactive_show_print_tot(int32_t tokens, char *cmdline, uint32_t flags, xd
 void
 xdd_interactive_show_tot_display_fields(target_data_t *tdp, FILE *fp) {
 
-	int			i;
-	char		*tot_mutex_state;
 	int32_t		tot_offset; // Offset into TOT
 	tot_entry_t	*tep;		// Pointer to a TOT Entry
-	int			sem_val = 0;
-	int			status;
-	int			save_errno;
 	int64_t		tot_block;
-	tot_wait_t	*totwp;
 
 
 	fprintf(fp,"Target %d has %d TOT Entries, queue depth of %d\n",
 		tdp->td_target_number, 
 		tdp->td_totp->tot_entries, 
 		tdp->td_queue_depth);
-	fprintf(fp,"TOT Offset,Waitp,WAIT TS,POST TS,W/P Delta,Update TS,Byte Location,Block Location,I/O Size,WaitWorkerThread,PostWorkerThread,UpdateWorkerThread,SemVal,Mutex State\n");
+	fprintf(fp,"TOT Offset,Op Number,WAIT TS,POST TS,W/P Delta,Update TS,Byte Location,Block Location,I/O Size,WaitWorkerThread,PostWorkerThread,UpdateWorkerThread,Releases,Waiters\n");
 	for (tot_offset = 0; tot_offset < tdp->td_totp->tot_entries; tot_offset++) {
 		tep = &tdp->td_totp->tot_entry[tot_offset];
-		status = pthread_mutex_trylock(&tep->tot_mutex);
-		if (status == 0) {
-			tot_mutex_state = "unlocked";
-			pthread_mutex_unlock(&tep->tot_mutex);
-		} else { // Must have been locked...
-			if (errno == EBUSY) 
-				tot_mutex_state = "LOCKED";
-			else {
-				save_errno = errno;
-				fprintf(fp,"Error on pthread_mutex_trylock at offset %d in the TOT\n",tot_offset);
-				errno = save_errno;
-				perror("Reason");
-				tot_mutex_state = "UNKNOWN";
-			}
-		}
-			
 		if (tep->tot_io_size) 
 			tot_block = (long long int)((long long int)tep->tot_byte_offset / tep->tot_io_size);
 		else  tot_block = -1;
-		fprintf(fp,"%5d,%p,%lld,%lld,%lld,%lld,%lld,%lld,%d,%d,%d,%d,%d,%s\n",
+		fprintf(fp,"%5d,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%d,%d,%d,%d,%u,%u\n",
 			tot_offset,
-			tep->tot_waitp,
+			(long long int)__atomic_load_n(&tep->tot_op_number, __ATOMIC_RELAXED),
 			(long long int)tep->tot_wait_ts,
 			(long long int)tep->tot_post_ts,
 			(long long int)(tep->tot_post_ts - (long long int)tep->tot_wait_ts),
@@ -540,19 +492,8 @@ xdd_interactive_show_tot_display_fields(target_data_t *tdp, FILE *fp) {
 			tep->tot_wait_worker_thread_number,
 			tep->tot_post_worker_thread_number,
 			tep->tot_update_worker_thread_number,
-			sem_val,
-			tot_mutex_state);
-			if (tep->tot_waitp) {
-				totwp = tep->tot_waitp;
-				i=0;
- 				fprintf(fp,"TOT Offset,TOTW,TOTW#,tot_wait ptr,next tot_wait ptr,Worker Data ptr,condition,Is Released\n");
-				while (totwp) {
-   					fprintf(fp,"%5d,TOTW,%d,%p,%p,%p,-,%d\n",tot_offset,i,totwp,totwp->totw_nextp,totwp->totw_wdp,totwp->totw_is_released);
-					totwp = totwp->totw_nextp;
-					i++;
-				sleep(1);
-				}
-			}
+			__atomic_load_n(&tep->tot_seq, __ATOMIC_RELAXED),
+			__atomic_load_n(&tep->tot_waiters, __ATOMIC_RELAXED));
 	} // End of FOR loop that displays all the TOT entries
 } // End of xdd_interactive_show_tot_display_fields()
 
@@ -117,6 +117,10 @@ xdd_parse(xdd_plan_t *planp, int32_t argc, char *argv[]) {
 		exit(XDD_RETURN_VALUE_INVALID_ARGUMENT);
 	}
 
+	// The latency percentiles in the output format need the latency histograms
+	if (xdd_results_format_uses_latency_histogram(planp->format_string))
+		xgp->global_options |= GO_LATENCY_HISTOGRAM;
+
 	// Build the Target Data Struct substructure for all targets
 	xdd_build_target_data_substructure(planp);
 
@@ -504,6 +508,53 @@ xdd_get_throtp(target_data_t *tdp) {
 
 } /* End of xdd_get_throtp() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_get_metadatap() - return a pointer to the XDD Metadata Workload Structure 
+ */
+xint_metadata_t *
+xdd_get_metadatap(target_data_t *tdp) {
+	int32_t	phase;
+
+
+	if (tdp->td_mdp == 0) { // If there is no existing Metadata structure, allocate a new one 
+		tdp->td_mdp = calloc(1, sizeof(xint_metadata_t));
+		if (tdp->td_mdp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for METADATA variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_metadata_t), tdp->td_target_number);
+			return(NULL);
+		}
+		// Set default Metadata values in the newly allocated metadata structure
+		tdp->td_mdp->md_files_per_worker = XINT_DEFAULT_MD_FILES;
+		tdp->td_mdp->md_dirs_per_worker = XINT_DEFAULT_MD_DIRS;
+		for (phase = 0; phase < XINT_MD_PHASES; phase++)
+			tdp->td_mdp->md_phases[phase] = phase;
+		tdp->td_mdp->md_phase_count = XINT_MD_PHASES;
+	}
+	return(tdp->td_mdp);
+
+} /* End of xdd_get_metadatap() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_stripep() - return a pointer to the XDD Striped Target Structure 
+ */
+xint_stripe_t *
+xdd_get_stripep(target_data_t *tdp) {
+
+	if (tdp->td_stripep == 0) { // If there is no existing Stripe structure, allocate a new one 
+		tdp->td_stripep = calloc(1, sizeof(xint_stripe_t));
+		if (tdp->td_stripep == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for STRIPE variables for target %d\n",
+			xgp->progname, (int)sizeof(xint_stripe_t), tdp->td_target_number);
+			return(NULL);
+		}
+		// Set default Stripe values in the newly allocated stripe structure
+		tdp->td_stripep->stripe_count = XINT_DEFAULT_STRIPE_COUNT;
+		tdp->td_stripep->stripe_unit = XINT_DEFAULT_STRIPE_UNIT;
+	}
+	return(tdp->td_stripep);
+
+} /* End of xdd_get_stripep() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_get_tsp() - return a pointer to the Time Stamp Variables
  * for the specified target
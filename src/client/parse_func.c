@@ -867,6 +867,9 @@ xddfunc_dryrun(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 //				port <number>
 //				issource
 //				isdestination
+//				zerocopy
+//				files
+//				filelist <filename>
 // 
 int
 xddfunc_endtoend(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -1294,6 +1297,68 @@ xddfunc_endtoend(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	    	}
 		}
 		return(args_index);
+    } else if (strcmp(argv[args_index], "zerocopy") == 0) { 
+		// Splice the data between the target file and the socket instead of copying it through the I/O buffer
+		args_index++;
+		if (target_number >= 0) {
+	    	tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+	    	if (tdp == NULL) return(-1);
+	    	tdp->td_target_options |= TO_E2E_ZEROCOPY;
+		} else {  /* set option for all targets */
+	    	if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+		    		tdp->td_target_options |= TO_E2E_ZEROCOPY;
+		    		i++;
+		    		tdp = planp->target_datap[i];
+				}
+	    	}
+		}
+		return(args_index);
+    } else if (strcmp(argv[args_index], "files") == 0) { 
+		// The target is a directory - send or receive all the files below it
+		args_index++;
+		if (target_number >= 0) {
+	    	tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+	    	if (tdp == NULL) return(-1);
+	    	tdp->td_target_options |= TO_E2E_FILES;
+		} else {  /* set option for all targets */
+	    	if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+		    		tdp->td_target_options |= TO_E2E_FILES;
+		    		i++;
+		    		tdp = planp->target_datap[i];
+				}
+	    	}
+		}
+		return(args_index);
+    } else if (strcmp(argv[args_index], "filelist") == 0) { 
+		// The source side only sends the paths in this file - implies "files"
+		if (args_index + 1 >= argc) {
+			fprintf(stderr,"%s: Error: No file name specified for End-to-End option filelist\n", xgp->progname);
+			return(0);
+		}
+		if (target_number >= 0) {
+	    	tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+	    	if (tdp == NULL) return(-1);
+	    	tdp->td_target_options |= TO_E2E_FILES;
+	    	tdp->td_e2ep->e2e_file_list_name = argv[args_index+1];
+		} else {  /* set option for all targets */
+	    	if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+		    		tdp->td_target_options |= TO_E2E_FILES;
+		    		tdp->td_e2ep->e2e_file_list_name = argv[args_index+1];
+		    		i++;
+		    		tdp = planp->target_datap[i];
+				}
+	    	}
+		}
+		return(args_index+2);
     } else if ((strcmp(argv[args_index], "sourcepath") == 0) ||  /* complete source file path for restart option */
 	       (strcmp(argv[args_index], "srcpath") == 0)) { 
 		if (target_number >= 0) {
@@ -1401,8 +1466,27 @@ xddfunc_fullhelp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(-1);
 }
 /*----------------------------------------------------------------------------*/
+// Return the name of a heartbeat output file for the specified target or NULL
+// if there is no memory for it. 
+static char *
+xdd_heartbeat_filename(char *basename, int32_t target_number)
+{
+	char		*filename; // Pointer to the area that will store the file name
+	int			len;
+
+
+	len = strlen(basename);
+	filename = (char *)malloc(len+16);
+	if (filename == NULL) {
+		fprintf(stderr,"%s: ERROR: Cannot allocate %d bytes for heartbeat output file name: '%s'\n", xgp->progname, len+16, basename);
+		return(NULL);
+	}
+	sprintf(filename,"%s.T%04d.csv",basename,target_number);
+	return(filename);
+}
+/*----------------------------------------------------------------------------*/
 /*  The -heartbeat option accepts one argument that is any of the following:
- *      - A positive integer that indicates the number of seconds between beats
+ *      - A positive number that indicates the number of seconds between beats - fractions are allowed
  *      - The word "operations" or "ops" to display the current number of operations complete
  *      - The word "bytes" to display the current number of bytes transfered 
  *      - The word "kbytes" or "kb" to display the current number of Kilo Bytes transfered 
@@ -1418,6 +1502,8 @@ xddfunc_fullhelp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
  *      - The word "sec" to display the "number of seconds" into the run on each heartbeat line
  *      - The word "host" to display the "host name" on each heartbeat line
  *      - The word "output" or "out" will send all the heartbeat output to a specific file
+ *      - The word "timeseries" or "ts" followed by a file name will write the bandwidth, IOPS,
+ *            latency and queue occupancy of each interval to that file
  * Specifying -heartbeat multiple times will add these to the heartbeat output string FOR EACH TARGET
  */
 int
@@ -1430,10 +1516,10 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	int			c1,c2;	// A single character
 	char		*cp;	// A single Character pointer
 	int			len;	// Length of the option string
-	int			digits;	// if set to 1 then string contains only numerical digits
+	char		*endp;	// End of the numerical part of the option string
+	double		seconds; // Heartbeat interval in seconds
 	int			return_value;
 	heartbeat_t	hb;		// A heartbeat structure for these options
-	char		*filename; // Pointer to the area that will store the file name
 
 
     args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
@@ -1455,31 +1541,31 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 	
 	// Convert the "option" string to lower case for consistency
-	digits = 0;
 	cp = sp;
 	for (i = 0; i < len; i++) {
 		c1 = *cp;
 		c2 = tolower(c1);
 		*cp = c2;
-		digits = isdigit(c2); // If this is ever a non-digit then digits will be set to 0
 		cp++;
 	}
 		
-	hb.hb_interval = 0;
-	if (digits) { // The heartbeat option is "number of seconds"
-		hb.hb_interval = atoi(sp);
-		if (hb.hb_interval <= 0) { // This should not happen but let's check just to be certain
-			fprintf(stderr,"%s: Error: Heartbeat value of '%d' cannot be negative\n", xgp->progname, hb.hb_interval);
-			return(-1);
-		}
-		return(2);
-	}
-
 	return_value = -1;
+	hb.hb_interval = 0;
 	hb.hb_options = 0;
 	hb.hb_filename = NULL;
+	hb.hb_ts_filename = NULL;
+	seconds = strtod(sp, &endp);
+	if ((endp != sp) && (*endp == '\0')) { // The heartbeat option is "number of seconds" - fractions are allowed
+		if (seconds <= 0.0) {
+			fprintf(stderr,"%s: Error: Heartbeat value of '%s' must be greater than 0\n", xgp->progname, sp);
+			return(-1);
+		}
+		hb.hb_interval = (nclk_t)(seconds * FLOAT_BILLION);
+		if (hb.hb_interval == 0)
+			hb.hb_interval = 1;
+		return_value = 2;
 	// Otherwise check to see if it is any of the recognized words
-	if ((strcmp(sp, "operations") == 0) || (strcmp(sp, "ops") == 0)) { // Report OPERATIONS 
+	} else if ((strcmp(sp, "operations") == 0) || (strcmp(sp, "ops") == 0)) { // Report OPERATIONS 
 			hb.hb_options |= HB_OPS;
 			return_value = 2;
 	} else if ((strcmp(sp, "bytes") == 0) || (strcmp(sp, "b") == 0)) { // Report Bytes 
@@ -1527,6 +1613,14 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	} else if ((strcmp(sp, "ignorerestart") == 0) || (strcmp(sp, "ir") == 0) || (strcmp(sp, "ignore") == 0)) { // Ignore the restart adjustments
 			hb.hb_options |= HB_IGNORE_RESTART;
 			return_value = 2;
+	} else if ((strcmp(sp, "timeseries") == 0) || (strcmp(sp, "ts") == 0)) { // Write the statistics of each interval to a file
+			if (argc < 3) {
+				fprintf(stderr,"%s: ERROR: No file name specified for '-heartbeat timeseries'\n", xgp->progname);
+				return(-1);
+			}
+			hb.hb_options |= HB_TIMESERIES;
+			hb.hb_ts_filename=argv[2];
+			return_value = 3;
 	} 
 	if (return_value == -1) {
 		// Not a recognizable option
@@ -1536,6 +1630,8 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 
 	// At this point we have figured out what was specified. Now we just have to put it into the proper Target Data Struct.
 	xgp->global_options |= GO_HEARTBEAT;
+	if (hb.hb_options & HB_TIMESERIES) // The latency percentiles of each interval come from the latency histograms
+		xgp->global_options |= GO_LATENCY_HISTOGRAM;
     // At this point the "target_number" is valid
 	if (target_number >= 0) { /* Set this option for a specific target */
 		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -1545,18 +1641,18 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		if (hb.hb_interval > 0) 
 			tdp->td_hb.hb_interval = hb.hb_interval;
 		if (hb.hb_filename) {
-			len = strlen(hb.hb_filename);
-			filename = (char *)malloc(len+16);
-			if (filename == NULL) {
-				fprintf(stderr,"%s: ERROR: Cannot allocate %d bytes for heartbeat output file name: '%s'\n", xgp->progname, len+16,hb.hb_filename);
+			tdp->td_hb.hb_filename = xdd_heartbeat_filename(hb.hb_filename, tdp->td_target_number);
+			if (tdp->td_hb.hb_filename == NULL)
 				return(-1);
-			}
-			sprintf(filename,"%s.T%04d.csv",hb.hb_filename,tdp->td_target_number);
-			tdp->td_hb.hb_filename = filename;
 		}
-		// Check to see if the heartbeat interval has been set yet. If not, then set it to 1.
+		if (hb.hb_ts_filename) {
+			tdp->td_hb.hb_ts_filename = xdd_heartbeat_filename(hb.hb_ts_filename, tdp->td_target_number);
+			if (tdp->td_hb.hb_ts_filename == NULL)
+				return(-1);
+		}
+		// Check to see if the heartbeat interval has been set yet. If not, then set it to 1 second.
 		if (tdp->td_hb.hb_interval == 0)
-			tdp->td_hb.hb_interval = 1;
+			tdp->td_hb.hb_interval = (nclk_t)BILLION;
         return(args+return_value);
     } else {// Put this option into all Targets 
 		if (flags & XDD_PARSE_PHASE2) {
@@ -1568,18 +1664,18 @@ xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 				if (hb.hb_interval > 0) 
 					tdp->td_hb.hb_interval = hb.hb_interval;
 				if (hb.hb_filename) {
-					len = strlen(hb.hb_filename);
-					filename = (char *)malloc(len+16);
-					if (filename == NULL) {
-						fprintf(stderr,"%s: ERROR: Cannot allocate %d bytes for heartbeat output file name: '%s'\n", xgp->progname, len+16,hb.hb_filename);
+					tdp->td_hb.hb_filename = xdd_heartbeat_filename(hb.hb_filename, tdp->td_target_number);
+					if (tdp->td_hb.hb_filename == NULL)
+						return(-1);
+				}
+				if (hb.hb_ts_filename) {
+					tdp->td_hb.hb_ts_filename = xdd_heartbeat_filename(hb.hb_ts_filename, tdp->td_target_number);
+					if (tdp->td_hb.hb_ts_filename == NULL)
 						return(-1);
-					}
-					sprintf(filename,"%s.T%04d.csv",hb.hb_filename,tdp->td_target_number);
-					tdp->td_hb.hb_filename = filename;
 				}
-				// Check to see if the heartbeat interval has been set yet. If not, then set it to 1.
+				// Check to see if the heartbeat interval has been set yet. If not, then set it to 1 second.
 				if (tdp->td_hb.hb_interval == 0)
-					tdp->td_hb.hb_interval = 1;
+					tdp->td_hb.hb_interval = (nclk_t)BILLION;
 				i++;
 				tdp = planp->target_datap[i];
 			}
@@ -1664,6 +1760,62 @@ xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
     return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Specify the I/O engine to use for a single target or for all targets
+// Arguments: -ioengine [target #] pthread|iouring|libaio
+// The default "pthread" engine uses one Worker Thread per outstanding I/O. 
+// The asynchronous engines issue all I/O from the Target Thread.
+int
+xddfunc_ioengine(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int 		args, i; 
+    int 		target_number;
+    target_data_t 	*tdp;
+	char		*enginep;
+	uint64_t	engine;
+
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	enginep = argv[args+1];
+	if ((strcmp(enginep, "pthread") == 0) || (strcmp(enginep, "threads") == 0)) {
+		engine = 0;
+	} else if ((strcmp(enginep, "iouring") == 0) || (strcmp(enginep, "io_uring") == 0)) {
+		engine = TO_IO_URING;
+	} else if ((strcmp(enginep, "libaio") == 0) || (strcmp(enginep, "aio") == 0)) {
+		engine = TO_LIBAIO;
+	} else {
+		fprintf(xgp->errout,"%s: xddfunc_ioengine: ERROR: Unknown I/O engine '%s'. This should be 'pthread', 'iouring', or 'libaio'.\n",
+			xgp->progname,
+			enginep);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_target_options &= ~TO_ASYNC_IO_ENGINE;
+		tdp->td_target_options |= engine;
+        return(args+2);
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_target_options &= ~TO_ASYNC_IO_ENGINE;
+				tdp->td_target_options |= engine;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(2);
+	}
+} // End of xddfunc_ioengine()
+/*----------------------------------------------------------------------------*/
 // Specify the number of KBytes to transfer per pass (1K=1024 bytes)
 // Arguments: -kbytes [target #] #
 // This will set tdp->td_bytes to the calculated value (kbytes * 1024)
@@ -1707,6 +1859,21 @@ xddfunc_kbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Keep latency histograms and write them to a CSV file
+// Arguments: -latencyhistogram <filename>
+int
+xddfunc_latency_histogram(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+
+	if (argc <= 1) {
+		fprintf(stderr,"%s: Error: No file name specified for the '-latencyhistogram' option\n", xgp->progname);
+		return(-1);
+	}
+	xgp->global_options |= GO_LATENCY_HISTOGRAM;
+	planp->latency_histogram_filename = argv[1];
+	return(2);
+}
+/*----------------------------------------------------------------------------*/
 /*  -lockstep
 	-ls
 	-lockstepoverlapped
@@ -2151,6 +2318,85 @@ xddfunc_memalign(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 } 
 /*----------------------------------------------------------------------------*/
+// Set one -metadata suboption in the metadata structure of a target
+static int
+xddfunc_metadata_set(target_data_t *tdp, char *what, char *value)
+{
+	xint_metadata_t	*mdp;
+	int64_t			count;
+
+
+	mdp = xdd_get_metadatap(tdp);
+	if (mdp == NULL)
+		return(-1);
+	tdp->td_target_options |= TO_METADATA;
+	if (strcmp(what, "phases") == 0) {
+		if (xdd_metadata_parse_phases(mdp, value) < 0) {
+			fprintf(xgp->errout,"%s: ERROR: metadata phases '%s' is not valid. phases must be 'all' or a comma separated list of create,stat,open,readdir,rename,unlink without repeats\n",xgp->progname,value);
+			return(-1);
+		}
+		return(0);
+	}
+	count = atoll(value);
+	if (count <= 0) {
+		fprintf(xgp->errout,"%s: ERROR: metadata %s of %lld is not valid. It must be a number greater than 0\n",xgp->progname,what,(long long int)count);
+		return(-1);
+	}
+	if (strcmp(what, "files") == 0) 
+		mdp->md_files_per_worker = count;
+	else mdp->md_dirs_per_worker = count;
+	return(0);
+}
+/*----------------------------------------------------------------------------*/
+// Run a metadata workload on a directory target in place of data I/O
+// Arguments: -metadata [target #] files <#> | dirs <#> | phases <list>
+// Each Worker Thread works on <#> files spread over its <#> directories and
+// each pass runs the phases in the order given
+int
+xddfunc_metadata(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    char *what;
+    char *value;
+    target_data_t *tdp;
+    int retval;
+
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+	if (argc < args+3) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-metadata'\n",xgp->progname);
+		return(0);
+	}
+	what = argv[args+1];
+	value = argv[args+2];
+	retval = args+3;
+	if ((strcmp(what, "files") != 0) && (strcmp(what, "dirs") != 0) && (strcmp(what, "phases") != 0)) {
+		fprintf(xgp->errout,"%s: ERROR: metadata option '%s' is not valid. It must be one of files, dirs or phases\n",xgp->progname,what);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		if (xddfunc_metadata_set(tdp, what, value) < 0)
+			return(0);
+	} else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				if (xddfunc_metadata_set(tdp, what, value) < 0)
+					return(0);
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+}
+/*----------------------------------------------------------------------------*/
 // Set the  no mem lock and no proc lock flags 
 int
 xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -2540,7 +2786,7 @@ xddfunc_output_format(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 				fprintf(stderr,"%s: Error: No format string specified for '-outputformat add' option\n", xgp->progname);
 				return(-1);
 			}
-			xdd_results_format_id_add(argv[2], planp->format_string);
+			planp->format_string = xdd_results_format_id_add(argv[2], planp->format_string);
 			return(3);
 		}
 		if (strcmp(argv[1], "new") == 0) {
@@ -3196,6 +3442,31 @@ xddfunc_restart(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			}
 		} 
 		return(args_index+2);
+	} else if (strcmp(argv[args_index], "journal") == 0) { /* Keep a journal of the completed extents in this file */
+		if(planp->restart_frequency == 0)  // Turn on restart 
+			planp->restart_frequency = 1;
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			rp = xdd_get_restartp(tdp);
+			if (rp == NULL) return(-1);
+			rp->journal_filename = argv[args_index+1];
+			tdp->td_target_options |= TO_RESTART_ENABLE;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					rp = xdd_get_restartp(tdp);
+					if (rp == NULL) return(-1);
+					rp->journal_filename = argv[args_index+1];
+					tdp->td_target_options |= TO_RESTART_ENABLE;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+2);
 	} else if ((strcmp(argv[args_index], "frequency") == 0) || 
 			   (strcmp(argv[args_index], "freq") == 0)) { // The frequency in seconds to check the threads
 		if (target_number >= 0) {  /* set option for specific target */
@@ -3608,6 +3879,40 @@ xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			}
 		}  
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "lazy") == 0) { /* generate seek locations as they are needed */
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_seekhdr.seek_options |= SO_SEEK_LAZY;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_seekhdr.seek_options |= SO_SEEK_LAZY;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}  
+		return(args_index+1);
+	} else if (strcmp(argv[args_index], "physical") == 0) { /* order the seek locations by physical layout */
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_seekhdr.seek_options |= SO_SEEK_PHYSICAL;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_seekhdr.seek_options |= SO_SEEK_PHYSICAL;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}  
+		return(args_index+1);
 	} else if (strcmp(argv[args_index], "range") == 0) { /* set the range of seek locations */
 		if (target_number >= 0) {  /* set option for specific target */
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -4099,6 +4404,91 @@ xddfunc_stoptrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Set one -stripe suboption in the stripe structure of a target
+static int
+xddfunc_stripe_set(target_data_t *tdp, char *what, char *value)
+{
+	xint_stripe_t	*stp;
+	int64_t			number;
+	char			*cp;
+
+
+	stp = xdd_get_stripep(tdp);
+	if (stp == NULL)
+		return(-1);
+	tdp->td_target_options |= TO_STRIPE;
+	if (strcmp(what, "files") == 0) {
+		stp->stripe_file_list = strdup(value);
+		if (stp->stripe_file_list == NULL)
+			return(-1);
+		stp->stripe_count = 1;
+		for (cp = value; *cp; cp++)
+			if ((*cp == ',') && (*(cp+1) != '\0'))
+				stp->stripe_count++;
+		return(0);
+	}
+	number = atoll(value);
+	if (number <= 0) {
+		fprintf(xgp->errout,"%s: ERROR: stripe %s of %lld is not valid. It must be a number greater than 0\n",xgp->progname,what,(long long int)number);
+		return(-1);
+	}
+	if (strcmp(what, "unit") == 0) {
+		stp->stripe_unit = number;
+	} else if (stp->stripe_file_list) {
+		fprintf(xgp->errout,"%s: ERROR: stripe count cannot be used with stripe files - the count is the number of files\n",xgp->progname);
+		return(-1);
+	} else stp->stripe_count = number;
+	return(0);
+}
+/*----------------------------------------------------------------------------*/
+// Stripe the offsets of a target across several files or devices
+// Arguments: -stripe [target #] count <#> | unit <#bytes> | files <name,name,...>
+// With "count" the files are named after the target with a ".<file#>" extension
+int
+xddfunc_stripe(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    char *what;
+    char *value;
+    target_data_t *tdp;
+    int retval;
+
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+	if (argc < args+3) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-stripe'\n",xgp->progname);
+		return(0);
+	}
+	what = argv[args+1];
+	value = argv[args+2];
+	retval = args+3;
+	if ((strcmp(what, "count") != 0) && (strcmp(what, "unit") != 0) && (strcmp(what, "files") != 0)) {
+		fprintf(xgp->errout,"%s: ERROR: stripe option '%s' is not valid. It must be one of count, unit or files\n",xgp->progname,what);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		if (xddfunc_stripe_set(tdp, what, value) < 0)
+			return(0);
+	} else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				if (xddfunc_stripe_set(tdp, what, value) < 0)
+					return(0);
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return(retval);
+}
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_syncio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -4365,6 +4755,50 @@ xddfunc_targetout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(args);
 }
 /*----------------------------------------------------------------------------*/
+// Specify the number of times a Worker Thread polls its task ring before it
+// goes to sleep waiting for the Target Thread to post the next task.
+// Arguments: -taskspin [target #] #iterations
+int
+xddfunc_taskspin(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{ 
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	int32_t task_ring_spin;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	task_ring_spin = atoi(argv[args+1]);
+	if (task_ring_spin < 0) {
+		fprintf(xgp->errout,"%s: xddfunc_taskspin: ERROR: The task spin count must be 0 or greater\n",
+			xgp->progname);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_task_ring_spin = task_ring_spin;
+        return(args+2);
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_task_ring_spin = task_ring_spin;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(2);
+	}
+} // End of xddfunc_taskspin()
+/*----------------------------------------------------------------------------*/
 // Specify the throttle type and associated throttle value 
 // Arguments: -throttle [target #] bw|ops|var #.#
 // 
@@ -4823,6 +5257,46 @@ xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		}
 		planp->ts_binary_filename_prefix = argv[args_index];
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "stream") == 0) { /* stream the timestamp entries to a binary file "filename" during the run */
+		if (argc < 3) {
+			fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-timestamp'\n",xgp->progname);
+			return(0);
+		}
+        args_index++;
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_DUMP | TS_STREAM);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_DUMP | TS_STREAM);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		planp->ts_binary_filename_prefix = argv[args_index];
+		return(args_index+1);
+	} else if (strcmp(argv[args_index], "compact") == 0) { /* write the binary timestamp file in the columnar format */
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_COMPACT);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_COMPACT);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
 	} else if (strcmp(argv[args_index], "summary") == 0) { /* set the time stamp SUMMARY reporting option */
 		if (target_number >= 0) {
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
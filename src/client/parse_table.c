@@ -26,7 +26,7 @@
 //                int     (*func_ptr)(int32_t argc, char *argv[], uint32_t flags, uint32_t flags);      /* pointer to the function */
 //                int     argc;           /* number of arguments */
 //                char    *help;          /* help string */
-//                char    *ext_help[5];   /* Extented help strings */
+//                char    *ext_help[7];   /* Extented help strings */
 //            };
 xdd_func_t  xdd_func[] = {
     {"blocksize", "bs",
@@ -132,9 +132,13 @@ xdd_func_t  xdd_func[] = {
     {"endtoend", "e2e",
             xddfunc_endtoend,
             1,
-            "  -endtoend [target #]  issource | isdestination | destination <hostname[:baseport#[,portcount]]> | port <#> | portcount <#>\n",
-            {"    Specifies a source and destination information for doing end-to-end test between two machines",
-            0,0,0,0},
+            "  -endtoend [target #]  issource | isdestination | destination <hostname[:baseport#[,portcount]]> | port <#> | portcount <#> | zerocopy | files | filelist <filename>\n",
+            {"    Specifies a source and destination information for doing end-to-end test between two machines\n",
+            "    'zerocopy' splices the data between the target file and the socket on either side with buffered I/O instead of copying it through the I/O buffer\n",
+            "    with '-xni tcp' the source sends the I/O buffers with MSG_ZEROCOPY instead\n",
+            "    'files' makes the target a directory: the source sends every file below it, packing small files into shared requests, and the destination recreates the tree\n",
+            "    'filelist' sends only the files and directories listed one per line in <filename>, relative to the source directory\n",
+            0,0},
 			0},
     {"errout", "eo",
             xddfunc_errout,     
@@ -167,8 +171,8 @@ xdd_func_t  xdd_func[] = {
     {"heartbeat", "hb",
             xddfunc_heartbeat,  
             1,  
-            "  -heartbeat # | ops | bytes | kbytes | mbytes | gbytes | percent | bw | iops | et | lf | tod | elapsed | target | hostname | output <filename> | ignorerestart\n",  
-            {"    Will print out heartbeat information every # seconds \n\
+            "  -heartbeat # | ops | bytes | kbytes | mbytes | gbytes | percent | bw | iops | et | lf | tod | elapsed | target | hostname | output <filename> | timeseries <filename> | ignorerestart\n",  
+            {"    Will print out heartbeat information every # seconds - fractions such as 0.1 are allowed \n\
  			     'operations' | 'ops' - current number of operations complete \n\
                  'bytes' | 'b' -  current bytes transfered \n\
                  'kbytes' | 'kb' - current Kilo Bytes transfered \n\
@@ -184,6 +188,7 @@ xdd_func_t  xdd_func[] = {
                  'target' | 'tgt' - Target Number\n\
                  'hostname' | 'host' - Name of host\n\
                  'output' | 'out' <filename> - Name of an output file - default stderr\n\
+                 'timeseries' | 'ts' <filename> - Write the bandwidth, IOPS, latency and queue occupancy of each interval to a CSV file\n\
                  'ignorerestart' | 'ir' - ignore the fact that a restart is in process\n",
 			 "Specifying -heartbeat multiple times will add these to the heartbeat output string FOR EACH TARGET\n",
             0,0,0},
@@ -209,6 +214,15 @@ xdd_func_t  xdd_func[] = {
             {"    Indicates that XDD should start up in Interactive Mode - targets will not start until the 'run' command is given.\n", 
             0,0,0,0},
 			0},
+    {"ioengine",   "ioe",
+            xddfunc_ioengine, 
+            1,  
+            "  -ioengine [target <target#>] pthread | iouring | libaio\n",  
+            {"    Selects how I/O operations are issued. 'pthread' (default) uses one Worker Thread per outstanding I/O.\n", 
+             "    'iouring' has the Target Thread submit and reap all -queuedepth operations through a single io_uring.\n",
+             "    'libaio' does the same with Linux native AIO in batches - use it with -dio to get asynchronous I/O.\n",
+			0,0},
+			0},
     {"kbytes",  "kb",
             xddfunc_kbytes,     
             1,  
@@ -216,6 +230,15 @@ xdd_func_t  xdd_func[] = {
             {"    Specifies the number of 1024-byte blocks to transfer during a single pass\n", 
             0,0,0,0},
 			0},
+    {"latencyhistogram", "lathist",
+            xddfunc_latency_histogram,     
+            1,  
+            "  -latencyhistogram <filename>\n",  
+            {"    Keeps a latency histogram for each Worker Thread and writes the histograms of every pass\n", 
+             "    and of the whole run to the CSV file 'filename'. Latency histograms are also kept when\n",
+             "    the output format includes any of the +P50LATENCY ... +P9999LATENCY format identifiers\n",
+            0,0},
+			0},
     {"lockstep", "ls",
             xddfunc_lockstep,   
             1,  
@@ -305,6 +328,16 @@ xdd_func_t  xdd_func[] = {
             {"    Align memory on an #-byte boundary - should be an even number\n", 
             0,0,0,0},
 			0},
+    {"metadata", "md",
+            xddfunc_metadata,
+            1,
+            "  -metadata [target <target#>] files <#> | dirs <#> | phases <list>\n",
+            {"    Run a metadata workload in the target directory in place of data I/O. Each Worker Thread\n",
+            "    creates, stats, opens, lists, renames and unlinks <#> files (default 1000) spread over\n",
+            "    <#> directories (default 1). 'phases' picks and orders the phases of a pass, e.g. create,stat\n",
+            "    Each phase reports ops/sec and latency percentiles after the COMBINED results\n",
+            0,0},
+			0},
     {"minall", "minall",
             xddfunc_minall,     
             1,  
@@ -394,7 +427,8 @@ xdd_func_t  xdd_func[] = {
             {"    Specify a 'new' output format or 'add' variables to the existing output format.\n",
              "    The existing output format specification is as follows:\n",
              DEFAULT_OUTPUT_FORMAT_STRING,
-            0,0},
+             "\n    Latency percentiles: +P50LATENCY +P90LATENCY +P99LATENCY +P999LATENCY +P9999LATENCY, also as +READP..LATENCY and +WRITEP..LATENCY\n",
+            0},
 			0},
     {"passdelay", "pdelay",       
             xddfunc_passdelay,      
@@ -517,9 +551,11 @@ xdd_func_t  xdd_func[] = {
     {"restart", "rst",
             xddfunc_restart,    
             1,  
-            "  -restart [target <target#>] enable | frequency <seconds> | file <name_of_restart_file> | offset <offset_in_bytes>\n",  
+            "  -restart [target <target#>] enable | frequency <seconds> | file <name_of_restart_file> | journal <name_of_journal_file> | offset <offset_in_bytes>\n",  
             {"    if just 'enable' is specified then the restart will start monitoring an end-to-end operation\n",
              "    if the name of the restart file is specified then a restart operation is attempted \n",
+             "    if a journal is specified then the destination records every range it has committed in that file and\n",
+             "    a source given the same journal only sends the ranges that are not in it - remove the journal to start over\n",
              "    if the offset is specified then a restart from that point is initiated regardless of what the restart file indicates\n",
              "    The 'frequency' is the number of seconds between monitor events and defaults to 1\n",
              0},
@@ -560,7 +596,7 @@ xdd_func_t  xdd_func[] = {
     {"seek",  "s",
             xddfunc_seek,       
             1,  
-            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | range #blocks | stagger #blocks | interleave #blocks | seed # | none\n",  
+            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | range #blocks | stagger #blocks | interleave #blocks | seed # | none | lazy | physical\n",  
             {"    -seek 'save <filename>' will save the seek list in the file specified\n\
     -seek 'load <filename>' will load the seek list from the file specified\n\
     -seek 'disthist #buckets' will display a 'seek distance' histogram using the specified number of 'buckets'\n\
@@ -571,8 +607,10 @@ xdd_func_t  xdd_func[] = {
     -seek 'stagger' specifies a staggered sequential access over 'range', by #blocks stride if > reqsize\n\
     -seek 'interleave #' specifies the number of blocksized blocks to interleave into the access pattern\n\
     -seek 'seed #' specifies a seed to use when generating random numbers\n\
-    -seek 'none' do not seek - retransfer the same block each time \n",
-                0,0,0},
+    -seek 'none' do not seek - retransfer the same block each time \n\
+    -seek 'lazy' generate each seek location when it is needed instead of building the seek list\n",
+             "    -seek 'physical' order the seek list by where each location lies on the device (Linux FIEMAP)\n",
+                0,0},
 			0},
     {"serialordering", "so",
             xddfunc_serialordering,     
@@ -652,6 +690,15 @@ xdd_func_t  xdd_func[] = {
             "  -stoptrigger <target#> <target#> <<time|op|percent|mbytes|kbytes> #>\n",   
             {" ", 0,0,0,0},
 			0},
+    {"stripe", "stripe",
+            xddfunc_stripe,
+            1,
+            "  -stripe [target <target#>] count <#> | unit <#bytes> | files <name,name,...>\n",
+            {"    Stripe the offsets of the target across several files or devices in units of <#bytes>\n",
+            "    (default 1048576). With 'count' the files are the target name with a .<file#> extension,\n",
+            "    with 'files' they are the names given. The Worker Threads share one file descriptor per file\n",
+            0,0,0},
+			0},
     {"syncio", "sio",
             xddfunc_syncio,     
             1,  
@@ -741,6 +788,14 @@ xdd_func_t  xdd_func[] = {
              "    See also: -targetin\n",
              0},
 			0},
+    {"taskspin", "tspin",
+            xddfunc_taskspin, 
+            1,  
+            "  -taskspin [target #] #iterations\n",   
+            {"    Specifies the number of times a Worker Thread polls for its next task before it sleeps.\n", 
+             "    The default is 0 which sleeps right away. Spinning lowers the per-I/O hand-off latency at the cost of CPU time.\n",
+            0,0,0},
+			0},
     {"throttle", "throt",
             xddfunc_throttle,   
             1,  
@@ -777,7 +832,7 @@ xdd_func_t  xdd_func[] = {
     {"timestamps", "ts",
             xddfunc_timestamp,  
             1,  
-            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|triggertime <seconds>|triggerop <op#>\n",   
+            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|stream <filename>|compact|triggertime <seconds>|triggerop <op#>\n",   
             {"    -ts  'summary' will turn on time stamping with summary reporting option\n\
     -ts  'detailed'  will turn on time stamping with detailed reporting option\n\
     -ts  'wrap'  will cause the timestamp buffer to wrap after N timestamp entries are used. Should be used in conjunction with -ts size.\n\
@@ -788,6 +843,8 @@ xdd_func_t  xdd_func[] = {
     -ts  'append'  will append output to existing output file.\n\
     -ts  'output filename' will print the output to file 'filename'. Default output is stdout\n\
     -ts  'dump filename'  will turn on time stamping and dump a binary time stamp file to 'filename'\n\
+    -ts  'stream filename'  will turn on time stamping and write the binary time stamp file 'filename' while the run is in progress. Use -ts size to set the number of entries kept in memory.\n\
+    -ts  'compact'  will write the binary time stamp file of 'dump' or 'stream' in the columnar format, which is several times smaller\n\
     Default is no time stamping.\n",
               0,0,0},
 			0},
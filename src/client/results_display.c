@@ -224,6 +224,95 @@ xdd_results_fmt_latency(results_t *rp) {
 
 }
 /*----------------------------------------------------------------------------*/
+// All the latency percentiles are displayed the same way - only the header
+// and the value differ. A value of -1 means that there were no ops to measure.
+static void
+xdd_results_fmt_latency_percentile(results_t *rp, char *header, double value) {
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%11s",header);
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%11s","   millisec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		fprintf(rp->output,"%11.3f",value);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p50_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "    P50_Lat", rp->latency_percentile[RESULTS_P50]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p90_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "    P90_Lat", rp->latency_percentile[RESULTS_P90]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p99_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "    P99_Lat", rp->latency_percentile[RESULTS_P99]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P99.9_Lat", rp->latency_percentile[RESULTS_P999]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p9999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, " P99.99_Lat", rp->latency_percentile[RESULTS_P9999]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_read_p50_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P50_RdLat", rp->read_latency_percentile[RESULTS_P50]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_read_p90_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P90_RdLat", rp->read_latency_percentile[RESULTS_P90]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_read_p99_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P99_RdLat", rp->read_latency_percentile[RESULTS_P99]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_read_p999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "P99.9_RdLat", rp->read_latency_percentile[RESULTS_P999]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_read_p9999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "P99.99_RdLat", rp->read_latency_percentile[RESULTS_P9999]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_write_p50_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P50_WrLat", rp->write_latency_percentile[RESULTS_P50]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_write_p90_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P90_WrLat", rp->write_latency_percentile[RESULTS_P90]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_write_p99_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "  P99_WrLat", rp->write_latency_percentile[RESULTS_P99]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_write_p999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "P99.9_WrLat", rp->write_latency_percentile[RESULTS_P999]);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_write_p9999_latency(results_t *rp) {
+	xdd_results_fmt_latency_percentile(rp, "P99.99_WrLat", rp->write_latency_percentile[RESULTS_P9999]);
+}
+/*----------------------------------------------------------------------------*/
 void 
 xdd_results_fmt_elapsed_time_from_1st_op(results_t *rp) {
 	if (rp->flags & RESULTS_HEADER_TAG) {
@@ -267,7 +356,7 @@ xdd_results_fmt_elapsed_pattern_fill_time(results_t *rp) {
 	} else if (rp->flags & RESULTS_UNITS_TAG) {
 		fprintf(rp->output,"%9s"," millisec");
 	} else if (rp->flags & RESULTS_PASS_INFO) {
-		fprintf(rp->output,"%9.3f",-1.0);
+		fprintf(rp->output,"%9.3f",rp->accumulated_pattern_fill_time);
 	}
 
 }
@@ -547,6 +636,21 @@ static	xdd_results_fmt_t	xdd_results_fmt_table[] = {
 	{"+READIOPS", 			xdd_results_fmt_read_iops},
 	{"+WRITEIOPS", 			xdd_results_fmt_write_iops},
 	{"+LATENCY", 			xdd_results_fmt_latency},
+	{"+P50LATENCY", 			xdd_results_fmt_p50_latency},
+	{"+P90LATENCY", 			xdd_results_fmt_p90_latency},
+	{"+P99LATENCY", 			xdd_results_fmt_p99_latency},
+	{"+P999LATENCY", 			xdd_results_fmt_p999_latency},
+	{"+P9999LATENCY", 			xdd_results_fmt_p9999_latency},
+	{"+READP50LATENCY", 		xdd_results_fmt_read_p50_latency},
+	{"+READP90LATENCY", 		xdd_results_fmt_read_p90_latency},
+	{"+READP99LATENCY", 		xdd_results_fmt_read_p99_latency},
+	{"+READP999LATENCY", 		xdd_results_fmt_read_p999_latency},
+	{"+READP9999LATENCY", 		xdd_results_fmt_read_p9999_latency},
+	{"+WRITEP50LATENCY", 		xdd_results_fmt_write_p50_latency},
+	{"+WRITEP90LATENCY", 		xdd_results_fmt_write_p90_latency},
+	{"+WRITEP99LATENCY", 		xdd_results_fmt_write_p99_latency},
+	{"+WRITEP999LATENCY", 		xdd_results_fmt_write_p999_latency},
+	{"+WRITEP9999LATENCY", 	xdd_results_fmt_write_p9999_latency},
 	{"+ELAPSEDTIME1STOP", 	xdd_results_fmt_elapsed_time_from_1st_op},
 	{"+ELAPSEDTIMEPASS", 	xdd_results_fmt_elapsed_time_from_pass_start},
 	{"+OVERHEADTIME", 		xdd_results_fmt_elapsed_over_head_time},
@@ -690,10 +794,32 @@ xdd_results_display(results_t *rp) {
 			
 }
 
+/*----------------------------------------------------------------------------*/
+// This routine returns 1 if the specified format string displays any of the
+// latency percentiles, which need the latency histograms, and 0 otherwise.
+int
+xdd_results_format_uses_latency_histogram(char *format_stringp) {
+	int		index;
+
+
+	if (format_stringp == NULL)
+		return(0);
+	index = 0;
+	while (xdd_results_fmt_table[index].fmt_name != NULL) {
+		if ((strstr(xdd_results_fmt_table[index].fmt_name, "LATENCY") != NULL) &&
+			(strcmp(xdd_results_fmt_table[index].fmt_name, "+LATENCY") != 0) &&
+			(strstr(format_stringp, xdd_results_fmt_table[index].fmt_name) != NULL))
+			return(1);
+		index++;
+	}
+	return(0);
+}
+
 /*----------------------------------------------------------------------------*/
 // This routine will add a string of format IDs or other text to the end
-// of the existing format ID string.
-void 
+// of the existing format ID string and return the new format ID string.
+// The existing format ID string is returned if there is no memory for the new one.
+char *
 xdd_results_format_id_add( char *sp , char *format_stringp) {
 
 	char	*tmpp;
@@ -713,9 +839,9 @@ xdd_results_format_id_add( char *sp , char *format_stringp) {
 			new_length,
 			sp,
 			format_stringp);
+		return(format_stringp);
 	}
 	sprintf(tmpp, "%s%s ",format_stringp, sp);
-	format_stringp = tmpp;
 	
-	return;
+	return(tmpp);
 }
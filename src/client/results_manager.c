@@ -186,6 +186,56 @@ xdd_results_header_display(results_t *tmprp, xdd_plan_t *planp) {
 	
 } // End of xdd_results_header_display()
 
+/*----------------------------------------------------------------------------*/
+// xdd_latency_histogram_dump_targets() 
+// Write the latency histograms of all the targets to the -latencyhistogram file.
+// For a pass the histogram of each Worker Thread is written followed by the
+// histogram of the whole target. For the run only the target histograms are written.
+// Called by xdd_process_pass_results() and xdd_process_run_results()
+//
+static void
+xdd_latency_histogram_dump_targets(xdd_plan_t *planp, int run) {
+	int				target_number;
+	target_data_t	*tdp;
+	worker_data_t	*wdp;
+	char			pass[32];
+	char			worker[32];
+
+
+	if (planp->latency_histogram_fp == NULL) {
+		planp->latency_histogram_fp = fopen(planp->latency_histogram_filename, "w");
+		if (planp->latency_histogram_fp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_latency_histogram_dump_targets: ERROR: Cannot open latency histogram file '%s'\n",
+				xgp->progname, planp->latency_histogram_filename);
+			perror("reason");
+			planp->latency_histogram_filename = NULL; // Do not try again
+			return;
+		}
+		xdd_latency_histogram_dump_header(planp->latency_histogram_fp);
+	}
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		if (run) {
+			if (tdp->td_lathist_runp)
+				xdd_latency_histogram_dump(planp->latency_histogram_fp, tdp->td_lathist_runp, "all", target_number, "all");
+			continue;
+		}
+		if (tdp->td_lathistp == NULL)
+			continue;
+		sprintf(pass, "%d", tdp->td_counters.tc_pass_number);
+		wdp = tdp->td_next_wdp;
+		while (wdp) {
+			if (wdp->wd_lathistp) {
+				sprintf(worker, "%d", wdp->wd_worker_number);
+				xdd_latency_histogram_dump(planp->latency_histogram_fp, wdp->wd_lathistp, pass, target_number, worker);
+			}
+			wdp = wdp->wd_next_wdp;
+		}
+		xdd_latency_histogram_dump(planp->latency_histogram_fp, tdp->td_lathistp, pass, target_number, "all");
+	}
+	fflush(planp->latency_histogram_fp);
+} // End of xdd_latency_histogram_dump_targets()
+
 /*----------------------------------------------------------------------------*/
 // xdd_process_pass_results() 
 // Called by xdd_results_manager() 
@@ -255,6 +305,10 @@ xdd_process_pass_results(xdd_plan_t *planp) {
 	
     } /* end of FOR loop that looks at all targets */
     
+	// Write the latency histograms of this pass if requested
+	if (planp->latency_histogram_filename)
+		xdd_latency_histogram_dump_targets(planp, 0);
+
 	if (planp->heartbeat_flags & HEARTBEAT_ACTIVE) 
 		planp->heartbeat_flags &= ~HEARTBEAT_HOLDOFF;
 
@@ -273,6 +327,7 @@ xdd_process_run_results(xdd_plan_t *planp) {
 	results_t	*tarp;	// Pointer to the Target Average results structure
 	results_t	*crp;	// Pointer to the temporary combined run results
 	results_t	combined_results; // Temporary for target combined results
+	xint_latency_histogram_t	*combined_lathistp; // Latency histogram of all targets for this run
 
 
 	// At this point all the Target Threads are waiting for this routine
@@ -293,6 +348,11 @@ xdd_process_run_results(xdd_plan_t *planp) {
 	crp->shortest_read_op_time = (double)DOUBLE_MAX;
 	crp->shortest_write_op_time = (double)DOUBLE_MAX;
 
+	// The latency percentiles of the COMBINED results come from the histograms of all targets
+	combined_lathistp = NULL;
+	if (xgp->global_options & GO_LATENCY_HISTOGRAM)
+		combined_lathistp = xdd_latency_histogram_alloc(planp->number_of_targets, "combined");
+
 	for (target_number=0; target_number<planp->number_of_targets; target_number++) {
 		tdp = planp->target_datap[target_number]; /* Get the target_datap for this target */
 		tarp = planp->target_average_resultsp[target_number];
@@ -305,6 +365,9 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		tarp->what = "TARGET_AVERAGE";
 		tarp->output = xgp->output;
 		tarp->delimiter = ' ';
+		xdd_latency_histogram_percentiles(tarp, tdp->td_lathist_runp); // milliseconds
+		if (combined_lathistp && tdp->td_lathist_runp)
+			xdd_latency_histogram_merge(combined_lathistp, tdp->td_lathist_runp);
 		if (xgp->global_options & GO_VERBOSE) {
 			// Display the Target AVERAGE results if -verbose was specified
 			xdd_results_display(tarp);
@@ -321,6 +384,9 @@ xdd_process_run_results(xdd_plan_t *planp) {
 	} // End of FOR loop that processes all targets for the run
 
 	// Now lets display the COMBINED results
+	xdd_latency_histogram_percentiles(crp, combined_lathistp); // milliseconds
+	if (combined_lathistp)
+		free(combined_lathistp);
 	crp->output = xgp->output;
 	crp->delimiter = ' ';
 	xdd_results_display(crp);
@@ -335,6 +401,28 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		xdd_results_display(crp);
 	}
 
+	// Display the rate and latencies of each phase of the metadata workloads
+	// and the physical layout of the targets that were accessed in physical order
+	for (target_number=0; target_number<planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		if (tdp->td_mdp)
+			xdd_metadata_display(tdp, xgp->output);
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_PHYSICAL)
+			fprintf(xgp->output,"EXTENTS        %6d %12lld extents %12lld of %lld ops in physical order\n",
+				tdp->td_target_number,
+				(long long int)tdp->td_seekhdr.seek_physical_extents,
+				(long long int)tdp->td_seekhdr.seek_physical_ops,
+				(long long int)tdp->td_seekhdr.seek_total_ops);
+	}
+
+	// Write the latency histograms of the whole run and close the file
+	if (planp->latency_histogram_filename)
+		xdd_latency_histogram_dump_targets(planp, 1);
+	if (planp->latency_histogram_fp) {
+		fclose(planp->latency_histogram_fp);
+		planp->latency_histogram_fp = NULL;
+	}
+
 	// Process TimeStamp reports for the -ts option
 	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
 		tdp = planp->target_datap[target_number]; /* Get the target_datap for this target */
@@ -349,6 +437,12 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		}
 	} // End of processing TimeStamp reports
 
+	// Wait for the heartbeat to write the last interval of any time series and exit
+	if (planp->heartbeat_flags & HEARTBEAT_ACTIVE) {
+		pthread_join(planp->Heartbeat_Thread, NULL);
+		planp->heartbeat_flags &= ~HEARTBEAT_ACTIVE;
+	}
+
 	return(0);
 } // End of xdd_process_run_results() 
 
@@ -682,6 +776,44 @@ xdd_combine_results(results_t *to, results_t *from, xdd_plan_t *planp) {
 
 } // End of xdd_combine_results()
 
+/*----------------------------------------------------------------------------*/
+// xdd_extract_extended_stats() 
+// Copy the longest/shortest op statistics of a target for this pass into the 
+// specified results structure. The op times are converted to seconds. 
+// Op types that did not occur during the pass get a time of 0.
+//
+static void
+xdd_extract_extended_stats(results_t *rp, xint_extended_stats_t *esp) {
+
+	rp->longest_op_time = (double)esp->my_longest_op_time / FLOAT_BILLION;
+	rp->longest_read_op_time = (double)esp->my_longest_read_op_time / FLOAT_BILLION;
+	rp->longest_write_op_time = (double)esp->my_longest_write_op_time / FLOAT_BILLION;
+	rp->shortest_op_time = (esp->my_shortest_op_time == NCLK_MAX) ? 0.0 : (double)esp->my_shortest_op_time / FLOAT_BILLION;
+	rp->shortest_read_op_time = (esp->my_shortest_read_op_time == NCLK_MAX) ? 0.0 : (double)esp->my_shortest_read_op_time / FLOAT_BILLION;
+	rp->shortest_write_op_time = (esp->my_shortest_write_op_time == NCLK_MAX) ? 0.0 : (double)esp->my_shortest_write_op_time / FLOAT_BILLION;
+
+	rp->longest_op_bytes = esp->my_longest_op_bytes;
+	rp->longest_read_op_bytes = esp->my_longest_read_op_bytes;
+	rp->longest_write_op_bytes = esp->my_longest_write_op_bytes;
+	rp->shortest_op_bytes = esp->my_shortest_op_bytes;
+	rp->shortest_read_op_bytes = esp->my_shortest_read_op_bytes;
+	rp->shortest_write_op_bytes = esp->my_shortest_write_op_bytes;
+
+	rp->longest_op_number = esp->my_longest_op_number;
+	rp->longest_read_op_number = esp->my_longest_read_op_number;
+	rp->longest_write_op_number = esp->my_longest_write_op_number;
+	rp->shortest_op_number = esp->my_shortest_op_number;
+	rp->shortest_read_op_number = esp->my_shortest_read_op_number;
+	rp->shortest_write_op_number = esp->my_shortest_write_op_number;
+
+	rp->longest_op_pass_number = esp->my_longest_op_pass_number;
+	rp->longest_read_op_pass_number = esp->my_longest_read_op_pass_number;
+	rp->longest_write_op_pass_number = esp->my_longest_write_op_pass_number;
+	rp->shortest_op_pass_number = esp->my_shortest_op_pass_number;
+	rp->shortest_read_op_pass_number = esp->my_shortest_read_op_pass_number;
+	rp->shortest_write_op_pass_number = esp->my_shortest_write_op_pass_number;
+} // End of xdd_extract_extended_stats()
+
 /*----------------------------------------------------------------------------*/
 // xdd_extract_pass_results() 
 // This routine will extract the pass results from the specified target_data
@@ -718,7 +850,7 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	rp->accumulated_op_time = (double)((double)tdp->td_counters.tc_accumulated_op_time / FLOAT_BILLION); // nano to seconds
 	rp->accumulated_read_op_time = (double)((double)tdp->td_counters.tc_accumulated_read_op_time / FLOAT_BILLION); // nano to seconds
 	rp->accumulated_write_op_time = (double)((double)tdp->td_counters.tc_accumulated_write_op_time / FLOAT_BILLION); // nano to seconds
-	rp->accumulated_pattern_fill_time = (double)((double)tdp->td_counters.tc_accumulated_pattern_fill_time / FLOAT_BILLION); // nano to milli
+	rp->accumulated_pattern_fill_time = (double)((double)tdp->td_counters.tc_accumulated_pattern_fill_time / FLOAT_MILLION); // nano to milli
 	rp->accumulated_flush_time = (double)((double)tdp->td_counters.tc_accumulated_flush_time / FLOAT_BILLION); // nano to milli
 	rp->earliest_start_time_this_run = (double)(tdp->td_counters.tc_time_first_op_issued_this_pass); // nanoseconds
 	rp->earliest_start_time_this_pass = (double)(tdp->td_counters.tc_pass_start_time); // nanoseconds
@@ -747,6 +879,7 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	if (rp->iops == 0.0)
 		rp->latency = 0.0;
 	else rp->latency = (double)((1.0/rp->iops) * 1000.0);  // milliseconds
+	xdd_latency_histogram_percentiles(rp, tdp->td_lathistp); // milliseconds
 
 	// Times
 	rp->user_time =   (double)(tdp->td_counters.tc_current_cpu_times.tms_utime  - tdp->td_counters.tc_starting_cpu_times_this_pass.tms_utime)/(double)(xgp->clock_tick); // Seconds
@@ -775,6 +908,8 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	// Extended Statistics
 	// The Hig/Low values are only updated when the -extendedstats option is specified
 	if (xgp->global_options & GO_EXTENDED_STATS) {
+		if (tdp->td_esp)
+			xdd_extract_extended_stats(rp, tdp->td_esp);
 		if (rp->shortest_op_time > 0.0) {
 			rp->highest_bandwidth = rp->shortest_op_bytes / rp->shortest_op_time;
 			rp->highest_iops = 1.0 / rp->shortest_op_time;
@@ -64,52 +64,6 @@ xdd_tokenize(char *cp) {
 	return(tokens);
 } /* end of xdd_tokenize() */
 
-/*----------------------------------------------------------------------------*/
-/* xdd_random_int() - returns a random integer
- */
-int
-xdd_random_int(void) {
-    
-#ifdef HAVE_INITSTATE
-    if (xgp->random_initialized == 0) {
-	initstate(xgp->random_init_seed, xgp->random_init_state, 256);
-	xgp->random_initialized = 1;
-    }
-#endif
-
-#ifdef HAVE_RANDOM
-    return random();
-#elif HAVE_RAND
-    return rand();
-#endif
-} /* end of xdd_random_int() */
-/*----------------------------------------------------------------------------*/
-/* xdd_random_float() - returns a random floating point number in double.
- */
-double xdd_random_float(void) {
-    double rm;
-    double recip;
-    double rval;
-    
-#ifdef HAVE_INITSTATE
-    if (xgp->random_initialized == 0) {
-	initstate(xgp->random_init_seed, xgp->random_init_state, 256);
-	xgp->random_initialized = 1;
-    }
-#endif
-
-#ifdef HAVE_RANDOM
-    rm = RAND_MAX;
-    recip = 1.0 / rm;
-    rval = random();
-    rval = recip * rval;
-    if (rval > 1.0)
-	rval = 1.0/rval;
-#elif HAVE_RAND
-    rval = ((double)(1.0 / RAND_MAX) * rand());
-#endif
-    return(rval);
-} /* end of xdd_random_float() */
  
 /*
  * Local variables:
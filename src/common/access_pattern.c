@@ -16,39 +16,11 @@
  */
 #include "xint.h"
 /*----------------------------------------------------------------------------*/
-/* xdd_init_seek_list() - Generate the list of seek operations to perform
- * This routine will generate a list of locations to access within the
- * specified range for random seeks or within the implied range for 
- * purely sequential operations. 
- * The seek list is either loaded from a specified file or is generated
- * by this routine. 
- * Each entry in the seek list contains the seek location, the size of the
- * data transfer (currently reqsize), and the operation to perform.
- * The seek entries are first loaded with their locations and a second
- * pass assigns operations (read or write) to the locations as
- * necessary. 
- * Example A - A normal 100% write seek list
- *
- * Operation# Location Op 
- *    0     0  W 
- *    1     1024  W 
- *    2     2048  W 
- *    3     3072  W 
- *    n     n*1024 W
- *
+/* xdd_seek_generator_init() - Calculate everything that xdd_seek_generate()
+ * needs to produce any entry of the seek list for this target.
  */
 void
-xdd_init_seek_list(target_data_t *tdp) {
-	int32_t  j;
-	int32_t  rw_op_index;  /* relative rw index from 0 to the number of rw ops minus 1  */
-	int32_t  rw_index;   /* absolute index into seek list for the current rw op*/
-	int32_t  rw_index_incr;  /* read/write index increment value (1 or 2) */
-	int32_t  op_index;   /* Current operation number  (from 0 to sp->seek_total_ops-1 ) */
-	int64_t  gap;    /* The gap in blocks between staggered locations */
-	int64_t  interleave_threadoffset;
-	int64_t  range_in_bytes;
-	int64_t  range_in_1kblocks;
-	int64_t  range_in_blocksize_blocks;
+xdd_seek_generator_init(target_data_t *tdp) {
 	double  bytes_per_sec;  /* The tranfer rate requested by the -throttle option */
 	double  seconds_per_op; /* a floating point representation of the time per operation */
 	double  variance_seconds_per_op; /* a floating point representation of the time variance per operation */
@@ -58,14 +30,10 @@ xdd_init_seek_list(target_data_t *tdp) {
 	double  bytes_per_request; /* self explanatory */
 	nclk_t  nano_seconds_per_op = 0; /* self explanatory */
     nclk_t  nano_second_throttle_variance = 0; /* Max variance per operation */
-	nclk_t  relative_time; /* Time in nanosecond relative to the first operation */
-	int32_t  previous_percent_op; /* used to determine read/write operation */
-	int32_t  percent_op;  /* used to determine read/write operation */
-	int32_t  current_op;  /* Current operation - SO_OP_READ or SO_OP_WRITE or SO_OP_NOOP */
 	seekhdr_t *sp;   /* pointer to the seek header */
         
 	/* If a throttle value has been specified, calculate the time that each operation should take */
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_init_seek_list: Target: %d: Worker: %d: ENTER: td_throtp: %p: throttle: %f:\n", (long long int)pclk_now(),tdp->td_target_number,-1,tdp->td_throtp,(tdp->td_throtp != NULL)?tdp->td_throtp->throttle:-69.69);
+if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_seek_generator_init: Target: %d: Worker: %d: ENTER: td_throtp: %p: throttle: %f:\n", (long long int)pclk_now(),tdp->td_target_number,-1,tdp->td_throtp,(tdp->td_throtp != NULL)?tdp->td_throtp->throttle:-69.69);
 	if ((tdp->td_throtp) && (tdp->td_throtp->throttle > 0.0)) {
 		if (tdp->td_throtp->throttle_type & XINT_THROTTLE_BW){
 			bytes_per_sec = tdp->td_throtp->throttle * MILLION;
@@ -98,104 +66,156 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
            	nano_second_throttle_variance = variance_seconds_per_op * BILLION;
 		}
 	} else nano_seconds_per_op = 0;
+
 	sp = &tdp->td_seekhdr;
-        /* Initialize the random number generator */
-	sp->oldstate = initstate(sp->seek_seed, sp->state, sizeof(sp->state));
+	sp->seek_num_rw_ops = sp->seek_total_ops;
+	sp->seek_location_key = xint_prng_key((uint64_t)sp->seek_seed, XINT_PRNG_STREAM_SEEK_LOCATION);
+	sp->seek_time_key = xint_prng_key((uint64_t)sp->seek_seed, XINT_PRNG_STREAM_SEEK_TIME);
+	sp->seek_range_blocks = (sp->seek_range * 1024) / tdp->td_block_size;
+	if (sp->seek_options & SO_SEEK_STAGGER) {
+		if (sp->seek_num_rw_ops > 1)
+			sp->seek_gap = ((sp->seek_range-tdp->td_reqsize) - (sp->seek_num_rw_ops*tdp->td_reqsize)) / (sp->seek_num_rw_ops-1);
+		else sp->seek_gap = 0;
+		if (sp->seek_stride > tdp->td_reqsize) sp->seek_gap = sp->seek_stride - tdp->td_reqsize;
+	} else sp->seek_gap = 0; 
+	if (sp->seek_interleave > 1)
+		sp->seek_interleave_offset = sp->seek_interleave*tdp->td_reqsize;
+	else sp->seek_interleave_offset = 0;
+	sp->seek_time_base = nano_seconds_per_op + tdp->td_start_delay;
+	sp->seek_nsec_per_op = nano_seconds_per_op;
+	sp->seek_nsec_variance = nano_second_throttle_variance;
+	// Only a bandwidth throttle has a high/low window for the issue time
+	if (seconds_per_op_high > seconds_per_op_low)
+		sp->seek_variance_span = seconds_per_op_high - seconds_per_op_low;
+	else sp->seek_variance_span = 0.0;
 
-	/* Check to see if we need to load the seeks from a specified file */
-	if (sp->seek_options & SO_SEEK_LOAD) { /* Load pre-defined seek list */
-		xdd_load_seek_list(tdp);
-		sp->seek_options &= ~SO_SEEK_LOAD; /* only want to load seek list once */
-	} else { /* Generate a new seek list */ 
-		relative_time = nano_seconds_per_op + tdp->td_start_delay;
-		rw_op_index = 0;
-		rw_index = 0;
-		rw_index_incr = 1;
-		sp->seek_num_rw_ops = sp->seek_total_ops;
-		if (tdp->td_rwratio >= 0.5) /* This has to be set correctly or the first op may not be correct */
-			previous_percent_op = -1.0;
-		else previous_percent_op = 0.0;
-		for (op_index = 0; op_index < sp->seek_total_ops; op_index++) {   
-			/* Fill in the seek location */
-			if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
-				range_in_1kblocks = sp->seek_range;
-				range_in_bytes = range_in_1kblocks * 1024;
-				range_in_blocksize_blocks = range_in_bytes / tdp->td_block_size;
-				if (rw_op_index == 0) { /* This is the first location for this thread */
-// FIXME ????					for (j = 0; j < tdp->td_my_qthread_number; j++) /* skip over the first N locations */
-// FIXME ????						sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-					/* Assign this location as the first seek */
-					sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-				} else { /* This section if for seek locations 2 thru N */
-					/* This is done to support interleaved I/O operations and/or command queuing */
-					for (j = 0; j < sp->seek_interleave; j++)
-						sp->seeks[rw_index].block_location = (uint64_t)(range_in_blocksize_blocks * xdd_random_float());
-				}
-			} else {/* generate a sequential seek */
-				if (sp->seek_options & SO_SEEK_STAGGER) {
-					gap = ((sp->seek_range-tdp->td_reqsize) - (sp->seek_num_rw_ops*tdp->td_reqsize)) / (sp->seek_num_rw_ops-1);
-				        if (sp->seek_stride > tdp->td_reqsize) gap = sp->seek_stride - tdp->td_reqsize;
-                                }
-				else gap = 0; 
-				if (sp->seek_interleave > 1)
-// FIXME ????		interleave_threadoffset = (tdp->td_my_qthread_number%sp->seek_interleave)*tdp->td_reqsize;
-					interleave_threadoffset = sp->seek_interleave*tdp->td_reqsize;
-				else interleave_threadoffset = 0;
-				sp->seeks[rw_index].block_location = tdp->td_start_offset + interleave_threadoffset + 
-						(rw_op_index * ((tdp->td_reqsize*sp->seek_interleave)+gap));
-			} /* end of generating a sequential seek */
-			/* Now lets fill in the request sizes to transfer */
-			sp->seeks[rw_index].reqsize = tdp->td_reqsize;
-			/* Now lets fill in the appropriate operation */
-			/* The operation is specified either as "read" or "write" in which case
-			 * all operations for this target will be either read or write accordingly.
-			 * The way this is actually done is that when the command line arguments are
-			 * parsed, if the -op read or -op write options are specified then the
-			 * rwratio is set to 100 or 0 accordingly. This way, the operation is
-			 * determined soley by the rwratio parameter. 
-			 * If the "rwratio" was specified, then the appropriate number
-			 * of read and write operations are used. 
-			 * The -rwratio option takes precedence over the -op option.
-			 */
-			if (tdp->td_rwratio == -1.0) { // No-op
-				sp->seeks[rw_index].operation = SO_OP_NOOP;
-			} else { // Normal read/write operations
-				percent_op = tdp->td_rwratio * rw_op_index;
-				if (percent_op > previous_percent_op) 
-					current_op = SO_OP_READ;
-				else current_op = SO_OP_WRITE;
-				previous_percent_op = percent_op;
-            	/* Fill in the operation */
-				if (current_op == SO_OP_WRITE) { /* This is a WRITE operation */
-					sp->seeks[rw_index].operation = SO_OP_WRITE;
-				} else { /* This is a READ operation */
-					sp->seeks[rw_index].operation = SO_OP_READ;
-				}
-			}
+} /* end of xdd_seek_generator_init() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_seek_generate() - Generate entry number "op" of the seek list
+ * Each entry in the seek list contains the seek location, the size of the
+ * data transfer (currently reqsize), the operation to perform, and the time
+ * at which the operation should be issued when the target is throttled.
+ * Every field is computed from the operation number alone so the entries 
+ * can be generated in any order, by any thread, and the same entry is always
+ * generated for the same seed whether or not the whole list is built.
+ *
+ * Example A - A normal 100% write seek list
+ *
+ * Operation# Location Op 
+ *    0     0  W 
+ *    1     1024  W 
+ *    2     2048  W 
+ *    3     3072  W 
+ *    n     n*1024 W
+ *
+ */
+void
+xdd_seek_generate(target_data_t *tdp, int64_t op, seek_t *seekp) {
+	int64_t  percent_op;  /* used to determine read/write operation */
+	int64_t  previous_percent_op; /* used to determine read/write operation */
+	nclk_t  relative_time; /* Time in nanosecond relative to the first operation */
+	seekhdr_t *sp;   /* pointer to the seek header */
 
-			/* fill in the time that this operation is supposed to take place */
-            //  -----------------L=========^=========H------------>
-            //   Time--->        |         |         |Relative time plus the variance
-            //                   |         |Relative time Average
-            //                   |Relative time minus the variance
-            // The actual time that an I/O operation should take place is somewhere between
-            // the relative time plus or minus the variance. In Theory. Maybe.
-            if ((tdp->td_throtp) && (tdp->td_throtp->throttle_variance > 0.0)) {
-                variance_seconds_per_op = ((seconds_per_op_high-seconds_per_op_low) * xdd_random_float()) * BILLION;
-                sp->seeks[rw_index].time1 = (relative_time - nano_second_throttle_variance) + variance_seconds_per_op;
 
-            } else {
-			    sp->seeks[rw_index].time1 = relative_time;
+	sp = &tdp->td_seekhdr;
+	/* Fill in the seek location */
+	if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
+		seekp->block_location = (uint64_t)(sp->seek_range_blocks * xint_prng_double(sp->seek_location_key, (uint64_t)op));
+	} else {/* generate a sequential seek */
+		seekp->block_location = tdp->td_start_offset + sp->seek_interleave_offset + 
+				(op * ((tdp->td_reqsize*sp->seek_interleave)+sp->seek_gap));
+	} /* end of generating a sequential seek */
+	/* Now lets fill in the request sizes to transfer */
+	seekp->reqsize = tdp->td_reqsize;
+	/* Now lets fill in the appropriate operation */
+	/* The operation is specified either as "read" or "write" in which case
+	 * all operations for this target will be either read or write accordingly.
+	 * The way this is actually done is that when the command line arguments are
+	 * parsed, if the -op read or -op write options are specified then the
+	 * rwratio is set to 100 or 0 accordingly. This way, the operation is
+	 * determined soley by the rwratio parameter. 
+	 * If the "rwratio" was specified, then the appropriate number
+	 * of read and write operations are used. 
+	 * An operation is a READ whenever rwratio*op crosses an integer boundary.
+	 * The -rwratio option takes precedence over the -op option.
+	 */
+	if (tdp->td_rwratio == -1.0) { // No-op
+		seekp->operation = SO_OP_NOOP;
+	} else { // Normal read/write operations
+		percent_op = tdp->td_rwratio * op;
+		if (op > 0)
+			previous_percent_op = tdp->td_rwratio * (op - 1);
+		else if (tdp->td_rwratio >= 0.5) /* This has to be set correctly or the first op may not be correct */
+			previous_percent_op = -1;
+		else previous_percent_op = 0;
+		if (percent_op > previous_percent_op) 
+			seekp->operation = SO_OP_READ;
+		else seekp->operation = SO_OP_WRITE;
+	}
 
-            }
-if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_init_seek_list: Target: %d: Worker: %d: SET SEEK TIME: nano_seconds_per_op: %lld: relative_time: %lld:\n", (long long int)pclk_now(),tdp->td_target_number,-1,(long long int)nano_seconds_per_op,(long long int)relative_time);
-			relative_time += nano_seconds_per_op;
+	/* fill in the time that this operation is supposed to take place */
+    //  -----------------L=========^=========H------------>
+    //   Time--->        |         |         |Relative time plus the variance
+    //                   |         |Relative time Average
+    //                   |Relative time minus the variance
+    // The actual time that an I/O operation should take place is somewhere between
+    // the relative time plus or minus the variance. In Theory. Maybe.
+	relative_time = sp->seek_time_base + (op * sp->seek_nsec_per_op);
+    if ((tdp->td_throtp) && (tdp->td_throtp->throttle_variance > 0.0)) {
+        seekp->time1 = (relative_time - sp->seek_nsec_variance) + 
+			((sp->seek_variance_span * xint_prng_double(sp->seek_time_key, (uint64_t)op)) * BILLION);
+    } else {
+	    seekp->time1 = relative_time;
+    }
+	seekp->time2 = 0;
 
-			/* Increment to the next entry in the seek list */
-			rw_index += rw_index_incr;
-			rw_op_index++;
-		} /* end of FOR loop */
+} /* end of xdd_seek_generate() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_seek_entry() - Return a pointer to entry number "op" of the seek list.
+ * When the seek list was not built (-seek lazy) the entry is generated into
+ * the seek_t provided by the caller and a pointer to that is returned.
+ */
+seek_t *
+xdd_seek_entry(target_data_t *tdp, int64_t op, seek_t *seekp) {
+
+	if (tdp->td_seekhdr.seeks)
+		return(&tdp->td_seekhdr.seeks[op]);
+	xdd_seek_generate(tdp, op, seekp);
+	return(seekp);
+
+} /* end of xdd_seek_entry() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_init_seek_list() - Generate the list of seek operations to perform
+ * This routine will generate a list of locations to access within the
+ * specified range for random seeks or within the implied range for 
+ * purely sequential operations. 
+ * The seek list is either loaded from a specified file or is generated
+ * by xdd_seek_generate(). With -seek lazy no list is built at all and
+ * each entry is generated when it is needed.
+ */
+void
+xdd_init_seek_list(target_data_t *tdp) {
+	int64_t  op_index;   /* Current operation number  (from 0 to sp->seek_total_ops-1 ) */
+	seekhdr_t *sp;   /* pointer to the seek header */
+
+
+	sp = &tdp->td_seekhdr;
+	xdd_seek_generator_init(tdp);
+
+	/* Check to see if we need to load the seeks from a specified file */
+	if (sp->seek_options & SO_SEEK_LOAD) { /* Load pre-defined seek list */
+		xdd_load_seek_list(tdp);
+		sp->seek_options &= ~SO_SEEK_LOAD; /* only want to load seek list once */
+	} else if (sp->seeks) { /* Generate a new seek list */ 
+		for (op_index = 0; op_index < sp->seek_total_ops; op_index++)
+			xdd_seek_generate(tdp, op_index, &sp->seeks[op_index]);
 	} /* done generating a new seek list */
+	/* Put the seek list in the order of the physical layout of the target if requested */
+	if (sp->seek_options & SO_SEEK_PHYSICAL)
+		xint_target_physical_order(tdp);
 	/* Save this seek list to a file if requested to do so */
 	if (sp->seek_options & (SO_SEEK_SAVE | SO_SEEK_SEEKHIST | SO_SEEK_DISTHIST)) 
 		xdd_save_seek_list(tdp);
@@ -205,7 +225,11 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
  */
 void
 xdd_save_seek_list(target_data_t *tdp) {
-	int32_t  i; /* working variable */
+	int64_t  i; /* working variable */
+	int32_t  b; /* bucket number */
+	seek_t  *seekp; /* entry "i" of the seek list */
+	seek_t  *prevp; /* entry "i-1" of the seek list */
+	seek_t  seek_scratch[2]; /* generated entries when there is no seek list */
 	uint64_t longest, shortest; /* Longest and shortest seek distances in blocks */
 	uint64_t total, average; /* Total and average distance traveled in blocks */
 	uint64_t distance; /* The distance from one location to the next */
@@ -234,9 +258,11 @@ xdd_save_seek_list(target_data_t *tdp) {
 		shortest = sp->seek_range;
 		total = 0;
 		for (i = 1; i < sp->seek_total_ops; i++) {
-			if (sp->seeks[i].block_location  > sp->seeks[i-1].block_location)
-				distance = sp->seeks[i].block_location - sp->seeks[i-1].block_location;
-			else distance = sp->seeks[i-1].block_location - sp->seeks[i].block_location;
+			prevp = xdd_seek_entry(tdp, i-1, &seek_scratch[0]);
+			seekp = xdd_seek_entry(tdp, i, &seek_scratch[1]);
+			if (seekp->block_location  > prevp->block_location)
+				distance = seekp->block_location - prevp->block_location;
+			else distance = prevp->block_location - seekp->block_location;
 			if (distance > longest) longest = distance;
 			if (distance < shortest) shortest = distance;
 			total += distance;
@@ -249,20 +275,21 @@ xdd_save_seek_list(target_data_t *tdp) {
 			(unsigned long long)average);
 		fprintf(tmp,"#Ordinal Location Reqsize Operation Time1 Time2\n"); 
 		for (i = 0; i < sp->seek_total_ops; i++) {
-			if (sp->seeks[i].operation == SO_OP_READ) 
+			seekp = xdd_seek_entry(tdp, i, &seek_scratch[1]);
+			if (seekp->operation == SO_OP_READ) 
 				opc = "r";
-			else if (sp->seeks[i].operation == SO_OP_WRITE)
+			else if (seekp->operation == SO_OP_WRITE)
 				opc = "w";
-			else if (sp->seeks[i].operation == SO_OP_NOOP)
+			else if (seekp->operation == SO_OP_NOOP)
 				opc = "n";
 			else opc = "u";
-			fprintf(tmp,"%010d %012llu %d %s %016llu %016llu\n",
-				i,
-				(unsigned long long)sp->seeks[i].block_location, 
-				sp->seeks[i].reqsize, 
+			fprintf(tmp,"%010lld %012llu %d %s %016llu %016llu\n",
+				(long long)i,
+				(unsigned long long)seekp->block_location, 
+				seekp->reqsize, 
 				opc, 
-				(unsigned long long)(sp->seeks[i].time1),
-				(unsigned long long)(sp->seeks[i].time2));
+				(unsigned long long)(seekp->time1),
+				(unsigned long long)(seekp->time2));
 		}
 	} /* end of section that saves the seek locations */
 	/* Collect and print any requested histogram information */
@@ -276,7 +303,7 @@ xdd_save_seek_list(target_data_t *tdp) {
 			fputs(errormessage,xgp->errout);
 			fputs(errormessage,tmp);
 		} else {
-		for (i = 0; i < sp->seek_NumSeekHistBuckets; i++) buckets[i] = 0;
+		for (b = 0; b < sp->seek_NumSeekHistBuckets; b++) buckets[b] = 0;
 		divisor = sp->seek_range / sp->seek_NumSeekHistBuckets;
 		if (divisor == 0) {
 			sprintf(errormessage,"#%s: Cannot print Seek histogram - %d is not enough range\n",xgp->progname, sp->seek_NumSeekHistBuckets);
@@ -286,12 +313,13 @@ xdd_save_seek_list(target_data_t *tdp) {
 		} else {
 			/* fill the histogram buckets */
 			for (i = 0; i < sp->seek_total_ops; i++) {
-				bucket = sp->seeks[i].block_location/divisor;
+				seekp = xdd_seek_entry(tdp, i, &seek_scratch[1]);
+				bucket = seekp->block_location/divisor;
 				buckets[bucket]++;
 			}
 			/* print the histgram information for each bucket */
-			for (i = 0; i < sp->seek_NumSeekHistBuckets; i++) {
-				fprintf(tmp,"#SeekHist %04d %10llu\n", i,(unsigned long long)buckets[i]);
+			for (b = 0; b < sp->seek_NumSeekHistBuckets; b++) {
+				fprintf(tmp,"#SeekHist %04d %10llu\n", b,(unsigned long long)buckets[b]);
 			}
 			free(buckets);
 		}
@@ -306,7 +334,7 @@ xdd_save_seek_list(target_data_t *tdp) {
 			fputs(errormessage,xgp->errout);
 			fputs(errormessage,tmp);
 		} else {
-		for (i = 0; i < sp->seek_NumDistHistBuckets; i++) buckets[i] = 0;
+		for (b = 0; b < sp->seek_NumDistHistBuckets; b++) buckets[b] = 0;
 		divisor = longest / sp->seek_NumDistHistBuckets;
 		if (divisor == 0) {
 			sprintf(errormessage,"#%s: Cannot print Distance histogram - %d is not enough range\n",xgp->progname, sp->seek_NumDistHistBuckets);
@@ -316,15 +344,17 @@ xdd_save_seek_list(target_data_t *tdp) {
 		} else {
 			/* fill the Distance histogram buckets */
 			for (i = 1; i < sp->seek_total_ops-1; i++) {
-			if (sp->seeks[i].block_location  > sp->seeks[i-1].block_location)
-				distance = sp->seeks[i].block_location - sp->seeks[i-1].block_location;
-			else distance = sp->seeks[i-1].block_location - sp->seeks[i].block_location;
+			prevp = xdd_seek_entry(tdp, i-1, &seek_scratch[0]);
+			seekp = xdd_seek_entry(tdp, i, &seek_scratch[1]);
+			if (seekp->block_location  > prevp->block_location)
+				distance = seekp->block_location - prevp->block_location;
+			else distance = prevp->block_location - seekp->block_location;
 				bucket = distance/divisor;
 				buckets[bucket]++;
 			}
 			/* print the Distance histgram information for each bucket */
-			for (i = 0; i < sp->seek_NumDistHistBuckets; i++) {
-				fprintf(tmp,"#DistHist %04d %10llu\n", i,(unsigned long long)buckets[i]);
+			for (b = 0; b < sp->seek_NumDistHistBuckets; b++) {
+				fprintf(tmp,"#DistHist %04d %10llu\n", b,(unsigned long long)buckets[b]);
 			}
 			free(buckets);
 		}
@@ -35,6 +35,8 @@ typedef struct seek_entries seek_t;
 #define SO_SEEK_NONE      0x00000010 /**< No seek locations */
 #define SO_SEEK_DISTHIST  0x00000020 /**< Print the seek distance histogram */
 #define SO_SEEK_SEEKHIST  0x00000040 /**< Print the seek location histogram */
+#define SO_SEEK_LAZY      0x00000080 /**< Generate each seek entry when it is needed instead of building the seek list */
+#define SO_SEEK_PHYSICAL  0x00000100 /**< Sort the seek list by the physical location of each op */
 
 /** The seek header contains all the information regarding seek locations */
 struct seekhdr {
@@ -44,16 +46,26 @@ struct seekhdr {
 	int32_t  seek_interleave; /**< interleave used for generating sequential seek locations */
 	int32_t  seek_stride;        /**< stride of each request...if > reqsize*/
 	uint32_t seek_iosize; /**< The largest I/O size in the list */
-	int32_t  seek_num_rw_ops;  /**< Number of read+write operations */
-	int32_t  seek_total_ops;   /**< Total number of ops in the seek list including verifies */
+	int64_t  seek_num_rw_ops;  /**< Number of read+write operations */
+	int64_t  seek_total_ops;   /**< Total number of ops in the seek list including verifies */
 	int32_t  seek_NumSeekHistBuckets;/**< Number of buckets for seek histogram */
 	int32_t  seek_NumDistHistBuckets;/**< Number of buckets for distance histogram */
 	char  *seek_savefile; /**< file to save seek locations into */
 	char  *seek_loadfile; /**< file from which to load seek locations from */
 	char  *seek_pattern; /**< The seek pattern used for this target */
-	seek_t  *seeks;  /**< the seek list */
-	char state[256];
-	char *oldstate;
+	seek_t  *seeks;  /**< the seek list - NULL when SO_SEEK_LAZY is set */
+	int64_t  seek_physical_extents;  /**< number of extents of the target file - SO_SEEK_PHYSICAL */
+	int64_t  seek_physical_ops;  /**< number of ops in mapped extents that were put in physical order - SO_SEEK_PHYSICAL */
+	/* The following are set by xdd_seek_generator_init() and used to generate a seek entry */
+	uint64_t seek_location_key;  /**< PRNG key for random seek locations */
+	uint64_t seek_time_key;  /**< PRNG key for the throttle variance of each issue time */
+	int64_t  seek_range_blocks;  /**< range of random seek locations in blocksize blocks */
+	int64_t  seek_gap;  /**< gap in blocks between staggered sequential locations */
+	int64_t  seek_interleave_offset;  /**< offset in blocks of interleaved sequential locations */
+	nclk_t   seek_time_base;  /**< issue time of the first operation */
+	nclk_t   seek_nsec_per_op;  /**< time between operations for a throttled target */
+	nclk_t   seek_nsec_variance;  /**< maximum throttle variance of an issue time */
+	double   seek_variance_span;  /**< width of the throttle variance window in seconds */
 };
 typedef struct seekhdr seekhdr_t;
 
@@ -26,6 +26,150 @@ int xdd_data_pattern_init(xint_data_pattern_t* xdp)
     return 0;
 }
 
+/*----------------------------------------------------------------------------*/
+/* Data pattern fill kernels
+ * Each kernel has a portable version and, on x86 processors, AVX2 and AVX-512
+ * versions that are selected at run time by xdd_datapattern_select_kernels()
+ * according to what the processor supports. All versions of a kernel produce
+ * exactly the same data.
+ */
+typedef void (*xdd_sequence_fill_func_t)(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert);
+typedef void (*xdd_prng_fill_func_t)(uint64_t key, uint64_t counter, uint64_t *bufp, size_t words);
+
+/* Word "j" of a sequenced pattern is its byte offset OR'd with the prefix 
+ * and then XOR'd with "invert" which is either 0 or all ones 
+ */
+static void
+xdd_sequence_fill_generic(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	size_t		j;
+
+
+	for (j = 0; j < words; j++)
+		bufp[j] = ((offset + (j * sizeof(uint64_t))) | prefix) ^ invert;
+} // End of xdd_sequence_fill_generic()
+
+/* Word "i" of a random pattern is the number at position counter+i of the
+ * random number stream for "key" - see xint_prng.h 
+ */
+static void
+xdd_prng_fill_generic(uint64_t key, uint64_t counter, uint64_t *bufp, size_t words) {
+	size_t		i;
+
+
+	for (i = 0; i < words; i++)
+		bufp[i] = xint_prng_u64(key, counter + i);
+} // End of xdd_prng_fill_generic()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define XDD_DATAPATTERN_X86_KERNELS
+typedef uint64_t xdd_v4u64_t __attribute__((vector_size(32)));
+typedef uint64_t xdd_v8u64_t __attribute__((vector_size(64)));
+
+__attribute__((target("avx2"))) static void
+xdd_sequence_fill_avx2(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	xdd_v4u64_t	v = {offset, offset+8, offset+16, offset+24};
+	xdd_v4u64_t	w;
+	size_t		j;
+
+
+	for (j = 0; j + 4 <= words; j += 4) {
+		w = (v | prefix) ^ invert;
+		memcpy(&bufp[j], &w, sizeof(w));
+		v += 4 * sizeof(uint64_t);
+	}
+	xdd_sequence_fill_generic(&bufp[j], words - j, offset + (j * sizeof(uint64_t)), prefix, invert);
+} // End of xdd_sequence_fill_avx2()
+
+__attribute__((target("avx512f"))) static void
+xdd_sequence_fill_avx512(uint64_t *bufp, size_t words, uint64_t offset, uint64_t prefix, uint64_t invert) {
+	xdd_v8u64_t	v = {offset, offset+8, offset+16, offset+24, offset+32, offset+40, offset+48, offset+56};
+	xdd_v8u64_t	w;
+	size_t		j;
+
+
+	for (j = 0; j + 8 <= words; j += 8) {
+		w = (v | prefix) ^ invert;
+		memcpy(&bufp[j], &w, sizeof(w));
+		v += 8 * sizeof(uint64_t);
+	}
+	xdd_sequence_fill_generic(&bufp[j], words - j, offset + (j * sizeof(uint64_t)), prefix, invert);
+} // End of xdd_sequence_fill_avx512()
+
+/* The 64-bit multiplies keep the AVX-512 version of this from being faster 
+ * than the AVX2 version so there is only an AVX2 version 
+ */
+__attribute__((target("avx2"))) static void
+xdd_prng_fill_avx2(uint64_t key, uint64_t counter, uint64_t *bufp, size_t words) {
+	xdd_v4u64_t	z;
+	xdd_v4u64_t	ctr = {counter+1, counter+2, counter+3, counter+4};
+	size_t		i;
+
+
+	for (i = 0; i + 4 <= words; i += 4) {
+		z = key + (ctr * XINT_PRNG_GOLDEN_GAMMA);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z = z ^ (z >> 31);
+		memcpy(&bufp[i], &z, sizeof(z));
+		ctr += 4;
+	}
+	xdd_prng_fill_generic(key, counter + i, &bufp[i], words - i);
+} // End of xdd_prng_fill_avx2()
+#endif
+
+static pthread_once_t				xdd_datapattern_kernels_once = PTHREAD_ONCE_INIT;
+static xdd_sequence_fill_func_t		xdd_sequence_fill_kernel = xdd_sequence_fill_generic;
+static xdd_prng_fill_func_t			xdd_prng_fill_kernel = xdd_prng_fill_generic;
+
+static void
+xdd_datapattern_select_kernels(void) {
+#if defined(XDD_DATAPATTERN_X86_KERNELS)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		xdd_sequence_fill_kernel = xdd_sequence_fill_avx2;
+		xdd_prng_fill_kernel = xdd_prng_fill_avx2;
+	}
+	if (__builtin_cpu_supports("avx512f"))
+		xdd_sequence_fill_kernel = xdd_sequence_fill_avx512;
+#endif
+} // End of xdd_datapattern_select_kernels()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prng_fill() - Fill a buffer with consecutive numbers from a random 
+ * number stream. Word "i" of the buffer gets the number at position 
+ * counter+i of the stream for "key".
+ */
+void
+xdd_prng_fill(uint64_t key, uint64_t counter, uint64_t *bufp, size_t words) {
+
+	pthread_once(&xdd_datapattern_kernels_once, xdd_datapattern_select_kernels);
+	xdd_prng_fill_kernel(key, counter, bufp, words);
+} // End of xdd_prng_fill()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_datapattern_replicate() - Fill a buffer with copies of a pattern.
+ * The pattern is copied into the buffer once and then the part of the buffer
+ * that has been filled is copied onto the part that has not, which doubles 
+ * the filled part each time, so a buffer of any size takes a few large 
+ * memcpy() calls instead of one memcpy() per copy of the pattern.
+ */
+void
+xdd_datapattern_replicate(unsigned char *bufp, size_t length, unsigned char *patternp, size_t pattern_length) {
+	size_t		filled;		// Number of bytes of the buffer that have been filled
+	size_t		copy;		// Number of bytes to copy 
+
+
+	if ((length == 0) || (pattern_length == 0))
+		return;
+	filled = (pattern_length < length) ? pattern_length : length;
+	memcpy(bufp, patternp, filled);
+	while (filled < length) {
+		copy = (filled < (length - filled)) ? filled : (length - filled);
+		memcpy(bufp + filled, bufp, copy);
+		filled += copy;
+	}
+} // End of xdd_datapattern_replicate()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_pattern_buffer() - init the I/O buffer with the appropriate pattern
  * This routine will put the requested pattern in the rw buffer.
@@ -33,131 +177,61 @@ int xdd_data_pattern_init(xint_data_pattern_t* xdp)
 void
 xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	target_data_t	*tdp;
-    int32_t i;
     int32_t pattern_length; // Length of the pattern
-    size_t remaining_length; // Length of the space in the pattern buffer
-    unsigned char    *ucp;          // Pointer to an unsigned char type, duhhhh
-    uint32_t *lp;			// pointer to a pattern
+    uint64_t key;			// Random number generator key for random patterns
+    uint64_t tail;			// Random number for a partial word at the end of the buffer
+    size_t words;			// Number of 64-bit words in the buffer
     xint_data_pattern_t	*dpp;
 
 
 	tdp = wdp->wd_tdp;
     dpp = tdp->td_dpp;
-    if (dpp->data_pattern_options & DP_RANDOM_PATTERN) { // A nice random pattern
-		lp = (uint32_t *)wdp->wd_task.task_datap;
-		xgp->random_initialized = 0;
-		xgp->random_init_seed = 72058; // Backward compatibility with older xdd versions
-		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
-	    	*lp=xdd_random_int();
-	    	lp++;
-		}
-    } else if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) { // A nice random pattern, unique by target number
-		lp = (uint32_t *)wdp->wd_task.task_datap;
-		xgp->random_initialized = 0;
-		xgp->random_init_seed = (tdp->td_target_number+1); 
-		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
-	    	*lp=xdd_random_int();
-	    	lp++;
+    if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN)) { // A nice random pattern
+		/* The random pattern depends only on the seed and the position in the
+		 * buffer so every Worker Thread of a target gets the same buffer no matter
+		 * how many Worker Threads there are or what order they run in.
+		 */
+		if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) // unique by target number
+			key = xint_prng_key(tdp->td_target_number+1, XINT_PRNG_STREAM_DATA_PATTERN);
+		else key = xint_prng_key(XINT_PRNG_SEED_DATA_PATTERN, XINT_PRNG_STREAM_DATA_PATTERN);
+		words = tdp->td_xfer_size / sizeof(uint64_t);
+		xdd_prng_fill(key, 0, (uint64_t *)wdp->wd_task.task_datap, words);
+		if (tdp->td_xfer_size % sizeof(uint64_t)) { // Partial word at the end of the buffer
+			tail = xint_prng_u64(key, words);
+			memcpy(wdp->wd_task.task_datap + (words * sizeof(uint64_t)), &tail, tdp->td_xfer_size % sizeof(uint64_t));
 		}
     } else if ((dpp->data_pattern_options & DP_ASCII_PATTERN) ||
 	     (dpp->data_pattern_options & DP_HEX_PATTERN)) { // put the pattern that is in the pattern buffer into the io buffer
-		// Clear out the buffer before putting in the string so there are no strange characters in it.
-		memset(wdp->wd_task.task_datap,'\0',tdp->td_xfer_size);
 		if (dpp->data_pattern_options & DP_REPLICATE_PATTERN) { // Replicate the pattern throughout the buffer
-	    	ucp = (unsigned char *)wdp->wd_task.task_datap;
-	    	remaining_length = tdp->td_xfer_size;
-	    	while (remaining_length) { 
-				if (dpp->data_pattern_length < remaining_length) 
-		    		pattern_length = dpp->data_pattern_length;
-				else pattern_length = remaining_length;
-		
-				memcpy(ucp,dpp->data_pattern,pattern_length);
-				remaining_length -= pattern_length;
-				ucp += pattern_length;
-	    	}
+			xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, dpp->data_pattern, dpp->data_pattern_length);
 		} else { // Just put the pattern at the beginning of the buffer once 
+			// Clear out the buffer before putting in the string so there are no strange characters in it.
+			memset(wdp->wd_task.task_datap,'\0',tdp->td_xfer_size);
 	    	if (dpp->data_pattern_length < (size_t)tdp->td_xfer_size) 
 				pattern_length = dpp->data_pattern_length;
 	    	else pattern_length = tdp->td_xfer_size;
 	    	memcpy(wdp->wd_task.task_datap,dpp->data_pattern,pattern_length);
 		}
     } else if (dpp->data_pattern_options & DP_LFPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(lfpat);
 		fprintf(stderr,"LFPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,lfpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, lfpat, sizeof(lfpat));
     } else if (dpp->data_pattern_options & DP_LTPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(ltpat);
 		fprintf(stderr,"LTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,ltpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, ltpat, sizeof(ltpat));
     } else if (dpp->data_pattern_options & DP_CJTPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(cjtpat);
 		fprintf(stderr,"CJTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,cjtpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, cjtpat, sizeof(cjtpat));
     } else if (dpp->data_pattern_options & DP_CRPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(crpat);
 		fprintf(stderr,"CRPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,crpat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, crpat, sizeof(crpat));
     } else if (dpp->data_pattern_options & DP_CSPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
 		dpp->data_pattern_length = sizeof(cspat);
 		fprintf(stderr,"CSPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
-		ucp = (unsigned char *)wdp->wd_task.task_datap;
-		while (remaining_length) { 
-	    	if (dpp->data_pattern_length < remaining_length) 
-				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = remaining_length;
-	    	memcpy(ucp,cspat,pattern_length);
-	    	remaining_length -= pattern_length;
-	    	ucp += pattern_length;
-		}
+		xdd_datapattern_replicate(wdp->wd_task.task_datap, tdp->td_xfer_size, cspat, sizeof(cspat));
     } else { // Otherwise set the entire buffer to the character in "dpp->data_pattern"
 		memset(wdp->wd_task.task_datap,*(dpp->data_pattern),tdp->td_xfer_size);
    	}
@@ -173,8 +247,6 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 void
 xdd_datapattern_fill(worker_data_t *wdp) {
 	target_data_t	*tdp;
-	size_t  		j;					// random variables 
-	uint64_t 		*posp;             	// Position Pointer 
 	nclk_t			start_time;			// Used for calculating elapsed times of ops
 	nclk_t			end_time;			// Used for calculating elapsed times of ops
 
@@ -183,16 +255,15 @@ xdd_datapattern_fill(worker_data_t *wdp) {
 	/* Sequenced Data Pattern */
 	if (tdp->td_dpp->data_pattern_options & DP_SEQUENCED_PATTERN) {
 		nclk_now(&start_time);
-		posp = (uint64_t *)wdp->wd_task.task_datap;
-		for (j=0; j<(tdp->td_xfer_size/sizeof(wdp->wd_task.task_byte_offset)); j++) {
-			*posp = wdp->wd_task.task_byte_offset + (j * sizeof(wdp->wd_task.task_byte_offset));
-			*posp |= tdp->td_dpp->data_pattern_prefix_binary;
-			if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
-				*posp ^= 0xffffffffffffffffLL; // 1's compliment of the pattern
-			posp++;
-		}
+		pthread_once(&xdd_datapattern_kernels_once, xdd_datapattern_select_kernels);
+		xdd_sequence_fill_kernel((uint64_t *)wdp->wd_task.task_datap,
+			tdp->td_xfer_size/sizeof(uint64_t),
+			wdp->wd_task.task_byte_offset,
+			tdp->td_dpp->data_pattern_prefix_binary,
+			(tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN) ? 0xffffffffffffffffULL : 0); // 1's compliment of the pattern
 		nclk_now(&end_time);
-// FIXME ????		wdp->wd_accumulated_pattern_fill_time = (end_time - start_time);
+		wdp->wd_counters.tc_current_pattern_fill_time = (end_time - start_time);
+		wdp->wd_counters.tc_accumulated_pattern_fill_time += wdp->wd_counters.tc_current_pattern_fill_time;
 	}
 } // End of xdd_datapattern_fill() 
 
@@ -44,7 +44,6 @@ xdd_show_global_data(void) {
     fprintf(stderr,"xdd_show_global_data: run_time_expired          %d - The alarm that goes off when the total run time has been exceeded \n",xgp->run_time_expired);
     fprintf(stderr,"xdd_show_global_data: run_complete              %d - Set to a 1 to indicate that all passes have completed \n",xgp->run_complete);
     fprintf(stderr,"xdd_show_global_data: abort                     %d - abort the run due to some catastrophic failure \n",xgp->abort);
-    fprintf(stderr,"xdd_show_global_data: random_initialized        %d - Random number generator has been initialized \n",xgp->random_initialized);
     fprintf(stderr,"xdd_show_global_data: ********* End of Global Data **********\n");
 
 } /* end of xdd_show_global_data() */ 
@@ -142,7 +141,8 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: tot_t                   *td_totp=%p\n",tdp->td_totp);                                // Pointer to the target_offset_table for this target
     fprintf(stderr,"xdd_show_target_data: pthread_cond_t          td_any_worker_thread_available_condition\n");
     fprintf(stderr,"xdd_show_target_data: pthread_mutex_t         td_any_worker_thread_available_mutex\n");
-    fprintf(stderr,"xdd_show_target_data: int                     td_any_worker_thread_available=%d\n",tdp->td_any_worker_thread_available);
+    fprintf(stderr,"xdd_show_target_data: int                     td_any_worker_thread_waiting=%d\n",tdp->td_any_worker_thread_waiting);
+    fprintf(stderr,"xdd_show_target_data: uint64_t                *td_idle_worker_map=%p words=%d hint=%d eof_count=%d\n",tdp->td_idle_worker_map,tdp->td_idle_worker_words,tdp->td_idle_worker_hint,tdp->td_idle_worker_eof_count);
     fprintf(stderr,"xdd_show_target_data: pthread_cond_t          td_this_wthread_is_available_condition\n");
     fprintf(stderr,"xdd_show_target_data: int64_t                 td_start_offset=%lld\n",(long long int)tdp->td_start_offset);             // starting block offset value 
     fprintf(stderr,"xdd_show_target_data: int64_t                 td_pass_offset=%lld\n",(long long int)tdp->td_pass_offset);             // number of blocks to add to seek locations between passes 
@@ -163,7 +163,6 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_processor=%d\n",tdp->td_processor);                  // Processor/target assignments 
     fprintf(stderr,"xdd_show_target_data: double                  td_start_delay=%f\n",tdp->td_start_delay);             // number of seconds to delay the start  of this operation 
     fprintf(stderr,"xdd_show_target_data: nclk_t                  td_start_delay_psec=%lld\n",(unsigned long long int)tdp->td_start_delay_psec);        // number of nanoseconds to delay the start  of this operation 
-    fprintf(stderr,"xdd_show_target_data: char                    td_random_init_state[256]\n");     // Random number generator state initalizer array 
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_block_size=%d\n",tdp->td_block_size);              // Size of a block in bytes for this target 
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_queue_depth=%d\n",tdp->td_queue_depth);             // Command queue depth for each target 
     fprintf(stderr,"xdd_show_target_data: int64_t                 td_preallocate=%lld\n",(long long int)tdp->td_preallocate);             // File preallocation value 
@@ -179,7 +178,6 @@ xdd_show_target_data(target_data_t *tdp) {
     fprintf(stderr,"xdd_show_target_data: int32_t                 td_results_run_barrier_index=%d\n",tdp->td_results_run_barrier_index);     // Where threads wait for all other threads at the completion of the run
     fprintf(stderr,"xdd_show_target_data: nclk_t                  td_open_start_time=%lld\n",(unsigned long long int)tdp->td_open_start_time);         // Time just before the open is issued for this target 
     fprintf(stderr,"xdd_show_target_data: nclk_t                  td_open_end_time=%lld\n",(unsigned long long int)tdp->td_open_end_time);             // Time just after the open completes for this target 
-    fprintf(stderr,"xdd_show_target_data: pthread_mutex_t         td_counters_mutex\n");             // Mutex for locking when updating td_counters
     fprintf(stderr,"xdd_show_target_data: struct xint_target_counters td_counters\n");        // Pointer to the target counters
     fprintf(stderr,"xdd_show_target_data: struct xint_throttle    *td_throtp=%p\n",tdp->td_throtp);            // Pointer to the throttle sturcture
     fprintf(stderr,"xdd_show_target_data: struct xint_e2e         *td_e2ep=%p\n",tdp->td_e2ep);            // Pointer to the e2e struct when needed
@@ -233,7 +231,7 @@ xdd_show_worker_data(worker_data_t *wdp) {
     fprintf(stderr,"xdd_show_worker_data: int32_t                 wd_worker_thread_target_sync=0x%08x:%s\n",wdp->wd_worker_thread_target_sync,option_string);        // Flags used to synchronize a Worker_Thread with its Target
     fprintf(stderr,"xdd_show_worker_data: pthread_cond_t          wd_this_worker_thread_is_available_condition\n");
     fprintf(stderr,"xdd_show_worker_data: xdd_barrier_t           *wd_current_barrier:%p: '%s'\n",wdp->wd_current_barrier, wdp->wd_current_barrier?wdp->wd_current_barrier->name:"NA");    // The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
-    fprintf(stderr,"xdd_show_worker_data: xdd_barrier_t           wd_thread_targetpass_wait_for_task_barrier:\n");    // The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
+    fprintf(stderr,"xdd_show_worker_data: xint_task_ring_t        wd_task_ring: tr_head=%u tr_tail=%u tr_sleeping=%d tr_spin=%d\n",wdp->wd_task_ring.tr_head,wdp->wd_task_ring.tr_tail,wdp->wd_task_ring.tr_sleeping,wdp->wd_task_ring.tr_spin);    // Where the Worker_Thread waits for targetpass() to post a task to perform
     fprintf(stderr,"xdd_show_worker_data: xdd_occupant_t          wd_occupant:\n");        // Used by the barriers to keep track of what is in a barrier at any given time
     xdd_show_occupant(&wdp->wd_occupant);
     fprintf(stderr,"xdd_show_worker_data: char                    wd_occupant_name[XDD_BARRIER_MAX_NAME_LENGTH]='%s'\n",wdp->wd_occupant_name);    // For a Target thread this is "TARGET####", for a Worker_Thread it is "TARGET####WORKER####"
@@ -253,12 +251,10 @@ xdd_show_worker_data(worker_data_t *wdp) {
 		strcat(option_string,"WORKER_CURRENT_STATE_BARRIER ");
 	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE)
 		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE ");
-	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE)
-		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE ");
-	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS)
-		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS ");
 	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO)
 		strcat(option_string,"WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO ");
+	if(wdp->wd_current_state & WORKER_CURRENT_STATE_WAITING_FOR_TASK)
+		strcat(option_string,"WORKER_CURRENT_STATE_WAITING_FOR_TASK ");
     fprintf(stderr,"xdd_show_worker_data: uint32_t                 wd_current_state=0x%08x: '%s'\n",wdp->wd_current_state,option_string);            // State of this thread at any given time (see Current State definitions below)
 
     fprintf(stderr,"xdd_show_worker_data:********* End of Worker Data **********\n");
@@ -450,38 +446,19 @@ xdd_show_e2e_header(xdd_e2e_header_t *e2ehp) {
  */
 void
 xdd_show_tot_entry(tot_t *totp, int i) {
-	tot_wait_t	*totwp;
-
 
   	fprintf(stderr,"\txdd_show_tot_entry:---------- TOT %p entry %d ----------\n",totp,i);
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> pthread_mutex_t tot_mutex\n",i);		// Mutex that is locked when updating items in this entry
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> pthread_cond_t tot_condition\n",i);
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> int64_t tot_op_number=%lld\n",i,(long long int)totp->tot_entry[i].tot_op_number);		// Target Operation Number of the last op released through this entry
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> uint32_t tot_seq=%u\n",i,totp->tot_entry[i].tot_seq);							// Bumped every time this entry is released
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> uint32_t tot_waiters=%u\n",i,totp->tot_entry[i].tot_waiters);					// Number of Worker Threads sleeping on tot_seq
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_wait_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_wait_ts);			// Time that another Worker Thread starts to wait on this
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_post_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_post_ts);			// Time that the responsible Worker Thread posts this semaphore
+   	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_post_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_post_ts);			// Time that the responsible Worker Thread releases this entry
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> nclk_t tot_update_ts=%lld\n",i,(long long int)totp->tot_entry[i].tot_update_ts);		// Time that the responsible Worker Thread updates the byte_location and io_size
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int64_t tot_byte_offset=%lld\n",i,(long long int)totp->tot_entry[i].tot_byte_offset);	// Byte Location that was just processed
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> int64_t tot_op_number=%lld\n",i,(long long int)totp->tot_entry[i].tot_op_number);		// Target Operation Number for the op that processed this block
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_io_size=%d\n",i,totp->tot_entry[i].tot_io_size);							// Size of I/O in bytes that was just processed
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_wait_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_wait_worker_thread_number);	// Number of the Worker Thread that is waiting for this TOT entry to be posted
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_post_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_post_worker_thread_number);	// Number of the Worker Thread that posted this TOT entry 
    	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t tot_update_worker_thread_number=%d\n",i,totp->tot_entry[i].tot_update_worker_thread_number);	// Number of the Worker Thread that last updated this TOT Entry
-   	fprintf(stderr,"\txdd_show_tot_entry: <%d> int32_t status=%d\n",i,totp->tot_entry[i].tot_status);
-
-	if (totp->tot_entry[i].tot_waitp) {
-		fprintf(stderr,"\t\txdd_show_tot_entry: <%d> TOT WAIT Chain\n",i);
-		totwp = totp->tot_entry[i].tot_waitp;
-		while (totwp) {
-			fprintf(stderr,"\t\txdd_show_tot_entry: ----------------------------------\n");
-   			fprintf(stderr,"\t\txdd_show_tot_entry: <%d> struct tot_wait *tot_waitp=%p\n",i,totp->tot_entry[i].tot_waitp);
-   			fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> tot_wait_t *totw_nextp=%p\n",i,totwp->totw_nextp);
-			fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> struct xint_worker_data	*totw_wdp=%p\n",i,totwp->totw_wdp);		// Pointer to the Worker that owns this tot_wait
-    		fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> pthread_cond_t totw_condition\n",i);; 
-    		fprintf(stderr,"\t\t***xdd_show_tot_entry: <%d> int totw_is_released=%d\n",i,totwp->totw_is_released);
-			totwp = totwp->totw_nextp;
-		}
-	}
-
-
 
 } // End of xdd_show_tot_entry()
 
@@ -525,6 +502,8 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream the time stamp entries to the binary output file during the run */
+#define TS_COMPACT            0x00008000 /**< Write the binary output file in the columnar format of xint_ts_columnar.h */
 #define DEFAULT_TS_OPTIONS 0x00000000
 	option_string[0]='\0';
 	if (ts_tablep->ts_options & TS_NORMALIZE)
@@ -555,6 +534,10 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 		strcat(option_string,"TS_TRIGGERED ");
 	if (ts_tablep->ts_options & TS_SUPPRESS_OUTPUT)
 		strcat(option_string,"TS_SUPPRESS_OUTPUT ");
+	if (ts_tablep->ts_options & TS_STREAM)
+		strcat(option_string,"TS_STREAM ");
+	if (ts_tablep->ts_options & TS_COMPACT)
+		strcat(option_string,"TS_COMPACT ");
 	fprintf(stderr,"xdd_show_ts_table: uint64_t        ts_options=0x%016llx: '%s'\n",(unsigned long long int)ts_tablep->ts_options,option_string); // Time Stamping Options 
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_current_entry=%lld\n",(long long int)ts_tablep->ts_current_entry); 		// Index into the Timestamp Table of the current entry
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_size=%lld\n",(long long int)ts_tablep->ts_size);  						// Time Stamping Size in number of entries 
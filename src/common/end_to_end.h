@@ -43,6 +43,68 @@ struct xdd_e2e_header {
 };
 typedef struct xdd_e2e_header xdd_e2e_header_t;
 
+/*
+ * With -e2e files the data portion of a message holds one or more file
+ * records instead of a piece of a single file. Every record starts on an
+ * 8-byte boundary:
+ *
+ * +-------------+--------------------+-------------------------------+
+ * | File Header | path (8-byte pad)  | file data (8-byte pad)        |
+ * +-------------+--------------------+-------------------------------+
+ *
+ * The path is relative to the target directory and is not NUL terminated.
+ * A directory or an empty file is a record without data. A file that does
+ * not fit into what is left of a message is split into records that carry
+ * consecutive pieces of it.
+ */
+#define XDD_E2E_FILE_RECORD		0xF11EF11E	// The magic number at the beginning of each file record
+#define XDD_E2E_FILE_ALIGN(x)	(((x) + 7) & ~((int64_t)7))
+#define XDD_E2E_FILE_MIN_SPLIT	4096		// A file is not split to fill in fewer bytes than this at the end of a message
+struct xdd_e2e_file_header {
+	uint32_t	e2efh_magic;				// Magic Number - XDD_E2E_FILE_RECORD
+	uint32_t	e2efh_path_length;			// Length of the path that follows this header
+	int64_t		e2efh_file_size;			// Size of the whole file in bytes
+	int64_t		e2efh_offset;				// Offset in the file of the data in this record
+	int64_t		e2efh_data_length;			// Number of bytes of file data in this record
+	uint32_t	e2efh_mode;					// st_mode of the file or directory
+	uint32_t	e2efh_reserved;				// Keeps the header a multiple of 8 bytes
+};
+typedef struct xdd_e2e_file_header xdd_e2e_file_header_t;
+
+// One file or directory of the tree that the source side sends
+struct xdd_e2e_file_entry {
+	char		*fe_path;					// Path relative to the target directory
+	int64_t		fe_size;					// Size of the file in bytes - 0 for a directory
+	uint32_t	fe_mode;					// st_mode of the file or directory
+	uint32_t	fe_path_length;				// strlen(fe_path)
+};
+typedef struct xdd_e2e_file_entry xdd_e2e_file_entry_t;
+
+// The first record of an E2E request - the request ends where the next one starts
+struct xdd_e2e_file_request {
+	int64_t		fr_entry;					// Index of the file entry of the first record
+	int64_t		fr_offset;					// Offset in that file of the first record
+};
+typedef struct xdd_e2e_file_request xdd_e2e_file_request_t;
+
+// The file table that the source side builds when the target is opened.
+// On the destination side the entries are the files and directories whose
+// mode is set once all their records have been written.
+struct xdd_e2e_file_table {
+	xdd_e2e_file_entry_t	*ft_entries;		// The files and directories in the order they are sent
+	int64_t					ft_entry_count;		// Number of entries in use
+	int64_t					ft_entry_size;		// Number of entries allocated
+	xdd_e2e_file_request_t	*ft_requests;		// Where each request starts; op number N sends request N
+	int64_t					ft_request_count;	// Number of requests in use
+	int64_t					ft_request_size;	// Number of requests allocated
+	int64_t					ft_file_count;		// Number of regular files
+	int64_t					ft_directory_count;	// Number of directories
+	int64_t					ft_skipped_count;	// Number of entries that are neither
+	int64_t					ft_bytes;			// Number of bytes in all the regular files
+	pthread_mutex_t			ft_mutex;			// Serializes the Worker Threads that add entries on the destination side
+};
+typedef struct xdd_e2e_file_table xdd_e2e_file_table_t;
+
 struct xdd_e2e_address_table_entry {
     char 	*address;					// Pointer to the ASCII string of the address 
     char 	hostname[HOSTNAMELENGTH];	// the ASCII string of the hostname associated with address 
@@ -129,6 +191,11 @@ struct xint_e2e {
 	nclk_t				e2e_first_packet_received_this_run;// Time that the first packet was received by the destination from the source
 	nclk_t				e2e_last_packet_received_this_run;// Time that the last packet was received by the destination from the source
 	nclk_t				e2e_sr_time; 			// Time spent sending or receiving data for End-to-End operation
+	int					e2e_pipe[2];			// Pipe that holds the data of a zero copy transfer - read end, write end
+	int32_t				e2e_pipe_size;			// Capacity of the pipe in bytes or 0 if zero copy is not used
+	int32_t				e2e_pipe_bytes;			// Number of data bytes in the pipe
+	char				*e2e_file_list_name;	// File that lists the paths to send with -e2e filelist
+	xdd_e2e_file_table_t *e2e_file_tablep;		// Files and directories sent by the source side with -e2e files
 	int32_t				e2e_address_table_host_count;	// Cumulative number of hosts represented in the e2e address table
 	int32_t				e2e_address_table_port_count;	// Cumulative number of ports represented in the e2e address table
 	int32_t				e2e_address_table_next_entry;	// Next available entry in the e2e_address_table
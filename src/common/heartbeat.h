@@ -10,11 +10,18 @@
  * Foundation.  See file COPYING.
  *
  */
+#include "xint_nclk.h"
+
 struct heartbeat {
-	uint32_t		hb_interval;			// Number of seconds to sleep between Heartbeat updates
+	nclk_t			hb_interval;			// Number of nanoseconds to sleep between Heartbeat updates
 	FILE			*hb_file_pointer;		// File pointer for the heartbeat output file
 	char			*hb_filename;			// Name of the heartbeat file
 	uint64_t		hb_options;				// Option flags
+	// The following are for the 'timeseries' option - statistics for each heartbeat interval
+	FILE			*hb_ts_file_pointer;	// File pointer for the time series file
+	char			*hb_ts_filename;		// Name of the time series file
+	struct xint_heartbeat_interval	*hb_ts_lastp;	// Counters and latency histogram at the end of the last interval
+	pthread_mutex_t	hb_ts_mutex;			// Serializes the samples of the heartbeat and of the Target Thread at the end of a pass
 };
 typedef struct heartbeat heartbeat_t;
 // heartbeat.h hb_options bit definitions
@@ -33,3 +40,4 @@ typedef struct heartbeat heartbeat_t;
 #define HB_ELAPSED				0x0000000000001000ULL  /* Elapsed Seconds */
 #define HB_TARGET				0x0000000000002000ULL  /* Target Number */
 #define HB_HOST					0x0000000000004000ULL  /* Host name */
+#define HB_TIMESERIES			0x0000000000008000ULL  /* Write the statistics of each interval to a time series file */
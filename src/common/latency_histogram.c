@@ -0,0 +1,269 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that merge and report the latency
+ * histograms that are kept when latency percentiles are requested.
+ */
+#include "xint.h"
+
+// The percentiles reported in the results - see RESULTS_P50 and friends in results.h
+static double xdd_latency_percentiles[RESULTS_LATENCY_PERCENTILES] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+
+// The names of the op types in the histogram dump
+static char *xdd_latency_histogram_optype_names[XDD_LATHIST_OPTYPES] = { "read", "write", "noop",
+	"create", "stat", "open", "readdir", "rename", "unlink" };
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_alloc() - allocate an empty latency histogram
+ * for the specified target. "what" is used in the error message.
+ * Returns a pointer to the histogram or NULL if there is no memory.
+ */
+xint_latency_histogram_t *
+xdd_latency_histogram_alloc(int32_t target_number, char *what) {
+	xint_latency_histogram_t	*lhp;
+
+
+	lhp = (xint_latency_histogram_t *)calloc(1, sizeof(xint_latency_histogram_t));
+	if (lhp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_latency_histogram_alloc: Target %d: ERROR: Cannot allocate %d bytes of memory for the %s latency histogram\n",
+			xgp->progname, target_number, (int)sizeof(xint_latency_histogram_t), what);
+		fflush(xgp->errout);
+	}
+	return(lhp);
+} /* end of xdd_latency_histogram_alloc() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_reset() - remove all the ops from a histogram
+ */
+void
+xdd_latency_histogram_reset(xint_latency_histogram_t *lhp) {
+
+	memset(lhp, 0, sizeof(xint_latency_histogram_t));
+} /* end of xdd_latency_histogram_reset() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_merge() - add the ops of histogram "from" to
+ * histogram "to". "from" may be the histogram of a running Worker Thread
+ * (for the heartbeat for example) in which case the ops it is counting
+ * while this runs may or may not be included.
+ */
+void
+xdd_latency_histogram_merge(xint_latency_histogram_t *to, xint_latency_histogram_t *from) {
+	uint64_t	count;
+	int		type;
+	int		i;
+
+
+	for (type = 0; type < XDD_LATHIST_OPTYPES; type++) {
+		if (__atomic_load_n(&from->lh_total[type], __ATOMIC_RELAXED) == 0)
+			continue;
+		// Each count is loaded once so that the total is always the sum of the buckets
+		for (i = 0; i < XDD_LATHIST_BUCKETS; i++) {
+			count = __atomic_load_n(&from->lh_counts[type][i], __ATOMIC_RELAXED);
+			to->lh_counts[type][i] += count;
+			to->lh_total[type] += count;
+		}
+	}
+} /* end of xdd_latency_histogram_merge() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_delta() - set histogram "to" to the ops that are
+ * in histogram "now" but not in the earlier histogram "prev" of the same
+ * Worker Threads. If an op type of "now" has fewer ops than "prev" then
+ * the histograms were reset in between (a new pass) and all the ops
+ * of "now" are used.
+ */
+void
+xdd_latency_histogram_delta(xint_latency_histogram_t *to, xint_latency_histogram_t *now, xint_latency_histogram_t *prev) {
+	int		type;
+	int		i;
+	int		reset;
+
+
+	for (type = 0; type < XDD_LATHIST_OPTYPES; type++) {
+		reset = (now->lh_total[type] < prev->lh_total[type]);
+		to->lh_total[type] = 0;
+		for (i = 0; i < XDD_LATHIST_BUCKETS; i++) {
+			if (reset || (now->lh_counts[type][i] < prev->lh_counts[type][i]))
+				to->lh_counts[type][i] = now->lh_counts[type][i];
+			else to->lh_counts[type][i] = now->lh_counts[type][i] - prev->lh_counts[type][i];
+			to->lh_total[type] += to->lh_counts[type][i];
+		}
+	}
+} /* end of xdd_latency_histogram_delta() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_bucket_low() - return the lowest op time in
+ * nanoseconds that is counted in the specified bucket
+ */
+nclk_t
+xdd_latency_histogram_bucket_low(int index) {
+	int		shift;
+
+
+	if (index < XDD_LATHIST_SUB_BUCKETS)
+		return((nclk_t)index);
+	shift = (index / XDD_LATHIST_HALF) - 1;
+	return((nclk_t)(index - (shift * XDD_LATHIST_HALF)) << shift);
+} /* end of xdd_latency_histogram_bucket_low() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_bucket_high() - return the highest op time in
+ * nanoseconds that is counted in the specified bucket
+ */
+nclk_t
+xdd_latency_histogram_bucket_high(int index) {
+	int		shift;
+
+
+	if (index < XDD_LATHIST_SUB_BUCKETS)
+		return((nclk_t)index);
+	shift = (index / XDD_LATHIST_HALF) - 1;
+	return(((nclk_t)(index - (shift * XDD_LATHIST_HALF) + 1) << shift) - 1);
+} /* end of xdd_latency_histogram_bucket_high() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_count() - return the number of ops in a bucket
+ * for the specified op type or for XDD_LATHIST_ALL op types
+ */
+static uint64_t
+xdd_latency_histogram_count(xint_latency_histogram_t *lhp, int type, int index) {
+	uint64_t	count;
+
+
+	if (type != XDD_LATHIST_ALL)
+		return(lhp->lh_counts[type][index]);
+	count = 0;
+	for (type = 0; type < XDD_LATHIST_OPTYPES; type++)
+		count += lhp->lh_counts[type][index];
+	return(count);
+} /* end of xdd_latency_histogram_count() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_value_at() - return the op time in nanoseconds
+ * that "percentile" percent of the ops of the specified op type did not
+ * exceed. The highest time of the bucket is returned so the value is never
+ * below the real one. Returns -1 if there are no ops of this type.
+ */
+int64_t
+xdd_latency_histogram_value_at(xint_latency_histogram_t *lhp, int type, double percentile) {
+	int64_t		total;
+	int64_t		target;
+	int64_t		cumulative;
+	int			i;
+
+
+	if (type == XDD_LATHIST_ALL) {
+		total = 0;
+		for (i = 0; i < XDD_LATHIST_OPTYPES; i++)
+			total += lhp->lh_total[i];
+	} else total = lhp->lh_total[type];
+	if (total == 0)
+		return(-1);
+	target = (int64_t)(((double)total * percentile) / 100.0);
+	if ((double)target < (((double)total * percentile) / 100.0))
+		target++;
+	if (target < 1)
+		target = 1;
+	cumulative = 0;
+	for (i = 0; i < XDD_LATHIST_BUCKETS; i++) {
+		cumulative += xdd_latency_histogram_count(lhp, type, i);
+		if (cumulative >= target)
+			return((int64_t)xdd_latency_histogram_bucket_high(i));
+	}
+	return((int64_t)xdd_latency_histogram_bucket_high(XDD_LATHIST_BUCKETS - 1));
+} /* end of xdd_latency_histogram_value_at() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_percentiles() - fill in the latency percentiles of
+ * a results structure in milliseconds. If there is no histogram or no ops
+ * of a type then its percentiles are set to -1.
+ */
+void
+xdd_latency_histogram_percentiles(results_t *rp, xint_latency_histogram_t *lhp) {
+	int		p;
+
+
+	for (p = 0; p < RESULTS_LATENCY_PERCENTILES; p++) {
+		if (lhp == NULL) {
+			rp->latency_percentile[p] = -1.0;
+			rp->read_latency_percentile[p] = -1.0;
+			rp->write_latency_percentile[p] = -1.0;
+			continue;
+		}
+		rp->latency_percentile[p] = xdd_latency_histogram_value_at(lhp, XDD_LATHIST_ALL, xdd_latency_percentiles[p]);
+		rp->read_latency_percentile[p] = xdd_latency_histogram_value_at(lhp, XDD_LATHIST_READ, xdd_latency_percentiles[p]);
+		rp->write_latency_percentile[p] = xdd_latency_histogram_value_at(lhp, XDD_LATHIST_WRITE, xdd_latency_percentiles[p]);
+		if (rp->latency_percentile[p] > 0.0)
+			rp->latency_percentile[p] /= FLOAT_MILLION; // nano to milli
+		if (rp->read_latency_percentile[p] > 0.0)
+			rp->read_latency_percentile[p] /= FLOAT_MILLION; // nano to milli
+		if (rp->write_latency_percentile[p] > 0.0)
+			rp->write_latency_percentile[p] /= FLOAT_MILLION; // nano to milli
+	}
+} /* end of xdd_latency_histogram_percentiles() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_dump_header() - write the column names of the
+ * latency histogram CSV file
+ */
+void
+xdd_latency_histogram_dump_header(FILE *fp) {
+
+	fprintf(fp,"Pass,Target,Worker,OpType,Low_usec,High_usec,Count,Cumulative_Percent\n");
+} /* end of xdd_latency_histogram_dump_header() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_latency_histogram_dump() - write the buckets of a histogram that
+ * have ops in them to the latency histogram CSV file. One line is written
+ * for each bucket of each op type. "pass" and "worker" are written as is
+ * so the caller can use "all" for a whole run or a whole target.
+ */
+void
+xdd_latency_histogram_dump(FILE *fp, xint_latency_histogram_t *lhp, char *pass, int32_t target_number, char *worker) {
+	int			type;
+	int			i;
+	int64_t		cumulative;
+
+
+	for (type = 0; type < XDD_LATHIST_OPTYPES; type++) {
+		if (lhp->lh_total[type] == 0)
+			continue;
+		cumulative = 0;
+		for (i = 0; i < XDD_LATHIST_BUCKETS; i++) {
+			if (lhp->lh_counts[type][i] == 0)
+				continue;
+			cumulative += lhp->lh_counts[type][i];
+			fprintf(fp,"%s,%d,%s,%s,%.3f,%.3f,%llu,%.4f\n",
+				pass,
+				target_number,
+				worker,
+				xdd_latency_histogram_optype_names[type],
+				(double)xdd_latency_histogram_bucket_low(i) / 1000.0,
+				(double)xdd_latency_histogram_bucket_high(i) / 1000.0,
+				(unsigned long long)lhp->lh_counts[type][i],
+				((double)cumulative * 100.0) / (double)lhp->lh_total[type]);
+		}
+	}
+} /* end of xdd_latency_histogram_dump() */
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -23,7 +23,7 @@
 /* The format of the entries in the xdd function table */
 typedef int (*func_ptr)(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 
-#define XDD_EXT_HELP_LINES 5
+#define XDD_EXT_HELP_LINES 7
 struct xdd_func {
 	char    *func_name;     /* name of the function */
 	char    *func_alt;      /* Alternate name of the function */
@@ -60,7 +60,9 @@ int xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 int xddfunc_help(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_id(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_ioengine(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_kbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_latency_histogram(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_lockstep(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_looseordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_maxall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -70,6 +72,7 @@ int xddfunc_maxpri(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 int xddfunc_mbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_memalign(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_memory_usage(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_metadata(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_multipath(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_nobarrier(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -114,6 +117,7 @@ int xddfunc_starttime(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 int xddfunc_starttrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_stoponerror(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_stoptrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_stripe(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_serialordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_syncio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_syncwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -127,6 +131,7 @@ int xddfunc_targetoffset(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t
 int xddfunc_targets(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_targetstartdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_targetout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_taskspin(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_throttle(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timelimit(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timerinfo(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
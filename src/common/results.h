@@ -26,6 +26,14 @@
 #define RESULTS_TARGET_AVG	0x0000000000000100		// Average information for each target over all passes
 #define RESULTS_COMBINED	0x0000000000000200		// Run information for all Targets over all passes
 
+// Latency percentiles kept in the results - see xdd_latency_histogram_percentiles()
+#define RESULTS_LATENCY_PERCENTILES	5
+#define RESULTS_P50					0
+#define RESULTS_P90					1
+#define RESULTS_P99					2
+#define RESULTS_P999				3
+#define RESULTS_P9999				4
+
 struct results {
 	uint64_t	flags;					// Flags that tell the display function what to display
 	char		*what;					// The type of information line to display - Queue Pass, Target Pass, Queue Avg, Target Avg, Combined
@@ -58,7 +66,7 @@ struct results {
 	double		accumulated_op_time;		// Total Accumulated Time in seconds processing I/O ops 
 	double		accumulated_read_op_time;	// Total Accumulated Time in seconds processing read I/O ops 
 	double		accumulated_write_op_time;	// Total Accumulated Time in seconds processing write I/O ops 
-	double		accumulated_pattern_fill_time;// Total Accumulated Time in seconds doing pattern fills 
+	double		accumulated_pattern_fill_time;// Total Accumulated Time in milliseconds doing pattern fills 
 	double		accumulated_flush_time;		// Total Accumulated Time in seconds doing buffer flushes 
 	double		accumulated_elapsed_time;	// Total Accumulated Time in seconds for all "elapsed" times 
 	double		accumulated_latency;		// Total Accumulated Latency Used to calculate average latency
@@ -141,6 +149,11 @@ struct results {
 	double		lowest_iops;			// Lowest individual op I/O Operations per second 
 	double		lowest_read_iops;		// Lowest individual op read I/O Operations per second 
 	double		lowest_write_iops;		// Lowest individual op write I/O Operations per second 
+
+	// Latency percentiles in milliseconds - only valid when latency histograms are kept, -1 otherwise
+	double		latency_percentile[RESULTS_LATENCY_PERCENTILES];		// All ops
+	double		read_latency_percentile[RESULTS_LATENCY_PERCENTILES];	// Read ops
+	double		write_latency_percentile[RESULTS_LATENCY_PERCENTILES];	// Write ops
 }; 
 typedef struct results results_t; 
 
@@ -183,6 +196,21 @@ void xdd_results_fmt_e2e_lag_time(results_t *rp);
 void xdd_results_fmt_e2e_percent_lag_time(results_t *rp);
 void xdd_results_fmt_e2e_first_read_time(results_t *rp);
 void xdd_results_fmt_e2e_last_write_time(results_t *rp);
+void xdd_results_fmt_p50_latency(results_t *rp);
+void xdd_results_fmt_p90_latency(results_t *rp);
+void xdd_results_fmt_p99_latency(results_t *rp);
+void xdd_results_fmt_p999_latency(results_t *rp);
+void xdd_results_fmt_p9999_latency(results_t *rp);
+void xdd_results_fmt_read_p50_latency(results_t *rp);
+void xdd_results_fmt_read_p90_latency(results_t *rp);
+void xdd_results_fmt_read_p99_latency(results_t *rp);
+void xdd_results_fmt_read_p999_latency(results_t *rp);
+void xdd_results_fmt_read_p9999_latency(results_t *rp);
+void xdd_results_fmt_write_p50_latency(results_t *rp);
+void xdd_results_fmt_write_p90_latency(results_t *rp);
+void xdd_results_fmt_write_p99_latency(results_t *rp);
+void xdd_results_fmt_write_p999_latency(results_t *rp);
+void xdd_results_fmt_write_p9999_latency(results_t *rp);
 void xdd_results_fmt_delimiter(results_t *rp);
 void xdd_results_fmt_text(results_t *rp);
 
@@ -47,6 +47,7 @@ xdd_init_new_target_data(target_data_t *tdp, int32_t n) {
 	tdp->td_preallocate = DEFAULT_PREALLOCATE;
 	tdp->td_pretruncate= DEFAULT_PRETRUNCATE;
 	tdp->td_queue_depth = DEFAULT_QUEUEDEPTH;
+	tdp->td_task_ring_spin = DEFAULT_TASK_RING_SPIN;
 	tdp->td_dpp->data_pattern_filename = (char *)DEFAULT_DATA_PATTERN_FILENAME;
 	tdp->td_dpp->data_pattern = (unsigned char *)DEFAULT_DATA_PATTERN;
 	tdp->td_dpp->data_pattern_length = DEFAULT_DATA_PATTERN_LENGTH;
@@ -137,6 +138,16 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 		tdp->td_target_bytes_to_xfer_per_pass = 0;
 		return;
 	}
+	// A metadata workload moves no data - a pass is the ops of all its phases
+	if (tdp->td_target_options & TO_METADATA) {
+		tdp->td_target_ops = xdd_metadata_ops_per_pass(tdp);
+		tdp->td_target_bytes_to_xfer_per_pass = 0;
+		return;
+	}
+	// With -e2e files the source side sizes the pass from the file tree when the target is opened
+	// and the destination side runs until the source side sends an EOF
+	if ((tdp->td_target_options & TO_E2E_FILES) && (tdp->td_numreqs == 0) && (tdp->td_bytes == 0))
+		tdp->td_bytes = tdp->td_xfer_size;
 	if (tdp->td_numreqs) 
 		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)(tdp->td_numreqs * tdp->td_xfer_size);
 	else if (tdp->td_bytes)
@@ -190,7 +201,9 @@ xdd_create_worker_data(target_data_t *tdp, int32_t q) {
 
 
 	// This is the upperlevel Worker_Data and it's next_qp needs to point to this new Worker_Data
-	wdp = malloc(sizeof(worker_data_t));
+	// It is aligned so that the counters of each Worker Thread start on their own cache line
+	if (posix_memalign((void **)&wdp, XINT_COUNTERS_CACHE_LINE_SIZE, sizeof(worker_data_t)))
+		wdp = NULL;
 	if (wdp == NULL) {
 		fprintf(xgp->errout,"%s: error getting memory for Worker_Data Structure for target %d - worker number %d\n",
 				xgp->progname, tdp->td_target_number, q);
@@ -223,6 +236,14 @@ xdd_create_worker_data(target_data_t *tdp, int32_t q) {
 			memcpy(wdp->wd_e2ep, tdp->td_e2ep, sizeof(xint_e2e_t));
 	}
 
+	// Allocate the latency histogram of this Worker Thread if the latency percentiles are needed
+	// A metadata workload always reports the latency percentiles of its phases
+	if ((xgp->global_options & GO_LATENCY_HISTOGRAM) || (tdp->td_target_options & TO_METADATA)) {
+		wdp->wd_lathistp = xdd_latency_histogram_alloc(tdp->td_target_number, "worker");
+		if (NULL == wdp->wd_lathistp)
+			return(NULL);
+	}
+
 	sprintf(wdp->wd_occupant_name,"TARGET%04d_WORKER%04d",tdp->td_target_number,wdp->wd_worker_number); 
 	xdd_init_barrier_occupant(&wdp->wd_occupant, wdp->wd_occupant_name, XDD_OCCUPANT_TYPE_WORKER_THREAD, (void *)wdp);
 	
@@ -295,6 +316,12 @@ xdd_build_target_data_substructure(xdd_plan_t* planp) {
 		// Calcualte the data transfer information - number of ops, bytes, starting offset, ...etc.
 		xdd_calculate_xfer_info(tdp);
 
+		// The latency histograms of the Worker Threads are merged into these at the end of each pass
+		if ((xgp->global_options & GO_LATENCY_HISTOGRAM) || (tdp->td_target_options & TO_METADATA)) {
+			tdp->td_lathistp = xdd_latency_histogram_alloc(target_number, "pass");
+			tdp->td_lathist_runp = xdd_latency_histogram_alloc(target_number, "run");
+		}
+
 		// Allocate a shiney new Worker Data Struct for each Worker Thread 
 		prev_wdp = NULL;
 		for (q = 0; q < tdp->td_queue_depth; q++ ) {
@@ -30,87 +30,67 @@
 // and the size of the TOT will be N*4 where N defaults to 1000 times 
 // the DEFAULT_TOT_MULTIPLIER.
 //
-// The tot_entries are assigned based on the block number being processed.
-// The tot_entry number is the block number mod the size of the block table.
+// The tot_entries are assigned based on the operation number being processed.
+// The tot_entry number is the operation number mod the size of the table.
 //
-// Each Worker Thread Data structure contains a tot_wait structure. The
-// tot_wait structure contains the condition variable that is waited on
-// by a Worker Thread that needs to use a particular tot_entry. 
-// In the event that more than one Worker Thread needs to use a specific
-// tot_entry, the tot_wait structures of each Worker Thread will be chained
-// together with the tot_entry being the anchor of the chain.
+// When Serial or Loose Ordering is in effect, the Worker Thread that is 
+// assigned operation N must wait for operation N-1 to be released before
+// it can issue its I/O. The Worker Thread that performs operation N-1 
+// releases it by storing N-1 into tot_op_number of tot_entry (N-1) mod size. 
+// The Worker Thread waiting for operation N-1 only looks at that one 
+// tot_entry so there is no lock involved when the previous operation has
+// already been released, which is the common case.
 //
-// +----------------+
-// | TOT ENTRY      |
-// |    tot_mutex   |  +-------------------+
-// |    tot_waitp----->| TOT WAIT Worker 0 |  +-------------------+
-// |     :          |  |   totw_nextp-------->| TOT WAIT Worker 2 |
-// +----------------+  |   totw_condition  |  |   totw_nextp=0    |
-//                     +-------------------+  |   totw_condition  |
-//                                            +-------------------+
-// The purpose of the TOT WAIT chain is to prevent TOT Collisions which
-// is the situation when one Worker Thread has "ownership" of a specific
-// tot_entry and a second Worker Thread needs to use it. This TOT WAIT
-// chain forces any subsequent Worker Threads to wait until the 
-// current Worker Thread completes its I/O operation and releases the
-// specific tot_entry.
+// A Worker Thread that has to wait sleeps on tot_seq of the tot_entry 
+// it is waiting on (a futex on Linux, a condition variable elsewhere). 
+// The releasing Worker Thread bumps tot_seq and only enters the kernel 
+// to wake the sleeper if tot_waiters says that there is one. Since each
+// tot_entry is waited on by the Worker Thread assigned the next operation, 
+// only that one Worker Thread is woken. All of them are woken only when
+// operations a whole table apart have Worker Threads sleeping on the same 
+// tot_entry, because the one that can go on is not known then.
 //
-// For example, consider the following, a target with 4 worker threads.
-// For the sake of aregument, say the TOT has only 4 enties.
-//     t=0: Worker0 is assigned to write block0 of a target tot_entry=0
-//     t=1: Worker1 is assigned to write block1 of a target tot_entry=1
-//     t=2: Worker2 is assigned to write block1 of a target tot_entry=2
-//     t=3: Worker3 is assigned to write block1 of a target tot_entry=3
-//      :
-//      :
-//     t=75 Worker0 completes block0, now assigned block 4 tot_entry 0
-//      :
-//     t=77 Worker2 completes block2, now assigned block 5 tot_entry 1
+// Each tot_entry occupies its own cache line so that Worker Threads
+// releasing and waiting on neighboring operations do not slow each 
+// other down.
+//
+// For example, consider a target with 4 worker threads and a TOT with 
+// only 4 entries.
+//     t=0: Worker0 is assigned op 0, nothing to wait for
+//     t=1: Worker1 is assigned op 1, waits for tot_entry 0 to reach op 0
+//     t=2: Worker2 is assigned op 2, waits for tot_entry 1 to reach op 1
+//     t=3: Worker3 is assigned op 3, waits for tot_entry 2 to reach op 2
 //      :
-//     t=79 Worker0 completes block4, now assigned block 6 tot_entry 2
+//     t=75 Worker0 completes op 0, stores 0 into tot_entry 0 and wakes Worker1
+//     t=76 Worker0 is assigned op 4, waits for tot_entry 3 to reach op 3
 //      :
-// The problem comes at time t=77 when Worker2 tries to get ownership
-// of tot_entry 1 which is currently owned by Worker1. At this point 
-// Worker2 will have to wait for Worker1 to complete. 
+// A starved Worker Thread can hold up all of the Worker Threads behind it
+// but the tot_entries themselves never collide since an operation can 
+// only be released after all of the operations before it.
 //
-// In a real-world workload, some Worker Threads get starved for cycles
-// and take an inordinate amount of time to complete. A starved Worker
-// Thread can be thousands of blocks behind all the other Worker Threads.
-// So, for example, Worker1 could be trying to process block 1 but 
-// because it is getting starved, the other Worker Threads could be
-// processing block numbers in the thousands (if there were no 
-// mechanism to prevent it).
+// The tot_op_number of an entry only increases during a pass and the
+// table is reset by tot_init() at the start of each pass.
 //
-#define TOT_ENTRY_AVAILABLE 1
-#define TOT_ENTRY_UNAVAILABLE 0
-/**
- * The Target Offset Table WAIT structure 
- * There is one of these per worker thread.
- */
-struct tot_wait {
-	struct tot_wait 		*totw_nextp;	// Pointer to the next tot_wait 
-	struct xint_worker_data	*totw_wdp;		// Pointer to the Worker that owns this tot_wait
-    pthread_cond_t 			totw_condition; 
-    int 					totw_is_released;
-	
-};
-typedef struct tot_wait tot_wait_t;
+#define TOT_CACHE_LINE_SIZE	64
 
 /** typedef unsigned long long iotimer_t; */
 struct tot_entry {
-    pthread_mutex_t tot_mutex;		// Mutex that is locked when updating items in this entry
-	struct	tot_wait	*tot_waitp;			// Pointer to the first tot_wait struct in the chain.
+    int64_t tot_op_number;					// Target Operation Number of the last op released through this entry, -1 if none
+	uint32_t tot_seq;						// Bumped every time this entry is released (also the futex word)
+	uint32_t tot_waiters;					// Number of Worker Threads sleeping on tot_seq
     nclk_t tot_wait_ts;						// Time that another Worker Thread starts to wait on this
-    nclk_t tot_post_ts;						// Time that the responsible Worker Thread posts this semaphore
+    nclk_t tot_post_ts;						// Time that the responsible Worker Thread releases this entry
     nclk_t tot_update_ts;					// Time that the responsible Worker Thread updates the byte_location and io_size
     int64_t tot_byte_offset;				// Byte Location that was just processed
-    int64_t tot_op_number;					// Target Operation Number for the op that processed this block
     int32_t tot_io_size;					// Size of I/O in bytes that was just processed
     int32_t tot_wait_worker_thread_number;	// Number of the Worker Thread that is waiting for this TOT entry to be posted
     int32_t tot_post_worker_thread_number;	// Number of the Worker Thread that posted this TOT entry 
     int32_t tot_update_worker_thread_number;// Number of the Worker Thread that last updated this TOT Entry
-	int32_t	tot_status;						// Either TOT_ENTRY_AVAILABLE or TOT_ENTRY_UNAVAILABLE
-};
+#if !defined(LINUX)
+    pthread_mutex_t tot_mutex;				// Protects the sleep on tot_seq when futexes are not available
+    pthread_cond_t tot_condition;			// Where Worker Threads sleep when futexes are not available
+#endif
+} __attribute__((aligned(TOT_CACHE_LINE_SIZE)));
 typedef struct tot_entry tot_entry_t;
 
 /**
@@ -136,6 +116,26 @@ int tot_init(tot_t** table, size_t queue_depth, size_t num_reqs);
  */
 int tot_destroy(tot_t* table);
 
+/**
+ * Wait for the specified operation to be released
+ *
+ * @return 0 on success, non-zero on failure
+ */
+int tot_wait(tot_t* table,
+	     int64_t req_number,
+	     int worker_thread_number);
+
+/**
+ * Release the specified operation and wake the Worker Thread waiting for it
+ *
+ * @return 0 on success, non-zero on failure
+ */
+int tot_release(tot_t* table,
+		int64_t req_number,
+		int worker_thread_number,
+		int64_t offset,
+		int32_t size);
+
 /**
  * Update the target offset table
  *
@@ -36,6 +36,311 @@ xdd_ts_overhead(struct xdd_ts_header *ts_hdrp) {
 		fflush(xgp->errout);
 	}
 } /* End of xdd_ts_overhead() */
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_map_segment() - map the next segment of a streamed time stamp
+ * file. The file is extended by one segment and the segment header is copied
+ * from the in-memory time stamp header. "first" is the number of the first
+ * entry that will go into the new segment.
+ * Returns 0 if all went well, -1 otherwise.
+ */
+static int
+xdd_ts_stream_map_segment(target_data_t *tdp, int64_t first) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tssp;
+	xdd_ts_header_t		*segp;
+	size_t				seg_bytes;
+	size_t				page_size;
+	int					status;
+
+
+	tsp = &tdp->td_ts_table;
+	tssp = tsp->ts_streamp;
+
+	// Let go of the previous segment - the kernel writes it back on its own time
+	if (tssp->tss_segp) {
+		munmap(tssp->tss_segp, tssp->tss_seg_bytes);
+		tssp->tss_segp = NULL;
+	}
+	tssp->tss_seg_offset += tssp->tss_seg_bytes;
+	tssp->tss_seg_bytes = 0;
+	tssp->tss_seg_entries = 0;
+
+	page_size = getpagesize();
+	seg_bytes = sizeof(struct xdd_ts_header) + (XDD_TS_STREAM_SEGMENT_ENTRIES * sizeof(struct xdd_ts_tte));
+	seg_bytes = ((seg_bytes + page_size - 1) / page_size) * page_size;
+
+#if (LINUX)
+	status = posix_fallocate(tssp->tss_fd, tssp->tss_seg_offset, seg_bytes);
+	if (status)
+		errno = status;
+#else
+	status = ftruncate(tssp->tss_fd, tssp->tss_seg_offset + seg_bytes);
+#endif
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_map_segment: Target %d: ERROR: Cannot extend timestamp stream file %s to %lld bytes - timestamp entries from %lld on are dropped\n",
+			xgp->progname,tdp->td_target_number,tsp->ts_binary_filename,(long long int)(tssp->tss_seg_offset + seg_bytes),(long long int)first);
+		fflush(xgp->errout);
+		perror("Reason");
+		return(-1);
+	}
+	segp = (xdd_ts_header_t *)mmap(NULL, seg_bytes, PROT_READ|PROT_WRITE, MAP_SHARED, tssp->tss_fd, tssp->tss_seg_offset);
+	if (segp == MAP_FAILED) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_map_segment: Target %d: ERROR: Cannot map %lld bytes of timestamp stream file %s - timestamp entries from %lld on are dropped\n",
+			xgp->progname,tdp->td_target_number,(long long int)seg_bytes,tsp->ts_binary_filename,(long long int)first);
+		fflush(xgp->errout);
+		perror("Reason");
+		return(-1);
+	}
+	memcpy(segp, tsp->ts_hdrp, offsetof(struct xdd_ts_header, tsh_tte));
+	segp->tsh_magic = XDD_TS_STREAM_MAGIC;
+	segp->tsh_numents = 0;
+	segp->tsh_tt_size = XDD_TS_STREAM_SEGMENT_ENTRIES;
+	segp->tsh_tt_bytes = seg_bytes;
+	segp->tsh_tte_indx = first;
+	tssp->tss_segp = segp;
+	tssp->tss_seg_bytes = seg_bytes;
+	return(0);
+} /* end of xdd_ts_stream_map_segment() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_flush() - copy the completed time stamp entries, in order,
+ * from the ring to the binary output file. Copying stops at the first entry
+ * that is not complete yet unless "final" is set, in which case every entry
+ * that has been handed out is copied.
+ * Only the stream thread calls this while the run is in progress.
+ */
+static void
+xdd_ts_stream_flush(target_data_t *tdp, int final) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tssp;
+	int64_t				next;
+	int64_t				allocated;
+	int64_t				slot;
+
+
+	tsp = &tdp->td_ts_table;
+	tssp = tsp->ts_streamp;
+	next = tssp->tss_flushed;
+	allocated = __atomic_load_n(&tssp->tss_allocated, __ATOMIC_ACQUIRE);
+	while (next < allocated) {
+		slot = next % tsp->ts_size;
+		if (!final && (__atomic_load_n(&tssp->tss_done[slot], __ATOMIC_ACQUIRE) != (next + 1)))
+			break;
+		if (tssp->tss_tscwp) {
+			// The columnar writer counts the entries that made it to the file itself
+			if (!tssp->tss_error && xdd_tsc_writer_append(tssp->tss_tscwp, &tsp->ts_hdrp->tsh_tte[slot])) {
+				fprintf(xgp->errout,"%s: xdd_ts_stream_flush: Target %d: ERROR: Cannot write timestamp stream file %s - timestamp entries from %lld on are dropped\n",
+					xgp->progname,tdp->td_target_number,tsp->ts_binary_filename,(long long int)tssp->tss_tscwp->tscw_header.tsc_numents);
+				fflush(xgp->errout);
+				perror("Reason");
+				tssp->tss_error = 1;
+			}
+		} else if (!tssp->tss_error) {
+			if ((tssp->tss_segp == NULL) || (tssp->tss_seg_entries == XDD_TS_STREAM_SEGMENT_ENTRIES)) {
+				if (xdd_ts_stream_map_segment(tdp, next))
+					tssp->tss_error = 1;
+			}
+		}
+		// If the file cannot take any more entries they are dropped so the Target Thread never stalls
+		if (!tssp->tss_error && !tssp->tss_tscwp) {
+			tssp->tss_segp->tsh_tte[tssp->tss_seg_entries] = tsp->ts_hdrp->tsh_tte[slot];
+			tssp->tss_seg_entries++;
+			tssp->tss_segp->tsh_numents = tssp->tss_seg_entries;
+			tssp->tss_written++;
+		}
+		next++;
+		// Hand the slot back to the Target Thread every so often rather than only at the end
+		if ((next & 0xff) == 0)
+			__atomic_store_n(&tssp->tss_flushed, next, __ATOMIC_RELEASE);
+	}
+	__atomic_store_n(&tssp->tss_flushed, next, __ATOMIC_RELEASE);
+} /* end of xdd_ts_stream_flush() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_wake() - wake the stream thread up before its next tick.
+ * Only the first caller after a flush takes the lock.
+ */
+static void
+xdd_ts_stream_wake(xint_ts_stream_t *tssp) {
+
+	if (__atomic_exchange_n(&tssp->tss_kicked, 1, __ATOMIC_ACQ_REL))
+		return;
+	pthread_mutex_lock(&tssp->tss_mutex);
+	pthread_cond_signal(&tssp->tss_wake);
+	pthread_mutex_unlock(&tssp->tss_mutex);
+} /* end of xdd_ts_stream_wake() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_thread() - move the completed time stamp entries of a target
+ * to its binary output file every XDD_TS_STREAM_FLUSH_USEC, or as soon as the
+ * Target Thread finds the ring half full, and let the Target Thread know
+ * when there is room in the ring again.
+ */
+static void *
+xdd_ts_stream_thread(void *datap) {
+	target_data_t		*tdp;
+	xint_ts_stream_t	*tssp;
+	struct timespec		deadline;
+
+
+	tdp = (target_data_t *)datap;
+	tssp = tdp->td_ts_table.ts_streamp;
+	pthread_mutex_lock(&tssp->tss_mutex);
+	while (!__atomic_load_n(&tssp->tss_stop, __ATOMIC_ACQUIRE)) {
+		if (!__atomic_load_n(&tssp->tss_kicked, __ATOMIC_ACQUIRE)) {
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			deadline.tv_nsec += XDD_TS_STREAM_FLUSH_USEC * 1000;
+			if (deadline.tv_nsec >= 1000000000) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000;
+			}
+			pthread_cond_timedwait(&tssp->tss_wake, &tssp->tss_mutex, &deadline);
+		}
+		pthread_mutex_unlock(&tssp->tss_mutex);
+		__atomic_store_n(&tssp->tss_kicked, 0, __ATOMIC_RELEASE);
+		xdd_ts_stream_flush(tdp, 0);
+		pthread_mutex_lock(&tssp->tss_mutex);
+		pthread_cond_broadcast(&tssp->tss_space);
+	}
+	pthread_mutex_unlock(&tssp->tss_mutex);
+	return(NULL);
+} /* end of xdd_ts_stream_thread() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_start() - open the binary output file and start the stream
+ * thread for "-ts stream". Called by xdd_ts_setup() once the time stamp
+ * header and the file names are set up.
+ * Returns 0 if all went well, -1 otherwise.
+ */
+static int
+xdd_ts_stream_start(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tssp;
+	int					status;
+
+
+	tsp = &tdp->td_ts_table;
+	tssp = (xint_ts_stream_t *)calloc(1, sizeof(xint_ts_stream_t));
+	if (tssp)
+		tssp->tss_done = (int64_t *)calloc(tsp->ts_size, sizeof(int64_t));
+	if ((tssp == NULL) || (tssp->tss_done == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot allocate memory for the timestamp stream\n",
+			xgp->progname,tdp->td_target_number);
+		fflush(xgp->errout);
+		perror("Reason");
+		if (tssp)
+			free(tssp);
+		return(-1);
+	}
+	tssp->tss_fd = open(tsp->ts_binary_filename,O_RDWR|O_CREAT|O_TRUNC,0666);
+	if (tssp->tss_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot open timestamp stream file %s\n",
+			xgp->progname,tdp->td_target_number,tsp->ts_binary_filename);
+		fflush(xgp->errout);
+		perror("Reason");
+		free(tssp->tss_done);
+		free(tssp);
+		return(-1);
+	}
+	if (tsp->ts_options & TS_COMPACT) {
+		tssp->tss_tscwp = xdd_tsc_writer_open(tssp->tss_fd, tsp->ts_hdrp);
+		if (tssp->tss_tscwp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot start columnar timestamp stream file %s\n",
+				xgp->progname,tdp->td_target_number,tsp->ts_binary_filename);
+			fflush(xgp->errout);
+			perror("Reason");
+			close(tssp->tss_fd);
+			free(tssp->tss_done);
+			free(tssp);
+			return(-1);
+		}
+	}
+	pthread_mutex_init(&tssp->tss_mutex, NULL);
+	pthread_cond_init(&tssp->tss_wake, NULL);
+	pthread_cond_init(&tssp->tss_space, NULL);
+	tsp->ts_streamp = tssp;
+	status = pthread_create(&tssp->tss_thread, NULL, xdd_ts_stream_thread, tdp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot create the timestamp stream thread\n",
+			xgp->progname,tdp->td_target_number);
+		fflush(xgp->errout);
+		if (tssp->tss_tscwp)
+			xdd_tsc_writer_abort(tssp->tss_tscwp);
+		close(tssp->tss_fd);
+		pthread_mutex_destroy(&tssp->tss_mutex);
+		pthread_cond_destroy(&tssp->tss_wake);
+		pthread_cond_destroy(&tssp->tss_space);
+		free(tssp->tss_done);
+		free(tssp);
+		tsp->ts_streamp = NULL;
+		return(-1);
+	}
+	return(0);
+} /* end of xdd_ts_stream_start() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_finish() - stop the stream thread, copy whatever is left in
+ * the ring to the binary output file and trim the file to its actual length.
+ */
+static void
+xdd_ts_stream_finish(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tssp;
+	off_t				file_size;
+	int64_t				written;
+	int64_t				columnar_size;
+
+
+	tsp = &tdp->td_ts_table;
+	tssp = tsp->ts_streamp;
+	if (tssp == NULL)
+		return;
+	pthread_mutex_lock(&tssp->tss_mutex);
+	__atomic_store_n(&tssp->tss_stop, 1, __ATOMIC_RELEASE);
+	pthread_cond_signal(&tssp->tss_wake);
+	pthread_mutex_unlock(&tssp->tss_mutex);
+	pthread_join(tssp->tss_thread, NULL);
+	xdd_ts_stream_flush(tdp, 1);
+
+	// The columnar writer writes its last block and its index, the last segment ends right after its last entry
+	file_size = tssp->tss_seg_offset;
+	if (tssp->tss_tscwp) {
+		if (xdd_tsc_writer_close(tssp->tss_tscwp, &written, &columnar_size)) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_finish: Target %d: ERROR: Cannot finish columnar timestamp stream file %s\n",
+				xgp->progname,tdp->td_target_number,tsp->ts_binary_filename);
+			fflush(xgp->errout);
+			perror("Reason");
+		}
+		tssp->tss_tscwp = NULL;
+		tssp->tss_written = written;
+		file_size = columnar_size;
+	}
+	if (tssp->tss_segp) {
+		tssp->tss_segp->tsh_tt_bytes = sizeof(struct xdd_ts_header) + (tssp->tss_seg_entries * sizeof(struct xdd_ts_tte));
+		file_size += tssp->tss_segp->tsh_tt_bytes;
+		munmap(tssp->tss_segp, tssp->tss_seg_bytes);
+		tssp->tss_segp = NULL;
+	}
+	if (ftruncate(tssp->tss_fd, file_size)) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_finish: Target %d: ERROR: Cannot trim timestamp stream file %s to %lld bytes\n",
+			xgp->progname,tdp->td_target_number,tsp->ts_binary_filename,(long long int)file_size);
+		fflush(xgp->errout);
+		perror("Reason");
+	}
+	close(tssp->tss_fd);
+	fprintf(xgp->output,"Timestamp stream written to %s - %lld entries, %lld bytes\n",
+		tsp->ts_binary_filename, (long long)tssp->tss_written, (long long)file_size);
+	if (tssp->tss_written != tssp->tss_flushed) 
+		fprintf(xgp->output,"Timestamp stream %s is missing %lld entries\n",
+			tsp->ts_binary_filename, (long long)(tssp->tss_flushed - tssp->tss_written));
+	pthread_mutex_destroy(&tssp->tss_mutex);
+	pthread_cond_destroy(&tssp->tss_wake);
+	pthread_cond_destroy(&tssp->tss_space);
+	free(tssp->tss_done);
+	free(tssp);
+	tsp->ts_streamp = NULL;
+} /* end of xdd_ts_stream_finish() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_ts_setup() - set up the time stamping
  * If time stamping is already turned on for this target then we need to make 
@@ -48,7 +353,8 @@ xdd_ts_setup(target_data_t *tdp) {
 	nclk_t		cycleval; /* resolution of the clock in nanoseconds per ticl */
 	time_t 		t;  /* Time */
 	size_t 	    tt_entries; /* number of entries in the time stamp table */
-	int32_t 	tt_bytes; /* size of time stamp table in bytes */
+	size_t	 	tt_bytes; /* size of time stamp table in bytes */
+	int64_t		run_entries; /* number of entries needed for the entire run */
 	int32_t		ts_filename_size; // Number of bytes in the size of the file name
 
 
@@ -58,7 +364,17 @@ xdd_ts_setup(target_data_t *tdp) {
 		return;
 
 	// Calculate the size of the timestamp table needed for this entire run
-	tsp->ts_size = (tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth;
+	run_entries = (tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth;
+	if (tsp->ts_options & TS_STREAM) {
+		// The table is only a ring that the stream thread drains to the binary output file
+		if (tsp->ts_size <= 0)
+			tsp->ts_size = XDD_TS_STREAM_DEFAULT_ENTRIES;
+		if (tsp->ts_size < (2 * tdp->td_queue_depth))
+			tsp->ts_size = 2 * tdp->td_queue_depth;
+		if (tsp->ts_size > run_entries)
+			tsp->ts_size = run_entries;
+		tsp->ts_options &= ~(TS_WRAP | TS_ONESHOT);
+	} else tsp->ts_size = run_entries;
 	if (tsp->ts_options & (TS_TRIGTIME | TS_TRIGOP)) 
 		tsp->ts_options &= ~TS_ALL; /* turn off the "time stamp all operations" flag if a trigger was requested */
 	if (tsp->ts_options & TS_TRIGTIME) { /* adjust the trigger time to an actual local time */
@@ -68,7 +384,7 @@ xdd_ts_setup(target_data_t *tdp) {
 
 	/* Calculate size of the time stamp table and malloc it */
 	tt_entries = tsp->ts_size; 
-	if (tt_entries < ((tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth)) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
+	if ((tt_entries < (size_t)run_entries) && !(tsp->ts_options & TS_STREAM)) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
 		if (((tsp->ts_options & TS_WRAP) == 0) &&
 			((tsp->ts_options & TS_ONESHOT) == 0)) {
 			fprintf(xgp->errout,"%s: ***NOTICE*** The size specified for timestamp table for target %d is too small - enabling time stamp wrapping to compensate\n",xgp->progname,tdp->td_target_number);
@@ -77,7 +393,7 @@ xdd_ts_setup(target_data_t *tdp) {
 		}
 	}
 	/* calculate the total size in bytes of the time stamp table */
-	tt_bytes = (int)((sizeof(struct xdd_ts_header)) + (tt_entries * sizeof(struct xdd_ts_tte)));
+	tt_bytes = (sizeof(struct xdd_ts_header)) + (tt_entries * sizeof(struct xdd_ts_tte));
 #if (LINUX || SOLARIS || AIX || DARWIN)
 	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)valloc(tt_bytes);
 if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_setup: Target: %d: Worker: -: TS INITIALIZATION td_ts_table.ts_hdrp: %p: %d: entries\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_ts_table.ts_hdrp,(int)tt_entries);
@@ -85,8 +401,8 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)malloc(tt_bytes);
 #endif
 	if (tdp->td_ts_table.ts_hdrp == 0) {
-		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: ERROR: Cannot allocate %d bytes of memory for timestamp table\n",
-			xgp->progname,tdp->td_target_number, tt_bytes);
+		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: ERROR: Cannot allocate %lld bytes of memory for timestamp table\n",
+			xgp->progname,tdp->td_target_number, (long long int)tt_bytes);
 		fflush(xgp->errout);
 		perror("Reason");
 		tsp->ts_options &= ~TS_ON;
@@ -107,7 +423,7 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	xdd_ts_overhead(tdp->td_ts_table.ts_hdrp);
 
         /* Set the XDD Version into the timestamp header */
-        tdp->td_ts_table.ts_hdrp->tsh_magic = 0xDEADBEEF;
+        tdp->td_ts_table.ts_hdrp->tsh_magic = XDD_TS_MAGIC;
         snprintf(tdp->td_ts_table.ts_hdrp->tsh_version, sizeof(tdp->td_ts_table.ts_hdrp->tsh_version), "%s", PACKAGE_STRING);
         
 	/* init entries in the trace table header */
@@ -162,10 +478,142 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	  }
 	  snprintf(tsp->ts_output_filename,ts_filename_size,"%s.target.%04d.csv",tdp->td_planp->ts_output_filename_prefix,tdp->td_target_number);
     }
+
+	// Start the thread that writes the time stamp entries to the binary output file
+	if (tsp->ts_options & TS_STREAM) {
+		if (xdd_ts_stream_start(tdp)) {
+			tsp->ts_options &= ~TS_ON;
+			return;
+		}
+	}
 if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_setup: Target: %d: Worker: -: TS INITIALIZATION COMPLETE for td_ts_table.ts_hdrp: %p: %d: entries\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_ts_table.ts_hdrp,(int)tt_entries);
 if (xgp->global_options & GO_DEBUG_TS) xdd_show_ts_table(&tdp->td_ts_table, tdp->td_target_number);
 	return;
 } /* end of xdd_ts_setup() */
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_assign_entry() - assign the next time stamp entry to a Worker Thread
+ * Called by the Target Thread while it sets up the task for the Worker Thread.
+ * With -ts stream this wakes the stream thread once the ring is half full
+ * and waits for it if the ring is full.
+ * Returns a pointer to the time stamp entry or NULL if time stamping is off.
+ */
+xdd_ts_tte_t *
+xdd_ts_assign_entry(target_data_t *tdp, worker_data_t *wdp) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tssp;
+	xdd_ts_tte_t		*ttep;
+	int64_t				entry;
+	int64_t				used;
+
+
+	tsp = &tdp->td_ts_table;
+	if (!(tsp->ts_options & (TS_ON|TS_TRIGGERED)))
+		return(NULL);
+
+	tssp = tsp->ts_streamp;
+	if (tssp) {
+		entry = tssp->tss_allocated;
+		used = entry - __atomic_load_n(&tssp->tss_flushed, __ATOMIC_ACQUIRE);
+		// While the ring is full the Worker Threads wake the stream thread as they finish entries
+		if (used >= tsp->ts_size)
+			__atomic_store_n(&tssp->tss_waiting, 1, __ATOMIC_SEQ_CST);
+		if (used >= (tsp->ts_size / 2))
+			xdd_ts_stream_wake(tssp);
+		if (used >= tsp->ts_size) {
+			pthread_mutex_lock(&tssp->tss_mutex);
+			while ((entry - __atomic_load_n(&tssp->tss_flushed, __ATOMIC_ACQUIRE)) >= tsp->ts_size)
+				pthread_cond_wait(&tssp->tss_space, &tssp->tss_mutex);
+			pthread_mutex_unlock(&tssp->tss_mutex);
+			__atomic_store_n(&tssp->tss_waiting, 0, __ATOMIC_RELEASE);
+		}
+		wdp->wd_ts_entry = entry % tsp->ts_size;
+		wdp->wd_ts_stream_entry = entry + 1;
+		ttep = &tsp->ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+		memset(ttep, 0, sizeof(*ttep));
+		__atomic_store_n(&tssp->tss_allocated, entry + 1, __ATOMIC_RELEASE);
+		return(ttep);
+	}
+
+	wdp->wd_ts_entry = tsp->ts_current_entry;	
+	ttep = &tsp->ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	tsp->ts_current_entry++;
+	if (tsp->ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
+		if (tsp->ts_current_entry == tsp->ts_size)
+			tsp->ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
+	} else if (tsp->ts_options & TS_WRAP) {
+		if (tsp->ts_current_entry == tsp->ts_size)
+			tsp->ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
+		tsp->ts_hdrp->tsh_tte_indx = tsp->ts_current_entry;
+	}
+	return(ttep);
+} /* end of xdd_ts_assign_entry() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_entry_done() - called by a Worker Thread when it has finished the
+ * task that its time stamp entry describes. With -ts stream this lets the
+ * stream thread copy the entry to the binary output file.
+ */
+void
+xdd_ts_entry_done(worker_data_t *wdp) {
+	xint_ts_stream_t	*tssp;
+
+
+	if (wdp->wd_ts_stream_entry == 0)
+		return;
+	tssp = wdp->wd_tdp->td_ts_table.ts_streamp;
+	__atomic_store_n(&tssp->tss_done[wdp->wd_ts_entry], wdp->wd_ts_stream_entry, __ATOMIC_RELEASE);
+	wdp->wd_ts_stream_entry = 0;
+	// The Target Thread is stuck until the stream thread makes room in the ring.
+	// The fence keeps the check of tss_waiting after the store of this entry.
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&tssp->tss_waiting, __ATOMIC_ACQUIRE))
+		xdd_ts_stream_wake(tssp);
+} /* end of xdd_ts_entry_done() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_write_compact() - write the timestamp entries to a columnar time
+ * stamp file for "-ts compact"
+ */
+static void
+xdd_ts_write_compact(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+	xint_tsc_writer_t	*tscwp;
+	xdd_ts_header_t		*ts_hdrp;
+	int64_t				i;
+	int64_t				numents;
+	int64_t				file_size;
+	int32_t				ttfd;
+	int					status;
+
+
+	tsp = &tdp->td_ts_table;
+	ts_hdrp = tsp->ts_hdrp;
+	ttfd = open(tsp->ts_binary_filename,O_WRONLY|O_CREAT|O_TRUNC,0666);
+	if (ttfd < 0) {
+		fprintf(xgp->errout,"%s: cannot open timestamp table binary output file %s\n", xgp->progname,tsp->ts_binary_filename);
+		fflush(xgp->errout);
+		perror("reason");
+		return;
+	}
+	tscwp = xdd_tsc_writer_open(ttfd, ts_hdrp);
+	status = (tscwp == NULL);
+	for (i = 0; (status == 0) && (i < ts_hdrp->tsh_numents); i++)
+		status = xdd_tsc_writer_append(tscwp, &ts_hdrp->tsh_tte[i]);
+	if (tscwp) {
+		if (status)
+			xdd_tsc_writer_abort(tscwp);
+		else status = xdd_tsc_writer_close(tscwp, &numents, &file_size);
+	}
+	if (status) {
+		fprintf(xgp->errout,"(%d) %s: cannot write timestamp table binary output file %s\n", tdp->td_target_number, xgp->progname,tsp->ts_binary_filename);
+		fflush(xgp->errout);
+		perror("reason");
+	} else fprintf(xgp->output,"Timestamp table written to %s - %lld entries, %lld bytes\n",
+		tsp->ts_binary_filename, (long long)numents, (long long)file_size);
+
+	close(ttfd);
+} /* end of xdd_ts_write_compact() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_ts_write() - write the timestamp entried to a file. 
  */
@@ -182,6 +630,14 @@ xdd_ts_write(target_data_t *tdp) {
 	ts_hdrp = tsp->ts_hdrp;
 	if ((tsp->ts_options & TS_DUMP) == 0)  /* dump only if DUMP was specified */
 		return;
+	if (tsp->ts_options & TS_STREAM) { /* the entries are already in the file */
+		xdd_ts_stream_finish(tdp);
+		return;
+	}
+	if (tsp->ts_options & TS_COMPACT) {
+		xdd_ts_write_compact(tdp);
+		return;
+	}
 	ttfd = open(tsp->ts_binary_filename,O_WRONLY|O_CREAT,0666);
 	if (ttfd < 0) {
 		fprintf(xgp->errout,"%s: cannot open timestamp table binary output file %s\n", xgp->progname,tsp->ts_binary_filename);
@@ -263,6 +719,13 @@ xdd_ts_reports(target_data_t *tdp) {
 #endif
     if(tsp->ts_options & TS_SUPPRESS_OUTPUT)
 	return;
+    if (tsp->ts_options & TS_STREAM) { /* the in-memory table only holds the last few entries */
+	if (tsp->ts_options & (TS_SUMMARY | TS_DETAILED)) {
+	    fprintf(xgp->output,"%s: Target %d: Timestamp reports are not generated with -ts stream - use xdd-read-tsdumps on %s\n",
+		xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+	}
+	return;
+    }
     if (!(tdp->td_current_state & TARGET_CURRENT_STATE_PASS_COMPLETE)) {
 	fprintf(xgp->errout,"%s: ALERT! ts_reports: target %d has not yet completed! Results beyond this point are unpredictable!\n",
 		xgp->progname, tdp->td_target_number);
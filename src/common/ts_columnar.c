@@ -0,0 +1,615 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that write and read the columnar
+ * time stamp files of "-ts compact" - see xint_ts_columnar.h for the format.
+ * Nothing here reports errors itself so the time stamp tools can use it too.
+ */
+#include "xint.h"
+
+// Where each column comes from in an xdd_ts_tte and how its values are made
+static struct xdd_tsc_column {
+	size_t		offset;		// Offset of the field in xdd_ts_tte
+	int			size;		// Size of the field in bytes
+	int			how;		// XDD_TSC_VALUE, XDD_TSC_DELTA or XDD_TSC_DIFF
+	int			ref;		// Column of the same entry that a XDD_TSC_DIFF column is relative to
+} xdd_tsc_columns[XDD_TSC_COLUMNS] = {
+#define TSC_FIELD(f)	offsetof(struct xdd_ts_tte, f), sizeof(((struct xdd_ts_tte *)0)->f)
+	{ TSC_FIELD(tte_op_type),				XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_pass_number),			XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_worker_thread_number),	XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_thread_id),				XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_disk_processor_start),	XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_disk_processor_end),	XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_net_processor_start),	XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_net_processor_end),		XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_disk_xfer_size),		XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_net_xfer_size),			XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_net_xfer_calls),		XDD_TSC_VALUE,	0 },
+	{ TSC_FIELD(tte_op_number),				XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_byte_offset),			XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_disk_start),			XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_disk_start_k),			XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_disk_end),				XDD_TSC_DIFF,	XDD_TSC_COL_DISK_START },
+	{ TSC_FIELD(tte_disk_end_k),			XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_net_start),				XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_net_start_k),			XDD_TSC_DELTA,	0 },
+	{ TSC_FIELD(tte_net_end),				XDD_TSC_DIFF,	XDD_TSC_COL_NET_START },
+	{ TSC_FIELD(tte_net_end_k),				XDD_TSC_DELTA,	0 },
+#undef TSC_FIELD
+};
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_get_field() - return the field of an entry for a column
+ */
+static int64_t
+xdd_tsc_get_field(xdd_ts_tte_t *ttep, int col) {
+	char	*fp;
+
+
+	fp = (char *)ttep + xdd_tsc_columns[col].offset;
+	switch (xdd_tsc_columns[col].size) {
+		case 1: return(*(int8_t *)fp);
+		case 2: return(*(int16_t *)fp);
+		case 4: return(*(int32_t *)fp);
+		default: return(*(int64_t *)fp);
+	}
+} /* end of xdd_tsc_get_field() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_set_field() - set the field of an entry for a column
+ */
+static void
+xdd_tsc_set_field(xdd_ts_tte_t *ttep, int col, int64_t value) {
+	char	*fp;
+
+
+	fp = (char *)ttep + xdd_tsc_columns[col].offset;
+	switch (xdd_tsc_columns[col].size) {
+		case 1: *(int8_t *)fp = (int8_t)value; break;
+		case 2: *(int16_t *)fp = (int16_t)value; break;
+		case 4: *(int32_t *)fp = (int32_t)value; break;
+		default: *(int64_t *)fp = value; break;
+	}
+} /* end of xdd_tsc_set_field() */
+
+/*----------------------------------------------------------------------------*/
+/* Zig-zag and varint encoding - small positive and negative values take
+ * one byte, seven bits per byte with the high bit set on all but the last.
+ * The differences are taken modulo 2^64 so every value round trips.
+ */
+static inline uint64_t
+xdd_tsc_zigzag(int64_t value) {
+	return(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static inline int64_t
+xdd_tsc_unzigzag(uint64_t value) {
+	return((int64_t)((value >> 1) ^ (~(value & 1) + 1)));
+}
+
+static inline int
+xdd_tsc_varint_bytes(uint64_t value) {
+	int		bytes;
+
+	for (bytes = 1; value >= 0x80; bytes++)
+		value >>= 7;
+	return(bytes);
+}
+
+static inline unsigned char *
+xdd_tsc_put_varint(unsigned char *p, uint64_t value) {
+	while (value >= 0x80) {
+		*p++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*p++ = (unsigned char)value;
+	return(p);
+}
+
+// Returns a pointer past the varint or NULL if it runs past "end"
+static inline const unsigned char *
+xdd_tsc_get_varint(const unsigned char *p, const unsigned char *end, uint64_t *valuep) {
+	uint64_t	value;
+	int			shift;
+
+	value = 0;
+	for (shift = 0; (p < end) && (shift < 64); shift += 7) {
+		value |= (uint64_t)(*p & 0x7f) << shift;
+		if ((*p++ & 0x80) == 0) {
+			*valuep = value;
+			return(p);
+		}
+	}
+	return(NULL);
+}
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_column_values() - make the values of a column from "entries"
+ * time stamp entries. The first entry of a XDD_TSC_DELTA column is
+ * relative to 0 so every block can be decoded on its own.
+ */
+static void
+xdd_tsc_column_values(xdd_ts_tte_t *ttep, int32_t entries, int col, int64_t *values) {
+	int32_t		i;
+	uint64_t	prev;
+	uint64_t	field;
+
+
+	prev = 0;
+	for (i = 0; i < entries; i++) {
+		field = (uint64_t)xdd_tsc_get_field(&ttep[i], col);
+		switch (xdd_tsc_columns[col].how) {
+			case XDD_TSC_DELTA:
+				values[i] = (int64_t)(field - prev);
+				prev = field;
+				break;
+			case XDD_TSC_DIFF:
+				values[i] = (int64_t)(field - (uint64_t)xdd_tsc_get_field(&ttep[i], xdd_tsc_columns[col].ref));
+				break;
+			default:
+				values[i] = (int64_t)field;
+				break;
+		}
+	}
+} /* end of xdd_tsc_column_values() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_encode_block() - encode "entries" time stamp entries into a block
+ * at "bufp", which must have room for XDD_TSC_MAX_BLOCK_BYTES.
+ * "first_entry" is the number of the first of them in the file.
+ * Returns the number of bytes in the block.
+ */
+uint32_t
+xdd_tsc_encode_block(xdd_ts_tte_t *ttep, int32_t entries, int64_t first_entry, unsigned char *bufp) {
+	xdd_tsc_block_t	*bp;
+	int64_t			values[XDD_TSC_BLOCK_ENTRIES];
+	unsigned char	*p;
+	unsigned char	*column_start;
+	int64_t			varint_bytes;
+	int64_t			runs_bytes;
+	int32_t			i, run;
+	int				col;
+	nclk_t			start, end;
+
+
+	bp = (xdd_tsc_block_t *)bufp;
+	memset(bp, 0, sizeof(*bp));
+	bp->tscb_magic = XDD_TSC_BLOCK_MAGIC;
+	bp->tscb_entries = entries;
+	bp->tscb_first_entry = first_entry;
+	bp->tscb_min_time = 0;
+	bp->tscb_max_time = 0;
+	for (i = 0; i < entries; i++) {
+		start = ttep[i].tte_disk_start;
+		if ((start == 0) || ((ttep[i].tte_net_start != 0) && (ttep[i].tte_net_start < start)))
+			start = ttep[i].tte_net_start;
+		end = (ttep[i].tte_net_end > ttep[i].tte_disk_end) ? ttep[i].tte_net_end : ttep[i].tte_disk_end;
+		if ((start != 0) && ((bp->tscb_min_time == 0) || (start < bp->tscb_min_time)))
+			bp->tscb_min_time = start;
+		if (end > bp->tscb_max_time)
+			bp->tscb_max_time = end;
+	}
+
+	p = bufp + sizeof(*bp);
+	for (col = 0; col < XDD_TSC_COLUMNS; col++) {
+		xdd_tsc_column_values(ttep, entries, col, values);
+		// Use runs if they are smaller than one varint per entry
+		varint_bytes = 0;
+		runs_bytes = 0;
+		for (i = 0; i < entries; i += run) {
+			for (run = 1; (i + run < entries) && (values[i + run] == values[i]); run++)
+				;
+			varint_bytes += run * xdd_tsc_varint_bytes(xdd_tsc_zigzag(values[i]));
+			runs_bytes += xdd_tsc_varint_bytes(run) + xdd_tsc_varint_bytes(xdd_tsc_zigzag(values[i]));
+		}
+		column_start = p;
+		if (runs_bytes < varint_bytes) {
+			bp->tscb_encodings |= (1 << col);
+			for (i = 0; i < entries; i += run) {
+				for (run = 1; (i + run < entries) && (values[i + run] == values[i]); run++)
+					;
+				p = xdd_tsc_put_varint(p, run);
+				p = xdd_tsc_put_varint(p, xdd_tsc_zigzag(values[i]));
+			}
+		} else {
+			for (i = 0; i < entries; i++)
+				p = xdd_tsc_put_varint(p, xdd_tsc_zigzag(values[i]));
+		}
+		bp->tscb_column_bytes[col] = p - column_start;
+	}
+	// Pad so the next block starts on an 8-byte boundary
+	while ((p - bufp) != XDD_TSC_ALIGN(p - bufp))
+		*p++ = 0;
+	bp->tscb_bytes = p - bufp;
+	return(bp->tscb_bytes);
+} /* end of xdd_tsc_encode_block() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_decode_block() - decode the block at "bp" into time stamp entries.
+ * "bytes" is the most the block can take - the rest of the file.
+ * "ttep" must have room for XDD_TSC_BLOCK_ENTRIES entries.
+ * Returns the number of entries or -1 if the block is damaged.
+ */
+int32_t
+xdd_tsc_decode_block(xdd_tsc_block_t *bp, size_t bytes, xdd_ts_tte_t *ttep) {
+	int64_t				values[XDD_TSC_BLOCK_ENTRIES];
+	const unsigned char	*p;
+	const unsigned char	*end;
+	uint64_t			run;
+	uint64_t			value;
+	uint64_t			prev;
+	int64_t				column_bytes;
+	int32_t				entries;
+	int32_t				i, j;
+	int					col;
+
+
+	if ((bytes < sizeof(*bp)) || (bp->tscb_magic != XDD_TSC_BLOCK_MAGIC) ||
+		(bp->tscb_bytes > bytes) || (bp->tscb_entries > XDD_TSC_BLOCK_ENTRIES))
+		return(-1);
+	column_bytes = sizeof(*bp);
+	for (col = 0; col < XDD_TSC_COLUMNS; col++)
+		column_bytes += bp->tscb_column_bytes[col];
+	if (XDD_TSC_ALIGN(column_bytes) != bp->tscb_bytes)
+		return(-1);
+
+	entries = bp->tscb_entries;
+	memset(ttep, 0, entries * sizeof(xdd_ts_tte_t));
+	p = (const unsigned char *)bp + sizeof(*bp);
+	for (col = 0; col < XDD_TSC_COLUMNS; col++) {
+		end = p + bp->tscb_column_bytes[col];
+		for (i = 0; i < entries; ) {
+			run = 1;
+			if ((bp->tscb_encodings & (1 << col)) && ((p = xdd_tsc_get_varint(p, end, &run)) == NULL))
+				return(-1);
+			if ((p == NULL) || ((p = xdd_tsc_get_varint(p, end, &value)) == NULL) || (run == 0) || (run > (uint64_t)(entries - i)))
+				return(-1);
+			for (j = 0; j < (int32_t)run; j++)
+				values[i++] = xdd_tsc_unzigzag(value);
+		}
+		if (p != end)
+			return(-1);
+
+		prev = 0;
+		for (i = 0; i < entries; i++) {
+			switch (xdd_tsc_columns[col].how) {
+				case XDD_TSC_DELTA:
+					prev += (uint64_t)values[i];
+					xdd_tsc_set_field(&ttep[i], col, (int64_t)prev);
+					break;
+				case XDD_TSC_DIFF:
+					xdd_tsc_set_field(&ttep[i], col, (int64_t)((uint64_t)xdd_tsc_get_field(&ttep[i], xdd_tsc_columns[col].ref) + (uint64_t)values[i]));
+					break;
+				default:
+					xdd_tsc_set_field(&ttep[i], col, values[i]);
+					break;
+			}
+		}
+	}
+	return(entries);
+} /* end of xdd_tsc_decode_block() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_pwrite() - write all "bytes" bytes at "offset"
+ * Returns 0 if all went well, -1 otherwise.
+ */
+static int
+xdd_tsc_pwrite(int fd, void *bufp, size_t bytes, off_t offset) {
+	ssize_t		status;
+
+
+	while (bytes > 0) {
+		status = pwrite(fd, bufp, bytes, offset);
+		if (status < 0) {
+			if (errno == EINTR)
+				continue;
+			return(-1);
+		}
+		bufp = (char *)bufp + status;
+		bytes -= status;
+		offset += status;
+	}
+	return(0);
+} /* end of xdd_tsc_pwrite() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_writer_open() - start a columnar time stamp file on "fd", which
+ * must be empty, for the target that "ts_hdrp" is the time stamp header of.
+ * Returns a pointer to the writer or NULL if there is no memory or the
+ * header could not be written.
+ */
+xint_tsc_writer_t *
+xdd_tsc_writer_open(int fd, xdd_ts_header_t *ts_hdrp) {
+	xint_tsc_writer_t	*tscwp;
+	xdd_tsc_header_t	*hp;
+	int32_t				id_bytes;
+	char				pad[8];
+
+
+	tscwp = (xint_tsc_writer_t *)calloc(1, sizeof(xint_tsc_writer_t));
+	if (tscwp == NULL)
+		return(NULL);
+	tscwp->tscw_ttep = (xdd_ts_tte_t *)malloc(XDD_TSC_BLOCK_ENTRIES * sizeof(xdd_ts_tte_t));
+	tscwp->tscw_bufp = (unsigned char *)malloc(XDD_TSC_MAX_BLOCK_BYTES);
+	if ((tscwp->tscw_ttep == NULL) || (tscwp->tscw_bufp == NULL)) {
+		xdd_tsc_writer_abort(tscwp);
+		return(NULL);
+	}
+	tscwp->tscw_fd = fd;
+
+	id_bytes = strnlen(ts_hdrp->tsh_id, MAX_IDLEN);
+	hp = &tscwp->tscw_header;
+	hp->tsc_magic = XDD_TSC_MAGIC;
+	hp->tsc_version = XDD_TSC_VERSION;
+	hp->tsc_header_bytes = XDD_TSC_ALIGN(sizeof(*hp) + id_bytes);
+	hp->tsc_block_entries = XDD_TSC_BLOCK_ENTRIES;
+	memcpy(hp->tsc_version_string, ts_hdrp->tsh_version, XDD_VERSION_BUFSZ);
+	hp->tsc_target_thread_id = ts_hdrp->tsh_target_thread_id;
+	hp->tsc_reqsize = ts_hdrp->tsh_reqsize;
+	hp->tsc_blocksize = ts_hdrp->tsh_blocksize;
+	hp->tsc_id_bytes = id_bytes;
+	hp->tsc_trigtime = ts_hdrp->tsh_trigtime;
+	hp->tsc_trigop = ts_hdrp->tsh_trigop;
+	hp->tsc_res = ts_hdrp->tsh_res;
+	hp->tsc_range = ts_hdrp->tsh_range;
+	hp->tsc_start_offset = ts_hdrp->tsh_start_offset;
+	hp->tsc_target_offset = ts_hdrp->tsh_target_offset;
+	hp->tsc_global_options = ts_hdrp->tsh_global_options;
+	hp->tsc_target_options = ts_hdrp->tsh_target_options;
+	memcpy(hp->tsc_td, ts_hdrp->tsh_td, CTIME_BUFSZ);
+	hp->tsc_timer_oh = ts_hdrp->tsh_timer_oh;
+	hp->tsc_delta = ts_hdrp->tsh_delta;
+	memset(pad, 0, sizeof(pad));
+	if (xdd_tsc_pwrite(fd, hp, sizeof(*hp), 0) ||
+		xdd_tsc_pwrite(fd, ts_hdrp->tsh_id, id_bytes, sizeof(*hp)) ||
+		xdd_tsc_pwrite(fd, pad, hp->tsc_header_bytes - (sizeof(*hp) + id_bytes), sizeof(*hp) + id_bytes)) {
+		xdd_tsc_writer_abort(tscwp);
+		return(NULL);
+	}
+	tscwp->tscw_offset = hp->tsc_header_bytes;
+	return(tscwp);
+} /* end of xdd_tsc_writer_open() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_writer_flush() - encode the waiting entries into a block and
+ * write it. Returns 0 if all went well, -1 otherwise.
+ */
+static int
+xdd_tsc_writer_flush(xint_tsc_writer_t *tscwp) {
+	xdd_tsc_header_t	*hp;
+	xdd_tsc_index_t		*ip;
+	xdd_tsc_block_t		*bp;
+	uint32_t			bytes;
+
+
+	if (tscwp->tscw_entries == 0)
+		return(0);
+	hp = &tscwp->tscw_header;
+	if (hp->tsc_numblocks == tscwp->tscw_index_size) {
+		ip = (xdd_tsc_index_t *)realloc(tscwp->tscw_indexp, (tscwp->tscw_index_size + 256) * sizeof(xdd_tsc_index_t));
+		if (ip == NULL)
+			return(-1);
+		tscwp->tscw_indexp = ip;
+		tscwp->tscw_index_size += 256;
+	}
+	bytes = xdd_tsc_encode_block(tscwp->tscw_ttep, tscwp->tscw_entries, hp->tsc_numents, tscwp->tscw_bufp);
+	if (xdd_tsc_pwrite(tscwp->tscw_fd, tscwp->tscw_bufp, bytes, tscwp->tscw_offset))
+		return(-1);
+
+	bp = (xdd_tsc_block_t *)tscwp->tscw_bufp;
+	ip = &tscwp->tscw_indexp[hp->tsc_numblocks];
+	ip->tsci_offset = tscwp->tscw_offset;
+	ip->tsci_first_entry = hp->tsc_numents;
+	ip->tsci_entries = bp->tscb_entries;
+	ip->tsci_bytes = bytes;
+	ip->tsci_min_time = bp->tscb_min_time;
+	ip->tsci_max_time = bp->tscb_max_time;
+	if ((bp->tscb_min_time != 0) && ((hp->tsc_min_time == 0) || (bp->tscb_min_time < hp->tsc_min_time)))
+		hp->tsc_min_time = bp->tscb_min_time;
+	if (bp->tscb_max_time > hp->tsc_max_time)
+		hp->tsc_max_time = bp->tscb_max_time;
+	hp->tsc_numblocks++;
+	hp->tsc_numents += tscwp->tscw_entries;
+	tscwp->tscw_offset += bytes;
+	tscwp->tscw_entries = 0;
+	return(0);
+} /* end of xdd_tsc_writer_flush() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_writer_append() - add a copy of a time stamp entry to the file.
+ * Entries go into the file a block at a time.
+ * Returns 0 if all went well, -1 if a block could not be written.
+ */
+int
+xdd_tsc_writer_append(xint_tsc_writer_t *tscwp, xdd_ts_tte_t *ttep) {
+
+	tscwp->tscw_ttep[tscwp->tscw_entries++] = *ttep;
+	if (tscwp->tscw_entries == XDD_TSC_BLOCK_ENTRIES)
+		return(xdd_tsc_writer_flush(tscwp));
+	return(0);
+} /* end of xdd_tsc_writer_append() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_writer_close() - write the last block, the block index and the
+ * final header, trim the file and free the writer. The file descriptor is
+ * left open. "numentsp" and "bytesp" are set to the number of entries and
+ * the size of the file.
+ * Returns 0 if all went well, -1 otherwise.
+ */
+int
+xdd_tsc_writer_close(xint_tsc_writer_t *tscwp, int64_t *numentsp, int64_t *bytesp) {
+	xdd_tsc_header_t	*hp;
+	int					status;
+
+
+	hp = &tscwp->tscw_header;
+	status = xdd_tsc_writer_flush(tscwp);
+	if ((status == 0) && (hp->tsc_numblocks > 0)) {
+		status = xdd_tsc_pwrite(tscwp->tscw_fd, tscwp->tscw_indexp, hp->tsc_numblocks * sizeof(xdd_tsc_index_t), tscwp->tscw_offset);
+		if (status == 0) {
+			hp->tsc_index_offset = tscwp->tscw_offset;
+			tscwp->tscw_offset += hp->tsc_numblocks * sizeof(xdd_tsc_index_t);
+		}
+	}
+	if (xdd_tsc_pwrite(tscwp->tscw_fd, hp, sizeof(*hp), 0))
+		status = -1;
+	if (ftruncate(tscwp->tscw_fd, tscwp->tscw_offset))
+		status = -1;
+	*numentsp = hp->tsc_numents;
+	*bytesp = tscwp->tscw_offset;
+	xdd_tsc_writer_abort(tscwp);
+	return(status);
+} /* end of xdd_tsc_writer_close() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_writer_abort() - free a writer without finishing its file
+ */
+void
+xdd_tsc_writer_abort(xint_tsc_writer_t *tscwp) {
+
+	free(tscwp->tscw_ttep);
+	free(tscwp->tscw_bufp);
+	free(tscwp->tscw_indexp);
+	free(tscwp);
+} /* end of xdd_tsc_writer_abort() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_check_header() - check that the "bytes" bytes at "basep" start
+ * with the header of a columnar time stamp file this code can read.
+ * Returns 0 if they do, -1 otherwise.
+ */
+int
+xdd_tsc_check_header(void *basep, size_t bytes) {
+	xdd_tsc_header_t	*hp;
+
+
+	hp = (xdd_tsc_header_t *)basep;
+	if ((bytes < sizeof(*hp)) || (hp->tsc_magic != XDD_TSC_MAGIC) || (hp->tsc_version != XDD_TSC_VERSION) ||
+		(hp->tsc_header_bytes > bytes) || (hp->tsc_header_bytes != XDD_TSC_ALIGN(sizeof(*hp) + hp->tsc_id_bytes)))
+		return(-1);
+	return(0);
+} /* end of xdd_tsc_check_header() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_get_ts_header() - fill in a time stamp header from the header of
+ * the columnar time stamp file at "basep". The entry counts are set to the
+ * number of entries in the file.
+ */
+void
+xdd_tsc_get_ts_header(void *basep, xdd_ts_header_t *ts_hdrp) {
+	xdd_tsc_header_t	*hp;
+	int32_t				id_bytes;
+
+
+	hp = (xdd_tsc_header_t *)basep;
+	memset(ts_hdrp, 0, offsetof(struct xdd_ts_header, tsh_tte));
+	ts_hdrp->tsh_magic = XDD_TS_MAGIC;
+	memcpy(ts_hdrp->tsh_version, hp->tsc_version_string, XDD_VERSION_BUFSZ);
+	ts_hdrp->tsh_target_thread_id = hp->tsc_target_thread_id;
+	ts_hdrp->tsh_reqsize = hp->tsc_reqsize;
+	ts_hdrp->tsh_blocksize = hp->tsc_blocksize;
+	ts_hdrp->tsh_numents = hp->tsc_numents;
+	ts_hdrp->tsh_trigtime = hp->tsc_trigtime;
+	ts_hdrp->tsh_trigop = hp->tsc_trigop;
+	ts_hdrp->tsh_res = hp->tsc_res;
+	ts_hdrp->tsh_range = hp->tsc_range;
+	ts_hdrp->tsh_start_offset = hp->tsc_start_offset;
+	ts_hdrp->tsh_target_offset = hp->tsc_target_offset;
+	ts_hdrp->tsh_global_options = hp->tsc_global_options;
+	ts_hdrp->tsh_target_options = hp->tsc_target_options;
+	id_bytes = (hp->tsc_id_bytes < MAX_IDLEN) ? hp->tsc_id_bytes : MAX_IDLEN - 1;
+	memcpy(ts_hdrp->tsh_id, (char *)basep + sizeof(*hp), id_bytes);
+	memcpy(ts_hdrp->tsh_td, hp->tsc_td, CTIME_BUFSZ);
+	ts_hdrp->tsh_timer_oh = hp->tsc_timer_oh;
+	ts_hdrp->tsh_delta = hp->tsc_delta;
+	ts_hdrp->tsh_tt_size = hp->tsc_numents;
+	ts_hdrp->tsh_tt_bytes = sizeof(xdd_ts_header_t) + (hp->tsc_numents * sizeof(xdd_ts_tte_t));
+} /* end of xdd_tsc_get_ts_header() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_tsc_read_index() - get the block index of the columnar time stamp
+ * file of "bytes" bytes at "basep". If the file has no index, because the
+ * run did not finish, the blocks are walked from the header instead and
+ * the header counts are not trusted. "*indexpp" is set to a copy of the
+ * index that the caller frees.
+ * Returns the number of blocks or -1 if there is no memory.
+ */
+int64_t
+xdd_tsc_read_index(void *basep, size_t bytes, xdd_tsc_index_t **indexpp) {
+	xdd_tsc_header_t	*hp;
+	xdd_tsc_block_t		*bp;
+	xdd_tsc_index_t		*ip;
+	xdd_tsc_index_t		*newp;
+	int64_t				numblocks;
+	int64_t				size;
+	int64_t				entries;
+	size_t				offset;
+
+
+	hp = (xdd_tsc_header_t *)basep;
+	*indexpp = NULL;
+	if ((hp->tsc_index_offset > 0) && (hp->tsc_numblocks > 0) && (hp->tsc_index_offset == XDD_TSC_ALIGN(hp->tsc_index_offset)) &&
+		((size_t)hp->tsc_index_offset + (hp->tsc_numblocks * sizeof(xdd_tsc_index_t)) <= bytes)) {
+		ip = (xdd_tsc_index_t *)malloc(hp->tsc_numblocks * sizeof(xdd_tsc_index_t));
+		if (ip == NULL)
+			return(-1);
+		memcpy(ip, (char *)basep + hp->tsc_index_offset, hp->tsc_numblocks * sizeof(xdd_tsc_index_t));
+		*indexpp = ip;
+		return(hp->tsc_numblocks);
+	}
+
+	// Walk the blocks up to the first one that is not all there
+	ip = NULL;
+	numblocks = 0;
+	size = 0;
+	entries = 0;
+	offset = hp->tsc_header_bytes;
+	while (offset + sizeof(xdd_tsc_block_t) <= bytes) {
+		bp = (xdd_tsc_block_t *)((char *)basep + offset);
+		if ((bp->tscb_magic != XDD_TSC_BLOCK_MAGIC) || (bp->tscb_bytes < sizeof(*bp)) ||
+			(bp->tscb_bytes != XDD_TSC_ALIGN(bp->tscb_bytes)) || (offset + bp->tscb_bytes > bytes))
+			break;
+		if (numblocks == size) {
+			newp = (xdd_tsc_index_t *)realloc(ip, (size + 256) * sizeof(xdd_tsc_index_t));
+			if (newp == NULL) {
+				free(ip);
+				return(-1);
+			}
+			ip = newp;
+			size += 256;
+		}
+		ip[numblocks].tsci_offset = offset;
+		ip[numblocks].tsci_first_entry = entries;
+		ip[numblocks].tsci_entries = bp->tscb_entries;
+		ip[numblocks].tsci_bytes = bp->tscb_bytes;
+		ip[numblocks].tsci_min_time = bp->tscb_min_time;
+		ip[numblocks].tsci_max_time = bp->tscb_max_time;
+		entries += bp->tscb_entries;
+		offset += bp->tscb_bytes;
+		numblocks++;
+	}
+	*indexpp = ip;
+	return(numblocks);
+} /* end of xdd_tsc_read_index() */
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -80,6 +80,7 @@
 #define DEFAULT_PORT 2000
 #define DEFAULT_E2E_PORT 40010
 #define DEFAULT_QUEUEDEPTH 1
+#define DEFAULT_TASK_RING_SPIN 0
 #define DEFAULT_BOUNCE 100
 #define DEFAULT_NUM_SEEK_HIST_BUCKETS 100
 #define DEFAULT_NUM_DIST_HIST_BUCKETS 100
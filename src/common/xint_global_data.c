@@ -57,7 +57,6 @@ xint_global_data_initialization(char* progname) {
 	xgp->run_complete = 0; 
 	xgp->abort = 0;       /* abort the run due to some catastrophic failure */
 	xgp->canceled = 0;       /* abort the run due to some catastrophic failure */
-	xgp->random_initialized = 0;     /* Random number generator has not been initialized  */
 	xgp->XDDMain_Thread = pthread_self();
 
 	return(xgp);
@@ -37,6 +37,7 @@
 #define GO_EXTENDED_STATS		0x0000000000010000ULL  /* Calculate Extended stats on each operation */
 #define GO_DRYRUN				0x0000000000020000ULL  /* Indicates a dry run - chicken! */
 #define GO_HEARTBEAT			0x0000000000040000ULL  /* Indicates that a heartbeat has been requested */
+#define GO_LATENCY_HISTOGRAM	0x0000000000080000ULL  /* Keep latency histograms for the latency percentiles */
 #define GO_INTERACTIVE			0x0000000400000000ULL  /* Enter Interactive Mode - oh what FUN! */
 #define GO_INTERACTIVE_EXIT		0x0000000800000000ULL  /* Exit Interactive Mode */
 #define GO_INTERACTIVE_STOP		0x0000001000000000ULL  /* Stop at various points in Interactive Mode */
@@ -82,9 +83,6 @@ struct xdd_global_data {
 	char			run_complete;   					/* Set to a 1 to indicate that all passes have completed */
 	char			abort;       						/* Abort the run due to some catastrophic failure */
 	char			canceled;       					/* Program canceled by user */
-	char                    random_initialized;                             /* Random number generator has been initialized */    
-	char                    random_init_state[256];                         /* Random number generator state initalizer array */
-	unsigned int            random_init_seed;                               /* Random number generator state seed value */
 	struct sigaction sa;								/* Used by the signal handlers to determine what to do */
     
 // PThread structures for the main threads
@@ -0,0 +1,61 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_IO_ENGINE_H
+#define XINT_IO_ENGINE_H
+
+// ------------------ Asynchronous I/O Engine stuff -----------------------------------
+// The default I/O engine for a target is one Worker Thread per outstanding I/O, each
+// doing a blocking pread()/pwrite(). The -ioengine option selects an asynchronous
+// engine instead. With an asynchronous engine the Target Thread itself issues and
+// reaps all -queuedepth operations through a single kernel submission interface and
+// the Worker Data structs are only used as per-operation "slots" (buffer, task, and
+// time stamp entry). No Worker Threads are created.
+//
+// Each engine provides the following operations:
+//   ioe_init    - set up the kernel interface for td_queue_depth operations
+//   ioe_prep    - queue the I/O task described by a Worker Data struct
+//   ioe_submit  - hand all queued operations to the kernel. If min_complete is
+//                 greater than 0 then the engine may also wait for that many
+//                 completions in the same system call. Operations that cannot be
+//                 submitted are completed with an error so nothing stays queued.
+//   ioe_reap    - wait for at least min_complete completions and call
+//                 xdd_io_engine_complete() for every completion found
+//   ioe_cleanup - release everything acquired by ioe_init
+//
+struct xint_io_engine {
+	const char			*ioe_name;				// Name of this I/O engine
+	int32_t				(*ioe_init)(target_data_t *tdp);
+	int32_t				(*ioe_prep)(worker_data_t *wdp);
+	int32_t				(*ioe_submit)(target_data_t *tdp, int32_t min_complete);
+	int32_t				(*ioe_reap)(target_data_t *tdp, int32_t min_complete);
+	void				(*ioe_cleanup)(target_data_t *tdp);
+	void				*ioe_private;			// Engine-specific state
+	int32_t				ioe_queue_depth;		// Maximum number of operations in flight
+	int32_t				ioe_queued;				// Operations prepared but not yet submitted
+	int32_t				ioe_inflight;			// Operations submitted but not yet reaped
+	int32_t				ioe_free_count;			// Number of entries on the free slot stack
+	worker_data_t		**ioe_free_slots;		// Stack of Worker Data structs that are not in use
+};
+typedef struct xint_io_engine xint_io_engine_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,91 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_LATENCY_HISTOGRAM_H
+#define XINT_LATENCY_HISTOGRAM_H
+
+// ------------------ Log-linear latency histograms ------------------------------------
+// Op times in nanoseconds are counted in buckets whose width doubles every
+// XDD_LATHIST_HALF buckets. Values below XDD_LATHIST_SUB_BUCKETS get a bucket each,
+// above that each bucket is at most 1/XDD_LATHIST_HALF of its value wide (~1.6%).
+// Values of XDD_LATHIST_MAX_VALUE nanoseconds (~18 minutes) or more go in the last bucket.
+//
+// Each Worker Thread has its own histogram that only it updates, so recording
+// an op needs no locks or atomics. The Target Thread merges the histograms of its
+// Worker Threads at the end of each pass while they are waiting at a barrier.
+//
+#define XDD_LATHIST_SUB_BUCKET_BITS		7
+#define XDD_LATHIST_SUB_BUCKETS			(1 << XDD_LATHIST_SUB_BUCKET_BITS)
+#define XDD_LATHIST_HALF				(XDD_LATHIST_SUB_BUCKETS / 2)
+#define XDD_LATHIST_MAX_BITS			40
+#define XDD_LATHIST_MAX_VALUE			(1ULL << XDD_LATHIST_MAX_BITS)
+#define XDD_LATHIST_BUCKETS				((XDD_LATHIST_MAX_BITS - XDD_LATHIST_SUB_BUCKET_BITS + 2) * XDD_LATHIST_HALF)
+
+// Op types that have a histogram of their own
+#define XDD_LATHIST_READ				0
+#define XDD_LATHIST_WRITE				1
+#define XDD_LATHIST_OTHER				2	// noop
+#define XDD_LATHIST_MD_CREATE			3	// Metadata ops - one for each XINT_MD_PHASE in the same order
+#define XDD_LATHIST_MD_STAT				4
+#define XDD_LATHIST_MD_OPEN				5
+#define XDD_LATHIST_MD_READDIR			6
+#define XDD_LATHIST_MD_RENAME			7
+#define XDD_LATHIST_MD_UNLINK			8
+#define XDD_LATHIST_OPTYPES				9
+#define XDD_LATHIST_ALL					-1	// All op types together - only for reading a histogram
+
+struct xint_latency_histogram {
+	int64_t		lh_total[XDD_LATHIST_OPTYPES];		// Number of ops counted for each op type
+	uint64_t	lh_counts[XDD_LATHIST_OPTYPES][XDD_LATHIST_BUCKETS];	// Number of ops in each bucket
+};
+typedef struct xint_latency_histogram xint_latency_histogram_t;
+
+// Return the bucket for an op time of "value" nanoseconds
+inline static int xdd_latency_histogram_index(nclk_t value)
+{
+	int		shift;
+
+	if (value < XDD_LATHIST_SUB_BUCKETS)
+		return ((int)value);
+	if (value >= XDD_LATHIST_MAX_VALUE)
+		value = XDD_LATHIST_MAX_VALUE - 1;
+	shift = (63 - __builtin_clzll(value)) - (XDD_LATHIST_SUB_BUCKET_BITS - 1);
+	return ((shift * XDD_LATHIST_HALF) + (int)(value >> shift));
+}
+
+// Count one op of the specified TASK_OP_TYPE that took "value" nanoseconds
+inline static void xdd_latency_histogram_record(xint_latency_histogram_t *lhp, int32_t op_type, nclk_t value)
+{
+	int		type;
+
+	if (op_type == TASK_OP_TYPE_READ)
+		type = XDD_LATHIST_READ;
+	else if (op_type == TASK_OP_TYPE_WRITE)
+		type = XDD_LATHIST_WRITE;
+	else if ((op_type >= TASK_OP_TYPE_MD_CREATE) && (op_type <= TASK_OP_TYPE_MD_UNLINK))
+		type = XDD_LATHIST_MD_CREATE + (op_type - TASK_OP_TYPE_MD_CREATE);
+	else type = XDD_LATHIST_OTHER;
+	lhp->lh_counts[type][xdd_latency_histogram_index(value)]++;
+	lhp->lh_total[type]++;
+}
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,58 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_METADATA_H
+#define XINT_METADATA_H
+
+// ------------------ Metadata workload stuff ------------------------------------------
+// The following structure is used by the -metadata option.
+// The target is a directory that holds md_dirs directories named d<#>.
+// File <#> lives in directory d<# modulo md_dirs> and is named f<#>, or r<#>
+// once the rename phase has run. Each phase is one op per file, except
+// readdir which is one op per directory. The phases run in the order given
+// and a phase only starts after all the ops of the previous phase are done.
+#define XINT_MD_PHASE_CREATE		0	// open(O_CREAT) and close a file
+#define XINT_MD_PHASE_STAT			1	// stat a file
+#define XINT_MD_PHASE_OPEN			2	// open and close a file
+#define XINT_MD_PHASE_READDIR		3	// read all the entries of a directory
+#define XINT_MD_PHASE_RENAME		4	// rename f<#> to r<#>
+#define XINT_MD_PHASE_UNLINK		5	// unlink a file
+#define XINT_MD_PHASES				6
+
+#define XINT_DEFAULT_MD_FILES		1000	// Default number of files per Worker Thread
+#define XINT_DEFAULT_MD_DIRS		1		// Default number of directories per Worker Thread
+
+struct xint_metadata {
+	int64_t		md_files_per_worker;			// Number of files for each Worker Thread - "-metadata files"
+	int64_t		md_dirs_per_worker;				// Number of directories for each Worker Thread - "-metadata dirs"
+	int32_t		md_phase_count;					// Number of phases in md_phases[]
+	int32_t		md_phases[XINT_MD_PHASES];		// The phases of a pass in the order they run - "-metadata phases"
+	int64_t		md_files;						// Number of files of the target
+	int64_t		md_dirs;						// Number of directories of the target
+	int64_t		md_first_op[XINT_MD_PHASES];	// Op number of the first op of each entry of md_phases[]
+	int32_t		md_renamed[XINT_MD_PHASES];		// Set if the rename phase comes before each entry of md_phases[]
+	int64_t		md_phase_ops[XINT_MD_PHASES];	// Ops issued by each phase in this run
+	nclk_t		md_phase_time[XINT_MD_PHASES];	// Elapsed time of each phase in this run
+};
+typedef struct xint_metadata xint_metadata_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -29,11 +29,17 @@
 #include "xint_throttle.h"
 #include "xint_common.h"
 #include "xint_nclk.h"
+#include "xint_prng.h"
 #include "xint_task.h"
 #include "xint_target_counters.h"
+#include "xint_latency_histogram.h"
+#include "xint_metadata.h"
+#include "xint_stripe.h"
 #include "xint_timestamp.h"
+#include "xint_ts_columnar.h"
 #include "xint_td.h"
 #include "xint_wd.h"
+#include "xint_io_engine.h"
 #include "xint_read_after_write.h"
 // REMOVE LATER struct ptds;
 
@@ -74,6 +80,8 @@ struct xint_plan {
 	nclk_t			pass_delay_accumulated_time;		/* number of high-res clock ticks of accumulated time during all pass delays */
 	char			*ts_binary_filename_prefix; 			/* timestamp filename prefix */
 	char			*ts_output_filename_prefix; 			/* timestamp report output filename prefix */
+	char			*latency_histogram_filename;			/* latency histogram CSV output file name */
+	FILE			*latency_histogram_fp;				/* latency histogram CSV output file */
 	uint32_t		restart_frequency;      			/* seconds between restart monitor checks */
 	int32_t			syncio;                 			/* the number of I/Os to perform btw syncs */
 	uint64_t		target_offset;          			/* offset value */
@@ -146,6 +154,7 @@ struct xint_plan {
 #define HEARTBEAT_HOLDOFF	0x00000002					// The results_manager will set HEARTBEAT_HOLDOFF bit when it wants to display pass results, 
 											 			// and unset HEARTBEAT_HOLDOFF after everything is displayed
 #define HEARTBEAT_EXIT		0x00000004		 			// The results_manager will set HEARTBEAT_EXIT to tell heartbeat to exit 
+#define HEARTBEAT_MAX_NAP	(100ULL * MILLION)			// Nanoseconds that heartbeat sleeps before checking for HEARTBEAT_EXIT
 														//
 #ifdef WIN32
 	HANDLE			ts_serializer_mutex;        		/* needed to circumvent a Windows bug */
@@ -0,0 +1,66 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_PRNG_H
+#define XINT_PRNG_H
+
+#include <stdint.h>
+
+// ------------------ Counter-based pseudo random numbers ------------------------------
+// The N'th random number of a stream is computed directly from a 64-bit key and N,
+// so there is no generator state to share between threads and any element of the
+// stream can be produced in any order. A key is made from a seed and a stream
+// number so that different uses of the same seed do not see the same numbers.
+// The mixing function is the SplitMix64 finalizer.
+//
+#define XINT_PRNG_GOLDEN_GAMMA				0x9E3779B97F4A7C15ULL
+#define XINT_PRNG_STREAM_SEEK_LOCATION		1	// Random seek locations
+#define XINT_PRNG_STREAM_SEEK_TIME			2	// Throttle variance of the seek issue times
+#define XINT_PRNG_STREAM_DATA_PATTERN		3	// Random data patterns
+#define XINT_PRNG_SEED_DATA_PATTERN			72058	// Seed of -datapattern random
+
+inline static uint64_t xint_prng_mix(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return (z ^ (z >> 31));
+}
+
+// Return the key for the specified stream of the specified seed
+inline static uint64_t xint_prng_key(uint64_t seed, uint32_t stream)
+{
+	return (xint_prng_mix(seed ^ ((uint64_t)stream << 48)));
+}
+
+// Return the 64-bit random number at position "counter" of the stream for "key"
+inline static uint64_t xint_prng_u64(uint64_t key, uint64_t counter)
+{
+	return (xint_prng_mix(key + ((counter + 1) * XINT_PRNG_GOLDEN_GAMMA)));
+}
+
+// Return the random number at position "counter" as a double in [0,1)
+inline static double xint_prng_double(uint64_t key, uint64_t counter)
+{
+	return ((double)(xint_prng_u64(key, counter) >> 11) * (1.0 / 9007199254740992.0));
+}
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
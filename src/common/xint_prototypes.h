@@ -19,6 +19,9 @@
 
 /* XDD function prototypes */
 // access_pattern.c
+void	xdd_seek_generator_init(target_data_t *tdp);
+void	xdd_seek_generate(target_data_t *tdp, int64_t op, seek_t *seekp);
+seek_t	*xdd_seek_entry(target_data_t *tdp, int64_t op, seek_t *seekp);
 void	xdd_init_seek_list(target_data_t *p);
 void	xdd_save_seek_list(target_data_t *p);
 int32_t	xdd_load_seek_list(target_data_t *p);
@@ -32,6 +35,8 @@ void	xdd_destroy_barrier(xdd_plan_t* planp, struct xdd_barrier *bp);
 int32_t	xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner);
 
 // datapatterns.c
+void	xdd_prng_fill(uint64_t key, uint64_t counter, uint64_t *bufp, size_t words);
+void	xdd_datapattern_replicate(unsigned char *bufp, size_t length, unsigned char *patternp, size_t pattern_length);
 void	xdd_datapattern_buffer_init(worker_data_t *wdp);
 void	xdd_datapattern_fill(worker_data_t *wdp);
 
@@ -53,6 +58,8 @@ void    xdd_show_results_data(results_t *rp, char *dumptype, xdd_plan_t *planp);
 
 // end_to_end.c
 int32_t	xdd_e2e_src_send(worker_data_t *wdp);
+ssize_t	xdd_e2e_src_zerocopy_read(worker_data_t *wdp);
+ssize_t	xdd_e2e_dest_zerocopy_write(worker_data_t *wdp);
 int32_t	xdd_e2e_dest_receive(worker_data_t *wdp);
 int32_t	xdd_e2e_dest_connection(worker_data_t *wdp);
 int32_t	xdd_e2e_dest_receive_header(worker_data_t *wdp);
@@ -61,11 +68,18 @@ int32_t	xdd_e2e_dest_receive_error(worker_data_t *wdp);
 int32_t xdd_e2e_eof_source_side(worker_data_t *wdp);
 int32_t xdd_e2e_eof_destination_side(worker_data_t *wdp);
 
+// end_to_end_files.c
+int32_t	xdd_e2e_files_open(target_data_t *tdp);
+ssize_t	xdd_e2e_files_read(worker_data_t *wdp);
+ssize_t	xdd_e2e_files_write(worker_data_t *wdp);
+int32_t	xdd_e2e_files_restore_modes(target_data_t *tdp);
+
 // end_to_end_init.c
 int32_t	xdd_e2e_target_init(target_data_t *tdp);
 int32_t	xdd_e2e_worker_init(worker_data_t *wdp);
 int32_t	xdd_e2e_src_init(worker_data_t *wdp);
 int32_t	xdd_e2e_setup_src_socket(worker_data_t *wdp);
+void	xdd_e2e_zerocopy_init(worker_data_t *wdp);
 int32_t	xdd_e2e_dest_init(worker_data_t *wdp);
 int32_t	xdd_e2e_setup_dest_socket(worker_data_t *wdp);
 void	xdd_e2e_set_socket_opts(worker_data_t *wdp, int skt);
@@ -89,6 +103,7 @@ void	clk_delta(in_addr_t addr, in_port_t port, int32_t bounce, nclk_t *nclkp);
 void *xdd_heartbeat(void *data);
 void	xdd_heartbeat_legend(xdd_plan_t* planp, target_data_t *p);
 void	xdd_heartbeat_values(target_data_t *p, int64_t bytes, int64_t ops, double elapsed);
+void	xdd_heartbeat_timeseries_pass_end(target_data_t *tdp);
 
 // info_display.c
 void	xdd_display_kmgt(FILE *out, long long int n, int block_size);
@@ -101,6 +116,18 @@ void	xdd_config_info(xdd_plan_t* planp);
 // initialization.c
 int32_t	xdd_initialization(int32_t argc,char *argv[], xdd_plan_t* planp);
 
+// latency_histogram.c
+xint_latency_histogram_t	*xdd_latency_histogram_alloc(int32_t target_number, char *what);
+void	xdd_latency_histogram_reset(xint_latency_histogram_t *lhp);
+void	xdd_latency_histogram_merge(xint_latency_histogram_t *to, xint_latency_histogram_t *from);
+void	xdd_latency_histogram_delta(xint_latency_histogram_t *to, xint_latency_histogram_t *now, xint_latency_histogram_t *prev);
+nclk_t	xdd_latency_histogram_bucket_low(int index);
+nclk_t	xdd_latency_histogram_bucket_high(int index);
+int64_t	xdd_latency_histogram_value_at(xint_latency_histogram_t *lhp, int type, double percentile);
+void	xdd_latency_histogram_percentiles(results_t *rp, xint_latency_histogram_t *lhp);
+void	xdd_latency_histogram_dump_header(FILE *fp);
+void	xdd_latency_histogram_dump(FILE *fp, xint_latency_histogram_t *lhp, char *pass, int32_t target_number, char *worker);
+
 // interactive.c
 void 	*xdd_interactive(void *debugger);
 int 	xdd_interactive_parse_command(int tokens, char *cmd, xdd_plan_t *planp);
@@ -129,6 +156,19 @@ void	xdd_interactive_show_tot_display_fields(target_data_t *tdp, FILE *fp);
 void	xdd_interactive_show_trace(int32_t tokens, char *cmdline, uint32_t flags, xdd_plan_t *planp);
 void	xdd_interactive_show_barrier(int32_t tokens, char *cmdline, uint32_t flags, xdd_plan_t *planp);
 
+// io_engine.c
+int32_t	xdd_io_engine_init(target_data_t *tdp);
+void	xdd_io_engine_cleanup(target_data_t *tdp);
+int32_t	xdd_io_engine_start_op(worker_data_t *wdp);
+void	xdd_io_engine_complete(worker_data_t *wdp, int64_t result);
+void	xdd_target_pass_async_loop(xdd_plan_t* planp, target_data_t *tdp);
+
+// io_engine_io_uring.c
+int32_t	xdd_io_uring_engine_setup(xint_io_engine_t *ioep);
+
+// io_engine_libaio.c
+int32_t	xdd_libaio_engine_setup(xint_io_engine_t *ioep);
+
 // io_buffers.c
 unsigned char *xdd_init_io_buffers(worker_data_t *wdp);
 
@@ -139,6 +179,14 @@ void	xdd_lockstep_before_pass(target_data_t *p);
 int32_t	xdd_lockstep_after_pass(target_data_t *p);
 int32_t xdd_lockstep_check_triggers(worker_data_t *wdp, lockstep_t *lsp);
 
+// metadata.c
+int32_t	xdd_metadata_parse_phases(xint_metadata_t *mdp, char *list);
+int64_t	xdd_metadata_ops_per_pass(target_data_t *tdp);
+int32_t	xdd_metadata_open(target_data_t *tdp);
+void	xdd_metadata_pass_loop(xdd_plan_t *planp, target_data_t *tdp);
+ssize_t	xdd_metadata_io(worker_data_t *wdp);
+void	xdd_metadata_display(target_data_t *tdp, FILE *fp);
+
 // memory.c
 void	xdd_lock_memory(unsigned char *bp, uint32_t bsize, char *sp);
 void	xdd_unlock_memory(unsigned char *bp, uint32_t bsize, char *sp);
@@ -158,6 +206,8 @@ xint_restart_t 			*xdd_get_restartp(target_data_t *tdp);
 xint_raw_t				*xdd_get_rawp(target_data_t *tdp);
 xint_e2e_t 				*xdd_get_e2ep(void);
 xint_throttle_t 		*xdd_get_throtp(target_data_t *tdp);
+xint_metadata_t 		*xdd_get_metadatap(target_data_t *tdp);
+xint_stripe_t 			*xdd_get_stripep(target_data_t *tdp);
 xint_triggers_t 		*xdd_get_trigp(target_data_t *tdp);
 xint_extended_stats_t 	*xdd_get_esp(target_data_t *tdp);
 int32_t					xdd_linux_cpu_count(void);
@@ -179,6 +229,9 @@ int32_t	xint_target_preallocate_for_os(target_data_t *p);
 int32_t	xint_target_preallocate_for_os(target_data_t *p);
 int32_t	xint_target_preallocate(target_data_t *p);
 
+// xint_physical_order.c
+int32_t	xint_target_physical_order(target_data_t *tdp);
+
 // xint_pretruncate.c
 int32_t	xint_target_pretruncate(target_data_t *p);
 
@@ -207,7 +260,8 @@ void	xdd_worker_thread_io(worker_data_t *wdp);
 int32_t	xdd_worker_thread_wait_for_previous_io(worker_data_t *wdp);
 int32_t	xdd_worker_thread_release_next_io(worker_data_t *wdp);
 void	xdd_worker_thread_update_local_counters(worker_data_t *wdp);
-void	xdd_worker_thread_update_target_counters(worker_data_t *wdp);
+void	xdd_target_counters_sum(target_data_t *tdp, xint_target_counters_t *tcp);
+void	xdd_worker_counters_reset(worker_data_t *wdp);
 void	xdd_worker_thread_check_io_status(worker_data_t *wdp);
 
 // worker_thread_io_for_os.c
@@ -220,6 +274,8 @@ void	xdd_dio_after_io_op(worker_data_t *wdp);
 void	xdd_raw_after_io_op(worker_data_t *wdp);
 void	xdd_e2e_after_io_op(worker_data_t *wdp);
 void	xdd_extended_stats(worker_data_t *wdp);
+void	xdd_extended_stats_reset(xint_extended_stats_t *esp);
+void	xdd_extended_stats_merge(xint_extended_stats_t *to, xint_extended_stats_t *from);
 void	xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp);
 
 // worker_thread_ttd_before_io_op.c
@@ -244,6 +300,12 @@ int	xdd_restart_create_restart_file(xint_restart_t *rp);
 int	xdd_restart_write_restart_file(xint_restart_t *rp);
 void 	*xdd_restart_monitor(void *junk);
 
+// restart_journal.c
+int	xdd_restart_journal_open(target_data_t *tdp);
+void	xdd_restart_journal_record(xint_restart_t *rp, int64_t offset, int64_t length);
+int	xdd_restart_journal_checkpoint(target_data_t *tdp);
+void	xdd_restart_journal_close(target_data_t *tdp);
+
 // results_display.c
 void	xdd_results_fmt_what(results_t *rp);
 void	xdd_results_fmt_pass_number(results_t *rp);
@@ -287,7 +349,8 @@ void	xdd_results_fmt_e2e_first_read_time(results_t *rp);
 void	xdd_results_fmt_e2e_last_write_time(results_t *rp);
 void	xdd_results_fmt_delimiter(results_t *rp);
 void 	*xdd_results_display(results_t *rp);
-void	xdd_results_format_id_add( char *sp, char *format_stringp  );
+char	*xdd_results_format_id_add( char *sp, char *format_stringp  );
+int	xdd_results_format_uses_latency_histogram(char *format_stringp);
 
 // results_manager.c
 void    *xdd_results_manager(void *data);
@@ -313,6 +376,13 @@ void	xdd_signal_handler(int signum, siginfo_t *sip, void *ucp);
 int32_t	xdd_signal_init(xdd_plan_t *planp);
 void	xdd_signal_start_debugger();
 
+// stripe.c
+int32_t	xdd_stripe_open(target_data_t *tdp);
+int32_t	xdd_stripe_close(target_data_t *tdp);
+void	xdd_stripe_unlink(target_data_t *tdp);
+int32_t	xdd_stripe_sync(target_data_t *tdp);
+ssize_t	xdd_stripe_io(worker_data_t *wdp);
+
 // target_cleanup.c
 void	xdd_target_thread_cleanup(target_data_t *p);
 
@@ -345,8 +415,11 @@ void	xdd_targetpass_e2e_eof_src(target_data_t *tdp);
 void	xdd_targetpass_e2e_monitor(target_data_t *tdp);
 
 // target_pass_qt_locator.c
+int32_t	xdd_idle_worker_map_init(target_data_t *tdp);
+void	xdd_worker_thread_make_available(worker_data_t *wdp);
 worker_data_t	*xdd_get_specific_worker_thread(target_data_t *tdp, int32_t q);
 worker_data_t	*xdd_get_any_available_worker_thread(target_data_t *tdp);
+worker_data_t	*xdd_get_any_available_worker_thread_before_eof(target_data_t *tdp);
 
 // target_thread.c
 void 	*xdd_target_thread(void *pin);
@@ -371,18 +444,34 @@ void	xdd_init_target_data_before_pass(target_data_t *tdp);
 void	xdd_init_worker_data_before_pass(worker_data_t *wdp);
 int32_t	xdd_target_ttd_before_pass(target_data_t *tdp);
 
+// task_ring.c
+int32_t	xdd_task_ring_init(worker_data_t *wdp);
+void	xdd_task_ring_post(worker_data_t *wdp, xint_task_t *taskp);
+void	xdd_task_ring_get(worker_data_t *wdp);
+
 // timestamp.c
 void	xdd_ts_overhead(struct xdd_ts_header *ts_hdrp); 
 void	xdd_ts_setup(target_data_t *p);
+xdd_ts_tte_t *xdd_ts_assign_entry(target_data_t *tdp, worker_data_t *wdp);
+void	xdd_ts_entry_done(worker_data_t *wdp);
 void	xdd_ts_write(target_data_t *p);
 void	xdd_ts_cleanup(struct xdd_ts_header *ts_hdrp);
 void	xdd_ts_reports(target_data_t *p);
 
+// ts_columnar.c
+uint32_t	xdd_tsc_encode_block(xdd_ts_tte_t *ttep, int32_t entries, int64_t first_entry, unsigned char *bufp);
+int32_t	xdd_tsc_decode_block(xdd_tsc_block_t *bp, size_t bytes, xdd_ts_tte_t *ttep);
+xint_tsc_writer_t	*xdd_tsc_writer_open(int fd, xdd_ts_header_t *ts_hdrp);
+int		xdd_tsc_writer_append(xint_tsc_writer_t *tscwp, xdd_ts_tte_t *ttep);
+int		xdd_tsc_writer_close(xint_tsc_writer_t *tscwp, int64_t *numentsp, int64_t *bytesp);
+void	xdd_tsc_writer_abort(xint_tsc_writer_t *tscwp);
+int		xdd_tsc_check_header(void *basep, size_t bytes);
+void	xdd_tsc_get_ts_header(void *basep, xdd_ts_header_t *ts_hdrp);
+int64_t	xdd_tsc_read_index(void *basep, size_t bytes, xdd_tsc_index_t **indexpp);
+
 // utils.c
 char 	*xdd_getnexttoken(char *tp);
 int 	xdd_tokenize(char *cp);
-int	xdd_random_int(void);
-double 	xdd_random_float(void);
 
 // verify.c
 int32_t	xdd_verify_checksum(worker_data_t *wdp, int64_t current_op);
@@ -392,6 +481,7 @@ int32_t	xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_contents(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_location(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify(worker_data_t *wdp, int64_t current_op);
+void	xdd_verify_after_io_op(worker_data_t *wdp);
 
 // xdd.c
 int32_t	xdd_start_targets(xdd_plan_t *planp);
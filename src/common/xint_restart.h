@@ -13,6 +13,20 @@
 #ifndef RESTART_H
 #define RESTART_H
 
+// A range of bytes that is on stable storage at the destination side of a copy
+struct xint_restart_extent {
+	int64_t			offset;					// Offset into the file of the first byte of the range
+	int64_t			length;					// Number of bytes in the range
+};
+typedef struct xint_restart_extent xint_restart_extent_t;
+
+// The restart journal file is RESTART_JOURNAL_MAGIC followed by xint_restart_extent_t records.
+// Records are appended as data is committed and may overlap; the journal is rewritten with
+// the merged extents once it holds RESTART_JOURNAL_COMPACT_RECORDS more records than that.
+#define RESTART_JOURNAL_MAGIC				"XDDRJNL1"
+#define RESTART_JOURNAL_MAGIC_LENGTH		8
+#define RESTART_JOURNAL_COMPACT_RECORDS		1024
+
 struct xint_restart {
     char			*restart_filename;		// Name of the restart file
     off_t                       initial_restart_offset;
@@ -30,6 +44,17 @@ struct xint_restart {
 	struct tm		tm;						// The time structure contains the time the restart files were created
 	uint64_t		flags;					// Flags with various information as defined below
 	pthread_mutex_t	restart_lock;			// Lock on this structure to serialize updates 
+	char			*journal_filename;		// Name of the completed extent journal
+	int				journal_fd;				// Destination side journal file descriptor opened for append
+	int64_t			journal_records;		// Number of extent records in the journal file
+	xint_restart_extent_t	*journal_extents;	// Sorted, merged extents that are known to be complete
+	int64_t			journal_extent_count;	// Number of entries in journal_extents
+	xint_restart_extent_t	*journal_pending;	// Extents written since the last checkpoint
+	int64_t			journal_pending_count;	// Number of entries in journal_pending
+	int64_t			journal_pending_size;	// Number of entries allocated for journal_pending
+	xint_restart_extent_t	*journal_spare;		// Pending array that is swapped in at each checkpoint
+	int64_t			journal_spare_size;		// Number of entries allocated for journal_spare
+	pthread_mutex_t	journal_lock;			// Serializes Worker Thread updates to journal_pending
 };
 typedef struct xint_restart xint_restart_t;
 // Restart.h flag bit definitions
@@ -37,6 +62,7 @@ typedef struct xint_restart xint_restart_t;
 #define	RESTART_FLAG_RESUME_COPY				0x0000000000000002		// Indicates that this is a resumption of a previous copy
 #define	RESTART_FLAG_SUCCESSFUL_COMPLETION		0x0000000000000004		// Indicates that the e2e (aka copy) operation completed successfully
 #define	RESTART_FLAG_RESTART_FILE_NOW_CLOSED	0x0000000000000008		// Indicates that the restart file has been closed
+#define	RESTART_FLAG_JOURNAL					0x0000000000000010		// Indicates that completed extents are recorded in the restart journal
 
 #endif
 /*
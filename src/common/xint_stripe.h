@@ -0,0 +1,45 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_STRIPE_H
+#define XINT_STRIPE_H
+
+// ------------------ Striped target stuff ------------------------------------------
+// The following structure is used by the -stripe option.
+// The offsets of the target are striped round-robin across stripe_count
+// files in units of stripe_unit bytes: logical stripe unit <#> lives in file
+// <# modulo stripe_count> at stripe unit <# / stripe_count> of that file.
+// The files are either named on the command line or are the target name
+// with a ".<file#>" extension.
+#define XINT_DEFAULT_STRIPE_COUNT	1			// Default number of files of a striped target
+#define XINT_DEFAULT_STRIPE_UNIT	1048576		// Default stripe unit in bytes
+
+struct xint_stripe {
+	int32_t		stripe_count;			// Number of files the target is striped across - "-stripe count"
+	int64_t		stripe_unit;			// Number of bytes of one file before moving on to the next - "-stripe unit"
+	char		*stripe_file_list;		// Comma separated names of the files - "-stripe files"
+	char		**stripe_names;			// Name of each file
+	int			*stripe_fds;			// File descriptor of each file
+};
+typedef struct xint_stripe xint_stripe_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
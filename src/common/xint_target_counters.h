@@ -12,6 +12,9 @@
  */
 #include "xint_nclk.h"
 #include "xint_plan.h"
+
+#define XINT_COUNTERS_CACHE_LINE_SIZE	64	// Alignment of the Worker Thread counters
+
 struct xint_target_counters {
 	// Time stamps and timing information - RESET AT THE START OF EACH PASS (or Operation on some)
 	int32_t		tc_pass_number; 				// Current pass number 
@@ -37,9 +40,12 @@ struct xint_target_counters {
 	nclk_t		tc_current_net_start_time; 		// Start time of the current network op (e2e only)
 	nclk_t		tc_current_net_end_time; 		// End time of the current network op (e2e only)
 	nclk_t		tc_current_net_elapsed_time;	// Elapsed time of the current network op (e2e only)
+	nclk_t		tc_current_pattern_fill_time;	// Time spent filling the data pattern for the current op
 
 	// Accumulated Counters 
-	// Updated in the Target Data structure by each Worker Thread at the completion of an I/O operation
+	// Each Worker Thread only updates the accumulated counters in its own Worker Data at the
+	// completion of an I/O operation. The counters of a Target are the sum of the counters
+	// of its Worker Threads and are filled in by xdd_target_counters_sum() when needed.
 	uint64_t		tc_accumulated_op_count; 		// The number of read+write operations that have completed so far
 	uint64_t		tc_accumulated_read_op_count;	// The number of read operations that have completed so far 
 	uint64_t		tc_accumulated_write_op_count;	// The number of write operations that have completed so far 
@@ -54,6 +60,8 @@ struct xint_target_counters {
 	nclk_t		tc_accumulated_noop_op_time;	// Accumulated time spent in noops 
 	nclk_t		tc_accumulated_pattern_fill_time; // Accumulated time spent in data pattern fill before all I/O operations 
 	nclk_t		tc_accumulated_flush_time; 		// Accumulated time spent doing flush (fsync) operations
+	nclk_t		tc_accumulated_sr_time; 		// Accumulated time spent sending or receiving data (e2e only)
+	uint64_t		tc_accumulated_error_count;		// The number of operations that failed or did not verify so far
 };
 typedef struct xint_target_counters xint_target_counters_t;
 
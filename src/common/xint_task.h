@@ -22,6 +22,12 @@
 #define TASK_OP_TYPE_WRITE		2	// Perform a WRITE operation
 #define TASK_OP_TYPE_NOOP		3	// Perform a NOOP operation
 #define TASK_OP_TYPE_EOF		4	// End-of-File processing when present in the Time Stamp Table
+#define TASK_OP_TYPE_MD_CREATE	5	// Metadata operations - one for each XINT_MD_PHASE in the same order
+#define TASK_OP_TYPE_MD_STAT	6
+#define TASK_OP_TYPE_MD_OPEN	7
+#define TASK_OP_TYPE_MD_READDIR	8
+#define TASK_OP_TYPE_MD_RENAME	9
+#define TASK_OP_TYPE_MD_UNLINK	10
 struct xint_task {
 	char				task_request;				// Type of Task to perform
 	int					task_file_desc;				// File Descriptor
@@ -38,6 +44,29 @@ struct xint_task {
 };
 typedef struct xint_task xint_task_t;
 
+// The xint_task_ring is a single-producer/single-consumer queue of tasks from
+// a Target Thread to one of its Worker Threads. The Target Thread is the only
+// thread that advances tr_tail and the Worker Thread is the only thread that
+// advances tr_head so no lock is needed to pass a task. A Worker Thread that
+// finds the ring empty polls it tr_spin times and then sleeps on tr_tail
+// (a futex on Linux, a condition variable elsewhere) until a task is posted.
+#define XINT_TASK_RING_ENTRIES	4	// Number of tasks that can be posted ahead - must be a power of 2
+#define XINT_TASK_RING_MASK		(XINT_TASK_RING_ENTRIES - 1)
+struct xint_task_ring {
+	uint32_t			tr_tail;					// Number of tasks posted by the Target Thread (also the futex word)
+	int32_t				tr_sleeping;				// Set by the Worker Thread while it is asleep waiting for a task
+	char				tr_pad1[56];				// Keep the producer and consumer indices in separate cache lines
+	uint32_t			tr_head;					// Number of tasks taken by the Worker Thread
+	int32_t				tr_spin;					// Number of times to poll an empty ring before going to sleep
+	char				tr_pad2[56];
+#if !defined(LINUX)
+	pthread_mutex_t		tr_mutex;					// Protects tr_sleeping when futexes are not available
+	pthread_cond_t		tr_cond;					// Where the Worker Thread sleeps when futexes are not available
+#endif
+	xint_task_t			tr_task[XINT_TASK_RING_ENTRIES];	// The tasks themselves
+};
+typedef struct xint_task_ring xint_task_ring_t;
+
 /*
  * Local variables:
  *  indent-tabs-mode: t
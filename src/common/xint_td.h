@@ -44,6 +44,13 @@
 #define TO_ORDERING_NETWORK_SERIAL     0x0000100000000000ULL  // Serial Odering method applied to network
 #define TO_ORDERING_STORAGE_LOOSE      0x0000200000000000ULL  // Loose Odering method applied to storage
 #define TO_ORDERING_NETWORK_LOOSE      0x0000400000000000ULL  // Loose Odering method applied to network
+#define TO_IO_URING                    0x0000800000000000ULL  // Use the io_uring asynchronous I/O engine
+#define TO_LIBAIO                      0x0001000000000000ULL  // Use the Linux native AIO asynchronous I/O engine
+#define TO_ASYNC_IO_ENGINE             (TO_IO_URING | TO_LIBAIO) // Any of the asynchronous I/O engines
+#define TO_E2E_ZEROCOPY                0x0002000000000000ULL  // End to End - splice the data between the target file and the socket
+#define TO_E2E_FILES                   0x0004000000000000ULL  // End to End - the target is a directory of files sent as file records
+#define TO_METADATA                    0x0008000000000000ULL  // Metadata workload - the target is a directory of files to create, stat, ...
+#define TO_STRIPE                      0x0010000000000000ULL  // Striped target - the offsets are striped across several files
 
 // Per Thread Data Structure - one for each thread 
 struct xint_target_data {
@@ -79,7 +86,7 @@ struct xint_target_data {
 
 
 	uint64_t			td_current_bytes_issued;	// The amount of data for all transfer requests that has been issued so far 
-	uint64_t			td_current_bytes_completed;	// The amount of data for all transfer requests that has been completed so far
+	uint64_t			td_current_bytes_completed;	// The amount of data for all transfer requests completed in the last pass
 	uint64_t			td_current_bytes_remaining;	// Bytes remaining to be transferred 
 
 	char				td_abort;					// Abort this operation (either a Worker Thread or a Target Thread)
@@ -98,7 +105,12 @@ struct xint_target_data {
     tot_t				*td_totp;								// Pointer to the target_offset_table for this target
     pthread_cond_t 		td_any_worker_thread_available_condition;
     pthread_mutex_t 	td_any_worker_thread_available_mutex;
-    int 				td_any_worker_thread_available;
+    int 				td_any_worker_thread_waiting;			// Set while the Target Thread waits for any Worker Thread to become available
+    uint64_t			*td_idle_worker_map;					// One bit per Worker Thread, set while that Worker Thread is available for a task
+    struct xint_worker_data	**td_idle_worker_table;				// Worker Data struct for each bit in td_idle_worker_map
+    int32_t				td_idle_worker_words;					// Number of 64-bit words in td_idle_worker_map
+    int32_t				td_idle_worker_hint;					// Word of td_idle_worker_map where the last available Worker Thread was found
+    int32_t				td_idle_worker_eof_count;				// E2E Destination Side: available Worker Threads set aside because they received an EOF
     pthread_cond_t 		td_this_wthread_is_available_condition;
 	
 	// command line option values 
@@ -121,9 +133,9 @@ struct xint_target_data {
 	int32_t				td_processor;  				// Processor/target assignments 
 	double				td_start_delay; 			// number of seconds to delay the start  of this operation 
 	nclk_t				td_start_delay_psec;		// number of nanoseconds to delay the start  of this operation 
-	char				td_random_init_state[256]; 	// Random number generator state initalizer array 
 	int32_t				td_block_size;  			// Size of a block in bytes for this target 
 	int32_t				td_queue_depth; 			// Command queue depth for each target 
+	int32_t				td_task_ring_spin;			// Number of times a Worker Thread polls its task ring before sleeping
 	int64_t				td_preallocate; 			// File preallocation value 
 	int64_t				td_pretruncate; 			// File pretruncation value 
 	int32_t				td_mem_align;   			// Memory read/write buffer alignment value in bytes 
@@ -149,16 +161,20 @@ struct xint_target_data {
 	// The following variables are used by the "-reopen" option
 	nclk_t        		td_open_start_time; 		// Time just before the open is issued for this target 
 	nclk_t        		td_open_end_time; 			// Time just after the open completes for this target 
-	pthread_mutex_t 	td_counters_mutex; 			// Mutex for locking when updating td_counters
 	struct xint_target_counters	td_counters;		// Pointer to the target counters
 	struct xint_throttle		*td_throtp;			// Pointer to the throttle sturcture
+	struct xint_metadata		*td_mdp;			// Pointer to the metadata workload structure used by the -metadata option
+	struct xint_stripe			*td_stripep;		// Pointer to the striped target structure used by the -stripe option
 	struct xint_e2e				*td_e2ep;			// Pointer to the e2e struct when needed
 	struct xint_extended_stats	*td_esp;			// Extended Stats Structure Pointer
+	struct xint_latency_histogram	*td_lathistp;		// Latency histogram of all Worker Threads for this pass
+	struct xint_latency_histogram	*td_lathist_runp;	// Latency histogram of all Worker Threads for this run
 	struct xint_triggers		*td_trigp;			// Triggers Structure Pointer
 	struct xint_data_pattern	*td_dpp;			// Data Pattern Structure Pointer
 	struct xint_raw				*td_rawp;          	// RAW Data Structure Pointer
 	struct lockstep				*td_lsp;			// Pointer to the lockstep structure used by the lockstep option
 	struct xint_restart			*td_restartp;		// Pointer to the restart structure used by the restart monitor
+	struct xint_io_engine		*td_ioep;			// Pointer to the asynchronous I/O engine when one is selected
 #if (LINUX || DARWIN)
 	struct stat					td_statbuf;			// Target File Stat buffer used by xdd_target_open()
 #elif (AIX || SOLARIS)
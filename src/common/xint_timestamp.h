@@ -50,6 +50,18 @@
 //  |                                     | +--------------------------------+
 //  +----- End of xint_target_data -------+
 //
+// With "-ts stream" the table is only a ring of ts_size entries. The Target Thread hands out
+// the entries in operation order and each Worker Thread marks its entry complete when it is
+// done with its task. A stream thread for each target copies the completed entries, in order,
+// into a memory-mapped binary file so that memory use does not grow with the length of the run.
+// The file is a series of segments. Each segment starts on a page boundary with a copy of the
+// timestamp header (tsh_magic set to XDD_TS_STREAM_MAGIC) where tsh_tte_indx is the number of
+// the first entry in the segment, tsh_numents is the number of entries in the segment and 
+// tsh_tt_bytes is the number of bytes from this header to the next one.
+//
+// With "-ts compact" the binary output file of "dump" or "stream" is a columnar time stamp
+// file instead - see xint_ts_columnar.h.
+//
 //------------------------------------------------------------------------------------------------//
 
 #define MAX_IDLEN 8192 // This is the maximum length of the Run ID Length field
@@ -142,8 +154,39 @@ typedef struct xdd_ts_header xdd_ts_header_t;
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream the time stamp entries to the binary output file during the run */
+#define TS_COMPACT            0x00008000 /**< Write the binary output file in the columnar format of xint_ts_columnar.h */
 #define DEFAULT_TS_OPTIONS 0x00000000
 
+#define XDD_TS_MAGIC					0xDEADBEEF	// tsh_magic of a time stamp table dumped at the end of the run
+#define XDD_TS_STREAM_MAGIC				0xDEADBEEE	// tsh_magic of each segment of a streamed time stamp file
+#define XDD_TS_STREAM_DEFAULT_ENTRIES	65536		// Default number of in-memory entries with -ts stream
+#define XDD_TS_STREAM_SEGMENT_ENTRIES	65536		// Number of entries in each segment of a streamed time stamp file
+#define XDD_TS_STREAM_FLUSH_USEC		10000		// How often the stream thread copies completed entries to the file when nobody wakes it
+
+// State of the stream thread for "-ts stream"
+struct xint_ts_stream {
+	pthread_t			tss_thread;				// Copies completed entries from the ring to the file
+	int					tss_fd;					// File descriptor of the binary output file
+	int32_t				tss_stop;				// Set to tell the stream thread to exit
+	int32_t				tss_error;				// Set if the file could not be extended - entries are then dropped
+	int32_t				tss_kicked;				// Set when the stream thread has been woken up and has not flushed yet
+	int32_t				tss_waiting;			// Set while the Target Thread waits for a free slot in the ring
+	pthread_mutex_t		tss_mutex;				// Protects the waits on tss_wake and tss_space
+	pthread_cond_t		tss_wake;				// The stream thread waits on this between flushes
+	pthread_cond_t		tss_space;				// The Target Thread waits on this while the ring is full
+	int64_t				*tss_done;				// tss_done[i] is the number of the entry in ring slot i plus 1 once that entry is complete
+	int64_t				tss_allocated;			// Number of entries handed out by the Target Thread
+	int64_t				tss_flushed;			// Number of entries copied to the file (or dropped)
+	int64_t				tss_written;			// Number of entries actually copied to the file
+	xdd_ts_header_t		*tss_segp;				// The segment of the file that is currently mapped
+	off_t				tss_seg_offset;			// File offset of the current segment
+	size_t				tss_seg_bytes;			// Number of bytes mapped for the current segment
+	int64_t				tss_seg_entries;		// Number of entries in the current segment
+	struct xint_tsc_writer	*tss_tscwp;			// Writes the file instead of the segments when TS_COMPACT is set
+};
+typedef struct xint_ts_stream xint_ts_stream_t;
+
 // The timestamp structure is pointed to from the Target Data Structure. 
 // There is one timestamp structure for each Target that has timestamping enabled.
 struct xint_timestamp {
@@ -156,6 +199,7 @@ struct xint_timestamp {
 	char				*ts_output_filename; 	// Timestamp report output filename for this Target
 	FILE				*ts_tsfp;   			// Pointer to the time stamp output file 
 	xdd_ts_header_t		*ts_hdrp;				// Pointer to the actual time stamp header and entries
+	xint_ts_stream_t	*ts_streamp;			// Pointer to the stream state when TS_STREAM is set
 };
 typedef struct xint_timestamp xint_timestamp_t;
 
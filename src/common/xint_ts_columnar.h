@@ -0,0 +1,172 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_TS_COLUMNAR_H
+#define XINT_TS_COLUMNAR_H
+
+//------------------------------------------------------------------------------------------------//
+// Columnar time stamp files - "-ts compact"
+//
+// Instead of a memory image of the xdd_ts_header and its xdd_ts_tte entries the file is:
+//
+//  +-- xdd_tsc_header ----------------+  offset 0
+//  |   ID string (tsc_id_bytes long)  |
+//  |   padding to 8 bytes             |
+//  +-- xdd_tsc_block -----------------+  one block for every XDD_TSC_BLOCK_ENTRIES entries
+//  |   column 0 ... column N-1        |
+//  |   padding to 8 bytes             |
+//  +-- xdd_tsc_block -----------------+
+//  |   ...                            |
+//  +-- xdd_tsc_index[tsc_numblocks] --+  at tsc_index_offset
+//
+// Each block holds the entries of one run of entries, one column per field of xdd_ts_tte.
+// A column is a series of signed 64-bit values that are zig-zag and varint encoded, either
+// one value per entry (XDD_TSC_ENC_VARINT) or as pairs of run length and value
+// (XDD_TSC_ENC_RUNS), whichever is smaller for that column of that block. Counters and
+// times are not stored as such: the value of a XDD_TSC_DELTA column is the difference
+// to the same field of the entry before it in the block and the value of a XDD_TSC_DIFF
+// column is the difference to another field of the same entry (the end of an op relative
+// to its start). Every block can be decoded on its own.
+//
+// The index has the file offset and the time range of every block so a reader can find
+// the blocks of a time range without reading the others. A file whose index was never
+// written (tsc_index_offset is 0) can still be read by walking the blocks from the header.
+//
+// The ID string and the columns of each block are padded with zeros to a multiple of 8
+// bytes so that every block header and the index start on an 8-byte boundary of the file
+// and can be used in place when the file is mapped. tsc_header_bytes and tscb_bytes
+// include the padding.
+//------------------------------------------------------------------------------------------------//
+
+#define XDD_TSC_MAGIC			0xDEADBEED	// tsc_magic of a columnar time stamp file
+#define XDD_TSC_BLOCK_MAGIC		0xDEADB10C	// tscb_magic of each block
+#define XDD_TSC_VERSION			2			// Version of the columnar format
+#define XDD_TSC_BLOCK_ENTRIES	4096		// Most entries in a block
+#define XDD_TSC_MAX_VARINT		10			// Most bytes in one varint
+#define XDD_TSC_ALIGN(x)		(((x) + 7) & ~((int64_t)7))	// Round up to the padding of the header and blocks
+
+// How the values of a column are made from the fields of an entry
+#define XDD_TSC_VALUE			0	// The field itself
+#define XDD_TSC_DELTA			1	// The field minus the same field of the previous entry
+#define XDD_TSC_DIFF			2	// The field minus another field of the same entry
+
+// How the values of a column are stored in a block
+#define XDD_TSC_ENC_VARINT		0	// One varint per entry
+#define XDD_TSC_ENC_RUNS		1	// A varint run length and a varint value for each run of equal values
+
+// The columns of a block - one for each field of xdd_ts_tte except tte_filler1
+#define XDD_TSC_COL_OP_TYPE				0
+#define XDD_TSC_COL_PASS_NUMBER			1
+#define XDD_TSC_COL_WORKER_NUMBER		2
+#define XDD_TSC_COL_THREAD_ID			3
+#define XDD_TSC_COL_DISK_PROC_START		4
+#define XDD_TSC_COL_DISK_PROC_END		5
+#define XDD_TSC_COL_NET_PROC_START		6
+#define XDD_TSC_COL_NET_PROC_END		7
+#define XDD_TSC_COL_DISK_XFER_SIZE		8
+#define XDD_TSC_COL_NET_XFER_SIZE		9
+#define XDD_TSC_COL_NET_XFER_CALLS		10
+#define XDD_TSC_COL_OP_NUMBER			11
+#define XDD_TSC_COL_BYTE_OFFSET			12
+#define XDD_TSC_COL_DISK_START			13
+#define XDD_TSC_COL_DISK_START_K		14
+#define XDD_TSC_COL_DISK_END			15
+#define XDD_TSC_COL_DISK_END_K			16
+#define XDD_TSC_COL_NET_START			17
+#define XDD_TSC_COL_NET_START_K			18
+#define XDD_TSC_COL_NET_END				19
+#define XDD_TSC_COL_NET_END_K			20
+#define XDD_TSC_COLUMNS					21
+
+// The start of a columnar time stamp file - followed by the ID string
+struct xdd_tsc_header {
+	uint32_t	tsc_magic;				// XDD_TSC_MAGIC
+	uint32_t	tsc_version;			// XDD_TSC_VERSION
+	uint32_t	tsc_header_bytes;		// Bytes in this header, the ID string and its padding - the first block starts here
+	uint32_t	tsc_block_entries;		// Most entries in a block
+	int64_t		tsc_numents;			// Number of entries in all blocks
+	int64_t		tsc_numblocks;			// Number of blocks
+	int64_t		tsc_index_offset;		// File offset of the block index or 0 if it was not written
+	nclk_t		tsc_min_time;			// Earliest start time of any entry
+	nclk_t		tsc_max_time;			// Latest end time of any entry
+	// The rest is from the xdd_ts_header of the target
+	char		tsc_version_string[XDD_VERSION_BUFSZ];	// xdd version
+	int32_t		tsc_target_thread_id;	// System target thread ID
+	int32_t		tsc_reqsize;			// Size of the requests in blocks
+	int32_t		tsc_blocksize;			// Size of each block in bytes
+	int32_t		tsc_id_bytes;			// Length of the ID string that follows this header
+	nclk_t		tsc_trigtime;			// Time the time stamp started
+	int64_t		tsc_trigop;				// Operation number that timestamping started
+	int64_t		tsc_res;				// Clock resolution
+	int64_t		tsc_range;				// Range over which the IO took place
+	int64_t		tsc_start_offset;		// Offset of the starting block
+	int64_t		tsc_target_offset;		// Offset of the starting block for each proc
+	uint64_t	tsc_global_options;		// Options used
+	uint64_t	tsc_target_options;		// Options used
+	char		tsc_td[CTIME_BUFSZ];	// Time and date
+	nclk_t		tsc_timer_oh;			// Timer overhead in nanoseconds
+	nclk_t		tsc_delta;				// Delta used for normalization
+};
+typedef struct xdd_tsc_header xdd_tsc_header_t;
+
+// The start of each block - followed by its columns in column order
+struct xdd_tsc_block {
+	uint32_t	tscb_magic;				// XDD_TSC_BLOCK_MAGIC
+	uint32_t	tscb_entries;			// Number of entries in the block
+	uint32_t	tscb_bytes;				// Bytes in the block including this header and the padding
+	uint32_t	tscb_encodings;			// Bit N is set if column N is XDD_TSC_ENC_RUNS
+	int64_t		tscb_first_entry;		// Number of the first entry of the block in the file
+	nclk_t		tscb_min_time;			// Earliest start time of an entry in the block
+	nclk_t		tscb_max_time;			// Latest end time of an entry in the block
+	uint32_t	tscb_column_bytes[XDD_TSC_COLUMNS];	// Bytes in each column
+	uint32_t	tscb_reserved;
+};
+typedef struct xdd_tsc_block xdd_tsc_block_t;
+
+// One entry of the block index at the end of the file
+struct xdd_tsc_index {
+	int64_t		tsci_offset;			// File offset of the block
+	int64_t		tsci_first_entry;		// Number of the first entry of the block in the file
+	uint32_t	tsci_entries;			// Number of entries in the block
+	uint32_t	tsci_bytes;				// Bytes in the block
+	nclk_t		tsci_min_time;			// Earliest start time of an entry in the block
+	nclk_t		tsci_max_time;			// Latest end time of an entry in the block
+};
+typedef struct xdd_tsc_index xdd_tsc_index_t;
+
+// State of a columnar time stamp file that is being written
+struct xint_tsc_writer {
+	int					tscw_fd;			// File descriptor of the file
+	off_t				tscw_offset;		// File offset of the next block
+	int32_t				tscw_entries;		// Number of entries waiting for the next block
+	xdd_ts_tte_t		*tscw_ttep;			// The entries waiting for the next block
+	unsigned char		*tscw_bufp;			// The encoded block
+	xdd_tsc_index_t		*tscw_indexp;		// The index of the blocks written so far
+	int64_t				tscw_index_size;	// Number of index entries allocated
+	xdd_tsc_header_t	tscw_header;		// The header of the file
+};
+typedef struct xint_tsc_writer xint_tsc_writer_t;
+
+// Most bytes an encoded block can take
+#define XDD_TSC_MAX_BLOCK_BYTES	(sizeof(xdd_tsc_block_t) + (XDD_TSC_COLUMNS * XDD_TSC_BLOCK_ENTRIES * 2 * XDD_TSC_MAX_VARINT) + 8)
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
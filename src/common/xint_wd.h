@@ -23,9 +23,15 @@ struct xint_worker_data {
 	int32_t   					wd_pid;   			// My process ID 
 	unsigned char				*wd_bufp;			// Pointer to the generic I/O buffer
 	int							wd_buf_size;		// Size in bytes of the generic I/O buffer
+	unsigned char				*wd_verify_bufp;	// Expected data for -verify contents, built when first needed
 	int64_t						wd_ts_entry;		// The TimeStamp entry to use when time-stamping an operation
+	int64_t						wd_ts_stream_entry;	// With -ts stream the number of the entry plus 1, 0 if none
 	struct xint_task			wd_task;			// Task Structure
-	struct xint_target_counters	wd_counters;		// Counters specific to this worker for this target
+	// The counters are only written by this Worker Thread and start on their own cache line so that
+	// the Worker Threads of a Target do not share cache lines when updating them
+	struct xint_target_counters	wd_counters __attribute__((aligned(XINT_COUNTERS_CACHE_LINE_SIZE)));	// Counters specific to this worker for this target
+	struct xint_extended_stats	wd_extended_stats;	// Longest/shortest ops of this worker - only updated with -extendedstats
+	struct xint_latency_histogram	*wd_lathistp;	// Latency histogram of this worker for this pass - only kept for latency percentiles
 
 	// Worker Thread-specific locks and associated pointers
 	pthread_mutex_t				wd_worker_thread_target_sync_mutex;	// Used to serialize access to the Worker_Thread-Target Synchronization flags
@@ -36,10 +42,9 @@ struct xint_worker_data {
 #define	WTSYNC_EOF_RECEIVED		0x00000008		// This Worker_Thread received an EOF packet from the Source Side of an E2E Operation
     pthread_cond_t 				wd_this_worker_thread_is_available_condition;
 	xdd_barrier_t				*wd_current_barrier;	// The barrier where the Worker_Thread is currently at
-	xdd_barrier_t				wd_thread_targetpass_wait_for_task_barrier;	// The barrier where the Worker_Thread waits for targetpass() to release it with a task to perform
+	xint_task_ring_t			wd_task_ring;		// Where the Worker_Thread waits for targetpass() to post a task to perform
 	xdd_occupant_t				wd_occupant;		// Used by the barriers to keep track of what is in a barrier at any given time
 	char						wd_occupant_name[XDD_BARRIER_MAX_NAME_LENGTH];	// For a Target thread this is "TARGET####", for a Worker_Thread it is "TARGET####WORKER####"
-	tot_wait_t					wd_tot_wait;		// The TOT Wait structure for this worker
 	xint_e2e_t					*wd_e2ep;			// Pointer to the e2e struct when needed
 	xdd_sgio_t					*wd_sgiop;			// SGIO Structure Pointer
 	pthread_mutex_t 			wd_current_state_mutex; 	// Mutex for locking when checking or updating the state info
@@ -51,9 +56,8 @@ struct xint_worker_data {
 #define	WORKER_CURRENT_STATE_SRC_SEND								0x00000008	// Waiting for "send" to send data - Source side of an E2E operation
 #define	WORKER_CURRENT_STATE_BARRIER								0x00000010	// Waiting inside a barrier
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE			0x00000020	// Worker Thread is waiting for the TOT lock in order to update the block number
-#define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE		0x00000040	// Worker Thread is waiting for the TOT lock in order to release the next I/O
-#define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS				0x00000080	// Worker Thread is waiting for the TOT lock to set the "wait" time stamp
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO				0x00000100	// Waiting on the previous I/O op semaphore
+#define	WORKER_CURRENT_STATE_WAITING_FOR_TASK						0x00000200	// Waiting for the Target Thread to post a task
 };
 typedef struct xint_worker_data worker_data_t;
 
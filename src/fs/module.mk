@@ -5,5 +5,6 @@ DIR := src/fs
 
 FS_SRC := $(DIR)/xint_preallocate.c \
 	$(DIR)/xint_pretruncate.c \
+	$(DIR)/xint_physical_order.c \
 	$(DIR)/sg.c
 
@@ -0,0 +1,252 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that put the seek list of a target
+ * in the order of its physical layout for the -seek physical option.
+ */
+#include "xint.h"
+#if  LINUX
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
+
+// One extent of the target - a range of logical bytes and where it starts on the device
+struct xint_extent {
+	uint64_t	ext_logical;	// Byte offset of the extent in the file
+	uint64_t	ext_physical;	// Byte offset of the extent on the device
+	uint64_t	ext_length;		// Length of the extent in bytes
+};
+typedef struct xint_extent xint_extent_t;
+
+// The physical location of one entry of the seek list
+struct xint_physical_key {
+	uint64_t	pk_location;	// Byte offset on the device - UINT64_MAX if the offset is not mapped
+	int64_t		pk_op;			// Entry of the seek list
+};
+typedef struct xint_physical_key xint_physical_key_t;
+
+#define XINT_FIEMAP_EXTENTS	512	// Number of extents asked for by each FIEMAP call
+
+#if  LINUX
+/*----------------------------------------------------------------------------*/
+/* xint_target_extents_for_os() - Extent map routine for linux
+ * This gets the extents of the target file in logical order with the
+ * FIEMAP ioctl. Extents whose physical location is not known are left out.
+ * Returns the number of extents in *extentsp or -1 if there is an error.
+ */
+static int64_t
+xint_target_extents_for_os(target_data_t *tdp, xint_extent_t **extentsp) {
+	struct fiemap			*fmp;		// FIEMAP request and the extents it returns
+	struct fiemap_extent	*fep;		// One extent returned by FIEMAP
+	xint_extent_t			*extents;	// The extents of the target
+	xint_extent_t			*newp;		// Used to grow the extents
+	int64_t					count;		// Number of extents in extents
+	int64_t					size;		// Number of extents that fit in extents
+	uint64_t				start;		// Byte offset to ask FIEMAP for next
+	uint32_t				i;
+	int						last;		// Set when FIEMAP returned the last extent
+
+
+	fmp = calloc(1, sizeof(struct fiemap) + (XINT_FIEMAP_EXTENTS * sizeof(struct fiemap_extent)));
+	if (fmp == NULL)
+		return(-1);
+	extents = NULL;
+	count = 0;
+	size = 0;
+	start = 0;
+	last = 0;
+	while (!last) {
+		memset(fmp, 0, sizeof(struct fiemap));
+		fmp->fm_start = start;
+		fmp->fm_length = FIEMAP_MAX_OFFSET - start;
+		fmp->fm_flags = FIEMAP_FLAG_SYNC; // Allocate any delayed allocation extents first
+		fmp->fm_extent_count = XINT_FIEMAP_EXTENTS;
+		if (ioctl(tdp->td_file_desc, FS_IOC_FIEMAP, fmp) < 0) {
+			free(fmp);
+			free(extents);
+			return(-1);
+		}
+		if (fmp->fm_mapped_extents == 0)
+			break;
+		for (i = 0; i < fmp->fm_mapped_extents; i++) {
+			fep = &fmp->fm_extents[i];
+			if (fep->fe_flags & FIEMAP_EXTENT_LAST)
+				last = 1;
+			start = fep->fe_logical + fep->fe_length;
+			if (fep->fe_flags & (FIEMAP_EXTENT_UNKNOWN | FIEMAP_EXTENT_ENCODED))
+				continue;
+			if (count == size) {
+				size = (size) ? size * 2 : XINT_FIEMAP_EXTENTS;
+				newp = realloc(extents, size * sizeof(xint_extent_t));
+				if (newp == NULL) {
+					free(fmp);
+					free(extents);
+					return(-1);
+				}
+				extents = newp;
+			}
+			extents[count].ext_logical = fep->fe_logical;
+			extents[count].ext_physical = fep->fe_physical;
+			extents[count].ext_length = fep->fe_length;
+			count++;
+		}
+	}
+	free(fmp);
+	*extentsp = extents;
+	return(count);
+
+} // End of xint_target_extents_for_os()
+#else
+
+/*----------------------------------------------------------------------------*/
+/* xint_target_extents_for_os() - The default extent map routine for all other OS
+ */
+static int64_t
+xint_target_extents_for_os(target_data_t *tdp, xint_extent_t **extentsp) {
+
+	errno = ENOTSUP;
+	return(-1);
+
+} // End of default xint_target_extents_for_os()
+#endif
+
+/*----------------------------------------------------------------------------*/
+// OS-independent code
+/*----------------------------------------------------------------------------*/
+/* xint_physical_key_compare() - qsort() comparison of two physical keys.
+ * Entries at the same location (which includes all the unmapped entries)
+ * keep their seek list order.
+ */
+static int
+xint_physical_key_compare(const void *a, const void *b) {
+	const xint_physical_key_t	*ka = a;
+	const xint_physical_key_t	*kb = b;
+
+	if (ka->pk_location != kb->pk_location)
+		return((ka->pk_location < kb->pk_location) ? -1 : 1);
+	return((ka->pk_op < kb->pk_op) ? -1 : (ka->pk_op > kb->pk_op));
+
+} // End of xint_physical_key_compare()
+
+/*----------------------------------------------------------------------------*/
+/* xint_target_physical_order() - Sort the seek list of a target by the
+ * device location of each op so that the ops follow the on-disk order of
+ * the file instead of its logical order. Ops over holes or past the end
+ * of the file keep their logical order after all the mapped ops. The last
+ * op stays last when it is shorter than the others because its transfer
+ * size is set by the bytes remaining when it is issued.
+ * This is called by xdd_init_seek_list() once the seek list is built.
+ * Upon success this routine will return a 0.
+ * Otherwise -1 is returned and the seek list is left in logical order.
+ */
+int32_t
+xint_target_physical_order(target_data_t *tdp) {
+	seekhdr_t			*sp;		// Seek header of this target
+	xint_extent_t		*extents;	// The extents of the target in logical order
+	xint_physical_key_t	*keys;		// The device location of each op
+	seek_t				*seeks;		// The seek list in physical order
+	int64_t				count;		// Number of extents
+	int64_t				ops;		// Number of ops to sort
+	int64_t				op;
+	int64_t				low, high, mid;
+	uint64_t			offset;		// Byte offset of an op in the file
+
+
+	sp = &tdp->td_seekhdr;
+	if (!(sp->seek_options & SO_SEEK_PHYSICAL) || (sp->seeks == NULL))
+		return(0);
+	if (tdp->td_target_options & (TO_NULL_TARGET | TO_STRIPE)) {
+		fprintf(xgp->errout,"%s: xint_target_physical_order: WARNING: Target %d: -seek physical does not apply to null or striped targets - using the logical order\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+
+	extents = NULL;
+	count = xint_target_extents_for_os(tdp, &extents);
+	if (count < 0) {
+		fprintf(xgp->errout,"%s: xint_target_physical_order: WARNING: Target %d name %s: Cannot get the physical layout - using the logical order: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			strerror(errno));
+		return(-1);
+	}
+	sp->seek_physical_extents = count;
+	sp->seek_physical_ops = 0;
+
+	ops = sp->seek_total_ops;
+	if ((tdp->td_target_bytes_to_xfer_per_pass % tdp->td_xfer_size) && (ops > 0))
+		ops--;
+	keys = malloc((ops + 1) * sizeof(xint_physical_key_t));
+	seeks = malloc(sp->seek_total_ops * sizeof(seek_t));
+	if ((keys == NULL) || (seeks == NULL)) {
+		fprintf(xgp->errout,"%s: xint_target_physical_order: WARNING: Target %d: Cannot allocate memory to sort %lld ops - using the logical order\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)sp->seek_total_ops);
+		free(keys);
+		free(seeks);
+		free(extents);
+		return(-1);
+	}
+
+	// Find the extent of each op with a binary search of the extents
+	for (op = 0; op < ops; op++) {
+		offset = ((tdp->td_target_number * tdp->td_planp->target_offset) + sp->seeks[op].block_location) * tdp->td_block_size;
+		keys[op].pk_op = op;
+		keys[op].pk_location = UINT64_MAX;
+		low = 0;
+		high = count - 1;
+		while (low <= high) {
+			mid = low + ((high - low) / 2);
+			if (offset < extents[mid].ext_logical)
+				high = mid - 1;
+			else if (offset >= extents[mid].ext_logical + extents[mid].ext_length)
+				low = mid + 1;
+			else {
+				keys[op].pk_location = extents[mid].ext_physical + (offset - extents[mid].ext_logical);
+				sp->seek_physical_ops++;
+				break;
+			}
+		}
+	}
+	qsort(keys, ops, sizeof(xint_physical_key_t), xint_physical_key_compare);
+	// The issue times stay with the op numbers so that a throttled target keeps its pace
+	for (op = 0; op < ops; op++) {
+		seeks[op] = sp->seeks[keys[op].pk_op];
+		seeks[op].time1 = sp->seeks[op].time1;
+		seeks[op].time2 = sp->seeks[op].time2;
+	}
+	for ( ; op < sp->seek_total_ops; op++)
+		seeks[op] = sp->seeks[op];
+	memcpy(sp->seeks, seeks, sp->seek_total_ops * sizeof(seek_t));
+
+	free(keys);
+	free(seeks);
+	free(extents);
+	return(0);
+
+} // End of xint_target_physical_order()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -16,6 +16,223 @@
  */
 #include "xint.h"
 
+#if defined(LINUX)
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_zerocopy_drain() - throw away any data that an earlier op that
+ * failed left in the zero copy pipe of this Worker Thread by reading it
+ * into the I/O buffer, which is large enough to hold a whole pipe.
+ *
+ * Return values: 0 is good, -1 is bad
+ */
+static int32_t
+xdd_e2e_zerocopy_drain(xint_e2e_t *e2ep) {
+	ssize_t				status;		// Status of a call to read()
+
+
+	while (e2ep->e2e_pipe_bytes > 0) {
+		status = read(e2ep->e2e_pipe[0], e2ep->e2e_datap, e2ep->e2e_pipe_bytes);
+		if (status <= 0)
+			return(-1);
+		e2ep->e2e_pipe_bytes -= status;
+	}
+	return(0);
+
+} /* end of xdd_e2e_zerocopy_drain() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_src_zerocopy_read() - read the data of the current task from
+ * the target file into the pipe of this Worker Thread with splice().
+ * The pages of the file are not copied into the I/O buffer;
+ * xdd_e2e_src_send() splices them from the pipe into the socket.
+ *
+ * Return values: the number of bytes read, or -1 if there was an error
+ */
+ssize_t
+xdd_e2e_src_zerocopy_read(worker_data_t *wdp) {
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	loff_t				offset;		// File offset of the next byte to read
+	ssize_t				status;		// Status of a call to splice()
+	size_t				remaining;	// Number of bytes still to be read
+
+
+	e2ep = wdp->wd_e2ep;
+	if (xdd_e2e_zerocopy_drain(e2ep))
+		return(-1);
+
+	offset = (loff_t)wdp->wd_task.task_byte_offset;
+	remaining = wdp->wd_task.task_xfer_size;
+	while (remaining > 0) {
+		status = splice(wdp->wd_task.task_file_desc, &offset, e2ep->e2e_pipe[1], NULL, remaining, SPLICE_F_MOVE);
+		if (status < 0)
+			return(-1);
+		if (status == 0) // End of file
+			break;
+		e2ep->e2e_pipe_bytes += status;
+		remaining -= status;
+	}
+	return(e2ep->e2e_pipe_bytes);
+
+} /* end of xdd_e2e_src_zerocopy_read() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_src_zerocopy_send() - send the E2E header from the buffer and
+ * then splice the data from the pipe into the socket. The destination sees
+ * exactly what sendto() of the header followed by the data would send.
+ * The number of send() and splice() calls is returned in *calls.
+ *
+ * Return values: the number of bytes sent, or -1 if there was an error
+ */
+static int32_t
+xdd_e2e_src_zerocopy_send(worker_data_t *wdp, int *calls) {
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	int32_t				bytes_sent;	// Cumulative number of bytes sent
+	ssize_t				status;		// Status of a call to send() or splice()
+
+
+	e2ep = wdp->wd_e2ep;
+	bytes_sent = 0;
+	*calls = 0;
+	while (bytes_sent < (int32_t)sizeof(xdd_e2e_header_t)) {
+		status = send(e2ep->e2e_sd,
+					  (unsigned char *)e2ep->e2e_hdrp + bytes_sent,
+					  sizeof(xdd_e2e_header_t) - bytes_sent,
+					  MSG_MORE);
+		if (status <= 0) {
+			xdd_e2e_err(wdp,"xdd_e2e_src_zerocopy_send","ERROR: error sending HEADER to destination\n");
+			return(-1);
+		}
+		bytes_sent += status;
+		(*calls)++;
+	}
+	while (e2ep->e2e_pipe_bytes > 0) {
+		status = splice(e2ep->e2e_pipe[0], NULL, e2ep->e2e_sd, NULL, e2ep->e2e_pipe_bytes, SPLICE_F_MOVE | SPLICE_F_MORE);
+		if (status <= 0) {
+			xdd_e2e_err(wdp,"xdd_e2e_src_zerocopy_send","ERROR: error splicing DATA to destination\n");
+			return(-1);
+		}
+		bytes_sent += status;
+		e2ep->e2e_pipe_bytes -= status;
+		(*calls)++;
+	}
+	return(bytes_sent);
+
+} /* end of xdd_e2e_src_zerocopy_send() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_dest_zerocopy_receive() - splice the data portion of an E2E
+ * message from the socket into the pipe of this Worker Thread. The data is
+ * written to the target file by xdd_e2e_dest_zerocopy_write().
+ * A pipe counts its capacity in buffers rather than bytes and TCP may fill
+ * a buffer with less than a page so the pipe can fill up before the whole
+ * message is in it. The rest of the message is then received into the I/O
+ * buffer at the same position it would have in the data.
+ *
+ * Return values: the number of bytes received, or the status of the
+ * call that failed (0 if the source closed the connection)
+ */
+static int32_t
+xdd_e2e_dest_zerocopy_receive(worker_data_t *wdp, int csd) {
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	struct pollfd		pfd;		// Used to wait for the socket or check the pipe
+	ssize_t				status;		// Status of a call to splice() or recv()
+	int32_t				bytes_received;	// Cumulative number of bytes received
+
+
+	e2ep = wdp->wd_e2ep;
+	if (xdd_e2e_zerocopy_drain(e2ep))
+		return(-1);
+	while (e2ep->e2e_pipe_bytes < e2ep->e2e_data_size) {
+		status = splice(csd, NULL, e2ep->e2e_pipe[1], NULL, e2ep->e2e_data_size - e2ep->e2e_pipe_bytes, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if (status > 0) {
+			e2ep->e2e_pipe_bytes += status;
+			continue;
+		}
+		if ((status == 0) || (errno != EAGAIN))
+			return((int32_t)status);
+		// Either the pipe is full or there is nothing to read yet
+		pfd.fd = e2ep->e2e_pipe[1];
+		pfd.events = POLLOUT;
+		if (poll(&pfd, 1, 0) == 0)
+			break;
+		pfd.fd = csd;
+		pfd.events = POLLIN;
+		if (poll(&pfd, 1, -1) < 0)
+			return(-1);
+	}
+
+	// Whatever did not fit in the pipe goes into the buffer
+	bytes_received = e2ep->e2e_pipe_bytes;
+	while (bytes_received < e2ep->e2e_data_size) {
+		status = recv(csd, e2ep->e2e_datap + bytes_received, e2ep->e2e_data_size - bytes_received, 0);
+		if (status <= 0)
+			return((int32_t)status);
+		bytes_received += status;
+	}
+	return(bytes_received);
+
+} /* end of xdd_e2e_dest_zerocopy_receive() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_dest_zerocopy_write() - write the data that
+ * xdd_e2e_dest_zerocopy_receive() left in the pipe of this Worker Thread
+ * to the target file at the offset of the current task with splice().
+ * The part of the data that did not fit in the pipe is written from
+ * the I/O buffer.
+ *
+ * Return values: the number of bytes written, or -1 if there was an error
+ */
+ssize_t
+xdd_e2e_dest_zerocopy_write(worker_data_t *wdp) {
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	loff_t				offset;		// File offset of the next byte to write
+	ssize_t				status;		// Status of a call to splice() or pwrite()
+	ssize_t				bytes_written;	// Cumulative number of bytes written
+
+
+	e2ep = wdp->wd_e2ep;
+	offset = (loff_t)wdp->wd_task.task_byte_offset;
+	bytes_written = 0;
+	while (e2ep->e2e_pipe_bytes > 0) {
+		status = splice(e2ep->e2e_pipe[0], NULL, wdp->wd_task.task_file_desc, &offset, e2ep->e2e_pipe_bytes, SPLICE_F_MOVE);
+		if (status <= 0)
+			return(-1);
+		e2ep->e2e_pipe_bytes -= status;
+		bytes_written += status;
+	}
+	while (bytes_written < (ssize_t)wdp->wd_task.task_xfer_size) {
+		status = pwrite(wdp->wd_task.task_file_desc,
+						wdp->wd_task.task_datap + bytes_written,
+						wdp->wd_task.task_xfer_size - bytes_written,
+						(off_t)(wdp->wd_task.task_byte_offset + bytes_written));
+		if (status <= 0)
+			return(-1);
+		bytes_written += status;
+	}
+	return(bytes_written);
+
+} /* end of xdd_e2e_dest_zerocopy_write() */
+#else
+ssize_t
+xdd_e2e_src_zerocopy_read(worker_data_t *wdp) {
+	return(-1);
+} /* end of xdd_e2e_src_zerocopy_read() */
+
+static int32_t
+xdd_e2e_src_zerocopy_send(worker_data_t *wdp, int *calls) {
+	return(-1);
+} /* end of xdd_e2e_src_zerocopy_send() */
+
+static int32_t
+xdd_e2e_dest_zerocopy_receive(worker_data_t *wdp, int csd) {
+	return(-1);
+} /* end of xdd_e2e_dest_zerocopy_receive() */
+
+ssize_t
+xdd_e2e_dest_zerocopy_write(worker_data_t *wdp) {
+	return(-1);
+} /* end of xdd_e2e_dest_zerocopy_write() */
+#endif
+
 /*----------------------------------------------------------------------*/
 /* xdd_e2e_src_send() - send the data from source to destination 
  * This subroutine will take the message header from the Worker Data Struct
@@ -27,6 +244,9 @@
  * 
  * Return values: 0 is good, -1 is bad
  *
+ * With "-e2e zerocopy" the data is in the pipe of the Worker Thread rather
+ * than in the buffer and is sent by xdd_e2e_src_zerocopy_send().
+ *
  * The size of the buffer depends on whether it is being used for network
  * I/O as in an End-to-end operation. For End-to-End operations, the size
  * of the buffer is 1 page larger than for non-End-to-End operations.
@@ -98,6 +318,13 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 if (xgp->global_options & GO_DEBUG_E2E) xdd_show_e2e_header((xdd_e2e_header_t *)bufp);
 
 	nclk_now(&wdp->wd_counters.tc_current_net_start_time);
+	if (e2ep->e2e_pipe_size) { // Zero copy - the data is in the pipe rather than the buffer
+		e2ehp->e2eh_data_length = e2ep->e2e_pipe_bytes;
+		e2ep->e2e_xfer_size = sizeof(xdd_e2e_header_t) + e2ehp->e2eh_data_length;
+		bytes_sent = xdd_e2e_src_zerocopy_send(wdp, &sento_calls);
+		if (bytes_sent < 0)
+			return(-1);
+	}
 	while (bytes_sent < e2ep->e2e_xfer_size) {
 		send_size = e2ep->e2e_xfer_size - bytes_sent;
 		if (send_size > max_xfer) 
@@ -332,6 +559,9 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
  * This subroutine will block until the entire data portion is received or 
  * until the connection is broken in which case an error is returned.
  *
+ * With "-e2e zerocopy" the data is spliced into the pipe of the Worker
+ * Thread rather than received into the buffer if the pipe can hold it.
+ *
  * Return values: Upon successfully reading the data and validating
  * it, the number of data bytes is returned to the caller.
  * Otherwise, in the event of an error, the status of the recvfrom() 
@@ -380,6 +610,22 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 			e2ep->e2e_data_size = e2ehp->e2eh_data_length;
 			bytes_received = 0;
 			bufp = (unsigned char *)e2ep->e2e_datap;
+			// With zero copy the data goes into the pipe unless it does not fit
+			if ((e2ep->e2e_pipe_size) && (e2ep->e2e_data_size <= e2ep->e2e_pipe_size)) {
+				status = xdd_e2e_dest_zerocopy_receive(wdp, e2ep->e2e_csd[e2ep->e2e_current_csd]);
+				if (status <= 0) {
+					e2ep->e2e_recv_status = status;
+					fprintf(xgp->errout,"\n%s: xdd_e2e_dest_receive_data: Target %d Worker: %d: ERROR SPLICING DATA: recv_status=%d, errno=%d\n",
+						xgp->progname,
+						tdp->td_target_number,
+						wdp->wd_worker_number,
+						e2ep->e2e_recv_status,
+						errno);
+					return(status);
+				}
+				bytes_received = status;
+				continue;
+			}
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_dest_receive_data: Target: %d: Worker: %d: OK - IT IS A HEADER SO LETS READ DATA: bytes_received=%d:e2e_data_size=%d \n", (long long int)pclk_now(),  tdp->td_target_number, wdp->wd_worker_number, bytes_received,e2ep->e2e_data_size);
 			while (bytes_received < e2ep->e2e_data_size) {
 				receive_size = e2ep->e2e_data_size - bytes_received;
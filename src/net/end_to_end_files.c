@@ -0,0 +1,807 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the E2E files mode (-e2e files).
+ * The target on either side is a directory instead of a single file.
+ * The source side walks the directory (or reads a list of paths) when the
+ * target is opened and lays the files out over a sequence of requests.
+ * Small files are packed into one request and large files are split over
+ * as many requests as it takes. Each request is read into the I/O buffer
+ * as a series of file records (see end_to_end.h) and sent as a normal E2E
+ * message, so one set of connections and Worker Threads moves the whole
+ * tree. The destination side takes the records of every message it
+ * receives apart and writes each one to its own file.
+ */
+#include "xint.h"
+#include <dirent.h>
+
+/*----------------------------------------------------------------------------*/
+// Add a file or directory to the file table
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_add_entry(target_data_t *tdp, xdd_e2e_file_table_t *ftp, char *path, struct stat *statp) {
+	xdd_e2e_file_entry_t	*fep;
+	int64_t					size;
+
+
+	if (ftp->ft_entry_count == ftp->ft_entry_size) {
+		size = (ftp->ft_entry_size) ? 2 * ftp->ft_entry_size : 1024;
+		fep = realloc(ftp->ft_entries, size * sizeof(xdd_e2e_file_entry_t));
+		if (fep == NULL) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_add_entry: Target %d: ERROR: Cannot allocate memory for %lld file entries\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(long long int)size);
+			return(-1);
+		}
+		ftp->ft_entries = fep;
+		ftp->ft_entry_size = size;
+	}
+	fep = &ftp->ft_entries[ftp->ft_entry_count];
+	fep->fe_path = strdup(path);
+	if (fep->fe_path == NULL) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_add_entry: Target %d: ERROR: Cannot allocate memory for path %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			path);
+		return(-1);
+	}
+	fep->fe_path_length = strlen(path);
+	fep->fe_mode = statp->st_mode;
+	if (S_ISDIR(statp->st_mode)) {
+		fep->fe_size = 0;
+		ftp->ft_directory_count++;
+	} else {
+		fep->fe_size = statp->st_size;
+		ftp->ft_file_count++;
+		ftp->ft_bytes += statp->st_size;
+	}
+	ftp->ft_entry_count++;
+	return(0);
+
+} // End of xdd_e2e_files_add_entry()
+
+/*----------------------------------------------------------------------------*/
+// Add every file and directory below the directory "path" to the file table.
+// Directories go in ahead of their contents. Entries that are neither a
+// regular file nor a directory (symbolic links, devices, ...) are counted and
+// left out.
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_walk(target_data_t *tdp, xdd_e2e_file_table_t *ftp, char *path) {
+	DIR				*dirp;
+	struct dirent	*dep;
+	struct stat		statbuf;
+	char			entry_path[PATH_MAX];
+	int				fd;
+	int32_t			status;
+
+
+	fd = openat(tdp->td_file_desc, (*path) ? path : ".", O_RDONLY|O_DIRECTORY);
+	if ((fd < 0) || ((dirp = fdopendir(fd)) == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_walk: Target %d: ERROR: Cannot open directory %s/%s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			path,
+			strerror(errno));
+		if (fd >= 0)
+			close(fd);
+		return(-1);
+	}
+
+	status = 0;
+	while ((dep = readdir(dirp)) != NULL) {
+		if ((strcmp(dep->d_name, ".") == 0) || (strcmp(dep->d_name, "..") == 0))
+			continue;
+		if (fstatat(dirfd(dirp), dep->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) < 0) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_walk: Target %d: ERROR: Cannot stat %s/%s/%s: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				tdp->td_target_full_pathname,
+				path,
+				dep->d_name,
+				strerror(errno));
+			status = -1;
+			break;
+		}
+		if (!S_ISREG(statbuf.st_mode) && !S_ISDIR(statbuf.st_mode)) {
+			ftp->ft_skipped_count++;
+			continue;
+		}
+		if (snprintf(entry_path, sizeof(entry_path), "%s%s%s", path, (*path) ? "/" : "", dep->d_name) >= (int)sizeof(entry_path)) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_walk: Target %d: ERROR: Path %s/%s is too long\n",
+				xgp->progname,
+				tdp->td_target_number,
+				path,
+				dep->d_name);
+			status = -1;
+			break;
+		}
+		if (xdd_e2e_files_add_entry(tdp, ftp, entry_path, &statbuf) < 0) {
+			status = -1;
+			break;
+		}
+		if (S_ISDIR(statbuf.st_mode) && (xdd_e2e_files_walk(tdp, ftp, entry_path) < 0)) {
+			status = -1;
+			break;
+		}
+	}
+	closedir(dirp);
+	return(status);
+
+} // End of xdd_e2e_files_walk()
+
+/*----------------------------------------------------------------------------*/
+// A path in a file list or a file record has to stay inside the target
+// directory: it must be relative and must not have a ".." component.
+static int
+xdd_e2e_files_path_is_safe(char *path) {
+	char	*cp;
+
+
+	if ((*path == '\0') || (*path == '/'))
+		return(0);
+	for (cp = path; cp; cp = strchr(cp, '/')) {
+		if (*cp == '/')
+			cp++;
+		if ((strncmp(cp, "..", 2) == 0) && ((cp[2] == '/') || (cp[2] == '\0')))
+			return(0);
+	}
+	return(1);
+
+} // End of xdd_e2e_files_path_is_safe()
+
+/*----------------------------------------------------------------------------*/
+// Add the paths listed in the -e2e filelist file, one per line and relative
+// to the target directory. A directory in the list is sent with everything
+// below it.
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_read_list(target_data_t *tdp, xdd_e2e_file_table_t *ftp) {
+	FILE			*fp;
+	struct stat		statbuf;
+	char			path[PATH_MAX];
+	size_t			length;
+	int32_t			status;
+
+
+	fp = fopen(tdp->td_e2ep->e2e_file_list_name, "r");
+	if (fp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_read_list: Target %d: ERROR: Cannot open file list %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_e2ep->e2e_file_list_name,
+			strerror(errno));
+		return(-1);
+	}
+
+	status = 0;
+	while (fgets(path, sizeof(path), fp)) {
+		length = strlen(path);
+		while ((length > 0) && ((path[length-1] == '\n') || (path[length-1] == '\r')))
+			path[--length] = '\0';
+		while ((length > 1) && (path[length-1] == '/'))
+			path[--length] = '\0';
+		if (length == 0)
+			continue;
+		if (!xdd_e2e_files_path_is_safe(path)) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_read_list: Target %d: ERROR: Path %s in file list %s is not relative to the target directory\n",
+				xgp->progname,
+				tdp->td_target_number,
+				path,
+				tdp->td_e2ep->e2e_file_list_name);
+			status = -1;
+			break;
+		}
+		if (fstatat(tdp->td_file_desc, path, &statbuf, 0) < 0) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_read_list: Target %d: ERROR: Cannot stat %s/%s: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				tdp->td_target_full_pathname,
+				path,
+				strerror(errno));
+			status = -1;
+			break;
+		}
+		if (!S_ISREG(statbuf.st_mode) && !S_ISDIR(statbuf.st_mode)) {
+			ftp->ft_skipped_count++;
+			continue;
+		}
+		if (xdd_e2e_files_add_entry(tdp, ftp, path, &statbuf) < 0) {
+			status = -1;
+			break;
+		}
+		if (S_ISDIR(statbuf.st_mode) && (xdd_e2e_files_walk(tdp, ftp, path) < 0)) {
+			status = -1;
+			break;
+		}
+	}
+	fclose(fp);
+	return(status);
+
+} // End of xdd_e2e_files_read_list()
+
+/*----------------------------------------------------------------------------*/
+// Return the number of data bytes of the next record of a file when "used"
+// bytes of the message are taken, or -1 if the record has to go into the
+// next message. Planning and reading both go through here so that they
+// always agree on where each request starts and ends.
+static int64_t
+xdd_e2e_files_record_length(xdd_e2e_file_entry_t *fep, int64_t offset, int64_t used, int64_t xfer_size) {
+	int64_t		space;			// Room for file data in the rest of the message
+	int64_t		remaining;		// Bytes of the file still to be sent
+
+
+	space = (xfer_size - used - (int64_t)sizeof(xdd_e2e_file_header_t) - XDD_E2E_FILE_ALIGN(fep->fe_path_length)) & ~((int64_t)7);
+	if (space < 0)
+		return(-1);
+	if (S_ISDIR(fep->fe_mode))
+		return(0);
+	remaining = fep->fe_size - offset;
+	if (remaining <= space)
+		return(remaining);
+	// Do not split off a sliver of a file at the end of a message
+	if ((used > 0) && (space < XDD_E2E_FILE_MIN_SPLIT))
+		return(-1);
+	return(space);
+
+} // End of xdd_e2e_files_record_length()
+
+/*----------------------------------------------------------------------------*/
+// Start a new request at the given entry and offset
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_add_request(target_data_t *tdp, xdd_e2e_file_table_t *ftp, int64_t entry, int64_t offset) {
+	xdd_e2e_file_request_t	*frp;
+	int64_t					size;
+
+
+	if (ftp->ft_request_count == ftp->ft_request_size) {
+		size = (ftp->ft_request_size) ? 2 * ftp->ft_request_size : 1024;
+		frp = realloc(ftp->ft_requests, size * sizeof(xdd_e2e_file_request_t));
+		if (frp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_add_request: Target %d: ERROR: Cannot allocate memory for %lld requests\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(long long int)size);
+			return(-1);
+		}
+		ftp->ft_requests = frp;
+		ftp->ft_request_size = size;
+	}
+	ftp->ft_requests[ftp->ft_request_count].fr_entry = entry;
+	ftp->ft_requests[ftp->ft_request_count].fr_offset = offset;
+	ftp->ft_request_count++;
+	return(0);
+
+} // End of xdd_e2e_files_add_request()
+
+/*----------------------------------------------------------------------------*/
+// Lay the file table out over requests of at most td_xfer_size bytes.
+// There is always at least one request so that an empty tree still makes a
+// (empty) pass.
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_plan(target_data_t *tdp, xdd_e2e_file_table_t *ftp) {
+	xdd_e2e_file_entry_t	*fep;
+	int64_t					entry;
+	int64_t					offset;
+	int64_t					used;
+	int64_t					length;
+
+
+	if (xdd_e2e_files_add_request(tdp, ftp, 0, 0) < 0)
+		return(-1);
+	used = 0;
+	for (entry = 0; entry < ftp->ft_entry_count; entry++) {
+		fep = &ftp->ft_entries[entry];
+		// Every record has to fit into an empty message with room to spare
+		if ((int64_t)sizeof(xdd_e2e_file_header_t) + XDD_E2E_FILE_ALIGN(fep->fe_path_length) + XDD_E2E_FILE_MIN_SPLIT > (int64_t)tdp->td_xfer_size) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_plan: Target %d: ERROR: The request size of %d bytes is too small for the records of %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				(int)tdp->td_xfer_size,
+				fep->fe_path);
+			return(-1);
+		}
+		offset = 0;
+		while (1) {
+			length = xdd_e2e_files_record_length(fep, offset, used, tdp->td_xfer_size);
+			if (length < 0) {
+				if (xdd_e2e_files_add_request(tdp, ftp, entry, offset) < 0)
+					return(-1);
+				used = 0;
+				continue;
+			}
+			used += sizeof(xdd_e2e_file_header_t) + XDD_E2E_FILE_ALIGN(fep->fe_path_length) + XDD_E2E_FILE_ALIGN(length);
+			offset += length;
+			if (offset >= fep->fe_size)
+				break;
+		}
+	}
+	return(0);
+
+} // End of xdd_e2e_files_plan()
+
+/*----------------------------------------------------------------------------*/
+// xdd_e2e_files_open() - Open the target directory of an E2E files mode
+// target. This is called by xdd_target_open() in place of the usual open.
+// The destination side creates the directory if it is not there yet.
+// The first time the source side opens its directory it builds the file
+// table and sets the number of ops of a pass to the number of requests.
+//
+// Return values: 0 is good, -1 is bad
+//
+int32_t
+xdd_e2e_files_open(target_data_t *tdp) {
+	xdd_e2e_file_table_t	*ftp;
+
+
+	if (tdp->td_target_options & TO_E2E_ZEROCOPY) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_open: Target %d: WARNING: -e2e zerocopy does not apply to -e2e files and is ignored\n",
+			xgp->progname,
+			tdp->td_target_number);
+		tdp->td_target_options &= ~TO_E2E_ZEROCOPY;
+	}
+
+	if ((tdp->td_target_options & TO_E2E_DESTINATION) &&
+		(mkdir(tdp->td_target_full_pathname, 0777) < 0) && (errno != EEXIST)) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_open: Target %d: ERROR: Cannot create directory %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			strerror(errno));
+		return(-1);
+	}
+	tdp->td_file_desc = open(tdp->td_target_full_pathname, O_RDONLY|O_DIRECTORY);
+	if (tdp->td_file_desc < 0) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_open: Target %d: ERROR: Cannot open directory %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			tdp->td_target_full_pathname,
+			strerror(errno));
+		return(-1);
+	}
+	tdp->td_target_options |= TO_REGULARFILE;
+
+	if (tdp->td_e2ep->e2e_file_tablep)
+		return(0);
+
+	ftp = calloc(1, sizeof(xdd_e2e_file_table_t));
+	if (ftp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_open: Target %d: ERROR: Cannot allocate memory for the file table\n",
+			xgp->progname,
+			tdp->td_target_number);
+		return(-1);
+	}
+	pthread_mutex_init(&ftp->ft_mutex, NULL);
+	tdp->td_e2ep->e2e_file_tablep = ftp;
+	if (!(tdp->td_target_options & TO_E2E_SOURCE))
+		return(0);
+	if (tdp->td_e2ep->e2e_file_list_name) {
+		if (xdd_e2e_files_read_list(tdp, ftp) < 0)
+			return(-1);
+	} else if (xdd_e2e_files_walk(tdp, ftp, "") < 0)
+		return(-1);
+	if (xdd_e2e_files_plan(tdp, ftp) < 0)
+		return(-1);
+
+	// Each op sends one request
+	tdp->td_target_ops = ftp->ft_request_count;
+	tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)ftp->ft_request_count * tdp->td_xfer_size;
+
+	if (ftp->ft_skipped_count)
+		fprintf(xgp->errout,"%s: xdd_e2e_files_open: Target %d: WARNING: Skipping %lld entries of %s that are neither regular files nor directories\n",
+			xgp->progname,
+			tdp->td_target_number,
+			(long long int)ftp->ft_skipped_count,
+			tdp->td_target_full_pathname);
+	fprintf(xgp->output,"%s: xdd_e2e_files_open: Target %d: INFO: Sending %lld bytes in %lld files and %lld directories as %lld requests\n",
+		xgp->progname,
+		tdp->td_target_number,
+		(long long int)ftp->ft_bytes,
+		(long long int)ftp->ft_file_count,
+		(long long int)ftp->ft_directory_count,
+		(long long int)ftp->ft_request_count);
+	return(0);
+
+} // End of xdd_e2e_files_open()
+
+/*----------------------------------------------------------------------------*/
+// xdd_e2e_files_read() - Fill the I/O buffer with the file records of the
+// request that belongs to the op number of this task. The transfer size of
+// the task is set to the number of bytes that the records take up, which
+// is what the E2E header tells the destination side.
+// This is called by xdd_io_for_os() on the source side in place of pread().
+//
+// Return values: the number of bytes in the buffer, or -1 if there was an error
+//
+ssize_t
+xdd_e2e_files_read(worker_data_t *wdp) {
+	target_data_t			*tdp;
+	xdd_e2e_file_table_t	*ftp;
+	xdd_e2e_file_entry_t	*fep;
+	xdd_e2e_file_header_t	*fhp;
+	unsigned char			*bufp;
+	unsigned char			*datap;
+	int64_t					request;
+	int64_t					entry, offset;
+	int64_t					end_entry, end_offset;
+	int64_t					used;
+	int64_t					length;
+	int64_t					done;
+	ssize_t					status;
+	int						fd;
+
+
+	tdp = wdp->wd_tdp;
+	ftp = tdp->td_e2ep->e2e_file_tablep;
+	request = wdp->wd_task.task_op_number;
+	if ((ftp == NULL) || (request < 0) || (request >= ftp->ft_request_count)) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_read: Target %d: Worker Thread %d: ERROR: There is no request for op number %lld\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			(long long int)request);
+		errno = EINVAL;
+		return(-1);
+	}
+	entry = ftp->ft_requests[request].fr_entry;
+	offset = ftp->ft_requests[request].fr_offset;
+	if (request + 1 < ftp->ft_request_count) {
+		end_entry = ftp->ft_requests[request+1].fr_entry;
+		end_offset = ftp->ft_requests[request+1].fr_offset;
+	} else {
+		end_entry = ftp->ft_entry_count;
+		end_offset = 0;
+	}
+
+	bufp = (unsigned char *)wdp->wd_task.task_datap;
+	used = 0;
+	while ((entry < end_entry) || ((entry == end_entry) && (offset < end_offset))) {
+		fep = &ftp->ft_entries[entry];
+		length = xdd_e2e_files_record_length(fep, offset, used, tdp->td_xfer_size);
+		if (length < 0)
+			break;
+		fhp = (xdd_e2e_file_header_t *)(bufp + used);
+		fhp->e2efh_magic = XDD_E2E_FILE_RECORD;
+		fhp->e2efh_path_length = fep->fe_path_length;
+		fhp->e2efh_file_size = fep->fe_size;
+		fhp->e2efh_offset = offset;
+		fhp->e2efh_data_length = length;
+		fhp->e2efh_mode = fep->fe_mode;
+		fhp->e2efh_reserved = 0;
+		used += sizeof(xdd_e2e_file_header_t);
+		memset(bufp + used, 0, XDD_E2E_FILE_ALIGN(fep->fe_path_length));
+		memcpy(bufp + used, fep->fe_path, fep->fe_path_length);
+		used += XDD_E2E_FILE_ALIGN(fep->fe_path_length);
+
+		datap = bufp + used;
+		if (length > 0) {
+			fd = openat(tdp->td_file_desc, fep->fe_path, O_RDONLY);
+			if (fd < 0) {
+				fprintf(xgp->errout,"%s: xdd_e2e_files_read: Target %d: Worker Thread %d: ERROR: Cannot open %s: %s\n",
+					xgp->progname,
+					tdp->td_target_number,
+					wdp->wd_worker_number,
+					fep->fe_path,
+					strerror(errno));
+				return(-1);
+			}
+			for (done = 0; done < length; done += status) {
+				status = pread(fd, datap + done, length - done, (off_t)(offset + done));
+				if ((status < 0) && (errno == EINTR)) {
+					status = 0;
+					continue;
+				}
+				if (status <= 0) {
+					if (status == 0)
+						errno = EIO;
+					fprintf(xgp->errout,"%s: xdd_e2e_files_read: Target %d: Worker Thread %d: ERROR: Cannot read %lld bytes at offset %lld of %s: %s\n",
+						xgp->progname,
+						tdp->td_target_number,
+						wdp->wd_worker_number,
+						(long long int)(length - done),
+						(long long int)(offset + done),
+						fep->fe_path,
+						(status == 0) ? "the file is shorter than when the copy started" : strerror(errno));
+					close(fd);
+					return(-1);
+				}
+			}
+			close(fd);
+		}
+		memset(datap + length, 0, XDD_E2E_FILE_ALIGN(length) - length);
+		used += XDD_E2E_FILE_ALIGN(length);
+
+		offset += length;
+		if (offset >= fep->fe_size) {
+			entry++;
+			offset = 0;
+		}
+	}
+
+	wdp->wd_task.task_xfer_size = used;
+	return(used);
+
+} // End of xdd_e2e_files_read()
+
+/*----------------------------------------------------------------------------*/
+// Create the directories above "path" in the target directory
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_make_parents(int dir_fd, char *path) {
+	char	*cp;
+	int		status;
+
+
+	for (cp = strchr(path, '/'); cp; cp = strchr(cp + 1, '/')) {
+		*cp = '\0';
+		status = mkdirat(dir_fd, path, 0777);
+		*cp = '/';
+		if ((status < 0) && (errno != EEXIST))
+			return(-1);
+	}
+	return(0);
+
+} // End of xdd_e2e_files_make_parents()
+
+/*----------------------------------------------------------------------------*/
+// Remember a file or directory whose mode is set by
+// xdd_e2e_files_restore_modes() once the copy is done
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_add_mode(target_data_t *tdp, char *path, mode_t mode) {
+	xdd_e2e_file_table_t	*ftp;
+	struct stat				statbuf;
+	int32_t					status;
+
+
+	ftp = tdp->td_e2ep->e2e_file_tablep;
+	memset(&statbuf, 0, sizeof(statbuf));
+	statbuf.st_mode = mode;
+	pthread_mutex_lock(&ftp->ft_mutex);
+	status = xdd_e2e_files_add_entry(tdp, ftp, path, &statbuf);
+	pthread_mutex_unlock(&ftp->ft_mutex);
+	return(status);
+
+} // End of xdd_e2e_files_add_mode()
+
+/*----------------------------------------------------------------------------*/
+// Write one file record to the target directory.
+// Files and directories are created with owner write permission so that
+// every record of a file can be written no matter what its mode is. Their
+// own mode is set when the copy is done. Directories are always remembered
+// because the parents of a file may be made before their own record shows up.
+// Return values: 0 is good, -1 is bad
+static int32_t
+xdd_e2e_files_write_record(worker_data_t *wdp, xdd_e2e_file_header_t *fhp, char *path, unsigned char *datap) {
+	target_data_t	*tdp;
+	struct stat		statbuf;
+	mode_t			mode;
+	int64_t			done;
+	ssize_t			status;
+	int				fd;
+
+
+	tdp = wdp->wd_tdp;
+	if (S_ISDIR(fhp->e2efh_mode)) {
+		mode = (fhp->e2efh_mode & 07777) | S_IRWXU;
+		status = mkdirat(tdp->td_file_desc, path, mode);
+		if ((status < 0) && (errno == ENOENT) && (xdd_e2e_files_make_parents(tdp->td_file_desc, path) == 0))
+			status = mkdirat(tdp->td_file_desc, path, mode);
+		// A directory left by an earlier pass may not be writable any more
+		if ((status < 0) && (errno == EEXIST))
+			status = fchmodat(tdp->td_file_desc, path, mode, 0);
+		if (status < 0) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_write_record: Target %d: Worker Thread %d: ERROR: Cannot create directory %s: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				path,
+				strerror(errno));
+			return(-1);
+		}
+		return(xdd_e2e_files_add_mode(tdp, path, fhp->e2efh_mode));
+	}
+
+	mode = (fhp->e2efh_mode & 07777) | S_IWUSR;
+	fd = openat(tdp->td_file_desc, path, O_WRONLY|O_CREAT, mode);
+	if ((fd < 0) && (errno == ENOENT) && (xdd_e2e_files_make_parents(tdp->td_file_desc, path) == 0))
+		fd = openat(tdp->td_file_desc, path, O_WRONLY|O_CREAT, mode);
+	// A read-only file left by an earlier pass
+	if ((fd < 0) && (errno == EACCES) && (fchmodat(tdp->td_file_desc, path, mode, 0) == 0))
+		fd = openat(tdp->td_file_desc, path, O_WRONLY|O_CREAT, mode);
+	if (fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_write_record: Target %d: Worker Thread %d: ERROR: Cannot open %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			path,
+			strerror(errno));
+		return(-1);
+	}
+	// The first record of a file sets its size; the other records may land in any order
+	if ((fhp->e2efh_offset == 0) && (ftruncate(fd, (off_t)fhp->e2efh_file_size) < 0)) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_write_record: Target %d: Worker Thread %d: ERROR: Cannot set the size of %s to %lld bytes: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			path,
+			(long long int)fhp->e2efh_file_size,
+			strerror(errno));
+		close(fd);
+		return(-1);
+	}
+	// Each file is looked at once, with its first record, and remembered if
+	// its mode is not right yet (owner write permission, umask, earlier pass)
+	if ((fhp->e2efh_offset == 0) && ((fstat(fd, &statbuf) < 0) || ((statbuf.st_mode & 07777) != (fhp->e2efh_mode & 07777))) &&
+		(xdd_e2e_files_add_mode(tdp, path, fhp->e2efh_mode) < 0)) {
+		close(fd);
+		return(-1);
+	}
+	for (done = 0; done < fhp->e2efh_data_length; done += status) {
+		status = pwrite(fd, datap + done, fhp->e2efh_data_length - done, (off_t)(fhp->e2efh_offset + done));
+		if ((status < 0) && (errno == EINTR)) {
+			status = 0;
+			continue;
+		}
+		if (status <= 0) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_write_record: Target %d: Worker Thread %d: ERROR: Cannot write %lld bytes at offset %lld of %s: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				(long long int)(fhp->e2efh_data_length - done),
+				(long long int)(fhp->e2efh_offset + done),
+				path,
+				strerror(errno));
+			close(fd);
+			return(-1);
+		}
+	}
+	if (close(fd) < 0) {
+		fprintf(xgp->errout,"%s: xdd_e2e_files_write_record: Target %d: Worker Thread %d: ERROR: Cannot close %s: %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			path,
+			strerror(errno));
+		return(-1);
+	}
+	return(0);
+
+} // End of xdd_e2e_files_write_record()
+
+/*----------------------------------------------------------------------------*/
+// xdd_e2e_files_write() - Write each file record of the message in the
+// I/O buffer to its file in the target directory.
+// This is called by xdd_io_for_os() on the destination side in place of
+// pwrite().
+//
+// Return values: the number of bytes in the message, or -1 if there was an error
+//
+ssize_t
+xdd_e2e_files_write(worker_data_t *wdp) {
+	target_data_t			*tdp;
+	xdd_e2e_file_header_t	*fhp;
+	unsigned char			*bufp;
+	char					path[PATH_MAX];
+	int64_t					length;
+	int64_t					used;
+	int64_t					record_length;
+
+
+	tdp = wdp->wd_tdp;
+	bufp = (unsigned char *)wdp->wd_task.task_datap;
+	length = wdp->wd_task.task_xfer_size;
+	for (used = 0; used < length; used += record_length) {
+		fhp = (xdd_e2e_file_header_t *)(bufp + used);
+		record_length = -1;
+		if ((length - used >= (int64_t)sizeof(xdd_e2e_file_header_t)) &&
+			(fhp->e2efh_magic == XDD_E2E_FILE_RECORD) &&
+			(fhp->e2efh_path_length > 0) && (fhp->e2efh_path_length < sizeof(path)) &&
+			(fhp->e2efh_offset >= 0) && (fhp->e2efh_data_length >= 0))
+			record_length = sizeof(xdd_e2e_file_header_t) + XDD_E2E_FILE_ALIGN(fhp->e2efh_path_length) + XDD_E2E_FILE_ALIGN(fhp->e2efh_data_length);
+		if ((record_length < 0) || (record_length > length - used)) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_write: Target %d: Worker Thread %d: ERROR: Bad file record at byte %lld of the message for op number %lld\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				(long long int)used,
+				(long long int)wdp->wd_task.task_op_number);
+			errno = EPROTO;
+			return(-1);
+		}
+		memcpy(path, bufp + used + sizeof(xdd_e2e_file_header_t), fhp->e2efh_path_length);
+		path[fhp->e2efh_path_length] = '\0';
+		if (!xdd_e2e_files_path_is_safe(path)) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_write: Target %d: Worker Thread %d: ERROR: Path %s of a file record is not relative to the target directory\n",
+				xgp->progname,
+				tdp->td_target_number,
+				wdp->wd_worker_number,
+				path);
+			errno = EPROTO;
+			return(-1);
+		}
+		if (xdd_e2e_files_write_record(wdp, fhp, path,
+				bufp + used + sizeof(xdd_e2e_file_header_t) + XDD_E2E_FILE_ALIGN(fhp->e2efh_path_length)) < 0)
+			return(-1);
+	}
+	return(length);
+
+} // End of xdd_e2e_files_write()
+
+/*----------------------------------------------------------------------------*/
+// Sort the file entries so that the contents of a directory come before it
+static int
+xdd_e2e_files_deepest_first(const void *a, const void *b) {
+
+	return(strcmp(((const xdd_e2e_file_entry_t *)b)->fe_path, ((const xdd_e2e_file_entry_t *)a)->fe_path));
+
+} // End of xdd_e2e_files_deepest_first()
+
+/*----------------------------------------------------------------------------*/
+// xdd_e2e_files_restore_modes() - Give the files and directories that were
+// written with owner write permission the mode they have on the source side.
+// The entries go from the deepest up so that no directory loses its owner
+// permissions before everything in it is done. The list is emptied so that
+// the next pass starts over.
+// This is called by the Target Thread on the destination side once all the
+// Worker Threads are done with the pass.
+//
+// Return values: 0 is good, -1 if any of the modes could not be set
+//
+int32_t
+xdd_e2e_files_restore_modes(target_data_t *tdp) {
+	xdd_e2e_file_table_t	*ftp;
+	xdd_e2e_file_entry_t	*fep;
+	int32_t					status;
+	int64_t					i;
+
+
+	ftp = tdp->td_e2ep->e2e_file_tablep;
+	if (ftp == NULL)
+		return(0);
+	status = 0;
+	qsort(ftp->ft_entries, ftp->ft_entry_count, sizeof(xdd_e2e_file_entry_t), xdd_e2e_files_deepest_first);
+	for (i = 0; i < ftp->ft_entry_count; i++) {
+		fep = &ftp->ft_entries[i];
+		if (fchmodat(tdp->td_file_desc, fep->fe_path, fep->fe_mode & 07777, 0) < 0) {
+			fprintf(xgp->errout,"%s: xdd_e2e_files_restore_modes: Target %d: ERROR: Cannot set the mode of %s to %04o: %s\n",
+				xgp->progname,
+				tdp->td_target_number,
+				fep->fe_path,
+				fep->fe_mode & 07777,
+				strerror(errno));
+			status = -1;
+		}
+		free(fep->fe_path);
+	}
+	ftp->ft_entry_count = 0;
+	ftp->ft_file_count = 0;
+	ftp->ft_directory_count = 0;
+	return(status);
+
+} // End of xdd_e2e_files_restore_modes()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
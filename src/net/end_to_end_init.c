@@ -50,6 +50,9 @@ xdd_e2e_target_init(target_data_t *tdp) {
 		rp = tdp->td_restartp;
 		rp->last_committed_byte_offset = rp->byte_offset;
 		rp->last_committed_length = 0;
+		// Load the extents of an earlier copy from the restart journal
+		if ((rp->journal_filename) && (xdd_restart_journal_open(tdp) < 0))
+			return(-1);
 	}
 
 	return(0);
@@ -171,11 +174,81 @@ xdd_e2e_src_init(worker_data_t *wdp) {
 	e2ep->e2e_hdrp->e2eh_byte_offset = 0;
 	e2ep->e2e_hdrp->e2eh_data_length = 0;
 
+	// Set up the pipe for zero copy transfers if requested
+	xdd_e2e_zerocopy_init(wdp);
 
 	return(0);
 
 } /* end of xdd_e2e_src_init() */
 
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_zerocopy_init() - set up zero copy for either side
+ * With zero copy the data never passes through the I/O buffer. On the
+ * source side it is spliced from the target file into a pipe by
+ * xdd_io_for_os() and from the pipe into the socket by xdd_e2e_src_send().
+ * On the destination side it is spliced from the socket into the pipe by
+ * xdd_e2e_dest_receive_data() and from the pipe into the target file by
+ * xdd_io_for_os(). The pipe has to hold a whole request. If zero copy cannot be used
+ * for this target then worker thread 0 says why and all of them use
+ * pread() and sendto() as usual. With -xni the request is passed to the
+ * XNI TCP transport by xint_e2e_xni_init() instead.
+ */
+void
+xdd_e2e_zerocopy_init(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_e2e_t		*e2ep;		// Pointer to the E2E data struct
+	char			*reason;	// Why zero copy is not used
+#if defined(LINUX) && defined(F_SETPIPE_SZ)
+	int				pipe_size;	// Capacity of the pipe
+#endif
+
+
+	tdp = wdp->wd_tdp;
+	e2ep = wdp->wd_e2ep;
+	e2ep->e2e_pipe[0] = -1;
+	e2ep->e2e_pipe[1] = -1;
+	e2ep->e2e_pipe_size = 0;
+	e2ep->e2e_pipe_bytes = 0;
+	if (!(tdp->td_target_options & TO_E2E_ZEROCOPY))
+		return;
+
+#if defined(LINUX) && defined(F_SETPIPE_SZ)
+	reason = NULL;
+	if (PLAN_ENABLE_XNI & tdp->td_planp->plan_options) {
+		// The XNI TCP transport sends with MSG_ZEROCOPY instead
+		if (tdp->td_target_options & TO_E2E_DESTINATION)
+			reason = "-xni only uses zero copy on the source side";
+	} else if (tdp->td_target_options & (TO_DIO | TO_SGIO | TO_NULL_TARGET)) {
+		reason = "the target does not use buffered I/O";
+	} else if (tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
+		reason = "the data is verified";
+	} else if (pipe(e2ep->e2e_pipe) < 0) {
+		reason = "a pipe could not be created";
+		e2ep->e2e_pipe[0] = -1;
+		e2ep->e2e_pipe[1] = -1;
+	} else {
+		pipe_size = fcntl(e2ep->e2e_pipe[1], F_SETPIPE_SZ, (int)tdp->td_xfer_size);
+		if (pipe_size < (int)tdp->td_xfer_size) {
+			reason = "the request size is larger than the largest pipe - see /proc/sys/fs/pipe-max-size";
+			close(e2ep->e2e_pipe[0]);
+			close(e2ep->e2e_pipe[1]);
+			e2ep->e2e_pipe[0] = -1;
+			e2ep->e2e_pipe[1] = -1;
+		} else e2ep->e2e_pipe_size = pipe_size;
+	}
+#else
+	reason = "splice() is not supported on this OS";
+#endif
+	if ((reason) && (wdp->wd_worker_number == 0)) {
+		fprintf(xgp->errout,"%s: xdd_e2e_zerocopy_init: Target %d: WARNING: End-to-End zero copy is not used because %s\n",
+			xgp->progname,
+			tdp->td_target_number,
+			reason);
+		fflush(xgp->errout);
+	}
+
+} /* end of xdd_e2e_zerocopy_init() */
+
 /*----------------------------------------------------------------------*/
 /* xdd_e2e_setup_src_socket() - set up the source side
  * This subroutine is called by xdd_e2e_src_init() and is passed a
@@ -299,6 +372,9 @@ xdd_e2e_dest_init(worker_data_t *wdp) {
 	wdp->wd_e2ep->e2e_msg_recv = 0;
 	wdp->wd_e2ep->e2e_msg_sequence_number = 0;
 
+	// Set up the pipe for zero copy transfers if requested
+	xdd_e2e_zerocopy_init(wdp);
+
 	return(0);
 
 } /* end of xdd_e2e_dest_init() */
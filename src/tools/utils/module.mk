@@ -9,7 +9,7 @@ TS_EXE_SRC := $(DIR)/global_time.c $(DIR)/timeserver.c
 
 GETTIME_EXE_SRC := $(DIR)/global_clock.c $(DIR)/global_time.c $(DIR)/gettime.c
 
-READ_TSDUMPS_EXE_SRC := $(DIR)/read_tsdumps.c $(DIR)/matchadd_kernel_events.c
+READ_TSDUMPS_EXE_SRC := $(DIR)/read_tsdumps.c $(DIR)/matchadd_kernel_events.c src/common/ts_columnar.c
 
 GETHOSTIP_EXE_SRC := $(DIR)/gethostip.c
 
@@ -16,6 +16,11 @@
 #include <stddef.h>
 #include <string.h>
 #include <libgen.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define XDDMAIN
 #include <xint.h>
@@ -28,7 +33,10 @@
 #define MIN(a,b) (a < b ? a : b)
 #endif
 /* converts xdd nclk time to seconds, given p (nclk value) */
-#define nclk2sec(p) ((double)p/1.0e9)
+#define nclk2sec(p) ((double)(p)/1.0e9)
+/* converts a source or destination nclk time to seconds since the start of the transfer */
+#define src_sec(p) nclk2sec((int64_t)((p) - src_start_norm))
+#define dst_sec(p) nclk2sec((int64_t)((p) - dst_start_norm))
 /* Bytes Per Unit... don't set to 0.  1000000 is MB/s */
 #define BPU (1000000.0)
 
@@ -48,10 +56,11 @@
 
 /* magic number to make sure we can read the file */
 #define BIN_MAGIC_NUMBER 0xDEADBEEF
+/* magic number of each segment of a file written with -ts stream */
+#define BIN_STREAM_MAGIC_NUMBER 0xDEADBEEE
 
-#define MAX_WORKER_THREADS 1024
-int thread_id_src[MAX_WORKER_THREADS];
-int thread_id_dst[MAX_WORKER_THREADS];
+int *thread_id_src = NULL;
+int *thread_id_dst = NULL;
 int total_threads_src = 0;
 int total_threads_dst = 0;
 double op_mix = 0.0;
@@ -65,19 +74,75 @@ char *srcfilename, *dstfilename;
 
 int kernel_trace = 0;
 /* number of seconds in the sliding window */
-int window_size;
-
-/* normalize timestamps */
+double window_size;
+/* number of threads that sort and analyze the timestamps */
+int nthreads;
+/* if range_end > 0 only the ops that end this many seconds from the start of a dump are used */
+double range_start = 0.0, range_end = 0.0;
+
+/* a sort key and the timestamp entry it came from - sorting these
+ * touches much less memory than sorting pointers by what they point at */
+typedef struct tte_key {
+	nclk_t        key;
+	xdd_ts_tte_t *tte;
+} tte_key_t;
+
+/* one piece of work for a thread of the parallel sort: either sort
+ * keys[low..high) or merge the runs a[0..na) and b[0..nb) into out */
+typedef struct sort_work {
+	tte_key_t *keys;
+	int64_t    low, high;
+	tte_key_t *a, *b, *out;
+	int64_t    na, nb;
+} sort_work_t;
+
+/* the ops of one sorted timestamp list that a thread summarizes
+ * by window - a thread always gets whole windows */
+typedef struct window_work {
+	xdd_ts_tte_t **op;        /* entries sorted by ending time */
+	int64_t        low, high; /* entries for this thread */
+	int            disk;      /* 1 for the disk times, 0 for the network times */
+	nclk_t         start_norm;/* start of the transfer on this side */
+	char          *label;     /* name of the op in the output */
+	char          *buf;       /* the output lines of this thread */
+	size_t         bufsize;
+} window_work_t;
+
+/* the blocks of a columnar (-ts compact) dump that one thread decodes */
+typedef struct decode_work {
+	char            *base;      /* the mapped file */
+	size_t           size;      /* bytes in the file */
+	xdd_tsc_index_t *index;     /* the blocks */
+	int64_t          low, high; /* blocks for this thread */
+	xdd_ts_tte_t    *tte;       /* where the entries of block 'low' go */
+	int64_t          bad;       /* first block that could not be decoded, -1 if none */
+} decode_work_t;
+
+/* what a window needs to know about one op */
+typedef struct window_op {
+	int32_t worker;
+	int32_t bytes;
+	nclk_t  latency;
+} window_op_t;
+
+/* get the time that all other times are relative to */
 void normalize_time(xdd_ts_header_t *src, nclk_t *start_norm);
-/* custom quick sort for the xdd_ts_tte_t array */
-void tte_qsort(xdd_ts_tte_t **list, size_t key_offset, int64_t left, int64_t right);
+/* run count pieces of work, each in its own thread */
+void run_parallel(void *(*func)(void *), void *work, size_t work_size, int count);
 /* sorts the timestamp entries by completion time */
 void sort_by_time(xdd_ts_header_t *tsdata, size_t op_offset, xdd_ts_tte_t ***op_sorted);
 /* write all the outfiles */
 void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **read_op,
 	xdd_ts_tte_t **send_op, xdd_ts_tte_t **recv_op, xdd_ts_tte_t **write_op);
+/* write the bandwidth and latency of each window for each worker thread */
+void write_windows(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **read_op,
+	xdd_ts_tte_t **send_op, xdd_ts_tte_t **recv_op, xdd_ts_tte_t **write_op);
 /* read, check, and store the src and dst file data */
 int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size);
+/* decode a columnar (-ts compact) file into a structure */
+int xdd_read_columnar(char *filename, void *base, size_t size, xdd_ts_header_t **tsdata, size_t *tsdata_size);
+/* keep only the entries that end in the -r range */
+void select_range(xdd_ts_header_t *tsdata, nclk_t first);
 /* Write an XDD binary timestamp structure to file */
 int xdd_writefile(char *filename, xdd_ts_header_t *tsdata, size_t tsdata_size);
 /* parse command line options */
@@ -85,7 +150,7 @@ int getoptions(int argc, char **argv);
 /* print command line usage */
 void printusage(char *progname);
 /* get total threads, thread pids, operation mix (%read,%write) */
-void xdd_getthreads(xdd_ts_header_t *tsdata, int *total_threads, int thread_id[], double *op_mix);
+void xdd_getthreads(xdd_ts_header_t *tsdata, int *total_threads, int **thread_id, double *op_mix);
 
 int
 matchadd_kernel_events(int issource, int nthreads, int thread_id[], char *filespec, xdd_ts_header_t *xdd_data);
@@ -94,7 +159,7 @@ matchadd_kernel_events(int issource, int nthreads, int thread_id[], char *filesp
 int main(int argc, char **argv) {
 
 	int fn,argnum,retval;
-        size_t tsdata_size;
+        size_t tsdata_size, src_size = 0, dst_size = 0;
         char *iotrace_data_dir, *current_work_dir;
 	/* tsdumps for the source and destination sides */
 	xdd_ts_header_t *src = NULL;
@@ -120,11 +185,13 @@ int main(int argc, char **argv) {
         /* if only 1 file given, then source==read, destination==write */
         if (READ_OP(tsdata->tsh_tte[0].tte_op_type)) { 
            src = tsdata;
+           src_size = tsdata_size;
            srcfilename = argv[fn];
 	}
         else
         if (WRITE_OP(tsdata->tsh_tte[0].tte_op_type)){
 	  dst = tsdata;
+	  dst_size = tsdata_size;
           dstfilename = argv[fn];
 	}
         else {
@@ -147,6 +214,7 @@ int main(int argc, char **argv) {
               exit(1);
             }
             src = tsdata;
+            src_size = tsdata_size;
             srcfilename = argv[fn+1];
           }
           else 
@@ -157,6 +225,7 @@ int main(int argc, char **argv) {
               exit(1);
             }
             dst = tsdata;
+            dst_size = tsdata_size;
             dstfilename = argv[fn+1];
           } 
           else {
@@ -172,8 +241,8 @@ int main(int argc, char **argv) {
         }
 
         /* get total threads */
-        if (src != NULL) xdd_getthreads(src,&total_threads_src, thread_id_src, &op_mix);
-        if (dst != NULL) xdd_getthreads(dst,&total_threads_dst, thread_id_dst, &op_mix);
+        if (src != NULL) xdd_getthreads(src,&total_threads_src, &thread_id_src, &op_mix);
+        if (dst != NULL) xdd_getthreads(dst,&total_threads_dst, &thread_id_dst, &op_mix);
         /* If e2e, better have same number of threads. */
         if (total_threads_src > 0 && total_threads_dst > 0 && total_threads_src != total_threads_dst) {
           fprintf(stderr,"Warning: source (%d) and destination (%d) files don't have the same number of I/O threads.\n",
@@ -211,7 +280,7 @@ int main(int argc, char **argv) {
             matchadd_kernel_events(0,total_threads_src,thread_id_src,kernfilename,src);
             /* write out the src and dst data structs that now contain kernel data */
             sprintf(kernfilename,"%s/%sk", current_work_dir, srcfilename);
-            retval = xdd_writefile(kernfilename,src,tsdata_size);
+            retval = xdd_writefile(kernfilename,src,src_size);
             if (retval == 0) {
 		fprintf(stderr,"xdd_writefile() failed to write %s ...exiting.\n",kernfilename);
 		exit(1);
@@ -239,7 +308,7 @@ int main(int argc, char **argv) {
             if (op_mix > 0.0)
             matchadd_kernel_events(1,total_threads_dst,thread_id_dst,kernfilename,dst);
             sprintf(kernfilename,"%s/%sk", current_work_dir, dstfilename);
-            retval = xdd_writefile(kernfilename,dst,tsdata_size);
+            retval = xdd_writefile(kernfilename,dst,dst_size);
             if (retval == 0) {
 		fprintf(stderr,"xdd_writefile() failed to write %s ...exiting.\n",kernfilename);
 		exit(1);
@@ -248,7 +317,7 @@ int main(int argc, char **argv) {
 
         }
 
-	/* get the MIN timestamp normalize the times */
+	/* get the MIN timestamp that the times are relative to */
 	if (src!=NULL) normalize_time(src,&src_start_norm);
 	if (dst!=NULL) normalize_time(dst,&dst_start_norm);
 
@@ -269,23 +338,26 @@ int main(int argc, char **argv) {
 
 	/* write the outfile(s) */
         write_outfile  (src,dst,read_op,send_op,recv_op,write_op);
+        write_windows  (src,dst,read_op,send_op,recv_op,write_op);
 
 	/* free memory */
 	free(read_op);
 	free(send_op);
 	free(recv_op);
 	free(write_op);
-	free(src);
-	free(dst);
+	if (src != NULL) munmap(src, src_size);
+	if (dst != NULL) munmap(dst, dst_size);
+	free(thread_id_src);
+	free(thread_id_dst);
 
 	return 0;
 }
 /* get total threads, thread ids, operation mix */
 void
-xdd_getthreads(xdd_ts_header_t *tsdata, int *total_threads, int thread_id[], double *op_mix)
+xdd_getthreads(xdd_ts_header_t *tsdata, int *total_threads, int **thread_id, double *op_mix)
 {
     size_t i;
-       int k = -1, tothreads = 0;
+       int w, tothreads = 0;
        uint64_t read_ops = 0, write_ops = 0;
        if (*op_mix > 0.0) {
           fprintf(stderr,"xdd_getthreads: op_mix = %10.4f ..should be 0.0\n",*op_mix);
@@ -294,20 +366,28 @@ xdd_getthreads(xdd_ts_header_t *tsdata, int *total_threads, int thread_id[], dou
         /* how many qthreads are there? */
         for (i = 0; i < tsdata->tsh_tt_size; i++) {
                 tothreads = MAX(tsdata->tsh_tte[i].tte_worker_thread_number,tothreads);
-                if (k < tothreads && k < MAX_WORKER_THREADS)
-                {
-                            k = tothreads;
-                  thread_id[k] = tsdata->tsh_tte[i].tte_thread_id;
-                }
                 read_ops  +=  READ_OP(tsdata->tsh_tte[i].tte_op_type);
                 write_ops += WRITE_OP(tsdata->tsh_tte[i].tte_op_type);
         }
+        /* the system thread id of each qthread */
+        *thread_id = calloc(tothreads + 1, sizeof(int));
+        if (*thread_id == NULL) {
+                fprintf(stderr,"xdd_getthreads: Could not allocate memory for %d thread ids\n",tothreads + 1);
+                exit(1);
+        }
+        for (i = 0; i < tsdata->tsh_tt_size; i++) {
+                w = tsdata->tsh_tte[i].tte_worker_thread_number;
+                if (w >= 0 && (*thread_id)[w] == 0)
+                        (*thread_id)[w] = tsdata->tsh_tte[i].tte_thread_id;
+        }
         *total_threads = tothreads + 1;
         *op_mix        = (read_ops && write_ops) ? (double)read_ops/(double)write_ops : 0.0;
        return;
 }
 
-/* subtract the timestamps by the minimum start times */
+/* get the minimum start time - all times are shown relative to it. The
+ * entries themselves are not changed so their pages of the mapped dump
+ * stay clean and do not have to be copied */
 void normalize_time(xdd_ts_header_t *tsdata, nclk_t *start_norm) {
 	size_t i;
 	nclk_t start;
@@ -324,96 +404,168 @@ void normalize_time(xdd_ts_header_t *tsdata, nclk_t *start_norm) {
 	}
 
         *start_norm = start;
+}
 
-	/* normalize timestamps */
-	for (i=0; i < tsdata->tsh_tt_size; i++) {
-		/* don't subtract from zero */
-		if (EOF_OP(tsdata->tsh_tte[i].tte_op_type) && (tsdata->tsh_tte[i].tte_disk_start == 0))
-			continue;
-		tsdata->tsh_tte[i].tte_disk_start   -= start;
-		tsdata->tsh_tte[i].tte_disk_start_k -= start;
-		tsdata->tsh_tte[i].tte_disk_end     -= start;
-		tsdata->tsh_tte[i].tte_disk_end_k   -= start;
-	}
 
-	/* normalize timestamps */
-	for (i=0; i < tsdata->tsh_tt_size; i++) {
-		/* don't subtract from zero */
-		if (EOF_OP(tsdata->tsh_tte[i].tte_op_type) && (tsdata->tsh_tte[i].tte_net_start == 0))
-			continue;
-		tsdata->tsh_tte[i].tte_net_start    -= start;
-		tsdata->tsh_tte[i].tte_net_start_k  -= start;
-		tsdata->tsh_tte[i].tte_net_end      -= start;
-		tsdata->tsh_tte[i].tte_net_end_k    -= start;
+/* run each piece of work in its own thread and wait for all of them */
+void run_parallel(void *(*func)(void *), void *work, size_t work_size, int count) {
+	pthread_t *threads;
+	int i;
+
+	/* no need for threads to do one thing */
+	if (count == 1) {
+		func(work);
+		return;
 	}
+	threads = malloc(count*sizeof(pthread_t));
+	if (threads == NULL) {
+		fprintf(stderr,"Could not allocate memory for %d threads.\n",count);
+		exit(1);
+	}
+	for (i = 0; i < count; i++) {
+		if (pthread_create(&threads[i], NULL, func, (char *)work + i*work_size) != 0) {
+			fprintf(stderr,"Could not create thread %d of %d.\n",i,count);
+			exit(1);
+		}
+	}
+	for (i = 0; i < count; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
 }
 
+/* compare two sort keys for qsort() */
+static int compare_keys(const void *a, const void *b) {
+	nclk_t ka = ((const tte_key_t *)a)->key;
+	nclk_t kb = ((const tte_key_t *)b)->key;
 
-/* custom quick sort for the xdd_ts_tte_t array */
-void tte_qsort(xdd_ts_tte_t **list, size_t key_offset, int64_t low, int64_t high) {
-	/* NOTE: the pointer arithmetic is intended to take 'key_offset'
-	 * and use it to access either disk_start, disk_end, net_start, or net_end
-	 * in a xdd_ts_tte_t element.  So if you pass a list of (xdd_ts_tte_t *) elements,
-	 * and you want to sort the pointers based on what is in list[i].tte_disk_start,
-	 * pass offsetof(xdd_ts_tte_t,disk_start) as key_offset.  This function is ONLY
-	 * intended to sort by nclk_t timestamps at the moment.  Passing any other
-	 * offset will break stuff. */
-
-	/* get the nclk_t time value (specified by key_offset)
-	 * from the given xdd_ts_tte_t element in the list */
-	#define timevalue(i) ( *((nclk_t *)((char *)list[i] + key_offset)) )
-
-	int64_t i,j;
-	xdd_ts_tte_t *tmp = NULL;
-	nclk_t mid;
-
-	i = low;
-	j = high;
-	/* comparison value */
-	mid = timevalue((low+high)/2);
-
-	/* partition */
-	while (i <= j) {
-		/* find element above and below */
-		while (timevalue(i) < mid) i++;
-		while (timevalue(j) > mid) j--;
-
-		if (i <= j) {
-			/* swap elements */
-			tmp = list[i];
-			list[i] = list[j];
-			list[j] = tmp;
-			i++;
-			j--;
-		}
+	return (ka > kb) - (ka < kb);
+}
+
+/* sort one run of keys */
+static void *sort_run(void *arg) {
+	sort_work_t *w = arg;
+
+	qsort(w->keys + w->low, w->high - w->low, sizeof(tte_key_t), compare_keys);
+	return NULL;
+}
+
+/* merge two sorted runs of keys - the first run wins ties */
+static void *merge_runs(void *arg) {
+	sort_work_t *w = arg;
+	int64_t i = 0, j = 0, k = 0;
+
+	while (i < w->na && j < w->nb) {
+		if (w->b[j].key < w->a[i].key)
+			w->out[k++] = w->b[j++];
+		else	w->out[k++] = w->a[i++];
 	}
+	while (i < w->na) w->out[k++] = w->a[i++];
+	while (j < w->nb) w->out[k++] = w->b[j++];
+	return NULL;
+}
 
-	/* recurse */
-	if (low  < j) tte_qsort(list, key_offset, low,    j);
-	if (high > i) tte_qsort(list, key_offset,   i, high);
+/* how many of the first d merged keys of runs a and b come from a */
+static int64_t merge_split(tte_key_t *a, int64_t na, tte_key_t *b, int64_t nb, int64_t d) {
+	int64_t low, high, mid;
+
+	low  = MAX(0, d - nb);
+	high = MIN(d, na);
+	while (low < high) {
+		mid = (low + high) / 2;
+		if (a[mid].key <= b[d-mid-1].key)
+			low = mid + 1;
+		else	high = mid;
+	}
+	return low;
 }
 
-/* sort timestamp entries by completion time */
+/* sort timestamp entries by completion time
+ *
+ * The time of each entry is copied next to its pointer and the keys are
+ * sorted in nthreads runs at the same time. Then the runs are merged in
+ * pairs until one is left. Each merge is split between the threads so
+ * all nthreads threads are busy in every round, even the last one. */
 void sort_by_time(xdd_ts_header_t *tsdata, size_t op_offset, xdd_ts_tte_t ***op_sorted )
 		                                                         {
-	/* allocate array of pointers to tte structs */
-	xdd_ts_tte_t **op = malloc(tsdata->tsh_tt_size*sizeof(xdd_ts_tte_t *));
-	if (op == NULL) {
-		fprintf(stderr,"Could not allocate enough memory for quick sort.\n");
+	int64_t n = tsdata->tsh_tt_size;
+	int64_t *bounds, i, d0, d1, i0, i1;
+	tte_key_t *keys, *tmp, *swap;
+	sort_work_t *work;
+	int runs, pairs, per, p, s, count;
+
+	/* allocate array of pointers to tte structs and the sort keys */
+	xdd_ts_tte_t **op = malloc(n*sizeof(xdd_ts_tte_t *));
+	keys   = malloc(n*sizeof(tte_key_t));
+	tmp    = malloc(n*sizeof(tte_key_t));
+	bounds = malloc((nthreads+1)*sizeof(int64_t));
+	work   = malloc(2*nthreads*sizeof(sort_work_t));
+	if (op == NULL || keys == NULL || tmp == NULL || bounds == NULL || work == NULL) {
+		fprintf(stderr,"Could not allocate enough memory for sort.\n");
 		exit(1);
 	}
 
-	/* initialize pointers */
-	size_t i;
-	for (i = 0; i < tsdata->tsh_tt_size; i++) {
-		op[i] = &(tsdata->tsh_tte[i]);
+	/* the time value at 'op_offset' (disk_end or net_end) of each entry */
+	for (i = 0; i < n; i++) {
+		keys[i].tte = &(tsdata->tsh_tte[i]);
+		keys[i].key = *((nclk_t *)((char *)keys[i].tte + op_offset));
 	}
 
-	/* sort pointers */
-	tte_qsort(op, op_offset,0, tsdata->tsh_tt_size-1);
+	/* sort a run in each thread */
+	runs = (int)MIN((int64_t)nthreads, n);
+	for (p = 0; p <= runs; p++)
+		bounds[p] = n*p/runs;
+	for (p = 0; p < runs; p++) {
+		work[p].keys = keys;
+		work[p].low  = bounds[p];
+		work[p].high = bounds[p+1];
+	}
+	run_parallel(sort_run, work, sizeof(sort_work_t), runs);
+
+	/* merge pairs of runs until there is one */
+	while (runs > 1) {
+		pairs = (runs + 1) / 2;
+		per   = MAX(1, nthreads / pairs);
+		count = 0;
+		for (p = 0; p < pairs; p++) {
+			tte_key_t *a = keys + bounds[2*p];
+			tte_key_t *b = keys + bounds[MIN(2*p+1, runs)];
+			int64_t na = bounds[MIN(2*p+1, runs)] - bounds[2*p];
+			int64_t nb = bounds[MIN(2*p+2, runs)] - bounds[MIN(2*p+1, runs)];
+
+			/* each thread merges the keys between two split points */
+			for (s = 0; s < per; s++) {
+				d0 = (na+nb)*s/per;
+				d1 = (na+nb)*(s+1)/per;
+				i0 = merge_split(a, na, b, nb, d0);
+				i1 = merge_split(a, na, b, nb, d1);
+				work[count].a   = a + i0;
+				work[count].na  = i1 - i0;
+				work[count].b   = b + (d0 - i0);
+				work[count].nb  = (d1 - i1) - (d0 - i0);
+				work[count].out = tmp + bounds[2*p] + d0;
+				count++;
+			}
+		}
+		run_parallel(merge_runs, work, sizeof(sort_work_t), count);
+
+		/* the merged runs are the runs of the next round */
+		for (p = 0; p < pairs; p++)
+			bounds[p] = bounds[2*p];
+		bounds[pairs] = n;
+		runs = pairs;
+		swap = keys;
+		keys = tmp;
+		tmp  = swap;
+	}
 
 	/* save pointers */
+	for (i = 0; i < n; i++)
+		op[i] = keys[i].tte;
 	*op_sorted = op;
+	free(keys);
+	free(tmp);
+	free(bounds);
+	free(work);
 }
 /* write the outfile */
 void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **read_op,
@@ -422,6 +574,9 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
     int i;
 	int64_t   k, numts_entries;
 	float cutoff;
+	/* bytes of the ops in the window of each operation and the first of them */
+	int64_t win_bytes[4] = {0, 0, 0, 0};
+	int64_t win_low[4] = {0, 0, 0, 0};
 	/* variables for the file writing loop below */
 	FILE *outfile;
 	/* bandwidths for each window in time */
@@ -505,11 +660,14 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
                 if (read_op != NULL) {
 		  /* read disk */
                  if (read_op[i]->tte_disk_end > 0) {
-                  cutoff = MAX( nclk2sec(read_op[i]->tte_disk_end)-window_size, 0.0);
-                  for (k = i; (k >= 0) && ( nclk2sec(read_op[k]->tte_disk_end) > cutoff); k--)
-			op_mbs [0] += (double)read_op[k]->tte_disk_xfer_size;
-			op_mbs [0]  = op_mbs[0] / MIN((double)window_size,(double)nclk2sec(read_op[i]->tte_disk_end)) / BPU;
-			op_time[0]  = nclk2sec(read_op[i]->tte_disk_end);
+                  /* slide the window up to this op */
+                  cutoff = MAX( src_sec(read_op[i]->tte_disk_end)-window_size, 0.0);
+                  win_bytes[0] += read_op[i]->tte_disk_xfer_size;
+                  for (; win_low[0] < i && (read_op[win_low[0]]->tte_disk_end == 0 ||
+                         src_sec(read_op[win_low[0]]->tte_disk_end) <= cutoff); win_low[0]++)
+			win_bytes[0] -= (read_op[win_low[0]]->tte_disk_end == 0) ? 0 : read_op[win_low[0]]->tte_disk_xfer_size;
+			op_mbs [0]  = (double)win_bytes[0] / MIN((double)window_size,(double)src_sec(read_op[i]->tte_disk_end)) / BPU;
+			op_time[0]  = src_sec(read_op[i]->tte_disk_end);
 			max_xfer = MAX(max_xfer,read_op[i]->tte_disk_xfer_size);
                   if (kernel_trace) {
 			op_dks [0]  = read_op[i]->tte_disk_start_k  - read_op[i]->tte_disk_start;
@@ -520,11 +678,14 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
                 if (send_op != NULL) {
 		/* send net */
                  if (send_op[i]->tte_net_end > 0) {
-                  cutoff = MAX( nclk2sec(send_op[i]->tte_net_end)-window_size ,0.0);
-                  for (k = i; (k >= 0) && ( nclk2sec(send_op[k]->tte_net_end) > cutoff); k--)
-			op_mbs [1] += (double)send_op[k]->tte_net_xfer_size;
-			op_mbs [1]  = op_mbs[1] / MIN((double)window_size,(double)nclk2sec(send_op[i]->tte_net_end)) / BPU;
-			op_time[1]  = nclk2sec(send_op[i]->tte_net_end);
+                  /* slide the window up to this op */
+                  cutoff = MAX( src_sec(send_op[i]->tte_net_end)-window_size, 0.0);
+                  win_bytes[1] += send_op[i]->tte_net_xfer_size;
+                  for (; win_low[1] < i && (send_op[win_low[1]]->tte_net_end == 0 ||
+                         src_sec(send_op[win_low[1]]->tte_net_end) <= cutoff); win_low[1]++)
+			win_bytes[1] -= (send_op[win_low[1]]->tte_net_end == 0) ? 0 : send_op[win_low[1]]->tte_net_xfer_size;
+			op_mbs [1]  = (double)win_bytes[1] / MIN((double)window_size,(double)src_sec(send_op[i]->tte_net_end)) / BPU;
+			op_time[1]  = src_sec(send_op[i]->tte_net_end);
 			max_xfer = MAX(max_xfer,send_op[i]->tte_net_xfer_size);
                   if (kernel_trace) {
 			op_dks [1]  = send_op[i]->tte_net_start_k   - send_op[i]->tte_net_start;
@@ -535,11 +696,14 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
                 if (recv_op != NULL) {
 		/* recv net */
                  if (recv_op[i]->tte_net_end > 0) {
-                  cutoff = MAX( nclk2sec(recv_op[i]->tte_net_end)-window_size, 0.0);
-                  for (k = i; (k >= 0) && ( nclk2sec(recv_op[k]->tte_net_end) > cutoff); k--)
-			op_mbs [2] += (double)recv_op[k]->tte_net_xfer_size;
-			op_mbs [2]  = op_mbs[2] / MIN((double)window_size,(double)nclk2sec(recv_op[i]->tte_net_end)) / BPU;
-			op_time[2]  = nclk2sec(recv_op[i]->tte_net_end);
+                  /* slide the window up to this op */
+                  cutoff = MAX( dst_sec(recv_op[i]->tte_net_end)-window_size, 0.0);
+                  win_bytes[2] += recv_op[i]->tte_net_xfer_size;
+                  for (; win_low[2] < i && (recv_op[win_low[2]]->tte_net_end == 0 ||
+                         dst_sec(recv_op[win_low[2]]->tte_net_end) <= cutoff); win_low[2]++)
+			win_bytes[2] -= (recv_op[win_low[2]]->tte_net_end == 0) ? 0 : recv_op[win_low[2]]->tte_net_xfer_size;
+			op_mbs [2]  = (double)win_bytes[2] / MIN((double)window_size,(double)dst_sec(recv_op[i]->tte_net_end)) / BPU;
+			op_time[2]  = dst_sec(recv_op[i]->tte_net_end);
 			max_xfer    = MAX(max_xfer,recv_op[i]->tte_net_xfer_size);
                   if (kernel_trace) {
 			op_dks [2]  = send_op[i]->tte_net_start_k   - send_op[i]->tte_net_start;
@@ -550,11 +714,14 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
                 if (write_op != NULL) {
 		/* write disk */
                  if (write_op[i]->tte_disk_end > 0) {
-                  cutoff = MAX( nclk2sec(write_op[i]->tte_disk_end)-window_size, 0.0);
-                  for (k = i; (k >= 0) && (nclk2sec(write_op[k]->tte_disk_end) > cutoff); k--)
-			op_mbs [3] += (double)write_op[k]->tte_disk_xfer_size;
-			op_mbs [3]  = op_mbs[3] / MIN((double)window_size,(double)nclk2sec(write_op[i]->tte_disk_end)) / BPU;
-			op_time[3]  = nclk2sec(write_op[i]->tte_disk_end);
+                  /* slide the window up to this op */
+                  cutoff = MAX( dst_sec(write_op[i]->tte_disk_end)-window_size, 0.0);
+                  win_bytes[3] += write_op[i]->tte_disk_xfer_size;
+                  for (; win_low[3] < i && (write_op[win_low[3]]->tte_disk_end == 0 ||
+                         dst_sec(write_op[win_low[3]]->tte_disk_end) <= cutoff); win_low[3]++)
+			win_bytes[3] -= (write_op[win_low[3]]->tte_disk_end == 0) ? 0 : write_op[win_low[3]]->tte_disk_xfer_size;
+			op_mbs [3]  = (double)win_bytes[3] / MIN((double)window_size,(double)dst_sec(write_op[i]->tte_disk_end)) / BPU;
+			op_time[3]  = dst_sec(write_op[i]->tte_disk_end);
 			max_xfer    = MAX(max_xfer,write_op[i]->tte_disk_xfer_size);
                   if (kernel_trace) {
 			op_dks [3]  = write_op[i]->tte_disk_start_k - write_op[i]->tte_disk_start;
@@ -741,6 +908,183 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
 }
 
 
+/* the window that an op ending at time 'end' is in */
+static int64_t window_of(nclk_t end, nclk_t start_norm) {
+	return (int64_t)(nclk2sec((int64_t)(end - start_norm)) / window_size);
+}
+
+/* compare the ops of a window by worker thread, then by latency */
+static int compare_window_ops(const void *a, const void *b) {
+	const window_op_t *wa = a, *wb = b;
+
+	if (wa->worker != wb->worker)
+		return (wa->worker > wb->worker) - (wa->worker < wb->worker);
+	return (wa->latency > wb->latency) - (wa->latency < wb->latency);
+}
+
+/* compare two latencies for qsort() */
+static int compare_latencies(const void *a, const void *b) {
+	nclk_t la = *(const nclk_t *)a;
+	nclk_t lb = *(const nclk_t *)b;
+
+	return (la > lb) - (la < lb);
+}
+
+/* the latency in ms that 'permille' of the n sorted latencies did not exceed */
+static double window_percentile(nclk_t *latency, int64_t n, int permille) {
+	int64_t rank = (n*permille + 999) / 1000;
+
+	return (double)latency[MAX(rank, 1) - 1] / 1.0e6;
+}
+
+/* write one line of windows.csv */
+static void window_line(FILE *fp, window_work_t *w, int64_t win, char *worker,
+	int64_t bytes, nclk_t *latency, int64_t n) {
+
+	fprintf(fp,"%.6f,%.6f,%s,%s,%lld,%lld,%.4f,%.6f,%.6f,%.6f,%.6f\n",
+		win*window_size, (win+1)*window_size, w->label, worker,
+		(long long)n, (long long)bytes, (double)bytes / window_size / BPU,
+		window_percentile(latency, n, 500), window_percentile(latency, n, 900),
+		window_percentile(latency, n, 990), (double)latency[n-1] / 1.0e6);
+}
+
+/* summarize the windows of ops w->low to w->high into w->buf */
+static void *window_summary(void *arg) {
+	window_work_t *w = arg;
+	window_op_t *ops = NULL;
+	nclk_t *latency = NULL;
+	int64_t i, j, k, m, first, win, bytes, total_bytes, size = 0;
+	xdd_ts_tte_t *tte;
+	char worker[32];
+	FILE *fp;
+
+	fp = open_memstream(&w->buf, &w->bufsize);
+	if (fp == NULL) {
+		fprintf(stderr,"Could not allocate memory for window summary.\n");
+		exit(1);
+	}
+	for (i = w->low; i < w->high; i = j) {
+		/* the ops of this window */
+		win = window_of(w->disk ? w->op[i]->tte_disk_end : w->op[i]->tte_net_end, w->start_norm);
+		for (j = i; j < w->high; j++)
+			if (window_of(w->disk ? w->op[j]->tte_disk_end : w->op[j]->tte_net_end, w->start_norm) != win)
+				break;
+		if (j - i > size) {
+			size = j - i;
+			ops = realloc(ops, size*sizeof(window_op_t));
+			latency = realloc(latency, size*sizeof(nclk_t));
+			if (ops == NULL || latency == NULL) {
+				fprintf(stderr,"Could not allocate memory for window summary.\n");
+				exit(1);
+			}
+		}
+		m = 0;
+		total_bytes = 0;
+		for (k = i; k < j; k++) {
+			tte = w->op[k];
+			ops[m].worker  = tte->tte_worker_thread_number;
+			ops[m].bytes   = w->disk ? tte->tte_disk_xfer_size : tte->tte_net_xfer_size;
+			ops[m].latency = w->disk ? tte->tte_disk_end - tte->tte_disk_start
+						 : tte->tte_net_end  - tte->tte_net_start;
+			if (ops[m].bytes <= 0)
+				continue;
+			total_bytes += ops[m].bytes;
+			latency[m] = ops[m].latency;
+			m++;
+		}
+		if (m == 0)
+			continue;
+
+		/* all worker threads together */
+		qsort(latency, m, sizeof(nclk_t), compare_latencies);
+		window_line(fp, w, win, "all", total_bytes, latency, m);
+
+		/* each worker thread */
+		qsort(ops, m, sizeof(window_op_t), compare_window_ops);
+		for (k = 0; k < m; k = first) {
+			bytes = 0;
+			for (first = k; first < m && ops[first].worker == ops[k].worker; first++) {
+				bytes += ops[first].bytes;
+				latency[first - k] = ops[first].latency;
+			}
+			sprintf(worker,"%d",ops[k].worker);
+			window_line(fp, w, win, worker, bytes, latency, first - k);
+		}
+	}
+	fclose(fp);
+	free(ops);
+	free(latency);
+	return NULL;
+}
+
+/* summarize one sorted list of ops into windows.csv, each thread doing
+ * about the same number of ops but always whole windows */
+static void write_window_op(FILE *outfile, xdd_ts_header_t *tsdata, xdd_ts_tte_t **op,
+	int disk, nclk_t start_norm, char *label) {
+
+	window_work_t *work;
+	int64_t n, first, b;
+	int t;
+
+#define op_end(i) (disk ? op[i]->tte_disk_end : op[i]->tte_net_end)
+	if (op == NULL)
+		return;
+	n = tsdata->tsh_tt_size;
+	/* ops that never finished sort first */
+	for (first = 0; first < n && op_end(first) == 0; first++)
+		;
+	work = calloc(nthreads, sizeof(window_work_t));
+	if (work == NULL) {
+		fprintf(stderr,"Could not allocate memory for window summary.\n");
+		exit(1);
+	}
+	for (t = 0; t < nthreads; t++) {
+		work[t].op = op;
+		work[t].disk = disk;
+		work[t].start_norm = start_norm;
+		work[t].label = label;
+		work[t].low = (t == 0) ? first : work[t-1].high;
+		/* move the split up to the start of the next window */
+		b = MAX(work[t].low, first + (n - first)*(t+1)/nthreads);
+		while (b > work[t].low && b < n &&
+		       window_of(op_end(b), start_norm) == window_of(op_end(b-1), start_norm))
+			b++;
+		work[t].high = (t == nthreads-1) ? n : b;
+	}
+#undef op_end
+	run_parallel(window_summary, work, sizeof(window_work_t), nthreads);
+	for (t = 0; t < nthreads; t++) {
+		fwrite(work[t].buf, 1, work[t].bufsize, outfile);
+		free(work[t].buf);
+	}
+	free(work);
+}
+
+/* write the bandwidth and latency percentiles of each operation in
+ * each window of window_size seconds to windows.csv, for all of the
+ * worker threads and for each of them */
+void write_windows(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **read_op,
+	xdd_ts_tte_t **send_op, xdd_ts_tte_t **recv_op, xdd_ts_tte_t **write_op) {
+
+	FILE *outfile;
+	char csvfilename[OUTFILENAME_LEN + sizeof("/windows.csv")];
+
+	/* write_outfile() made the directory */
+	snprintf(csvfilename,sizeof(csvfilename),"%s/windows.csv",outfilebase);
+	outfile = fopen(csvfilename, "w");
+	if (outfile == NULL) {
+		fprintf(stderr,"Can not open output file: %s\n",csvfilename);
+		exit(1);
+	}
+	fprintf(outfile,"Window_Start_sec,Window_End_sec,Op,Worker,Ops,Bytes,Bandwidth_MBps,P50_Latency_ms,P90_Latency_ms,P99_Latency_ms,Max_Latency_ms\n");
+	/* a mixed read/write dump has all its ops in one list */
+	write_window_op(outfile, src, read_op,  1, src_start_norm, (op_mix > 0.0) ? "disk" : "read");
+	write_window_op(outfile, src, send_op,  0, src_start_norm, "send");
+	write_window_op(outfile, dst, recv_op,  0, dst_start_norm, "recv");
+	write_window_op(outfile, dst, write_op, 1, dst_start_norm, (op_mix > 0.0) ? "disk" : "write");
+	fclose(outfile);
+}
+
 /*********************************************************
  * Read an XDD binary timestamp dump into a structure
  *
@@ -748,80 +1092,282 @@ void write_outfile(xdd_ts_header_t *src, xdd_ts_header_t *dst, xdd_ts_tte_t **re
  *   filename    - name of the .bin file to read
  * OUT:
  *   tsdata      - pointer to the timestamp structure
- *   tsdata_size - size malloc'd for the structure
+ *   tsdata_size - size mapped for the structure (munmap() it)
  * RETURN:
  *   1 if succeeded, 0 if failed
+ *
+ * The file is mapped private rather than read so large dumps
+ * are paged in as they are used instead of copied up front.
+ * Changes to the entries (kernel events, stream segments)
+ * only go to private copies of the pages, never to the file.
  *********************************************************/
 int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size) {
 
-	FILE *tsfd;
+	int tsfd;
+	struct stat statbuf;
 	size_t tsize = 0;
 	xdd_ts_header_t *tdata = NULL;
-	size_t result = 0;
 	uint32_t magic = 0;
+	int result;
 
 	/* open file */
-	tsfd = fopen(filename, "rb");
+	tsfd = open(filename, O_RDONLY);
 
-	if (tsfd == NULL) {
+	if (tsfd < 0) {
 		fprintf(stderr,"Can not open file: %s\n",filename);
 		return 0;
 	}
 
 	/* get file length */
-	fseek(tsfd,0,SEEK_END);
-	tsize = ftell(tsfd);
-	fseek(tsfd,0,SEEK_SET);
+	if (fstat(tsfd,&statbuf) < 0) {
+		fprintf(stderr,"Error reading file: %s\n",filename);
+		close(tsfd);
+		return 0;
+	}
+	tsize = statbuf.st_size;
 
-	if (tsize == 0) {
+	if (tsize < sizeof(xdd_ts_header_t)) {
 		fprintf(stderr,"File is empty: %s\n",filename);
+		close(tsfd);
 		return 0;
 	}
 
-	/* allocate memory */
-	tdata = malloc(tsize);
+	/* map the file */
+	tdata = mmap(NULL, tsize, PROT_READ|PROT_WRITE, MAP_PRIVATE, tsfd, 0);
+	close(tsfd);
 
-	if (tdata == NULL) {
-		fprintf(stderr,"Could not allocate memory for file: %s\n",filename);
+	if (tdata == MAP_FAILED) {
+		fprintf(stderr,"Could not map file: %s\n",filename);
 		return 0;
 	}
+	/* the entries are read in order by every pass over them */
+	madvise(tdata, tsize, MADV_SEQUENTIAL);
 
 	/* check magic number in xdd_ts_header_t */
-	result = fread(&magic,sizeof(uint32_t),1,tsfd);
-	fseek(tsfd,0,SEEK_SET);
-
-	if (result == 0) {
-		fprintf(stderr,"Error reading file: %s\n",filename);
-		return 0;
+	magic = tdata->tsh_magic;
+	if (magic == XDD_TSC_MAGIC) {
+		result = xdd_read_columnar(filename, tdata, tsize, tsdata, tsdata_size);
+		munmap(tdata, tsize);
+		return result;
 	}
-	if (magic != BIN_MAGIC_NUMBER) {
+	if (magic != BIN_MAGIC_NUMBER && magic != BIN_STREAM_MAGIC_NUMBER) {
 		fprintf(stderr,"File is not in a readable format: %s\n",filename);
+		munmap(tdata, tsize);
 		return 0;
 	}
 
-	/* read rest of structure */
-	result = fread(tdata,tsize,1,tsfd);
+	/* a streamed file is a series of segments - pull their entries together behind the first header */
+	if (magic == BIN_STREAM_MAGIC_NUMBER) {
+		size_t offset = 0;
+		int64_t total = 0;
+		xdd_ts_header_t *seg;
+		int64_t numents, tt_bytes;
+
+		while (offset + sizeof(xdd_ts_header_t) <= tsize) {
+			seg = (xdd_ts_header_t *)((char *)tdata + offset);
+			numents = seg->tsh_numents;
+			tt_bytes = seg->tsh_tt_bytes;
+			if (seg->tsh_magic != BIN_STREAM_MAGIC_NUMBER || tt_bytes <= 0 || numents < 0 ||
+			    offset + sizeof(xdd_ts_header_t) + numents * sizeof(xdd_ts_tte_t) > tsize) {
+				fprintf(stderr,"Timestamp stream segment at offset %zu is damaged: %s\n",offset,filename);
+				break;
+			}
+			/* the move can overwrite this segment's header so it is only read before the move */
+			memmove(&tdata->tsh_tte[total], seg->tsh_tte, numents * sizeof(xdd_ts_tte_t));
+			total += numents;
+			offset += tt_bytes;
+		}
+		tdata->tsh_magic = BIN_MAGIC_NUMBER;
+		tdata->tsh_numents = total;
+		tdata->tsh_tt_size = total;
+		tdata->tsh_tte_indx = 0;
+		tdata->tsh_tt_bytes = sizeof(xdd_ts_header_t) + total * sizeof(xdd_ts_tte_t);
+	}
 
-	if (result == 0) {
-		fprintf(stderr,"Error reading file: %s\n",filename);
-		return 0;
+	/* tsh_tt_size is the size of the table xdd had - only the entries it used are in the file */
+	if (sizeof(xdd_ts_header_t) + tdata->tsh_tt_size * sizeof(xdd_ts_tte_t) > tsize)
+		tdata->tsh_tt_size = (tsize - sizeof(xdd_ts_header_t)) / sizeof(xdd_ts_tte_t);
+
+	/* the range starts at the first op of the file */
+	if (range_end > 0.0) {
+		size_t i;
+		nclk_t first = 0;
+		for (i = 0; i < tdata->tsh_tt_size; i++) {
+			if (tdata->tsh_tte[i].tte_disk_start != 0 && (first == 0 || tdata->tsh_tte[i].tte_disk_start < first))
+				first = tdata->tsh_tte[i].tte_disk_start;
+			if (tdata->tsh_tte[i].tte_net_start != 0 && (first == 0 || tdata->tsh_tte[i].tte_net_start < first))
+				first = tdata->tsh_tte[i].tte_net_start;
+		}
+		select_range(tdata, first);
 	}
 
 	/* no empty sets */
 	if (tdata->tsh_tt_size < 1) {
 		fprintf(stderr,"Timestamp dump was empty: %s\n",filename);
+		munmap(tdata, tsize);
 		return 0;
 	}
 
 	*tsdata = tdata;
 	*tsdata_size = tsize;
 
-	/* close file */
-	fclose(tsfd);
+	return 1;
+}
+
+
+/* decode the blocks of one thread */
+static void *decode_blocks(void *arg) {
+	decode_work_t *w = arg;
+	xdd_tsc_index_t *ip;
+	int64_t b, pos = 0;
+	int32_t n;
+
+	w->bad = -1;
+	for (b = w->low; b < w->high; b++) {
+		ip = &w->index[b];
+		n = -1;
+		if (ip->tsci_offset == XDD_TSC_ALIGN(ip->tsci_offset) &&
+		    (size_t)ip->tsci_offset + sizeof(xdd_tsc_block_t) <= w->size &&
+		    ((xdd_tsc_block_t *)(w->base + ip->tsci_offset))->tscb_entries == ip->tsci_entries)
+			n = xdd_tsc_decode_block((xdd_tsc_block_t *)(w->base + ip->tsci_offset),
+				w->size - ip->tsci_offset, w->tte + pos);
+		if (n != (int32_t)ip->tsci_entries) {
+			w->bad = b;
+			break;
+		}
+		pos += n;
+	}
+	return NULL;
+}
+
+/*********************************************************
+ * Decode a columnar (-ts compact) timestamp dump into
+ * the same structure as a plain dump
+ *
+ * IN:
+ *   filename    - name of the file, for messages
+ *   base, size  - the mapped file
+ * OUT:
+ *   tsdata      - pointer to the timestamp structure
+ *   tsdata_size - size mapped for the structure (munmap() it)
+ * RETURN:
+ *   1 if succeeded, 0 if failed
+ *
+ * With -r only the blocks that can have ops ending in the
+ * range are decoded, the others are never read. The blocks
+ * are split between the threads.
+ *********************************************************/
+int xdd_read_columnar(char *filename, void *base, size_t size, xdd_ts_header_t **tsdata, size_t *tsdata_size) {
+
+	xdd_tsc_header_t *hp = base;
+	xdd_tsc_index_t *index;
+	xdd_ts_header_t *tdata;
+	decode_work_t *work;
+	int64_t numblocks, selected, b, entries, bad;
+	nclk_t t0, t1;
+	size_t tsize;
+	int t, count;
+
+	if (xdd_tsc_check_header(base, size) != 0) {
+		fprintf(stderr,"Columnar timestamp file has an unknown version or a damaged header: %s\n",filename);
+		return 0;
+	}
+	numblocks = xdd_tsc_read_index(base, size, &index);
+	if (numblocks < 0) {
+		fprintf(stderr,"Could not allocate memory for the block index of file: %s\n",filename);
+		return 0;
+	}
+
+	/* keep the blocks that can have ops ending in the range */
+	selected = numblocks;
+	if (range_end > 0.0) {
+		t0 = hp->tsc_min_time + (nclk_t)(range_start * 1.0e9);
+		t1 = hp->tsc_min_time + (nclk_t)(range_end * 1.0e9);
+		selected = 0;
+		for (b = 0; b < numblocks; b++)
+			if (index[b].tsci_max_time >= t0 && index[b].tsci_min_time < t1)
+				index[selected++] = index[b];
+	}
+
+	/* room for all the entries of those blocks */
+	entries = 0;
+	for (b = 0; b < selected; b++)
+		entries += index[b].tsci_entries;
+	tsize = sizeof(xdd_ts_header_t) + MAX(entries, 1) * sizeof(xdd_ts_tte_t);
+	tdata = mmap(NULL, tsize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+	if (tdata == MAP_FAILED) {
+		fprintf(stderr,"Could not allocate memory for file: %s\n",filename);
+		free(index);
+		return 0;
+	}
+	xdd_tsc_get_ts_header(base, tdata);
+
+	/* decode about the same number of blocks in each thread */
+	count = (int)MIN((int64_t)nthreads, MAX(selected, 1));
+	work = calloc(count, sizeof(decode_work_t));
+	if (work == NULL) {
+		fprintf(stderr,"Could not allocate memory for file: %s\n",filename);
+		exit(1);
+	}
+	for (t = 0, b = 0, entries = 0; t < count; t++) {
+		work[t].base  = base;
+		work[t].size  = size;
+		work[t].index = index;
+		work[t].low   = selected*t/count;
+		work[t].high  = selected*(t+1)/count;
+		for (; b < work[t].low; b++)
+			entries += index[b].tsci_entries;
+		work[t].tte   = tdata->tsh_tte + entries;
+	}
+	run_parallel(decode_blocks, work, sizeof(decode_work_t), count);
+
+	/* a damaged block ends the file */
+	bad = -1;
+	for (t = 0; t < count && bad < 0; t++)
+		bad = work[t].bad;
+	entries = 0;
+	for (b = 0; b < selected && b != bad; b++)
+		entries += index[b].tsci_entries;
+	if (bad >= 0)
+		fprintf(stderr,"Block %lld of columnar timestamp file is damaged, using the %lld entries before it: %s\n",
+			(long long)bad,(long long)entries,filename);
+	tdata->tsh_numents = entries;
+	tdata->tsh_tt_size = entries;
+	free(work);
+	free(index);
+
+	if (range_end > 0.0)
+		select_range(tdata, hp->tsc_min_time);
+	if (tdata->tsh_tt_size < 1) {
+		fprintf(stderr,"Timestamp dump was empty: %s\n",filename);
+		munmap(tdata, tsize);
+		return 0;
+	}
+
+	*tsdata = tdata;
+	*tsdata_size = tsize;
 
 	return 1;
 }
 
+/* keep only the entries that end in the -r range of seconds after 'first' */
+void select_range(xdd_ts_header_t *tsdata, nclk_t first) {
+	nclk_t t0, t1, end;
+	size_t i, kept = 0;
+
+	t0 = first + (nclk_t)(range_start * 1.0e9);
+	t1 = first + (nclk_t)(range_end * 1.0e9);
+	for (i = 0; i < tsdata->tsh_tt_size; i++) {
+		end = MAX(tsdata->tsh_tte[i].tte_disk_end, tsdata->tsh_tte[i].tte_net_end);
+		if (end < t0 || end >= t1)
+			continue;
+		if (kept != i)
+			tsdata->tsh_tte[kept] = tsdata->tsh_tte[i];
+		kept++;
+	}
+	tsdata->tsh_numents = kept;
+	tsdata->tsh_tt_size = kept;
+}
 
 /*********************************************************
  * Write an XDD binary timestamp dump from a structure
@@ -884,18 +1430,37 @@ int getoptions(int argc, char **argv) {
 	/* set default options */
 	strcpy(outfilebase,".");
 	window_size = 1;
+	nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads < 1)
+		nthreads = 1;
 
 	/* loop through options */
-	while ((opt = getopt(argc, argv, "t:ko:h")) != -1) {
+	while ((opt = getopt(argc, argv, "t:j:r:ko:h")) != -1) {
 		switch (opt) {
 			case 't': /* moving average */
-				window_size = atoi(optarg);
+				window_size = atof(optarg);
 				argnum += 2;
 				if (window_size <= 0) {
 					fprintf(stderr,"\nwindow size must be more than 0.\n\n");
 					ierr++;
 				}
 				break;
+			case 'r': /* time range */
+				if (sscanf(optarg,"%lf:%lf",&range_start,&range_end) != 2 ||
+				    range_start < 0.0 || range_end <= range_start) {
+					fprintf(stderr,"\ntime range must be <start>:<end> seconds with end after start.\n\n");
+					ierr++;
+				}
+				argnum += 2;
+				break;
+			case 'j': /* sort and analysis threads */
+				nthreads = atoi(optarg);
+				argnum += 2;
+				if (nthreads <= 0) {
+					fprintf(stderr,"\nnumber of threads must be more than 0.\n\n");
+					ierr++;
+				}
+				break;
                         case 'k': /* use src, dst kernel trace files */
                                 kernel_trace = 1;
                                 argnum += 1;
@@ -947,6 +1512,8 @@ void printusage(char *progname) {
 
 	fprintf(stderr, "Analysis results are located in directory [directory]. \n");
 	fprintf(stderr, "Results are included in file 'analysis.dat' and plots in '*.eps' files\n");
+	fprintf(stderr, "File 'windows.csv' has the bandwidth and latency percentiles of each\n");
+	fprintf(stderr, "operation in each window of [secs], for all and for each worker thread\n");
 	fprintf(stderr, "Edit file 'gnuplot_[directory]' as desired and run 'gnuplot gnuplot_[directory]'\n");
         fprintf(stderr, "to regenerate\n\n");
 
@@ -971,7 +1538,10 @@ void printusage(char *progname) {
 	fprintf(stderr, "OPTIONS:\n");
 	fprintf(stderr, "\t -h             \t print this usage text\n");
 	fprintf(stderr, "\t -o [directory] \t analysis results directory w analysis.dat & *.eps files (default 'PWD') \n");
-	fprintf(stderr, "\t -t <seconds>   \t number of seconds in the sliding window (default: %d)\n", window_size);
+	fprintf(stderr, "\t -t <seconds>   \t number of seconds in the sliding window (default: %g)\n", window_size);
+	fprintf(stderr, "\t -j <threads>   \t number of threads that sort and analyze (default: %d, the CPUs online)\n", nthreads);
+	fprintf(stderr, "\t -r <start>:<end>\t only use the ops that end this many seconds after the start of each file.\n");
+	fprintf(stderr, "\t                \t Only the blocks of the range are read from columnar (-ts compact) files\n");
 	fprintf(stderr, "\t -k             \t also analyze kernel trace data\n");
 
 	fprintf(stderr, "\n");
@@ -51,6 +51,7 @@ int32_t xint_e2e_xni_init(target_data_t *tdp) {
 	if (xni_protocol_tcp == tdp->xni_pcl)
 		rc = xni_allocate_tcp_control_block(num_threads,
 											tdp->xni_tcp_congestion,
+											(tdp->td_target_options & TO_E2E_ZEROCOPY) ? XNI_TCP_ZEROCOPY : 0,
 											&tdp->xni_cb);
 #if HAVE_ENABLE_IB
 	else if (xni_protocol_ib == tdp->xni_pcl)
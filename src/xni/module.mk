@@ -4,6 +4,7 @@
 DIR := src/xni
 
 XNI_SRC := $(DIR)/xni.c \
+	$(DIR)/xni_buffer_pool.c \
 	$(DIR)/xni_ib.c \
 	$(DIR)/xni_tcp.c \
 	$(DIR)/xni_udt.c 
@@ -387,6 +387,9 @@ void xni_target_buffer_set_data_length(int length, xni_target_buffer_t buffer);
 enum {
   XNI_TCP_DEFAULT_NUM_SOCKETS = 0,  /*!< \brief Use the default number of sockets. */
 };
+enum {
+  XNI_TCP_ZEROCOPY = 0x1,  /*!< \brief Send with MSG_ZEROCOPY where the kernel supports it. */
+};
 extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP congestion avoidance algorithm. */
 /*! \brief Create a control block for the TCP implementation.
  *
@@ -397,8 +400,13 @@ extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP
  * If \e congestion is #XNI_TCP_DEFAULT_CONGESTION then the system
  * default congestion avoidance algorithm will be used.
  *
+ * If \e flags contains #XNI_TCP_ZEROCOPY then buffers are sent without
+ * being copied into the kernel. A sent buffer is not handed out again
+ * until the kernel reports that it no longer references it.
+ *
  * \param num_sockets The number of TCP sockets to create per connection.
  * \param congestion the congestion control algorithm to use
+ * \param flags Zero or #XNI_TCP_ZEROCOPY.
  * \param[out] control_block The newly allocated control block.
  *
  * \return #XNI_OK if the control block was successfully created.
@@ -406,7 +414,7 @@ extern const char *XNI_TCP_DEFAULT_CONGESTION;  /*!< \brief Use the default TCP
  *
  * \sa xni_free_tcp_control_block()
  */
-int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_control_block_t *control_block);
+int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, int flags, xni_control_block_t *control_block);
 /*! \brief Free a TCP control block.
  *
  * It is forbidden to call this function more than once with the same
@@ -0,0 +1,113 @@
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "xni.h"
+#include "xni_internal.h"
+
+
+// The buffer this thread returned last, tried first by its next claim
+static __thread struct {
+  const struct xni_buffer_pool *pool;
+  long index;
+} last_put = { NULL, -1 };
+
+int xni_buffer_pool_init(struct xni_buffer_pool *pool, size_t capacity)
+{
+  pool->busy = calloc(capacity, sizeof(*pool->busy));
+  if (pool->busy == NULL && capacity > 0)
+    return XNI_ERR;
+  pool->capacity = capacity;
+  pool->num_buffers = 0;
+  pool->next_start = 0;
+  pool->waiters = 0;
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->cond, NULL);
+  return XNI_OK;
+}
+
+void xni_buffer_pool_destroy(struct xni_buffer_pool *pool)
+{
+  pthread_mutex_destroy(&pool->mutex);
+  pthread_cond_destroy(&pool->cond);
+  free(pool->busy);
+  pool->busy = NULL;
+  pool->capacity = 0;
+  pool->num_buffers = 0;
+}
+
+long xni_buffer_pool_add(struct xni_buffer_pool *pool)
+{
+  const size_t index = pool->num_buffers;
+  if (index >= pool->capacity)
+    return -1;
+
+  // publish the flag before the buffer becomes visible to a scan
+  pool->busy[index] = 0;
+  __atomic_store_n(&pool->num_buffers, index + 1, __ATOMIC_RELEASE);
+  return (long)index;
+}
+
+long xni_buffer_pool_try_get(struct xni_buffer_pool *pool)
+{
+  const size_t num_buffers = __atomic_load_n(&pool->num_buffers, __ATOMIC_ACQUIRE);
+  if (num_buffers == 0)
+    return -1;
+
+  size_t start;
+  if (last_put.pool == pool && (size_t)last_put.index < num_buffers)
+    start = (size_t)last_put.index;
+  else
+    start = __atomic_fetch_add(&pool->next_start, 1, __ATOMIC_RELAXED) % num_buffers;
+
+  for (size_t i = 0; i < num_buffers; i++) {
+    const size_t index = (start + i) % num_buffers;
+    int expected = 0;
+    // sequentially consistent so that a sleeper cannot miss a put
+    if (__atomic_load_n(&pool->busy[index], __ATOMIC_SEQ_CST) == 0 &&
+        __atomic_compare_exchange_n(&pool->busy[index], &expected, 1, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+      return (long)index;
+  }
+  return -1;
+}
+
+long xni_buffer_pool_get(struct xni_buffer_pool *pool)
+{
+  long index = xni_buffer_pool_try_get(pool);
+  if (index >= 0)
+    return index;
+
+  // announce the sleeper before the last scan so that a put either is
+  // seen by the scan or sees the sleeper and signals it
+  __atomic_add_fetch(&pool->waiters, 1, __ATOMIC_SEQ_CST);
+  pthread_mutex_lock(&pool->mutex);
+  while ((index = xni_buffer_pool_try_get(pool)) < 0)
+    pthread_cond_wait(&pool->cond, &pool->mutex);
+  pthread_mutex_unlock(&pool->mutex);
+  __atomic_sub_fetch(&pool->waiters, 1, __ATOMIC_SEQ_CST);
+  return index;
+}
+
+void xni_buffer_pool_put(struct xni_buffer_pool *pool, long index)
+{
+  last_put.pool = pool;
+  last_put.index = index;
+
+  __atomic_store_n(&pool->busy[index], 0, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&pool->waiters, __ATOMIC_SEQ_CST) > 0) {
+    pthread_mutex_lock(&pool->mutex);
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -43,11 +43,12 @@ struct ib_context {
 	struct ib_target_buffer *target_buffers;
 	size_t num_registered;
 
+	// free target buffers on the source side
+	struct xni_buffer_pool buffer_pool;
+
 	// locks
 	pthread_mutex_t target_buffers_mutex;
 	pthread_cond_t target_buffers_cond;
-	pthread_mutex_t busy_flag_mutex;
-	pthread_cond_t busy_flag_cond;
 
 };
 
@@ -91,7 +92,6 @@ struct ib_target_buffer {
 
 	// added by struct ib_target_buffer
 	size_t buffer_size;
-	int busy;
 	enum send_state send_state;
 	struct ibv_mr *memory_region;
 	void *header;
@@ -184,8 +184,7 @@ static int ib_context_create(xni_protocol_t proto_, xni_control_block_t cb_, xni
   tmp->num_registered = 0;
   pthread_mutex_init(&tmp->target_buffers_mutex, NULL);
   pthread_cond_init(&tmp->target_buffers_cond, NULL);
-  pthread_mutex_init(&tmp->busy_flag_mutex, NULL);
-  pthread_cond_init(&tmp->busy_flag_cond, NULL);
+  xni_buffer_pool_init(&tmp->buffer_pool, cb->num_buffers);
 
   *ctx = tmp;
   return XNI_OK;
@@ -198,6 +197,7 @@ static int ib_context_destroy(xni_context_t *ctx_)
   (void)ibv_dealloc_pd((*ctx)->domain);
   (void)ibv_close_device((*ctx)->verbs_context);
 
+  xni_buffer_pool_destroy(&(*ctx)->buffer_pool);
   free(*ctx);
 
   *ctx = NULL;
@@ -233,12 +233,12 @@ static int ib_register_buffer(xni_context_t ctx_, void* buf, size_t nbytes, size
 	tb->data = (void*)datap;
 	tb->data_length = -1;
 	tb->buffer_size = nbytes - reserved;
-	tb->busy = 0;
 	tb->send_state = 0;
 	tb->memory_region = mr;
 	tb->header = (void*)(datap - IB_DATA_MESSAGE_HEADER_SIZE);
 	tb->connection = NULL;
 	ctx->num_registered++;
+	xni_buffer_pool_add(&ctx->buffer_pool);
 	pthread_mutex_unlock(&ctx->target_buffers_mutex);
 
 	// Set the outbound target buffer
@@ -890,25 +890,9 @@ static int ib_request_target_buffer(xni_context_t ctx_, xni_target_buffer_t *tar
 	struct ib_context *ctx = (struct ib_context*)ctx_;
 	struct ib_target_buffer **targetbuf = (struct ib_target_buffer**)targetbuf_;
 
-	struct ib_target_buffer *tb = NULL;
-	pthread_mutex_lock(&ctx->busy_flag_mutex);
-	while (tb == NULL) {
-		for (size_t i = 0; i < ctx->num_registered; i++) {
-			struct ib_target_buffer* ptr = ctx->target_buffers + i;
-
-			if (!ptr->busy) {
-				tb = ptr;
-				tb->busy = 1;
-				break;
-			}
-		}
-		if (tb == NULL)
-			pthread_cond_wait(&ctx->busy_flag_cond,
-							  &ctx->busy_flag_mutex);
-	}
-	pthread_mutex_unlock(&ctx->busy_flag_mutex);
+	const long index = xni_buffer_pool_get(&ctx->buffer_pool);
     
-	*targetbuf = tb;
+	*targetbuf = ctx->target_buffers + index;
 	return XNI_OK;
 }
 
@@ -979,10 +963,7 @@ static int ib_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *ta
     
   free_out:
 	// mark the buffer as free
-	pthread_mutex_lock(&conn->context->busy_flag_mutex);
-	tb->busy = 0;
-	pthread_cond_signal(&conn->context->busy_flag_cond);
-	pthread_mutex_unlock(&conn->context->busy_flag_mutex);
+	xni_buffer_pool_put(&conn->context->buffer_pool, (long)(tb - conn->context->target_buffers));
 	
 	return return_code;
 }
@@ -1046,10 +1027,8 @@ static int ib_release_target_buffer(xni_target_buffer_t *targetbuf_)
     if (send_credits(tb->connection, 1))
       return XNI_ERR;
   } else {
-    pthread_mutex_lock(&tb->connection->context->busy_flag_mutex);
-    tb->busy = 0;
-    pthread_cond_signal(&tb->connection->context->busy_flag_cond);
-    pthread_mutex_unlock(&tb->connection->context->busy_flag_mutex);
+    struct ib_context *ctx = tb->connection->context;
+    xni_buffer_pool_put(&ctx->buffer_pool, (long)(tb - ctx->target_buffers));
   }
 
   *targetbuf = NULL;
@@ -1,6 +1,8 @@
 #ifndef XDD_XNI_INTERNAL_H
 #define XDD_XNI_INTERNAL_H
 
+#include <stddef.h>
+#include <pthread.h>
 
 struct xni_protocol {
     const char *name;
@@ -35,6 +37,34 @@ struct xni_target_buffer {
     int data_length;
 };
 
+/*
+ * Pool of the registered target buffers of a context, shared by the
+ * protocol modules. Buffers are identified by their index in the order
+ * they were added. A buffer is claimed and returned with atomic
+ * operations, and each thread first tries the buffer it returned last,
+ * so threads only take the mutex to sleep when every buffer is in use.
+ */
+struct xni_buffer_pool {
+    int *busy;  // one flag per buffer, claimed by compare-and-swap
+    size_t capacity;
+    size_t num_buffers;
+    size_t next_start;  // spreads the first scan of new threads
+    int waiters;  // threads sleeping in xni_buffer_pool_get()
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+int xni_buffer_pool_init(struct xni_buffer_pool *pool, size_t capacity);
+void xni_buffer_pool_destroy(struct xni_buffer_pool *pool);
+// Add a free buffer and return its index, or -1 if the pool is full;
+// adds must not race with each other
+long xni_buffer_pool_add(struct xni_buffer_pool *pool);
+// Claim a free buffer and return its index, or -1 if all are in use
+long xni_buffer_pool_try_get(struct xni_buffer_pool *pool);
+// Claim a free buffer, sleeping until one is returned
+long xni_buffer_pool_get(struct xni_buffer_pool *pool);
+void xni_buffer_pool_put(struct xni_buffer_pool *pool, long index);
+
 #endif // XDD_XNI_INTERNAL_H
 
 /*
@@ -19,17 +19,32 @@
 #include "xni.h"
 #include "xni_internal.h"
 
+// Use a shared epoll instance for the receive side when available
+#if HAVE_SYS_EPOLL_H && HAVE_SYS_EVENTFD_H
+#define TCP_USE_EPOLL 1
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+// Send with MSG_ZEROCOPY when requested and available
+#if HAVE_LINUX_ERRQUEUE_H && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+#define TCP_USE_ZEROCOPY 1
+#include <poll.h>
+#include <linux/errqueue.h>
+#endif
+
 
 #define PROTOCOL_NAME "tcp-nlmills-20120809"
 #define ALIGN(val,align) (((val)+(align)-1UL) & ~((align)-1UL))
 
 const char *XNI_TCP_DEFAULT_CONGESTION = "";
 
-static const size_t TCP_DATA_MESSAGE_HEADER_SIZE = 12;
+enum { TCP_DATA_MESSAGE_HEADER_SIZE = 12 };
 
 struct tcp_control_block {
   size_t num_sockets;
   char congestion[16];
+  int flags;
 };
 
 struct tcp_context {
@@ -42,8 +57,8 @@ struct tcp_context {
     // added by struct tcp_connection
     struct tcp_target_buffer *registered_buffers;  // NULL-terminated
 	size_t num_registered;
-    pthread_mutex_t buffer_mutex;
-    pthread_cond_t buffer_cond;
+    struct xni_buffer_pool buffer_pool;  // free registered buffers
+    pthread_mutex_t buffer_mutex;  // registration and zero copy state
 
 };
 
@@ -51,6 +66,15 @@ struct tcp_socket {
   int sockd;
   int busy;
   int eof;
+
+  // receive side: the next message header, read along with the previous payload
+  char header[TCP_DATA_MESSAGE_HEADER_SIZE];
+  size_t header_bytes;
+
+  // send side: MSG_ZEROCOPY notification ids are counted per socket
+  int zerocopy;
+  uint32_t zc_next;  // id of the next zero copy send
+  int zc_inflight;  // buffers waiting for their completions
 };
 
 struct tcp_connection {
@@ -63,6 +87,11 @@ struct tcp_connection {
     int num_sockets;
     pthread_mutex_t socket_mutex;
     pthread_cond_t socket_cond;
+
+    // receive side readiness (destination only)
+    int epfd;  // one-shot, edge-triggered registration of every socket
+    int wakefd;  // readable once the last socket has reached EOF
+    int num_live;  // sockets that have not reached EOF
 };
 
 struct tcp_target_buffer {
@@ -73,12 +102,18 @@ struct tcp_target_buffer {
   int data_length;
 
   // added by tcp_target_buffer
-  int busy;
   void *header;
+
+  // zero copy sends [zc_first, zc_last] on zc_socket still reference the data
+  struct tcp_connection *zc_conn;
+  struct tcp_socket *zc_socket;
+  uint32_t zc_first;
+  uint32_t zc_last;
+  uint32_t zc_pending;
 };
 
 
-int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_control_block_t *cb_)
+int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, int flags, xni_control_block_t *cb_)
 {
   struct tcp_control_block **cb = (struct tcp_control_block**)cb_;
 
@@ -93,6 +128,7 @@ int xni_allocate_tcp_control_block(int num_sockets, const char *congestion, xni_
   struct tcp_control_block *tmp = calloc(1, sizeof(*tmp));
   tmp->num_sockets = num_sockets;
   strncpy(tmp->congestion, congestion, (sizeof(tmp->congestion) - 1));
+  tmp->flags = flags;
   *cb = tmp;
   return XNI_OK;
 }
@@ -120,8 +156,8 @@ static int tcp_context_create(xni_protocol_t proto_, xni_control_block_t cb_, xn
   tmp->protocol = proto;
   tmp->control_block = *cb;
   tmp->registered_buffers = calloc(num_buffers, sizeof(*tmp->registered_buffers));
+  xni_buffer_pool_init(&tmp->buffer_pool, num_buffers);
   pthread_mutex_init(&tmp->buffer_mutex, NULL);
-  pthread_cond_init(&tmp->buffer_cond, NULL);
   
   // Swap in the context
   *ctx = tmp;
@@ -133,7 +169,7 @@ static int tcp_context_destroy(xni_context_t *ctx_)
 {
   struct tcp_context **ctx = (struct tcp_context **)ctx_;
   pthread_mutex_destroy(&(*ctx)->buffer_mutex);
-  pthread_cond_destroy(&(*ctx)->buffer_cond);
+  xni_buffer_pool_destroy(&(*ctx)->buffer_pool);
   free((*ctx)->registered_buffers);
   free(*ctx);
 
@@ -162,10 +198,12 @@ static int tcp_register_buffer(xni_context_t ctx_, void* buf, size_t nbytes, siz
 	tb->data = (void*)datap;
 	tb->target_offset = 0;
 	tb->data_length = -1;
-	tb->busy = 0;
 	tb->header = (void*)(datap - TCP_DATA_MESSAGE_HEADER_SIZE);
+	tb->zc_conn = NULL;
+	tb->zc_socket = NULL;
 	ctx->registered_buffers[ctx->num_registered] = *tb;
 	ctx->num_registered++;
+	xni_buffer_pool_add(&ctx->buffer_pool);
 	pthread_mutex_unlock(&ctx->buffer_mutex);
 
 	// Set the user's target buffer
@@ -191,13 +229,13 @@ static int tcp_accept_connection(xni_context_t ctx_, struct xni_endpoint* local,
 
 	// connected sockets
 	struct tcp_socket *clients = malloc(num_sockets*sizeof(*clients));
-	for (int i = 0; i < num_sockets; i++) {
+	memset(clients, 0, num_sockets*sizeof(*clients));
+	for (int i = 0; i < num_sockets; i++)
 		clients[i].sockd = -1;
-		clients[i].busy = 0;
-		clients[i].eof = 0;
-	}
 
 	struct tcp_connection *tmpconn = calloc(1, sizeof(*tmpconn));
+	tmpconn->epfd = -1;
+	tmpconn->wakefd = -1;
 
 	// place all server sockets in the listening state
 	for (int i = 0; i < num_sockets; i++) {
@@ -256,6 +294,36 @@ static int tcp_accept_connection(xni_context_t ctx_, struct xni_endpoint* local,
 	tmpconn->destination = 1;
 	tmpconn->sockets = clients;
 	tmpconn->num_sockets = num_sockets;
+	tmpconn->num_live = num_sockets;
+
+#if TCP_USE_EPOLL
+	// register every socket once; receivers re-arm it after each message
+	if ((tmpconn->epfd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+		perror("epoll_create1");
+		goto error_out;
+	}
+	for (int i = 0; i < num_sockets; i++) {
+		struct epoll_event event = { .events = EPOLLIN | EPOLLET | EPOLLONESHOT };
+		event.data.u32 = (uint32_t)i;
+		if (epoll_ctl(tmpconn->epfd, EPOLL_CTL_ADD, clients[i].sockd, &event) == -1) {
+			perror("epoll_ctl");
+			goto error_out;
+		}
+	}
+
+	// level-triggered so that every waiting receiver sees the final EOF
+	if ((tmpconn->wakefd = eventfd(0, EFD_CLOEXEC)) == -1) {
+		perror("eventfd");
+		goto error_out;
+	}
+	struct epoll_event wake = { .events = EPOLLIN };
+	wake.data.u32 = (uint32_t)num_sockets;
+	if (epoll_ctl(tmpconn->epfd, EPOLL_CTL_ADD, tmpconn->wakefd, &wake) == -1) {
+		perror("epoll_ctl");
+		goto error_out;
+	}
+#endif  // TCP_USE_EPOLL
+
 	pthread_mutex_init(&tmpconn->socket_mutex, NULL);
 	pthread_cond_init(&tmpconn->socket_cond, NULL);
 
@@ -263,6 +331,11 @@ static int tcp_accept_connection(xni_context_t ctx_, struct xni_endpoint* local,
 	return XNI_OK;
 
  error_out:
+  if (tmpconn->wakefd != -1)
+    close(tmpconn->wakefd);
+  if (tmpconn->epfd != -1)
+    close(tmpconn->epfd);
+
   // close any opened client sockets
   for (int i = 0; i < num_sockets; i++)
     if (clients[i].sockd != -1)
@@ -293,9 +366,9 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
 
 	// connected sockets
 	struct tcp_socket *servers = malloc(num_sockets*sizeof(*servers));
+	memset(servers, 0, num_sockets*sizeof(*servers));
 	for (int i = 0; i < num_sockets; i++) {
 		servers[i].sockd = -1;
-		servers[i].busy = 0;
 		servers[i].eof = 1;
 	}
   
@@ -333,6 +406,17 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
 			perror("connect");
 			goto error_out;
 		}
+
+#if TCP_USE_ZEROCOPY
+		// without kernel support the buffers are copied as usual
+		if (ctx->control_block.flags & XNI_TCP_ZEROCOPY) {
+			int optval = 1;
+			if (setsockopt(servers[i].sockd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval)) == 0)
+				servers[i].zerocopy = 1;
+			else if (i == 0)
+				perror("setsockopt(SO_ZEROCOPY)");
+		}
+#endif  // TCP_USE_ZEROCOPY
 	}
 
 	//TODO: allocate target buffer list and attach
@@ -341,6 +425,9 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
   tmpconn->destination = 0;
   tmpconn->sockets = servers;
   tmpconn->num_sockets = num_sockets;
+  tmpconn->epfd = -1;
+  tmpconn->wakefd = -1;
+  tmpconn->num_live = num_sockets;
   pthread_mutex_init(&tmpconn->socket_mutex, NULL);
   pthread_cond_init(&tmpconn->socket_cond, NULL);
 
@@ -364,6 +451,97 @@ static int tcp_connect(xni_context_t ctx_, struct xni_endpoint* remote, xni_conn
   return XNI_ERR;
 }
 
+#if TCP_USE_ZEROCOPY
+// Collect the MSG_ZEROCOPY completions queued on a socket and free the
+// buffers whose sends have all completed. The caller must own the socket
+// (busy) so that no completion is reaped before its buffer is recorded.
+static void tcp_reap_zerocopy(struct tcp_context *ctx, struct tcp_socket *socket)
+{
+  for (;;) {
+    char control[128];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(socket->sockd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+      return;  // EAGAIN once the queue is empty
+
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (cm->cmsg_level != SOL_IP || cm->cmsg_type != IP_RECVERR)
+        continue;
+      const struct sock_extended_err *serr = (const struct sock_extended_err*)CMSG_DATA(cm);
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+        continue;
+
+      // the kernel had to copy anyway, so stop paying for notifications
+      if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+        socket->zerocopy = 0;
+
+      // sends [ee_info, ee_data] have completed, possibly out of order
+      pthread_mutex_lock(&ctx->buffer_mutex);
+      for (size_t i = 0; i < ctx->num_registered; i++) {
+        struct tcp_target_buffer *tb = ctx->registered_buffers + i;
+        if (tb->zc_socket != socket)
+          continue;
+        const uint32_t first = (tb->zc_first > serr->ee_info ? tb->zc_first : serr->ee_info);
+        const uint32_t last = (tb->zc_last < serr->ee_data ? tb->zc_last : serr->ee_data);
+        if (first > last)
+          continue;
+        tb->zc_pending -= (last - first + 1);
+        if (tb->zc_pending == 0) {
+          tb->zc_conn = NULL;
+          tb->zc_socket = NULL;
+          socket->zc_inflight--;
+          xni_buffer_pool_put(&ctx->buffer_pool, (long)i);
+        }
+      }
+      pthread_mutex_unlock(&ctx->buffer_mutex);
+    }
+  }
+}
+
+// Called when no buffer is free. Waits briefly for completions on the
+// socket of a buffer that is still being sent from. Returns 0 if no
+// buffer is waiting for completions.
+static int tcp_wait_zerocopy(struct tcp_context *ctx)
+{
+  struct tcp_target_buffer *tb = NULL;
+  pthread_mutex_lock(&ctx->buffer_mutex);
+  for (size_t i = 0; i < ctx->num_registered && tb == NULL; i++)
+    if (ctx->registered_buffers[i].zc_socket != NULL)
+      tb = ctx->registered_buffers + i;
+  struct tcp_connection *conn = (tb ? tb->zc_conn : NULL);
+  struct tcp_socket *socket = (tb ? tb->zc_socket : NULL);
+  pthread_mutex_unlock(&ctx->buffer_mutex);
+  if (tb == NULL)
+    return 0;
+
+  // a sender that owns the socket reaps it itself
+  int owned = 0;
+  pthread_mutex_lock(&conn->socket_mutex);
+  if (!socket->busy) {
+    socket->busy = 1;
+    owned = 1;
+  }
+  pthread_mutex_unlock(&conn->socket_mutex);
+
+  if (owned) {
+    // a queued completion is reported as POLLERR
+    struct pollfd pfd = { .fd = socket->sockd, .events = 0 };
+    poll(&pfd, 1, 10);
+    tcp_reap_zerocopy(ctx, socket);
+
+    pthread_mutex_lock(&conn->socket_mutex);
+    socket->busy = 0;
+    pthread_cond_signal(&conn->socket_cond);
+    pthread_mutex_unlock(&conn->socket_mutex);
+  } else
+    poll(NULL, 0, 1);
+
+  return 1;
+}
+#endif  // TCP_USE_ZEROCOPY
+
 //XXX: this is not going to be thread safe??
 //alternatives: a flag that signals shutdown state
 //and freeing the buffers as they become available on freelist
@@ -373,9 +551,25 @@ static int tcp_close_connection(xni_connection_t *conn_)
 
   struct tcp_connection *c = *conn;
 
+#if TCP_USE_ZEROCOPY
+  // the kernel may still send from buffers the caller is about to free
+  for (int i = 0; i < c->num_sockets; i++) {
+    struct tcp_socket *s = c->sockets + i;
+    for (int waits = 0; s->zc_inflight > 0 && waits < 1000; waits++) {
+      struct pollfd pfd = { .fd = s->sockd, .events = 0 };
+      poll(&pfd, 1, 10);
+      tcp_reap_zerocopy(c->context, s);
+    }
+  }
+#endif  // TCP_USE_ZEROCOPY
+
   for (int i = 0; i < c->num_sockets; i++)
     if (c->sockets[i].sockd != -1)
       close(c->sockets[i].sockd);
+  if (c->wakefd != -1)
+    close(c->wakefd);
+  if (c->epfd != -1)
+    close(c->epfd);
 
   /*BWS
   struct tcp_target_buffer **buffers = (c->destination ? c->receive_buffers : c->send_buffers);
@@ -392,24 +586,20 @@ static int tcp_request_target_buffer(xni_context_t ctx_, xni_target_buffer_t *ta
 {
   struct tcp_context *ctx = (struct tcp_context*)ctx_;
   struct tcp_target_buffer **targetbuf = (struct tcp_target_buffer**)targetbuf_;
-  struct tcp_target_buffer *tb = NULL;
-  
-  pthread_mutex_lock(&ctx->buffer_mutex);
-  while (tb == NULL) {
-	  for (size_t i = 0; i < ctx->num_registered; i++) {
-		  struct tcp_target_buffer *ptr = ctx->registered_buffers + i;
-		  if (!ptr->busy) {
-			  tb = ptr;
-			  tb->busy = 1;
-			  break;
-		  }
+  long index;
+
+#if TCP_USE_ZEROCOPY
+  // buffers still being sent from are only freed by reaping
+  while ((index = xni_buffer_pool_try_get(&ctx->buffer_pool)) < 0)
+	  if (!tcp_wait_zerocopy(ctx)) {
+		  index = xni_buffer_pool_get(&ctx->buffer_pool);
+		  break;
 	  }
-	  if (tb == NULL)
-		  pthread_cond_wait(&ctx->buffer_cond, &ctx->buffer_mutex);
-  }
-  pthread_mutex_unlock(&ctx->buffer_mutex);
+#else
+  index = xni_buffer_pool_get(&ctx->buffer_pool);
+#endif  // TCP_USE_ZEROCOPY
     
-  *targetbuf = tb;
+  *targetbuf = ctx->registered_buffers + index;
   return XNI_OK;
 }
 
@@ -444,58 +634,118 @@ static int tcp_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *t
   }
   pthread_mutex_unlock(&conn->socket_mutex);
 
+  // the header is stored in front of the payload so one call sends both
+  int flags = 0;
+  uint32_t zc_sends = 0;
+  const uint32_t zc_first = socket->zc_next;
+#if TCP_USE_ZEROCOPY
+  if (socket->zc_inflight)
+    tcp_reap_zerocopy(tb->context, socket);
+  if (socket->zerocopy)
+    flags = MSG_ZEROCOPY;
+#endif  // TCP_USE_ZEROCOPY
+
   // send the message (header + data payload)
   const size_t total = (size_t)((char*)tb->data - (char*)tb->header) + tb->data_length;
   for (size_t sent = 0; sent < total;) {
-    ssize_t cnt = send(socket->sockd, (char*)tb->header+sent, (total - sent), 0);
+    ssize_t cnt = send(socket->sockd, (char*)tb->header+sent, (total - sent), flags);
     //TODO: fix adding after EINTR logic
-    if (cnt != -1)
+    if (cnt != -1) {
       sent += cnt;
+      // every successful zero copy send is assigned the next id
+      if (flags) {
+        socket->zc_next++;
+        zc_sends++;
+      }
+    }
+#if TCP_USE_ZEROCOPY
+    else if (errno == ENOBUFS && flags)
+      flags = 0;  // out of socket option memory; copy the rest
+#endif  // TCP_USE_ZEROCOPY
     else if (errno != EINTR) {
       perror("send");
       return XNI_ERR;
     }
   }
 
+  // mark the buffer as free unless the kernel still sends from it; this
+  // is recorded before the socket is released to anyone who could reap
+  if (zc_sends) {
+    pthread_mutex_lock(&tb->context->buffer_mutex);
+    tb->zc_conn = conn;
+    tb->zc_socket = socket;
+    tb->zc_first = zc_first;
+    tb->zc_last = zc_first + zc_sends - 1;
+    tb->zc_pending = zc_sends;
+    socket->zc_inflight++;
+    pthread_mutex_unlock(&tb->context->buffer_mutex);
+  } else
+    xni_buffer_pool_put(&tb->context->buffer_pool, (long)(tb - tb->context->registered_buffers));
+
   // mark the socket as free
   pthread_mutex_lock(&conn->socket_mutex);
   socket->busy = 0;
   pthread_cond_signal(&conn->socket_cond);
   pthread_mutex_unlock(&conn->socket_mutex);
 
-  // mark the buffer as free
-  pthread_mutex_lock(&tb->context->buffer_mutex);
-  tb->busy = 0;
-  pthread_cond_signal(&tb->context->buffer_cond);
-  pthread_mutex_unlock(&tb->context->buffer_mutex);
-
   *targetbuf = NULL;
   return XNI_OK;
 }
 
-static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t *targetbuf_)
+#if TCP_USE_EPOLL
+// Wait for a socket with a pending message; the one-shot registration
+// hands each ready socket to exactly one receiver until it is re-armed
+static int tcp_wait_readable_socket(struct tcp_connection *conn, struct tcp_socket **socket)
 {
-  struct tcp_connection *conn = (struct tcp_connection*)conn_;
-  struct tcp_target_buffer **targetbuf = (struct tcp_target_buffer**)targetbuf_;
-  int return_code = XNI_ERR;
+  for (;;) {
+    pthread_mutex_lock(&conn->socket_mutex);
+    const int num_live = conn->num_live;
+    pthread_mutex_unlock(&conn->socket_mutex);
+    if (num_live == 0)
+      return XNI_EOF;
+
+    struct epoll_event event;
+    const int nready = epoll_wait(conn->epfd, &event, 1, -1);
+    if (nready == -1 && errno == EINTR)
+      continue;
+    if (nready != 1) {
+      perror("epoll_wait");
+      return XNI_ERR;
+    }
 
-  // grab a free buffer
-  struct tcp_target_buffer *tb = NULL;
-  pthread_mutex_lock(&conn->context->buffer_mutex);
-  while (tb == NULL) {
-	  for (size_t i = 0; i < conn->context->num_registered; i++) {
-		  struct tcp_target_buffer *ptr = conn->context->registered_buffers + i;
-		  if (!ptr->busy) {
-			  tb = ptr;
-			  tb->busy = 1;
-			  break;
-		  }
+    // the wake descriptor only means the live count must be rechecked
+    if (event.data.u32 < (uint32_t)conn->num_sockets) {
+      *socket = conn->sockets + event.data.u32;
+      return XNI_OK;
     }
-    if (tb == NULL)
-      pthread_cond_wait(&conn->context->buffer_cond, &conn->context->buffer_mutex);
   }
-  pthread_mutex_unlock(&conn->context->buffer_mutex);
+}
 
+// Re-arm the socket for the next message, or retire it on EOF or error
+static void tcp_release_readable_socket(struct tcp_connection *conn, struct tcp_socket *socket, int return_code)
+{
+  if (return_code == XNI_OK) {
+    struct epoll_event event = { .events = EPOLLIN | EPOLLET | EPOLLONESHOT };
+    event.data.u32 = (uint32_t)(socket - conn->sockets);
+    if (epoll_ctl(conn->epfd, EPOLL_CTL_MOD, socket->sockd, &event) == 0)
+      return;
+    perror("epoll_ctl");
+  }
+
+  // a retired socket is never reported again
+  epoll_ctl(conn->epfd, EPOLL_CTL_DEL, socket->sockd, NULL);
+  pthread_mutex_lock(&conn->socket_mutex);
+  socket->eof = 1;
+  if (--conn->num_live == 0) {
+    uint64_t one = 1;
+    if (write(conn->wakefd, &one, sizeof(one)) != sizeof(one))
+      perror("write");
+  }
+  pthread_mutex_unlock(&conn->socket_mutex);
+}
+#else
+static int tcp_wait_readable_socket(struct tcp_connection *conn, struct tcp_socket **socket_)
+{
   struct tcp_socket *socket = NULL;
   while (socket == NULL) {
     // prepare to call select(2)
@@ -512,13 +762,11 @@ static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
       }
     }
     pthread_mutex_unlock(&conn->socket_mutex);
-    if (maxsd == -1) {
-      return_code = XNI_EOF;
-      goto buffer_out;
-    }
+    if (maxsd == -1)
+      return XNI_EOF;
 
     if (select((maxsd + 1), &outfds, NULL, NULL, NULL) < 1)
-      goto buffer_out;
+      return XNI_ERR;
 
     pthread_mutex_lock(&conn->socket_mutex);
     for (int i = 0; i < conn->num_sockets; i++)
@@ -537,34 +785,85 @@ static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
     pthread_mutex_unlock(&conn->socket_mutex);
   }
 
-  char *recvbuf = (char*)tb->header;
-  size_t total = (size_t)((char*)tb->data - (char*)tb->header);
-  for (size_t received = 0; received < total;) {
-    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), 0);
-    if (cnt == 0) {  //TODO: handle true EOF; true EOF only on first read
-      return_code = XNI_EOF;
+  *socket_ = socket;
+  return XNI_OK;
+}
+
+static void tcp_release_readable_socket(struct tcp_connection *conn, struct tcp_socket *socket, int return_code)
+{
+  // mark the socket as free
+  pthread_mutex_lock(&conn->socket_mutex);
+  socket->busy = 0;
+  if (return_code == XNI_EOF)
+    socket->eof = 1;
+  //TODO: re-enable this
+  //pthread_cond_signal(&conn->socket_cond);
+  pthread_mutex_unlock(&conn->socket_mutex);
+}
+#endif  // TCP_USE_EPOLL
+
+static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t *targetbuf_)
+{
+  struct tcp_connection *conn = (struct tcp_connection*)conn_;
+  struct tcp_target_buffer **targetbuf = (struct tcp_target_buffer**)targetbuf_;
+  int return_code = XNI_ERR;
+
+  // grab a free buffer
+  const long index = xni_buffer_pool_get(&conn->context->buffer_pool);
+  struct tcp_target_buffer *tb = conn->context->registered_buffers + index;
+
+  struct tcp_socket *socket = NULL;
+ socket_wait:
+  if ((return_code = tcp_wait_readable_socket(conn, &socket)) != XNI_OK)
+    goto buffer_out;
+  return_code = XNI_ERR;
+
+  // the header usually arrived with the previous payload on this socket
+  while (socket->header_bytes < TCP_DATA_MESSAGE_HEADER_SIZE) {
+    ssize_t cnt = recv(socket->sockd, socket->header+socket->header_bytes,
+                       (TCP_DATA_MESSAGE_HEADER_SIZE - socket->header_bytes), 0);
+    if (cnt == 0) {  // true EOF only between messages
+      if (socket->header_bytes == 0)
+        return_code = XNI_EOF;
       goto socket_out;
-    } else if (cnt == -1) {  //TODO: handle EINTR
+    } else if (cnt == -1) {
+      if (errno == EINTR)
+        continue;
       perror("recv");
       goto socket_out;
     } else
-      received += cnt;
+      socket->header_bytes += cnt;
   }
 
   uint64_t target_offset;
-  memcpy(&target_offset, recvbuf, 8);
+  memcpy(&target_offset, socket->header, 8);
   uint32_t data_length;
-  memcpy(&data_length, recvbuf+8, 4);
-
-  recvbuf = (char*)tb->data;
-  total = data_length;
-  for (size_t received = 0; received < total;) {
-    ssize_t cnt = recv(socket->sockd, recvbuf+received, (total - received), 0);
+  memcpy(&data_length, socket->header+8, 4);
+  socket->header_bytes = 0;
+
+  // receive the payload together with as much of the next header as has
+  // arrived, so a busy stream needs one recvmsg(2) per message
+  struct iovec iov[2];
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = 2;
+  for (size_t received = 0; received < data_length;) {
+    iov[0].iov_base = (char*)tb->data + received;
+    iov[0].iov_len = data_length - received;
+    iov[1].iov_base = socket->header;
+    iov[1].iov_len = TCP_DATA_MESSAGE_HEADER_SIZE;
+    ssize_t cnt = recvmsg(socket->sockd, &msg, 0);
     if (cnt == 0)  // failure EOF
       goto socket_out;
-    else if (cnt == -1) {  //TODO: EINTR
-      perror("recv");
+    else if (cnt == -1) {
+      if (errno == EINTR)
+        continue;
+      perror("recvmsg");
       goto socket_out;
+    } else if ((size_t)cnt > data_length - received) {
+      socket->header_bytes = (size_t)cnt - (data_length - received);
+      received = data_length;
     } else
       received += cnt;
   }
@@ -577,22 +876,18 @@ static int tcp_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
   return_code = XNI_OK;
 
  socket_out:
-  // mark the socket as free
-  pthread_mutex_lock(&conn->socket_mutex);
-  socket->busy = 0;
+  tcp_release_readable_socket(conn, socket, return_code);
+#if TCP_USE_EPOLL
+  // one stream ending is not the end of the connection; XNI_EOF is
+  // returned by the wait once every stream has ended
   if (return_code == XNI_EOF)
-    socket->eof = 1;
-  //TODO: re-enable this
-  //pthread_cond_signal(&conn->socket_cond);
-  pthread_mutex_unlock(&conn->socket_mutex);
+    goto socket_wait;
+#endif  // TCP_USE_EPOLL
 
  buffer_out:
   if (return_code != XNI_OK) {
     // mark the buffer as free
-    pthread_mutex_lock(&conn->context->buffer_mutex);
-    tb->busy = 0;
-    pthread_cond_signal(&conn->context->buffer_cond);
-    pthread_mutex_unlock(&conn->context->buffer_mutex);
+    xni_buffer_pool_put(&conn->context->buffer_pool, index);
   }
 
   return return_code;
@@ -606,10 +901,7 @@ static int tcp_release_target_buffer(xni_target_buffer_t *targetbuf_)
   tb->target_offset = 0;
   tb->data_length = -1;
 
-  pthread_mutex_lock(&tb->context->buffer_mutex);
-  tb->busy = 0;
-  pthread_cond_signal(&tb->context->buffer_cond);
-  pthread_mutex_unlock(&tb->context->buffer_mutex);
+  xni_buffer_pool_put(&tb->context->buffer_pool, (long)(tb - tb->context->registered_buffers));
                          
   *targetbuf = NULL;
   return XNI_OK;
@@ -42,8 +42,8 @@ struct udt_context {
     // added by struct udt_connection
     struct udt_target_buffer *registered_buffers;  // NULL-terminated
 	size_t num_registered;
-    pthread_mutex_t buffer_mutex;
-    pthread_cond_t buffer_cond;
+    struct xni_buffer_pool buffer_pool;  // free registered buffers
+    pthread_mutex_t buffer_mutex;  // registration
 
 };
 
@@ -73,7 +73,6 @@ struct udt_target_buffer {
   int data_length;
 
   // added by udt_target_buffer
-  int busy;
   void *header;
 };
 
@@ -120,8 +119,8 @@ static int udt_context_create(xni_protocol_t proto_, xni_control_block_t cb_, xn
   tmp->protocol = proto;
   tmp->control_block = *cb;
   tmp->registered_buffers = calloc(num_buffers, sizeof(*tmp->registered_buffers));
+  xni_buffer_pool_init(&tmp->buffer_pool, num_buffers);
   pthread_mutex_init(&tmp->buffer_mutex, NULL);
-  pthread_cond_init(&tmp->buffer_cond, NULL);
   
   // Swap in the context
   *ctx = tmp;
@@ -133,7 +132,7 @@ static int udt_context_destroy(xni_context_t *ctx_)
 {
   struct udt_context **ctx = (struct udt_context **)ctx_;
   pthread_mutex_destroy(&(*ctx)->buffer_mutex);
-  pthread_cond_destroy(&(*ctx)->buffer_cond);
+  xni_buffer_pool_destroy(&(*ctx)->buffer_pool);
   free((*ctx)->registered_buffers);
   free(*ctx);
 
@@ -162,10 +161,10 @@ static int udt_register_buffer(xni_context_t ctx_, void* buf, size_t nbytes, siz
 	tb->data = (void*)datap;
 	tb->target_offset = 0;
 	tb->data_length = -1;
-	tb->busy = 0;
 	tb->header = (void*)(datap - UDT_DATA_MESSAGE_HEADER_SIZE);
 	ctx->registered_buffers[ctx->num_registered] = *tb;
 	ctx->num_registered++;
+	xni_buffer_pool_add(&ctx->buffer_pool);
 	pthread_mutex_unlock(&ctx->buffer_mutex);
 
 	// Set the user's target buffer
@@ -392,24 +391,9 @@ static int udt_request_target_buffer(xni_context_t ctx_, xni_target_buffer_t *ta
 {
   struct udt_context *ctx = (struct udt_context*)ctx_;
   struct udt_target_buffer **targetbuf = (struct udt_target_buffer**)targetbuf_;
-  struct udt_target_buffer *tb = NULL;
-  
-  pthread_mutex_lock(&ctx->buffer_mutex);
-  while (tb == NULL) {
-	  for (size_t i = 0; i < ctx->num_registered; i++) {
-		  struct udt_target_buffer *ptr = ctx->registered_buffers + i;
-		  if (!ptr->busy) {
-			  tb = ptr;
-			  tb->busy = 1;
-			  break;
-		  }
-	  }
-	  if (tb == NULL)
-		  pthread_cond_wait(&ctx->buffer_cond, &ctx->buffer_mutex);
-  }
-  pthread_mutex_unlock(&ctx->buffer_mutex);
+  const long index = xni_buffer_pool_get(&ctx->buffer_pool);
     
-  *targetbuf = tb;
+  *targetbuf = ctx->registered_buffers + index;
   return XNI_OK;
 }
 
@@ -464,10 +448,7 @@ static int udt_send_target_buffer(xni_connection_t conn_, xni_target_buffer_t *t
   pthread_mutex_unlock(&conn->socket_mutex);
 
   // mark the buffer as free
-  pthread_mutex_lock(&tb->context->buffer_mutex);
-  tb->busy = 0;
-  pthread_cond_signal(&tb->context->buffer_cond);
-  pthread_mutex_unlock(&tb->context->buffer_mutex);
+  xni_buffer_pool_put(&tb->context->buffer_pool, (long)(tb - tb->context->registered_buffers));
 
   *targetbuf = NULL;
   return XNI_OK;
@@ -480,21 +461,8 @@ static int udt_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
   int return_code = XNI_ERR;
 
   // grab a free buffer
-  struct udt_target_buffer *tb = NULL;
-  pthread_mutex_lock(&conn->context->buffer_mutex);
-  while (tb == NULL) {
-	  for (size_t i = 0; i < conn->context->num_registered; i++) {
-		  struct udt_target_buffer *ptr = conn->context->registered_buffers + i;
-		  if (!ptr->busy) {
-			  tb = ptr;
-			  tb->busy = 1;
-			  break;
-		  }
-    }
-    if (tb == NULL)
-      pthread_cond_wait(&conn->context->buffer_cond, &conn->context->buffer_mutex);
-  }
-  pthread_mutex_unlock(&conn->context->buffer_mutex);
+  const long index = xni_buffer_pool_get(&conn->context->buffer_pool);
+  struct udt_target_buffer *tb = conn->context->registered_buffers + index;
 
   struct udt_socket *socket = NULL;
   while (socket == NULL) {
@@ -589,10 +557,7 @@ static int udt_receive_target_buffer(xni_connection_t conn_, xni_target_buffer_t
  buffer_out:
   if (return_code != XNI_OK) {
     // mark the buffer as free
-    pthread_mutex_lock(&conn->context->buffer_mutex);
-    tb->busy = 0;
-    pthread_cond_signal(&conn->context->buffer_cond);
-    pthread_mutex_unlock(&conn->context->buffer_mutex);
+    xni_buffer_pool_put(&conn->context->buffer_pool, index);
   }
 
   return return_code;
@@ -606,10 +571,7 @@ static int udt_release_target_buffer(xni_target_buffer_t *targetbuf_)
   tb->target_offset = 0;
   tb->data_length = -1;
 
-  pthread_mutex_lock(&tb->context->buffer_mutex);
-  tb->busy = 0;
-  pthread_cond_signal(&tb->context->buffer_cond);
-  pthread_mutex_unlock(&tb->context->buffer_mutex);
+  xni_buffer_pool_put(&tb->context->buffer_pool, (long)(tb - tb->context->registered_buffers));
                          
   *targetbuf = NULL;
   return XNI_OK;
@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# Test that the random data pattern does not depend on the queue depth
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write the random pattern with one and with many Worker Threads
+#
+generate_local_filename sfile
+generate_local_filename mfile
+$XDDTEST_XDD_EXE -op write -target $sfile -reqsize 64 -numreqs 256 -queuedepth 1 -datapattern random >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with a queue depth of 1 failed"
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op write -target $mfile -reqsize 64 -numreqs 256 -queuedepth 16 -datapattern random >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with a queue depth of 16 failed"
+    finalize_test 1
+fi
+
+#
+# The files must be identical
+#
+cmp -s $sfile $mfile
+result=$?
+finalize_test $result
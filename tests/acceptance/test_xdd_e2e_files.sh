@@ -0,0 +1,61 @@
+#!/bin/bash
+#
+# Test that an end-to-end copy with -e2e files recreates a directory tree
+# of many small files, a few large files, an empty directory and read-only
+# files and directories in one xdd process on each side
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename sdir
+generate_local_filename ddir
+mkdir -p $sdir/small/nested $sdir/large $sdir/empty
+for i in $(seq 1 1000); do
+    head -c $((RANDOM % 8192)) /dev/urandom > $sdir/small/f$i
+done
+for i in $(seq 1 100); do
+    head -c $((RANDOM % 512)) /dev/urandom > $sdir/small/nested/g$i
+done
+for i in 1 2 3; do
+    head -c $((i * 7 * 1024 * 1024 + 12345)) /dev/urandom > $sdir/large/l$i
+done
+: > $sdir/large/zero
+mkdir -p $sdir/readonly/inner
+head -c 100000 /dev/urandom > $sdir/readonly/inner/ro
+head -c 3000 /dev/urandom > $sdir/readonly/exec
+chmod 0444 $sdir/readonly/inner/ro
+chmod 0755 $sdir/readonly/exec
+chmod 0500 $sdir/readonly/inner
+chmod 0555 $sdir/readonly
+
+#
+# Run the destination in the background and the source against it
+#
+port=$((20000 + (RANDOM % 100) * 100))
+$XDDTEST_XDD_EXE -op write -target $ddir -e2e files -e2e isdest -e2e dest 127.0.0.1:$port,4 -reqsize 1024 -queuedepth 4 >/dev/null 2>&1 &
+dest_pid=$!
+sleep 1
+$XDDTEST_XDD_EXE -op read -target $sdir -e2e files -e2e issource -e2e dest 127.0.0.1:$port,4 -reqsize 1024 -queuedepth 4 >/dev/null 2>&1
+src_rc=$?
+wait $dest_pid
+dest_rc=$?
+if [ 0 -ne $src_rc -o 0 -ne $dest_rc ]; then
+    echo "XDD files mode source ($src_rc) or destination ($dest_rc) failed"
+    finalize_test 1
+fi
+
+result=0
+if ! diff -r $sdir $ddir >/dev/null; then
+    echo "Destination directory differs from the source directory"
+    result=1
+fi
+smodes=$(cd $sdir && find . -printf "%p %m\n" | sort)
+dmodes=$(cd $ddir && find . -printf "%p %m\n" | sort)
+if [ "$smodes" != "$dmodes" ]; then
+    echo "Modes of the destination directory differ from the source directory"
+    diff <(echo "$smodes") <(echo "$dmodes") | head
+    result=1
+fi
+chmod -R u+w $sdir $ddir
+finalize_test $result
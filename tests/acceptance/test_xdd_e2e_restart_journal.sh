@@ -0,0 +1,51 @@
+#!/bin/bash
+#
+# Test that an end-to-end copy resumed with a restart journal only sends
+# the ranges that the journal does not list and still delivers the same
+# data as the source file
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename sfile
+generate_local_filename dfile
+jfile=$dfile.journal
+rm -f $jfile
+$XDDTEST_XDD_EXE -op write -target $sfile -reqsize 1 -blocksize $((1024*1024)) -bytes $((64*1024*1024)) -datapattern random >/dev/null 2>&1
+if [ 0 -ne $? -o ! -s $sfile ]; then
+    echo "Unable to generate the source file"
+    finalize_test 2
+fi
+
+#
+# Copy the first half of the file, then resume the copy of the whole file
+#
+src_out=$(mktemp)
+for bytes in $((32*1024*1024)) $((64*1024*1024)); do
+    port=$((20000 + (RANDOM % 100) * 100))
+    $XDDTEST_XDD_EXE -op write -target $dfile -e2e isdest -e2e dest 127.0.0.1:$port,4 -restart journal $jfile -reqsize 256 -bytes $bytes >/dev/null 2>&1 &
+    dest_pid=$!
+    sleep 1
+    $XDDTEST_XDD_EXE -op read -target $sfile -e2e issource -e2e dest 127.0.0.1:$port,4 -restart journal $jfile -reqsize 256 -bytes $bytes >$src_out 2>&1
+    src_rc=$?
+    wait $dest_pid
+    dest_rc=$?
+    if [ 0 -ne $src_rc -o 0 -ne $dest_rc ]; then
+        echo "XDD source ($src_rc) or destination ($dest_rc) failed copying $bytes bytes"
+        rm -f $src_out $jfile
+        finalize_test 1
+    fi
+done
+
+result=0
+if ! grep -q "Skipping 33554432 bytes" $src_out; then
+    echo "Resumed source did not skip the first half of the file"
+    result=1
+fi
+if ! cmp -s $sfile $dfile; then
+    echo "Destination file differs from the source file"
+    result=1
+fi
+rm -f $src_out $jfile
+finalize_test $result
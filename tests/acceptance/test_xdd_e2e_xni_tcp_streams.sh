@@ -0,0 +1,39 @@
+#!/bin/bash
+#
+# Test that an XNI TCP end-to-end copy over many streams delivers the same
+# data as the source file when the streams finish at different times
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename sfile
+generate_local_filename dfile
+$XDDTEST_XDD_EXE -op write -target $sfile -reqsize 1 -blocksize $((1024*1024)) -bytes $((64*1024*1024)) -datapattern random >/dev/null 2>&1
+if [ 0 -ne $? -o ! -s $sfile ]; then
+    echo "Unable to generate the source file"
+    finalize_test 2
+fi
+
+#
+# Run the destination in the background and the source against it
+#
+port=$((20000 + (RANDOM % 100) * 100))
+$XDDTEST_XDD_EXE -op write -target $dfile -e2e isdest -e2e dest 127.0.0.1:$port,32 -xni tcp -reqsize 16 -bytes $((64*1024*1024)) >/dev/null 2>&1 &
+dest_pid=$!
+sleep 1
+$XDDTEST_XDD_EXE -op read -target $sfile -e2e issource -e2e dest 127.0.0.1:$port,32 -xni tcp -reqsize 16 -bytes $((64*1024*1024)) >/dev/null 2>&1
+src_rc=$?
+wait $dest_pid
+dest_rc=$?
+if [ 0 -ne $src_rc -o 0 -ne $dest_rc ]; then
+    echo "XDD XNI TCP source ($src_rc) or destination ($dest_rc) failed"
+    finalize_test 1
+fi
+
+result=0
+if ! cmp -s $sfile $dfile; then
+    echo "Destination file differs from the source file"
+    result=1
+fi
+finalize_test $result
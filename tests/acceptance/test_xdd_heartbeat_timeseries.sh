@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# Test that -heartbeat timeseries writes the statistics of each sub-second
+# interval and that the intervals of a pass add up to the whole pass
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename tfile
+generate_local_filename sfile
+truncate -s 64M $tfile
+$XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 16384 -queuedepth 2 -passes 3 -throttle ops 30000 -heartbeat 0.05 -heartbeat timeseries $sfile > /dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD run with -heartbeat timeseries failed"
+    finalize_test 1
+fi
+
+#
+# Every operation of each pass must be in exactly one interval, including
+# the ones after the last heartbeat of a pass that is followed right away
+# by the next pass
+#
+result=0
+if [ ! -s $sfile.T0000.csv ]; then
+    echo "Time series file $sfile.T0000.csv is missing"
+    finalize_test 1
+fi
+for pass in 1 2 3; do
+    ops=$(awk -F, -v pass=$pass 'NR > 1 && $2 == pass {n += $5} END {print n + 0}' $sfile.T0000.csv)
+    if [ "$ops" != "16384" ]; then
+        echo "Time series of pass $pass has $ops ops"
+        result=1
+    fi
+done
+rm -f $sfile.T0000.csv
+finalize_test $result
@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# Test that the latency percentiles of -heartbeat timeseries are real times
+# while the heartbeat merges the latency histograms of Worker Threads that
+# keep recording ops as fast as they can
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename sfile
+$XDDTEST_XDD_EXE -op read -targets 1 null -reqsize 1 -numreqs 2000000 -queuedepth 8 -heartbeat 0.001 -heartbeat timeseries $sfile > /dev/null 2>&1
+if [ 0 -ne $? -o ! -s $sfile.T0000.csv ]; then
+    echo "XDD run with -heartbeat timeseries failed"
+    finalize_test 1
+fi
+
+#
+# An op of the null target takes far less than a second so a percentile of
+# a second or more, or percentiles out of order, mean that the total of a
+# merged histogram does not match its buckets
+#
+bad=$(awk -F, 'NR > 1 && ($12 >= 1000.0 || $13 >= 1000.0 || $14 >= 1000.0 || $15 >= 1000.0 || $12 > $13 || $13 > $14 || $14 > $15) {n++} END {print n + 0}' $sfile.T0000.csv)
+result=0
+if [ "$bad" != "0" ]; then
+    echo "Time series has $bad intervals with impossible latency percentiles"
+    result=1
+fi
+rm -f $sfile.T0000.csv
+finalize_test $result
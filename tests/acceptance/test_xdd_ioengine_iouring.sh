@@ -0,0 +1,40 @@
+#!/bin/bash
+#
+# Test that the io_uring I/O engine writes the same data as the default engine
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write the same sequenced pattern with both engines
+#
+generate_local_filename ufile
+generate_local_filename pfile
+output=$($XDDTEST_XDD_EXE -op write -target $ufile -reqsize 16 -numreqs 1024 -queuedepth 32 -datapattern sequenced -ioengine iouring 2>&1)
+if [ 0 -ne $? ]; then
+    #
+    # Only an engine that this platform or kernel does not provide is a skip
+    #
+    if echo "$output" | grep -q "engine is not supported on this platform" ||
+       (echo "$output" | grep -q "io_uring_setup failed" &&
+        echo "$output" | grep -q "Reason: \(Function not implemented\|Operation not permitted\)"); then
+        echo "io_uring engine not available"
+        finalize_test -1
+    fi
+    echo "XDD write with the io_uring engine failed"
+    echo "$output" | grep -i "error\|reason" | head -5
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op write -target $pfile -reqsize 16 -numreqs 1024 -queuedepth 32 -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write with the default engine failed"
+    finalize_test 1
+fi
+
+#
+# The files must be identical
+#
+cmp -s $ufile $pfile
+result=$?
+finalize_test $result
@@ -0,0 +1,42 @@
+#!/bin/bash
+#
+# Test that the latency percentile output format IDs are displayed and
+# that -latencyhistogram writes the histograms of every pass and the run
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename tfile
+generate_local_filename hfile
+truncate -s 64M $tfile
+output=$($XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 1024 -queuedepth 2 -passes 2 -outputformat add "+P50LATENCY+P9999LATENCY+WRITEP99LATENCY" -latencyhistogram $hfile 2>&1)
+if [ 0 -ne $? ]; then
+    echo "XDD run with latency percentiles failed"
+    finalize_test 1
+fi
+
+#
+# The read percentiles must be real times and there are no writes
+#
+result=0
+combined=$(echo "$output" | grep COMBINED)
+p50=$(echo "$combined" | awk '{print $(NF-2)}')
+write_p99=$(echo "$combined" | awk '{print $NF}')
+if [ "$write_p99" != "-1.000" ] || ! awk "BEGIN {exit !($p50 > 0.0)}"; then
+    echo "Unexpected latency percentiles: $combined"
+    result=1
+fi
+
+#
+# Every read must be counted once in the histograms of each pass and of the run
+#
+for pass in 1:1024 2:1024 all:2048; do
+    count=$(awk -F, -v pass=${pass%:*} '$1 == pass && $3 == "all" {n += $7} END {print n + 0}' $hfile)
+    if [ "$count" != "${pass#*:}" ]; then
+        echo "Latency histogram of pass ${pass%:*} has $count reads"
+        result=1
+    fi
+done
+rm -f $hfile
+finalize_test $result
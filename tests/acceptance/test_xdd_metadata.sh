@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# Test that -metadata runs every phase of the metadata workload, reports
+# the rate of each phase and leaves no files behind
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename mdir
+output=$($XDDTEST_XDD_EXE -op write -target $mdir -reqsize 1 -queuedepth 4 -passes 2 -metadata files 200 -metadata dirs 2 2>&1)
+rc=$?
+if [ 0 -ne $rc ]; then
+    echo "XDD metadata workload failed with $rc"
+    finalize_test 1
+fi
+
+result=0
+for phase in create stat open readdir rename unlink; do
+    ops=$(echo "$output" | awk -v phase=$phase '$1 == "METADATA" && $3 == phase {print $4}')
+    expected=1600
+    if [ "$phase" = "readdir" ]; then
+        expected=16
+    fi
+    if [ "$ops" != "$expected" ]; then
+        echo "Phase $phase reported '$ops' ops, expected $expected"
+        result=1
+    fi
+done
+if [ -n "$(find $mdir -type f)" ]; then
+    echo "Files are left in $mdir after the unlink phase"
+    result=1
+fi
+rm -rf $mdir
+
+#
+# The asynchronous I/O engines and E2E would never run the metadata loop
+# so they must be refused up front
+#
+for other in "-ioengine iouring" "-e2e isdest -e2e dest 127.0.0.1:40010,1"; do
+    timeout 30 $XDDTEST_XDD_EXE -op write -target $mdir -reqsize 1 -metadata files 20 $other >/dev/null 2>&1
+    rc=$?
+    if [ 0 -eq $rc -o 124 -eq $rc ]; then
+        echo "XDD metadata workload with $other was not refused (exit $rc)"
+        result=1
+    fi
+done
+rm -rf $mdir
+finalize_test $result
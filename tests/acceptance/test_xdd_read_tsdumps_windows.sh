@@ -0,0 +1,46 @@
+#!/bin/bash
+#
+# Test that xdd-read-tsdumps summarizes each window of a timestamp dump
+# for all worker threads and for each of them, the same with any
+# number of analysis threads
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename tfile
+generate_local_filename dfile
+truncate -s 64M $tfile
+$XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 4096 -queuedepth 4 -ts dump $dfile >/dev/null 2>&1
+if [ 0 -ne $? -o ! -s $dfile.target.0000.bin ]; then
+    echo "XDD run with -ts dump failed"
+    finalize_test 1
+fi
+
+#
+# Analyze with one thread and with several - the gnuplot file goes in the
+# current directory so run from the test directory
+#
+for threads in 1 3; do
+    (cd $(dirname $dfile) && $XDDTEST_XDD_PATH/xdd-read-tsdumps -j $threads -t 0.01 -o $dfile.j$threads $dfile.target.0000.bin >/dev/null 2>&1)
+    if [ ! -s $dfile.j$threads/windows.csv -o ! -s $dfile.j$threads/analysis.dat ]; then
+        echo "xdd-read-tsdumps -j $threads did not write its results"
+        finalize_test 1
+    fi
+done
+
+#
+# Every op must be in the windows of all worker threads and in the windows of each one
+#
+result=0
+all_ops=$(awk -F, '$4 == "all" {ops += $5} END {print ops}' $dfile.j1/windows.csv)
+worker_ops=$(awk -F, 'NR > 1 && $4 != "all" {ops += $5} END {print ops}' $dfile.j1/windows.csv)
+if [ "$all_ops" != "4096" -o "$worker_ops" != "4096" ]; then
+    echo "Windows have $all_ops ops for all worker threads and $worker_ops for each - expected 4096"
+    result=1
+fi
+if ! cmp -s $dfile.j1/windows.csv $dfile.j3/windows.csv; then
+    echo "Windows differ between 1 and 3 analysis threads"
+    result=1
+fi
+finalize_test $result
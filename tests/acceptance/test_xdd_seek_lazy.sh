@@ -0,0 +1,32 @@
+#!/bin/bash
+#
+# Test that -seek lazy generates the same seek list as the materialized list
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Save a random, mixed read/write, throttled seek list both ways
+#
+generate_local_filename tfile
+generate_local_filename lfile
+generate_local_filename mfile
+truncate -s 256M $tfile
+$XDDTEST_XDD_EXE -op write -target $tfile -reqsize 4 -numreqs 4096 -queuedepth 4 -seek random -seek range 200000 -seek seed 42 -rwratio 30 -throttle bw 100 -throttle var 10 -seek save $mfile >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD run with a materialized seek list failed"
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op write -target $tfile -reqsize 4 -numreqs 4096 -queuedepth 4 -seek random -seek range 200000 -seek seed 42 -rwratio 30 -throttle bw 100 -throttle var 10 -seek save $lfile -seek lazy >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD run with -seek lazy failed"
+    finalize_test 1
+fi
+
+#
+# The saved seek lists must be identical
+#
+cmp -s $mfile.T0.txt $lfile.T0.txt
+result=$?
+finalize_test $result
@@ -0,0 +1,76 @@
+#!/bin/bash
+#
+# Test that -seek physical reads a fragmented file in on-disk order and
+# reports its extents
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write a sequenced pattern, then copy it back to front into a new file
+# interleaved with another file so that the copy ends up fragmented
+#
+generate_local_filename pfile
+generate_local_filename ffile
+generate_local_filename zfile
+generate_local_filename sname
+$XDDTEST_XDD_EXE -op write -target $pfile -reqsize 64 -numreqs 64 -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write of the sequenced pattern failed"
+    finalize_test 1
+fi
+for i in $(seq 63 -1 0); do
+    dd if=$pfile of=$ffile bs=65536 skip=$i seek=$i count=1 conv=notrunc,fsync >/dev/null 2>&1
+    dd if=/dev/zero of=$zfile bs=65536 seek=$((63 - i)) count=1 conv=notrunc,fsync >/dev/null 2>&1
+done
+
+#
+# Read it back in physical order with verification
+#
+output=$($XDDTEST_XDD_EXE -op read -target $ffile -reqsize 64 -numreqs 64 -queuedepth 4 -datapattern sequenced -verify contents -seek physical -seek save $sname 2>&1)
+rc=$?
+if echo "$output" | grep -q "Cannot get the physical layout"; then
+    echo "FIEMAP is not supported on this file system"
+    finalize_test -1
+fi
+if [ 0 -ne $rc ]; then
+    echo "XDD read in physical order failed with $rc"
+    finalize_test 1
+fi
+result=0
+ops=$(echo "$output" | awk '$1 == "EXTENTS" {print $5}')
+if [ "$ops" != "64" ]; then
+    echo "Expected 64 ops in physical order, got '$ops'"
+    result=1
+fi
+
+#
+# The device location of each op in the saved seek list must never go down
+#
+if command -v filefrag >/dev/null 2>&1; then
+    filefrag -v $ffile | awk -v list=$sname.T0.txt '
+        /blocks of/ { bsize = $(NF-1) }
+        $1 ~ /^[0-9]+:$/ {
+            gsub(/[:.]+/, " ")
+            n++; lstart[n] = $2 * bsize; lend[n] = ($3 + 1) * bsize; pstart[n] = $4 * bsize
+        }
+        END {
+            prev = -1
+            while ((getline line < list) > 0) {
+                if (line ~ /^#/) continue
+                split(line, f, " ")
+                offset = f[2] * 1024
+                for (e = 1; e <= n; e++)
+                    if (offset >= lstart[e] && offset < lend[e]) break
+                location = pstart[e] + (offset - lstart[e])
+                if (location < prev) { print "Op " f[1] " is out of physical order"; exit 1 }
+                prev = location
+            }
+        }'
+    if [ 0 -ne $? ]; then
+        result=1
+    fi
+fi
+rm -f $pfile $ffile $zfile $sname.T0.txt
+finalize_test $result
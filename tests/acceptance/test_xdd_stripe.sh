@@ -0,0 +1,52 @@
+#!/bin/bash
+#
+# Test that -stripe spreads the offsets of a target round-robin across its
+# files in stripe units and that the striped data reads back intact
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename pfile
+generate_local_filename sfile
+generate_local_filename jfile
+
+#
+# Write the same sequenced pattern to a plain target and to a target striped
+# across 3 files, with requests that straddle the stripe units
+#
+$XDDTEST_XDD_EXE -op write -target $pfile -reqsize 96 -numreqs 40 -queuedepth 4 -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write of the plain target failed"
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op write -target $sfile -reqsize 96 -numreqs 40 -queuedepth 4 -datapattern sequenced -stripe count 3 -stripe unit 65536 >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write of the striped target failed"
+    finalize_test 1
+fi
+
+#
+# Put the stripe units back together in logical order - they must match the plain target
+#
+units=$(( (96 * 1024 * 40) / 65536 ))
+: > $jfile
+for u in $(seq 0 $((units - 1))); do
+    dd if=$sfile.$((u % 3)) bs=65536 skip=$((u / 3)) count=1 >> $jfile 2>/dev/null
+done
+result=0
+if ! cmp -s $pfile $jfile; then
+    echo "The stripe files do not hold the stripe units of the target in order"
+    result=1
+fi
+
+#
+# Read the striped target back through the file list with verification
+#
+$XDDTEST_XDD_EXE -op read -target $sfile -reqsize 96 -numreqs 40 -queuedepth 4 -datapattern sequenced -verify contents -stripe files $sfile.0,$sfile.1,$sfile.2 -stripe unit 65536 >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD verify of the striped target failed"
+    result=1
+fi
+rm -f $pfile $jfile $sfile.0 $sfile.1 $sfile.2
+finalize_test $result
@@ -0,0 +1,46 @@
+#!/bin/bash
+#
+# Test that -ts compact writes a columnar timestamp file that is smaller
+# than the plain dump and that xdd-read-tsdumps reads every op from it
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename tfile
+generate_local_filename dfile
+generate_local_filename cfile
+truncate -s 64M $tfile
+$XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 4096 -queuedepth 4 -ts dump $dfile >/dev/null 2>&1
+if [ 0 -ne $? -o ! -s $dfile.target.0000.bin ]; then
+    echo "XDD run with -ts dump failed"
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 4096 -queuedepth 4 -ts dump $cfile -ts compact >/dev/null 2>&1
+if [ 0 -ne $? -o ! -s $cfile.target.0000.bin ]; then
+    echo "XDD run with -ts compact failed"
+    finalize_test 1
+fi
+
+result=0
+dsize=$(stat -c %s $dfile.target.0000.bin)
+csize=$(stat -c %s $cfile.target.0000.bin)
+if [ $((csize * 4)) -gt $dsize ]; then
+    echo "Compact file is $csize bytes - the dump is $dsize bytes"
+    result=1
+fi
+
+#
+# Every op must be read back from the compact file
+#
+(cd $(dirname $cfile) && $XDDTEST_XDD_PATH/xdd-read-tsdumps -t 0.01 -o $cfile.out $cfile.target.0000.bin >/dev/null 2>&1)
+if [ ! -s $cfile.out/windows.csv ]; then
+    echo "xdd-read-tsdumps did not read the compact file"
+    finalize_test 1
+fi
+all_ops=$(awk -F, '$4 == "all" {ops += $5} END {print ops}' $cfile.out/windows.csv)
+if [ "$all_ops" != "4096" ]; then
+    echo "Windows of the compact file have $all_ops ops - expected 4096"
+    result=1
+fi
+finalize_test $result
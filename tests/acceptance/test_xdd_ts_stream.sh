@@ -0,0 +1,48 @@
+#!/bin/bash
+#
+# Test that -ts stream writes one time stamp entry per operation while
+# the in-memory time stamp ring is much smaller than the run, and that
+# xdd-read-tsdumps reads back every entry of a file with several segments
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+generate_local_filename tfile
+generate_local_filename sfile
+truncate -s 512M $tfile
+output=$($XDDTEST_XDD_EXE -op read -target $tfile -reqsize 4 -numreqs 100000 -queuedepth 4 -passes 2 -ts size 64 -ts stream $sfile 2>&1)
+if [ 0 -ne $? ]; then
+    echo "XDD run with -ts stream failed"
+    finalize_test 1
+fi
+
+#
+# Every operation of both passes must be in the stream file - 200000
+# entries take 4 segments of the file
+#
+echo "$output" | grep -q "Timestamp stream written to $sfile.target.0000.bin - 200000 entries"
+if [ 0 -ne $? -o ! -s $sfile.target.0000.bin ]; then
+    echo "Timestamp stream file $sfile.target.0000.bin does not have 200000 entries"
+    finalize_test 1
+fi
+
+#
+# The gnuplot file goes in the current directory so run from the test directory
+#
+errors=$(cd $(dirname $sfile) && $XDDTEST_XDD_PATH/xdd-read-tsdumps -t 0.01 -o $sfile.out $sfile.target.0000.bin 2>&1 >/dev/null)
+if [ ! -s $sfile.out/windows.csv ]; then
+    echo "xdd-read-tsdumps did not write its results: $errors"
+    finalize_test 1
+fi
+result=0
+if echo "$errors" | grep -q "damaged"; then
+    echo "xdd-read-tsdumps found a damaged segment: $errors"
+    result=1
+fi
+all_ops=$(awk -F, '$4 == "all" {ops += $5} END {print ops}' $sfile.out/windows.csv)
+if [ "$all_ops" != "200000" ]; then
+    echo "Windows have $all_ops ops - expected 200000"
+    result=1
+fi
+finalize_test $result
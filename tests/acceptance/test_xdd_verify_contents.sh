@@ -0,0 +1,33 @@
+#!/bin/bash
+#
+# Test that -verify contents passes for good data and fails for damaged data
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write a sequenced pattern and read it back with verification
+#
+generate_local_filename vfile
+$XDDTEST_XDD_EXE -op write -target $vfile -reqsize 64 -numreqs 64 -queuedepth 4 -datapattern sequenced >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write of the sequenced pattern failed"
+    finalize_test 1
+fi
+$XDDTEST_XDD_EXE -op read -target $vfile -reqsize 64 -numreqs 64 -queuedepth 4 -datapattern sequenced -verify contents >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD verify of good data failed"
+    finalize_test 1
+fi
+
+#
+# Damage one block in the middle of the file - the verify must now fail
+#
+dd if=/dev/zero of=$vfile bs=4096 seek=100 count=1 conv=notrunc >/dev/null 2>&1
+$XDDTEST_XDD_EXE -op read -target $vfile -reqsize 64 -numreqs 64 -queuedepth 4 -datapattern sequenced -verify contents >/dev/null 2>&1
+if [ 0 -eq $? ]; then
+    echo "XDD verify did not detect damaged data"
+    finalize_test 1
+fi
+finalize_test 0
@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Benchmark the cost of -serialordering and -looseordering.
+#
+# Runs NOOP operations against /dev/null so that the only thing being
+# measured is how fast the Worker Threads can pass ops to each other
+# through the Target Offset Table. Prints the ops/second for each ordering
+# at each queue depth. Give a second xdd binary to compare two builds,
+# for example one from before and one from after a change to the TOT.
+#
+# Usage: bench_xdd_ordering.sh [xdd] [baseline xdd]
+#
+
+# Parameters
+xdd=${1:-xdd}
+baseline=$2
+numreqs=200000
+queue_depths="2 8 32"
+passes=3
+#end Parameters
+
+run_one() {
+    $1 -op noop -targets 1 /dev/null -reqsize 1 -numreqs $numreqs -qd $2 -passes $passes $3 2>&1 | \
+        awk '/ COMBINED /{print $9}'
+}
+
+printf "%-40s %6s %-16s %14s\n" "xdd" "qd" "ordering" "ops/sec"
+for qd in $queue_depths
+do
+    for ordering in none -serialordering -looseordering
+    do
+        opt=$ordering
+        [ "$ordering" = "none" ] && opt=""
+        for exe in $xdd $baseline
+        do
+            printf "%-40s %6d %-16s %14s\n" "$exe" $qd $ordering "$(run_one $exe $qd "$opt")"
+        done
+    done
+done